@@ -0,0 +1,41 @@
+#pragma once
+#include "YRenderLib/Renderer.h"
+#include "YBaseLib/PODArray.h"
+#include <mutex>
+
+// Holds the final reference to resources until the GPU can no longer be using them. A resource released during
+// frame N may be referenced by commands for frame N, which the GPU can still be executing until frame
+// N + frameLatency + 1 begins, so releases are bucketed by frame and a bucket is emptied when its slot comes
+// round again. Release may be called from any thread, BeginFrame and ReleaseAll from the render thread only.
+class DeferredReleaseQueue
+{
+public:
+    DeferredReleaseQueue(uint32 frameLatency);
+    ~DeferredReleaseQueue();
+
+    // Takes over the caller's reference.
+    void Release(GPUResource *pResource);
+
+    // Releases everything queued frameLatency + 1 frames ago, cost is proportional to the number released.
+    void BeginFrame();
+
+    // Releases everything regardless of age, for when the GPU is idle, e.g. at shutdown.
+    void ReleaseAll();
+
+    uint32 GetFrameLatency() const { return m_bucketCount - 1; }
+    uint32 GetPendingCount() const;
+
+private:
+    // moves a bucket into m_releaseList, the lock must be held
+    void TakeBucket(uint32 bucketIndex);
+    void ReleaseTakenResources();
+
+    PODArray<GPUResource *> *m_pBuckets;
+    uint32 m_bucketCount;
+    uint32 m_currentBucket;
+
+    // only touched on the render thread, so releases happen without the lock held
+    PODArray<GPUResource *> m_releaseList;
+
+    mutable std::mutex m_mutex;
+};
@@ -0,0 +1,156 @@
+#pragma once
+#include "YRenderLib/Renderer.h"
+#include "YBaseLib/PODArray.h"
+
+class FrameGraph;
+class RenderTargetPool;
+struct TransientRenderTarget;
+
+typedef uint32 FrameGraphResource;
+#define FRAME_GRAPH_INVALID_RESOURCE (0xFFFFFFFF)
+
+// What happens to a target's contents when a pass binds it for writing.
+enum FRAME_GRAPH_LOAD_OP
+{
+    FRAME_GRAPH_LOAD_OP_LOAD,           // keep the previous contents
+    FRAME_GRAPH_LOAD_OP_CLEAR,          // clear to the pass's clear values
+    FRAME_GRAPH_LOAD_OP_DONT_CARE,      // the pass overwrites everything, previous contents are discarded
+};
+
+// Called with the pass's targets bound and the viewport covering the first of them.
+typedef void(*FrameGraphExecuteFunction)(FrameGraph *pFrameGraph, GPUContext *pGPUContext, void *pUserData);
+
+// Per-frame graph of render passes. Passes declare which virtual resources they read and write, then Compile
+// orders the passes by those dependencies, culls passes whose results are never used, and works out the first
+// and last pass using each transient resource. Execute allocates transient targets from a RenderTargetPool just
+// before their first use and returns them straight after their last, binds each pass's targets, clears or
+// discards them according to their load ops, and discards transient targets at the end of their lifetime.
+//
+// A read sees the contents written by the last pass added before it that writes the resource, or by the first
+// writer if none was, while reads of imported resources added before any writer see their previous contents.
+// Passes writing the same resource run in the order they were added, each after the reads of the contents it
+// replaces. Otherwise passes keep the order they were added. Compile doesn't touch the GPU, and Execute can run
+// without one, so graphs can be checked without a device. Names are not copied and must outlive the frame.
+class FrameGraph
+{
+public:
+    FrameGraph();
+    ~FrameGraph();
+
+    // Clears all passes and resources, ready for the next frame.
+    void Reset();
+
+    // transient resources, allocated from the pool while in use
+    FrameGraphResource CreateRenderTarget(const char *name, const GPU_TEXTURE2D_DESC *pTextureDesc);
+    FrameGraphResource CreateDepthStencilBuffer(const char *name, const GPU_TEXTURE2D_DESC *pTextureDesc);
+
+    // Resources owned elsewhere. Imported resources are never discarded, and passes writing them are kept.
+    // Importing a render target with a null texture and view refers to the context's current output buffer,
+    // which must be the only target written by passes using it.
+    FrameGraphResource ImportRenderTarget(const char *name, GPUTexture2D *pTexture, GPURenderTargetView *pRenderTargetView);
+    FrameGraphResource ImportDepthStencilBuffer(const char *name, GPUTexture2D *pTexture, GPUDepthStencilBufferView *pDepthStencilBufferView);
+
+    // Keeps a transient resource's writers alive even if nothing in the graph reads it, and keeps its target
+    // out of the pool after Execute so GetTexture can fetch the result. Outputs are returned to the pool by
+    // ReleaseOutputs, Reset or the next Execute, so the pool must outlive them.
+    void MarkOutput(FrameGraphResource resource);
+    void ReleaseOutputs();
+
+    // passes, returns the pass index
+    uint32 AddPass(const char *name, FrameGraphExecuteFunction executeFunction, void *pUserData);
+    void PassRead(uint32 pass, FrameGraphResource resource);
+    void PassWriteRenderTarget(uint32 pass, FrameGraphResource resource, FRAME_GRAPH_LOAD_OP loadOp = FRAME_GRAPH_LOAD_OP_LOAD);
+    void PassWriteDepthStencilBuffer(uint32 pass, FrameGraphResource resource, FRAME_GRAPH_LOAD_OP loadOp = FRAME_GRAPH_LOAD_OP_LOAD);
+    void SetPassClearValues(uint32 pass, const FloatColor &clearColor, float clearDepth = 1.0f, uint8 clearStencil = 0);
+
+    // passes with side effects, e.g. readbacks or compute writes to buffers, are never culled
+    void SetPassHasSideEffects(uint32 pass);
+
+    // Returns false if the graph is invalid, e.g. a resource is read before it's written.
+    bool Compile();
+
+    // Runs the compiled graph. Every transient target other than the outputs is back in the pool when this returns.
+    // With a null context and pool, only the execute functions are called, in order and with a null context, so
+    // scheduling can be tested without a device. GetTexture returns null for transients in that case.
+    bool Execute(GPUContext *pGPUContext, RenderTargetPool *pRenderTargetPool);
+
+    // Resources of the current pass, valid during its execute function, and outputs until they are released.
+    GPUTexture2D *GetTexture(FrameGraphResource resource) const;
+
+    // compiled graph queries
+    uint32 GetPassCount() const { return m_passes.GetSize(); }
+    uint32 GetResourceCount() const { return m_resources.GetSize(); }
+    bool IsPassCulled(uint32 pass) const { return m_passes[pass].Culled; }
+    uint32 GetCulledPassCount() const;
+
+    // Pass at a position in the compiled order, culled passes included.
+    uint32 GetScheduledPass(uint32 position) const { return m_schedule[position]; }
+
+    // Passes using the resource first and last, FRAME_GRAPH_INVALID_RESOURCE if no remaining pass uses it.
+    void GetResourceLifetime(FrameGraphResource resource, uint32 *pFirstPass, uint32 *pLastPass) const;
+
+    // Logs passes, culling and resource lifetimes.
+    void DumpToLog() const;
+
+private:
+    enum RESOURCE_USAGE
+    {
+        RESOURCE_USAGE_READ,
+        RESOURCE_USAGE_RENDER_TARGET,
+        RESOURCE_USAGE_DEPTH_STENCIL_BUFFER,
+    };
+
+    struct Resource
+    {
+        const char *Name;
+        GPU_TEXTURE2D_DESC TextureDesc;
+        bool IsDepthStencil;
+        bool IsImported;
+        bool IsOutput;
+        uint32 ReferenceCount;
+        uint32 FirstPass;
+        uint32 LastPass;
+
+        GPUTexture2D *pTexture;
+        GPURenderTargetView *pRenderTargetView;
+        GPUDepthStencilBufferView *pDepthStencilBufferView;
+        const TransientRenderTarget *pTransientTarget;
+    };
+
+    struct Pass
+    {
+        const char *Name;
+        FrameGraphExecuteFunction ExecuteFunction;
+        void *pUserData;
+        FloatColor ClearColor;
+        float ClearDepth;
+        uint8 ClearStencil;
+        bool HasSideEffects;
+        bool Culled;
+        uint32 ReferenceCount;
+        uint32 FirstUse;
+        uint32 UseCount;
+    };
+
+    struct ResourceUse
+    {
+        uint32 Pass;
+        FrameGraphResource Resource;
+        RESOURCE_USAGE Usage;
+        FRAME_GRAPH_LOAD_OP LoadOp;
+        FRAME_GRAPH_LOAD_OP CompiledLoadOp;     // LoadOp as executed, set by Compile
+        uint32 Order;
+    };
+
+    FrameGraphResource AddResource(const char *name, const GPU_TEXTURE2D_DESC *pTextureDesc, bool isDepthStencil);
+    void AddResourceUse(uint32 pass, FrameGraphResource resource, RESOURCE_USAGE usage, FRAME_GRAPH_LOAD_OP loadOp);
+    bool SchedulePasses();
+    bool ExecutePass(uint32 passIndex, GPUContext *pGPUContext, RenderTargetPool *pRenderTargetPool);
+
+    PODArray<Resource> m_resources;
+    PODArray<Pass> m_passes;
+    PODArray<ResourceUse> m_uses;
+    PODArray<uint32> m_schedule;
+    RenderTargetPool *m_pOutputRenderTargetPool;
+    bool m_compiled;
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include "YRenderLib/Renderer.h"
+#include "YBaseLib/PODArray.h"
+#include <unordered_map>
+
+// Asks the owner of a resource to release it. Return true once the owner has dropped its references, the
+// tracker then stops accounting the resource. Returning false keeps the resource, e.g. if it's still in use.
+// The callback may untrack its own resource, but must not track or untrack any others.
+typedef bool(*GPUMemoryEvictionCallback)(GPUResource *pResource, void *pUserData);
+
+#define GPU_MEMORY_MAX_CATEGORIES (32)
+#define GPU_MEMORY_INVALID_CATEGORY (0xFFFFFFFF)
+
+struct GPU_MEMORY_CATEGORY_SNAPSHOT
+{
+    const char *Name;
+    uint64 Usage;
+    uint64 PeakUsage;
+    uint64 Budget;                  // 0 for no budget
+    uint32 ResourceCount;
+    uint32 EvictionCount;           // since the category was registered
+};
+
+struct GPU_MEMORY_SNAPSHOT
+{
+    uint32 FrameNumber;
+    uint64 TotalUsage;
+    uint64 TotalPeakUsage;
+    uint64 TotalBudget;             // 0 for no budget
+    uint32 CategoryCount;
+    GPU_MEMORY_CATEGORY_SNAPSHOT Categories[GPU_MEMORY_MAX_CATEGORIES];
+};
+
+// Accounts GPU memory against user-defined categories (e.g. "Textures", "Meshes", "Render Targets"), with
+// high-water marks and optional budgets per category and in total. Each category keeps its resources in
+// least-recently-used order, when a budget is exceeded the oldest resources with an eviction callback are
+// released until it fits again. Sizes are taken from GPUResource::GetMemoryUsage when tracking starts.
+// Not thread-safe, intended to be used from the render thread.
+class GPUMemoryTracker
+{
+public:
+    GPUMemoryTracker();
+    ~GPUMemoryTracker();
+
+    // Returns the category index, or GPU_MEMORY_INVALID_CATEGORY if too many categories are registered.
+    // Registering an existing name returns the existing category.
+    uint32 RegisterCategory(const char *name, uint64 budget = 0);
+    uint32 FindCategory(const char *name) const;
+
+    // budgets of zero disable enforcement
+    void SetCategoryBudget(uint32 category, uint64 budget);
+    void SetTotalBudget(uint64 budget) { m_totalBudget = budget; }
+
+    // Adds a reference to the resource while it's tracked. Resources without an eviction callback are
+    // accounted but never evicted.
+    void TrackResource(GPUResource *pResource, uint32 category, GPUMemoryEvictionCallback evictionCallback = nullptr, void *pUserData = nullptr);
+    void UntrackResource(GPUResource *pResource);
+    bool IsResourceTracked(GPUResource *pResource) const { return (m_resourceMap.find(pResource) != m_resourceMap.end()); }
+
+    // marks a resource as used this frame, moving it to the back of the eviction order
+    void TouchResource(GPUResource *pResource);
+
+    // Advances the frame counter used for LRU ordering, and evicts anything over budget.
+    void BeginFrame();
+
+    // Evicts least recently used resources until an allocation of the given size fits in both the category
+    // and total budgets. Returns false without evicting if the evictable resources can't cover it, or after
+    // evicting if callbacks refused. Resources touched in the current frame are never evicted.
+    bool MakeRoom(uint32 category, uint64 size);
+
+    // Evicts until all categories and the total are within budget.
+    void EnforceBudgets();
+
+    // queries
+    uint32 GetCategoryCount() const { return m_categories.GetSize(); }
+    uint64 GetCategoryUsage(uint32 category) const { return m_categories[category].Usage; }
+    uint64 GetCategoryPeakUsage(uint32 category) const { return m_categories[category].PeakUsage; }
+    uint64 GetTotalUsage() const { return m_totalUsage; }
+    uint64 GetTotalPeakUsage() const { return m_totalPeakUsage; }
+    void ResetPeakUsage();
+    void GetSnapshot(GPU_MEMORY_SNAPSHOT *pSnapshot) const;
+
+private:
+    struct Entry
+    {
+        GPUResource *pResource;
+        GPUMemoryEvictionCallback EvictionCallback;
+        void *pUserData;
+        uint64 Size;
+        uint32 Category;
+        uint32 LastUsedFrame;
+        uint32 Previous;            // towards least recently used
+        uint32 Next;                // towards most recently used
+    };
+
+    struct Category
+    {
+        char Name[64];
+        uint64 Usage;
+        uint64 PeakUsage;
+        uint64 Budget;
+        uint32 ResourceCount;
+        uint32 EvictionCount;
+        uint32 Head;                // least recently used
+        uint32 Tail;                // most recently used
+    };
+
+    void LinkEntry(uint32 entryIndex);
+    void UnlinkEntry(uint32 entryIndex);
+    void RemoveEntry(uint32 entryIndex);
+    uint64 EvictFromCategory(uint32 category, uint64 bytesToFree);
+    uint64 EvictFromAll(uint64 bytesToFree);
+    uint64 GetEvictableUsage(uint32 category) const;
+
+    PODArray<Entry> m_entries;
+    PODArray<uint32> m_freeEntries;
+    PODArray<Category> m_categories;
+    std::unordered_map<const GPUResource *, uint32> m_resourceMap;
+
+    uint64 m_totalUsage;
+    uint64 m_totalPeakUsage;
+    uint64 m_totalBudget;
+    uint32 m_frameNumber;
+};
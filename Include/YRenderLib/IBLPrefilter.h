@@ -0,0 +1,87 @@
+#pragma once
+#include "YBaseLib/Common.h"
+#include "YBaseLib/NonCopyable.h"
+#include "YBaseLib/PODArray.h"
+#include "YRenderLib/PixelFormat.h"
+#include "YRenderLib/RendererTypes.h"
+#include "YRenderLib/Math/Vectorf.h"
+
+// Cube map face data in system memory. Subresources are stored face-major (every level of +X, then every level of -X,
+// and so on), which is the order CreateTextureCube takes its initial data in:
+//
+//   GPU_TEXTURECUBE_DESC desc;
+//   cubeMap.GetTextureDesc(&desc, GPU_TEXTURE_FLAG_SHADER_BINDABLE);
+//   pDevice->CreateTextureCube(&desc, &samplerDesc, cubeMap.GetInitialData(), cubeMap.GetInitialDataPitches());
+class IBLCubeMapData
+{
+    DeclareNonCopyable(IBLCubeMapData);
+
+public:
+    IBLCubeMapData();
+    ~IBLCubeMapData();
+
+    // Allocates every face and level, contents are undefined. A mipLevels of 0 creates the full chain down to 1x1.
+    bool Create(PIXEL_FORMAT format, uint32 faceSize, uint32 mipLevels);
+    void Destroy();
+
+    PIXEL_FORMAT GetFormat() const { return m_format; }
+    uint32 GetFaceSize() const { return m_faceSize; }
+    uint32 GetMipLevels() const { return m_mipLevels; }
+    uint32 GetMipSize(uint32 mipLevel) const { return Max(m_faceSize >> mipLevel, (uint32)1); }
+
+    void *GetFaceData(CUBEMAP_FACE face, uint32 mipLevel) { return const_cast<void *>(m_subresourceData[face * m_mipLevels + mipLevel]); }
+    const void *GetFaceData(CUBEMAP_FACE face, uint32 mipLevel) const { return m_subresourceData[face * m_mipLevels + mipLevel]; }
+    uint32 GetFacePitch(uint32 mipLevel) const { return m_subresourcePitches[mipLevel]; }
+
+    // arguments for CreateTextureCube
+    void GetTextureDesc(GPU_TEXTURECUBE_DESC *pTextureDesc, uint32 flags) const;
+    const void **GetInitialData() const { return const_cast<const void **>(m_subresourceData.GetBasePointer()); }
+    const uint32 *GetInitialDataPitches() const { return m_subresourcePitches.GetBasePointer(); }
+
+private:
+    PIXEL_FORMAT m_format;
+    uint32 m_faceSize;
+    uint32 m_mipLevels;
+    byte *m_pMemory;
+    PODArray<const void *> m_subresourceData;
+    PODArray<uint32> m_subresourcePitches;
+};
+
+// Irradiance as 9 RGB spherical harmonic coefficients (bands 0-2), already convolved with the cosine lobe.
+// Evaluating it for a normal gives irradiance, divide by pi for the radiance leaving a white Lambertian surface.
+struct IBL_SH9
+{
+    Vector3f Coefficients[9];
+};
+
+// Offline image-based lighting preprocessing on the CPU, for baking reflection probes without a GPU.
+//
+// Directions follow the cube map face layout samplers use: +Y is up, +Z is the centre of the +Z face. Equirectangular
+// images have +Y along the top row, with the centre column looking down +Z and the left edge at -Z, turning through -X.
+//
+// Sources and destinations can be any format PixelFormat_DecodePixels/EncodePixels handle, except block-compressed
+// ones. Everything is computed in float, R16G16B16A16_FLOAT or R9G9B9E5_SHAREDEXP are good destination formats.
+// Work is split into rows of each face and level, which are handed out to threads as they finish.
+namespace IBLPrefilter {
+
+    // Resamples an equirectangular (longitude/latitude) image to cube faces, supersampling when the source is
+    // more detailed than the faces. Levels below the first are box filtered from the level above.
+    bool EquirectangularToCubeMap(IBLCubeMapData *pDestination, PIXEL_FORMAT destinationFormat, uint32 faceSize, uint32 mipLevels,
+                                  const void *pSourcePixels, uint32 sourceWidth, uint32 sourceHeight, uint32 sourcePitch, PIXEL_FORMAT sourceFormat,
+                                  uint32 threadCount = 0);
+
+    // Projects the top level of a cube map onto the first three SH bands, weighting texels by solid angle.
+    bool ComputeIrradianceSH(IBL_SH9 *pIrradiance, const IBLCubeMapData *pSource, uint32 threadCount = 0);
+    Vector3f EvaluateIrradianceSH(const IBL_SH9 *pIrradiance, const Vector3f &normal);
+
+    // Builds a GGX prefiltered specular chain from the top level of pSource, level i holding roughness
+    // GetMipRoughness(i, mipLevels) with the usual split-sum assumption of view = normal. The GGX lobe is importance
+    // sampled, and each sample reads a source level matching its footprint, so few samples are needed without
+    // fireflies from bright texels.
+    bool PrefilterSpecular(IBLCubeMapData *pDestination, PIXEL_FORMAT destinationFormat, uint32 faceSize, uint32 mipLevels,
+                           const IBLCubeMapData *pSource, uint32 sampleCount = 256, uint32 threadCount = 0);
+
+    // Perceptual roughness (GGX alpha is its square) stored in a level, linear from 0 in the first level to 1 in the last.
+    // Shaders select the level with roughness * (mipLevels - 1).
+    float GetMipRoughness(uint32 mipLevel, uint32 mipLevels);
+}
@@ -11,8 +11,8 @@ class GPUContext;
 
 namespace ImGuiBridge
 {
-    // Ready engine and imgui for drawing
-    bool Initialize(GPUDevice* pGPUDevice, GPUContext* pGPUContext);
+    // Ready engine and imgui for drawing, gpuFrameLatency should match RendererInitializationParameters::GPUFrameLatency
+    bool Initialize(GPUDevice* pGPUDevice, GPUContext* pGPUContext, uint32 gpuFrameLatency = 3);
 
     // Shutdown bridge and imgui
     void Shutdown();
@@ -31,4 +31,11 @@ namespace ImGuiBridge
 
     // Release everything
     void FreeResources();
+
+    // Cache the baked font atlas in this file, keyed on the font configuration. Set before Initialize.
+    void SetFontCacheFileName(const char *fileName);
+
+    // Upload fonts added to io.Fonts since the last call. New fonts are rasterized on their own into rows reserved
+    // below the existing glyphs and only that region is uploaded, the whole atlas is rebuilt if they don't fit.
+    bool UpdateFontTexture();
 }
@@ -0,0 +1,26 @@
+#pragma once
+#include "YBaseLib/Common.h"
+#include "YRenderLib/PixelFormat.h"
+
+enum IMAGE_RESAMPLE_FILTER
+{
+    IMAGE_RESAMPLE_FILTER_BOX,              // average of the covered pixels, nearest neighbour when upscaling
+    IMAGE_RESAMPLE_FILTER_TRIANGLE,         // bilinear when upscaling
+    IMAGE_RESAMPLE_FILTER_MITCHELL,         // Mitchell-Netravali with B = C = 1/3, a good default
+    IMAGE_RESAMPLE_FILTER_LANCZOS3,         // sharpest, can ring around hard edges
+    IMAGE_RESAMPLE_FILTER_COUNT,
+};
+
+// CPU image resizing with a separable filter. Source rows are decoded to float and filtered horizontally into an
+// intermediate image, which is then filtered vertically and encoded to the destination format. Both passes use
+// weight tables computed once per axis, and are split into row bands across threads.
+//
+// Any pair of formats PixelFormat_DecodePixels/EncodePixels handle can be used, except block-compressed ones.
+// sRGB formats decode to linear, so they are filtered in linear space. Edge pixels are clamped.
+namespace ImageResampler {
+
+    // threadCount of 0 uses one thread per hardware thread, small images are always resized on the calling thread
+    bool Resample(const void *pSourcePixels, uint32 sourceWidth, uint32 sourceHeight, uint32 sourcePitch, PIXEL_FORMAT sourceFormat,
+                  void *pDestinationPixels, uint32 destinationWidth, uint32 destinationHeight, uint32 destinationPitch, PIXEL_FORMAT destinationFormat,
+                  IMAGE_RESAMPLE_FILTER filter, uint32 threadCount = 0);
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "YBaseLib/Common.h"
+#include "YRenderLib/PixelFormat.h"
+#include "YRenderLib/RendererTypes.h"
+
+enum IMAGE_TRANSFORM
+{
+    IMAGE_TRANSFORM_IDENTITY,
+    IMAGE_TRANSFORM_FLIP_VERTICAL,
+    IMAGE_TRANSFORM_FLIP_HORIZONTAL,
+    IMAGE_TRANSFORM_ROTATE_90,              // clockwise
+    IMAGE_TRANSFORM_ROTATE_180,
+    IMAGE_TRANSFORM_ROTATE_270,             // clockwise, i.e. 90 counter-clockwise
+    IMAGE_TRANSFORM_TRANSPOSE,              // mirror across the top-left to bottom-right diagonal
+    IMAGE_TRANSFORM_TRANSVERSE,             // mirror across the top-right to bottom-left diagonal
+    IMAGE_TRANSFORM_COUNT,
+};
+
+struct CUBEMAP_FACE_TRANSFORM
+{
+    CUBEMAP_FACE SourceFace;
+    IMAGE_TRANSFORM Transform;
+};
+
+// Reorders the elements of an image. Transposes and rotations are done in cache-sized tiles, and 4-byte elements
+// (the common 32bpp formats) use SSE2 4x4 transposes and shuffles.
+//
+// The element functions work on any element size, which is the pixel size for uncompressed data, or the block size
+// for block-compressed data with dimensions given in blocks. Blocks are moved as a whole, their contents aren't
+// reoriented. The PIXEL_FORMAT overloads work this out from the format and take dimensions in pixels.
+namespace ImageTransform {
+
+    // the destination is height x width for these
+    bool SwapsDimensions(IMAGE_TRANSFORM transform);
+
+    // source and destination must not overlap
+    void TransformElements(void *pDestination, uint32 destinationPitch, const void *pSource, uint32 sourcePitch, uint32 width, uint32 height, uint32 elementSize, IMAGE_TRANSFORM transform);
+
+    // Transforms without a second buffer, for elements of up to 16 bytes. Transforms that swap dimensions require a square image.
+    bool TransformElementsInPlace(void *pPixels, uint32 pitch, uint32 width, uint32 height, uint32 elementSize, IMAGE_TRANSFORM transform);
+
+    bool TransformImage(void *pDestination, uint32 destinationPitch, const void *pSource, uint32 sourcePitch, PIXEL_FORMAT format, uint32 width, uint32 height, IMAGE_TRANSFORM transform);
+    bool TransformImageInPlace(void *pPixels, uint32 pitch, PIXEL_FORMAT format, uint32 width, uint32 height, IMAGE_TRANSFORM transform);
+
+    // Builds each destination face from a transformed source face, both arrays are indexed by CUBEMAP_FACE.
+    bool TransformCubemapFaces(void *const *ppDestinationFaces, uint32 destinationPitch, const void *const *ppSourceFaces, uint32 sourcePitch, PIXEL_FORMAT format, uint32 faceSize,
+                               const CUBEMAP_FACE_TRANSFORM *pFaceTransforms);
+
+    // face transforms for a cubemap mirrored along Z, converting between left- and right-handed conventions
+    extern const CUBEMAP_FACE_TRANSFORM CubemapMirrorZFaceTransforms[CUBEMAP_FACE_COUNT];
+}
@@ -22,3 +22,17 @@ DECLARE_HASHTRAIT_BYREF(Vector2u);
 DECLARE_HASHTRAIT_BYREF(Vector3u);
 DECLARE_HASHTRAIT_BYREF(Vector4u);
 
+// Hashes of a whole array, each matching HashTrait<T>::GetHash, for building spatial hashes or welding vertices in bulk.
+void HashTrait_GetHashes(HashType *pHashes, const Vector2f *pValues, uint32 count);
+void HashTrait_GetHashes(HashType *pHashes, const Vector3f *pValues, uint32 count);
+void HashTrait_GetHashes(HashType *pHashes, const Vector4f *pValues, uint32 count);
+void HashTrait_GetHashes(HashType *pHashes, const Vector2i *pValues, uint32 count);
+void HashTrait_GetHashes(HashType *pHashes, const Vector3i *pValues, uint32 count);
+void HashTrait_GetHashes(HashType *pHashes, const Vector4i *pValues, uint32 count);
+void HashTrait_GetHashes(HashType *pHashes, const Vector2u *pValues, uint32 count);
+void HashTrait_GetHashes(HashType *pHashes, const Vector3u *pValues, uint32 count);
+void HashTrait_GetHashes(HashType *pHashes, const Vector4u *pValues, uint32 count);
+
+// XXH32 (seed 0) of arbitrary bytes, using only its short input rounds, for keys that aren't vectors such as packed
+// vertex attributes. A vector's hash equals this over its components, once -0 is folded into +0.
+HashType HashTrait_HashBytes(const void *pData, uint32 size);
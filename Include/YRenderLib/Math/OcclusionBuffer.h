@@ -0,0 +1,110 @@
+#pragma once
+#include "YBaseLib/NonCopyable.h"
+#include "YBaseLib/PODArray.h"
+#include "YRenderLib/Math/Common.h"
+#include "YRenderLib/Math/Vectorf.h"
+#include "YRenderLib/Math/Matrixf.h"
+#include "YRenderLib/Math/AABox.h"
+#include "YRenderLib/Math/Frustum.h"
+
+// Low resolution software depth buffer used to cull objects on the CPU before submission.
+//
+// Occluder triangles are transformed and binned into screen tiles by AddOccluder(). Each tile
+// is then rasterized independently, either by Rasterize() on its own worker threads or by
+// RasterizeTile() from an existing job system. Finally, bounding boxes are tested against an
+// 8x8 hierarchical depth buffer with a per-pixel refinement, which is safe to do from any
+// number of threads.
+//
+// Depth is stored as 1/w, which is independent of the projection's depth range convention.
+// Larger values are closer to the viewer, and the buffer is cleared to zero (infinitely far).
+class OcclusionBuffer
+{
+    DeclareNonCopyable(OcclusionBuffer);
+
+public:
+    static const uint32 TILE_WIDTH = 32;
+    static const uint32 TILE_HEIGHT = 32;
+    static const uint32 HIZ_BLOCK_SIZE = 8;
+
+    // dimensions are rounded up to a multiple of the tile size
+    OcclusionBuffer(uint32 width = 256, uint32 height = 128);
+    ~OcclusionBuffer();
+
+    uint32 GetWidth() const { return m_width; }
+    uint32 GetHeight() const { return m_height; }
+    uint32 GetTileCount() const { return m_tileCountX * m_tileCountY; }
+
+    // occluder triangles with any vertex closer than this clip-space w are discarded
+    float GetNearClipW() const { return m_nearClipW; }
+    void SetNearClipW(float nearClipW) { m_nearClipW = nearClipW; }
+
+    // starts a new frame with the specified camera, discarding all binned occluders
+    void BeginFrame(const Matrix4x4f &viewProjectionMatrix);
+
+    // transforms and bins occluder geometry, must not be called concurrently
+    void AddOccluder(const Vector3f *pVertices, uint32 vertexCount, const uint16 *pIndices, uint32 indexCount, const Matrix4x4f &localToWorldMatrix);
+    void AddOccluder(const Vector3f *pVertices, uint32 vertexCount, const uint32 *pIndices, uint32 indexCount, const Matrix4x4f &localToWorldMatrix);
+
+    // clears and rasterizes a single tile, different tiles can be processed concurrently
+    void RasterizeTile(uint32 tileIndex);
+
+    // rasterizes all tiles on the calling thread
+    void RasterizeAllTiles();
+
+    // Rasterizes all tiles across threadCount threads including the calling one, 0 uses one per hardware
+    // thread. Frames with few occluders are rasterized on the calling thread.
+    void Rasterize(uint32 threadCount = 0);
+
+    // returns false if the box is outside the frustum or hidden behind occluders, all tiles must be rasterized first
+    bool IsVisible(const AABox &box) const;
+
+    // batch version of IsVisible, projects four boxes at a time
+    void TestVisibility(const AABox *pBoxes, uint32 count, bool *pVisibleResults) const;
+
+    // raw buffer access for debugging
+    const float *GetDepthBuffer() const { return m_pDepthBuffer; }
+    const float *GetHiZBuffer() const { return m_pHiZBuffer; }
+
+private:
+    // screen-space triangle with edge equations and depth plane set up for pixel centers
+    struct Triangle
+    {
+        float EdgeA[3];
+        float EdgeB[3];
+        float EdgeC[3];
+        float DepthA;
+        float DepthB;
+        float DepthC;
+        int32 MinX;
+        int32 MinY;
+        int32 MaxX;
+        int32 MaxY;
+    };
+
+    template<typename INDEX_TYPE>
+    void AddOccluderTriangles(const Vector3f *pVertices, uint32 vertexCount, const INDEX_TYPE *pIndices, uint32 indexCount, const Matrix4x4f &localToWorldMatrix);
+
+    void BinTriangle(const Vector4f &v0, const Vector4f &v1, const Vector4f &v2);
+    void RasterizeTriangle(const Triangle &triangle, int32 tileMinX, int32 tileMinY, int32 tileMaxX, int32 tileMaxY);
+    void UpdateHiZ(uint32 tileX, uint32 tileY);
+
+    // tests a projected screen rectangle, nearest depth as 1/w, against the hierarchical and full depth buffers
+    bool IsRectVisible(float minX, float maxX, float minY, float maxY, float nearestDepth) const;
+
+    uint32 m_width;
+    uint32 m_height;
+    uint32 m_tileCountX;
+    uint32 m_tileCountY;
+    uint32 m_hizWidth;
+    float m_nearClipW;
+
+    Matrix4x4f m_viewProjectionMatrix;
+    Frustum m_frustum;
+
+    float *m_pDepthBuffer;
+    float *m_pHiZBuffer;
+
+    PODArray<Triangle> m_triangles;
+    PODArray<uint32> *m_pTileBins;
+    PODArray<Vector4f> m_clipSpaceVertices;
+};
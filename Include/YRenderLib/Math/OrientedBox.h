@@ -0,0 +1,45 @@
+#pragma once
+#include "YRenderLib/Math/Common.h"
+#include "YRenderLib/Math/Vectorf.h"
+#include "YBaseLib/Assert.h"
+
+class AABox;
+class Sphere;
+struct SIMDVector3f;
+
+// this class represents an oriented bounding box, a center with three orthonormal axes and the half extents along them
+class OrientedBox
+{
+public:
+    OrientedBox() {}
+    OrientedBox(const Vector3f &center, const Vector3f &halfExtents, const Vector3f &axisX, const Vector3f &axisY, const Vector3f &axisZ);
+    OrientedBox(const AABox &box);
+    OrientedBox(const OrientedBox &copy);
+
+    // accessors
+    const Vector3f &GetCenter() const { return m_center; }
+    const Vector3f &GetHalfExtents() const { return m_halfExtents; }
+    const Vector3f &GetAxis(uint32 axis) const { DebugAssert(axis < 3); return m_axes[axis]; }
+    float GetVolume() const { return 8.0f * m_halfExtents.x * m_halfExtents.y * m_halfExtents.z; }
+
+    // tests whether a point is inside the box
+    bool ContainsPoint(const Vector3f &point) const;
+
+    // corner vertices, in the same order as AABox::GetCornerPoints
+    void GetCornerPoints(Vector3f *pVertices) const;
+
+    // axis-aligned box/sphere containing this box
+    AABox GetAABox() const;
+    Sphere GetBoundingSphere() const;
+
+    OrientedBox &operator=(const OrientedBox &copy);
+
+    // builds a box aligned to the principal axes of the points, falls back to the axis-aligned box when that is smaller
+    static OrientedBox FromPoints(const SIMDVector3f *pPoints, uint32 nPoints);
+    static OrientedBox FromPoints(const Vector3f *pPoints, uint32 nPoints);
+
+private:
+    Vector3f m_center;
+    Vector3f m_halfExtents;
+    Vector3f m_axes[3];
+};
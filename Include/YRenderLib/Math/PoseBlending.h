@@ -0,0 +1,80 @@
+#pragma once
+#include "YBaseLib/NonCopyable.h"
+#include "YRenderLib/Math/Common.h"
+#include "YRenderLib/Math/Quaternion.h"
+#include "YRenderLib/Math/Transform.h"
+
+enum POSE_BLEND_ROTATION_MODE
+{
+    POSE_BLEND_ROTATION_MODE_NLERP,             // normalized lerp, fastest, angular velocity is not constant
+    POSE_BLEND_ROTATION_MODE_SLERP,             // nlerp with a corrected factor, closely approximates slerp
+    POSE_BLEND_ROTATION_MODE_COUNT,
+};
+
+// Structure-of-arrays storage for a skeleton pose. Each component stream is 16-byte aligned
+// and padded to a multiple of four bones, so the blend kernels never need a scalar tail.
+class PoseSoA
+{
+    DeclareNonCopyable(PoseSoA);
+
+public:
+    enum STREAM
+    {
+        STREAM_POSITION_X,
+        STREAM_POSITION_Y,
+        STREAM_POSITION_Z,
+        STREAM_ROTATION_X,
+        STREAM_ROTATION_Y,
+        STREAM_ROTATION_Z,
+        STREAM_ROTATION_W,
+        STREAM_SCALE_X,
+        STREAM_SCALE_Y,
+        STREAM_SCALE_Z,
+        STREAM_COUNT,
+    };
+
+    PoseSoA();
+    PoseSoA(uint32 boneCount);
+    ~PoseSoA();
+
+    // contents are undefined after a resize, padding bones are initialized to identity
+    void Resize(uint32 boneCount);
+
+    uint32 GetBoneCount() const { return m_boneCount; }
+    uint32 GetPaddedBoneCount() const { return m_paddedBoneCount; }
+
+    float *GetStream(STREAM stream) { DebugAssert(stream < STREAM_COUNT); return m_pData + stream * m_paddedBoneCount; }
+    const float *GetStream(STREAM stream) const { DebugAssert(stream < STREAM_COUNT); return m_pData + stream * m_paddedBoneCount; }
+
+    // conversion to/from transform arrays, count must match the bone count
+    void SetIdentity();
+    void LoadTransforms(const Transform *pTransforms, uint32 count);
+    void StoreTransforms(Transform *pTransforms, uint32 count) const;
+    void GetTransform(uint32 bone, Transform *pTransform) const;
+    void SetTransform(uint32 bone, const Transform &transform);
+
+private:
+    float *m_pData;
+    uint32 m_boneCount;
+    uint32 m_paddedBoneCount;
+};
+
+// Batch blending kernels, processing four bones per iteration when SSE is available.
+// Output poses may alias an input pose. If pBoneWeights is provided, it holds one weight
+// per bone which is multiplied with the global weight (masked/partial blending).
+namespace PoseBlending
+{
+    // out = lerp(a, b, weight) on position/scale, nlerp or slerp on rotation
+    void Blend(PoseSoA *pOutPose, const PoseSoA &poseA, const PoseSoA &poseB, float weight, POSE_BLEND_ROTATION_MODE rotationMode, const float *pBoneWeights = nullptr);
+
+    // applies an additive (delta from reference) pose on top of a base pose:
+    // position += delta * weight, scale *= lerp(1, delta, weight), rotation = rotation * nlerp(identity, delta, weight)
+    void Add(PoseSoA *pOutPose, const PoseSoA &basePose, const PoseSoA &additivePose, float weight, const float *pBoneWeights = nullptr);
+
+    // builds an additive pose from a source pose relative to a reference pose, the inverse of Add with weight = 1
+    void MakeAdditive(PoseSoA *pOutPose, const PoseSoA &sourcePose, const PoseSoA &referencePose);
+
+    // array variants for quaternions stored as AoS
+    void NLerpQuaternions(Quaternion *pOut, const Quaternion *pStart, const Quaternion *pEnd, uint32 count, float factor);
+    void SLerpQuaternions(Quaternion *pOut, const Quaternion *pStart, const Quaternion *pEnd, uint32 count, float factor);
+}
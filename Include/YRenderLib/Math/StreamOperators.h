@@ -1,4 +1,5 @@
 #pragma once
+#include "YBaseLib/Common.h"
 
 class BinaryReader;
 class BinaryWriter;
@@ -12,6 +13,10 @@ struct Vector2u;
 struct Vector3u;
 struct Vector4u;
 struct Quaternion;
+struct Matrix3x3f;
+struct Matrix3x4f;
+struct Matrix4x4f;
+class Transform;
 class AABox;
 class Sphere;
 
@@ -39,4 +44,58 @@ BinaryWriter &operator<<(BinaryWriter &binaryWriter, const Vector3u &value);
 BinaryWriter &operator<<(BinaryWriter &binaryWriter, const Vector4u &value);
 BinaryWriter &operator<<(BinaryWriter &binaryWriter, const Quaternion &value);
 BinaryWriter &operator<<(BinaryWriter &binaryWriter, const AABox &value);
-BinaryWriter &operator<<(BinaryWriter &binaryWriter, const Sphere &value);
\ No newline at end of file
+BinaryWriter &operator<<(BinaryWriter &binaryWriter, const Sphere &value);
+
+// Bulk versions for arrays, laid out as the operators above write them: each element is a run of 32-bit little-endian
+// components (Transform is position, rotation, scale). On little-endian hosts that is also the memory layout, so a whole
+// array is one read or write instead of a call per component. Reads return false on a short read, like SafeReadBytes.
+bool StreamReadArray(BinaryReader &binaryReader, Vector2f *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Vector3f *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Vector4f *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Vector2i *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Vector3i *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Vector4i *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Vector2u *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Vector3u *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Vector4u *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Quaternion *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Matrix3x3f *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Matrix3x4f *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Matrix4x4f *pValues, uint32 count);
+bool StreamReadArray(BinaryReader &binaryReader, Transform *pValues, uint32 count);
+
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Vector2f *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Vector3f *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Vector4f *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Vector2i *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Vector3i *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Vector4i *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Vector2u *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Vector3u *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Vector4u *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Quaternion *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Matrix3x3f *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Matrix3x4f *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Matrix4x4f *pValues, uint32 count);
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Transform *pValues, uint32 count);
+
+// Same again for serialized data already in memory, such as a loaded blob or a memory-mapped file.
+void StreamDecodeArray(Vector2f *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Vector3f *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Vector4f *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Vector2i *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Vector3i *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Vector4i *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Vector2u *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Vector3u *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Vector4u *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Quaternion *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Matrix3x3f *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Matrix3x4f *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Matrix4x4f *pValues, const void *pData, uint32 count);
+void StreamDecodeArray(Transform *pValues, const void *pData, uint32 count);
+
+// Zero-copy access to an array inside serialized data in memory. Returns pData itself when the host is little-endian,
+// pData is aligned for T and dataSize covers the array, otherwise nullptr and the caller copies with StreamDecodeArray.
+// Available for every type above except Transform, which has no fixed memory layout.
+template<typename T> const T *StreamMapArray(const void *pData, size_t dataSize, uint32 count);
@@ -0,0 +1,94 @@
+#pragma once
+#include "YBaseLib/PODArray.h"
+#include "YRenderLib/Math/Common.h"
+#include "YRenderLib/Math/AABox.h"
+
+// Broadphase overlap detection using sort-and-sweep along a single axis.
+// Endpoints are kept sorted between updates, so when proxies move a small amount each
+// frame the insertion sort in Update() runs in close to linear time. The remaining two
+// axes are rejected four active proxies at a time when SSE is available.
+class SweepAndPrune
+{
+public:
+    static const uint32 InvalidProxy = 0xFFFFFFFF;
+
+    struct OverlapPair
+    {
+        // ProxyA is always less than ProxyB
+        uint32 ProxyA;
+        uint32 ProxyB;
+    };
+
+    SweepAndPrune(uint32 sortAxis = 0);
+    ~SweepAndPrune();
+
+    // proxy management, proxy indices are recycled after the next Update()
+    uint32 AddProxy(const AABox &bounds, void *pUserData = nullptr);
+    void RemoveProxy(uint32 proxy);
+    void UpdateProxy(uint32 proxy, const AABox &bounds);
+    void RemoveAllProxies();
+
+    // accessors
+    uint32 GetSortAxis() const { return m_sortAxis; }
+    uint32 GetProxyCount() const { return m_liveProxyCount; }
+    void *GetProxyUserData(uint32 proxy) const { DebugAssert(proxy < m_proxies.GetSize()); return m_proxies[proxy].pUserData; }
+    AABox GetProxyBounds(uint32 proxy) const;
+
+    // changes the axis endpoints are sorted on, forces a full re-sort on the next update
+    void SetSortAxis(uint32 sortAxis);
+
+    // picks the axis with the largest spread of proxy centers, call occasionally if the scene layout changes
+    void SelectSortAxis();
+
+    // re-sorts endpoints and regenerates the overlapping pair list
+    void Update();
+
+    // pairs found by the last Update()
+    const OverlapPair *GetOverlappingPairs() const { return m_pairs.GetBasePointer(); }
+    uint32 GetOverlappingPairCount() const { return m_pairs.GetSize(); }
+
+private:
+    enum PROXY_FLAG
+    {
+        PROXY_FLAG_ALLOCATED    = (1 << 0),
+        PROXY_FLAG_REMOVED      = (1 << 1),
+    };
+
+    struct Proxy
+    {
+        float MinBounds[3];
+        float MaxBounds[3];
+        void *pUserData;
+        uint32 Flags;
+        uint32 ActiveIndex;
+    };
+
+    // Data holds the proxy index shifted left by one, low bit set for max endpoints
+    struct Endpoint
+    {
+        float Value;
+        uint32 Data;
+    };
+
+    void RemoveDeadEndpoints();
+    void RefreshEndpointValues();
+    void SortEndpoints();
+    void Sweep();
+
+    PODArray<Proxy> m_proxies;
+    PODArray<uint32> m_freeProxies;
+    PODArray<Endpoint> m_endpoints;
+    PODArray<OverlapPair> m_pairs;
+
+    // active set during the sweep, stored as structure-of-arrays for the SIMD rejection test
+    PODArray<float> m_activeMinA;
+    PODArray<float> m_activeMaxA;
+    PODArray<float> m_activeMinB;
+    PODArray<float> m_activeMaxB;
+    PODArray<uint32> m_activeProxies;
+
+    uint32 m_sortAxis;
+    uint32 m_liveProxyCount;
+    uint32 m_pendingAddCount;
+    bool m_hasRemovedProxies;
+};
@@ -128,13 +128,152 @@ struct PIXEL_FORMAT_INFO
     uint32 StencilBits;
 };
 
+// Kept in the header and constexpr so lookups with a known format fold to constants, e.g. in upload loops.
+struct PixelFormatInfoTable
+{
+    static constexpr PIXEL_FORMAT_INFO Entries[PIXEL_FORMAT_COUNT] =
+    {
+        // Name                                     BitsPerPixel    IsImageFormat   HasAlpha    IsBlockCompressed   BytesPerBlock   BlockSize   UncompressedFormat                  LinearFormat                        ColorMaskRed    ColorMaskGreen  ColorMaskBlue   ColorMaskAlpha  ColorBits   DepthBits   StencilBits
+        { "PIXEL_FORMAT_R8_UINT",                   8,              true,           false,      false,              0,              0,          PIXEL_FORMAT_R8_UINT,               PIXEL_FORMAT_R8_UINT,               0x000000FF,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_R8_SINT",                   8,              true,           false,      false,              0,              0,          PIXEL_FORMAT_R8_SINT,               PIXEL_FORMAT_R8_SINT,               0x000000FF,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_R8_UNORM",                  8,              true,           false,      false,              0,              0,          PIXEL_FORMAT_R8_UNORM,              PIXEL_FORMAT_R8_UNORM,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_R8_SNORM",                  8,              true,           false,      false,              0,              0,          PIXEL_FORMAT_R8_SNORM,              PIXEL_FORMAT_R8_SNORM,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_R8G8_UINT",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8_UINT,             PIXEL_FORMAT_R8G8_UINT,             0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_R8G8_SINT",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8_SINT,             PIXEL_FORMAT_R8G8_SINT,             0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_R8G8_UNORM",                16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8_UNORM,            PIXEL_FORMAT_R8G8_UNORM,            0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_R8G8_SNORM",                16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8_SNORM,            PIXEL_FORMAT_R8G8_SNORM,            0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_R8G8B8A8_UINT",             32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_UINT,         PIXEL_FORMAT_R8G8B8A8_UINT,         0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R8G8B8A8_SINT",             32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_SINT,         PIXEL_FORMAT_R8G8B8A8_SINT,         0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R8G8B8A8_UNORM",            32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_R8G8B8A8_UNORM,        0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB",       32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_R8G8B8A8_UNORM,        0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R8G8B8A8_SNORM",            32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_SNORM,        PIXEL_FORMAT_R8G8B8A8_SNORM,        0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R9G9B9E5_SHAREDEXP",        32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R9G9B9E5_SHAREDEXP,    PIXEL_FORMAT_R9G9B9E5_SHAREDEXP,    0x000001FF,     0x0003FE00,     0x07FC0000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R10G10B10A2_UINT",          32,             false,          true,       false,              0,              0,          PIXEL_FORMAT_R10G10B10A2_UINT,      PIXEL_FORMAT_R10G10B10A2_UINT,      0x000003FF,     0x000FFC00,     0x3FF00000,     0xC0000000,     30,         0,          0           },
+        { "PIXEL_FORMAT_R10G10B10A2_UNORM",         32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R10G10B10A2_UNORM,     PIXEL_FORMAT_R10G10B10A2_UNORM,     0x000003FF,     0x000FFC00,     0x3FF00000,     0xC0000000,     30,         0,          0           },
+        { "PIXEL_FORMAT_R11G11B10_FLOAT",           32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R11G11B10_FLOAT,       PIXEL_FORMAT_R11G11B10_FLOAT,       0x000007FF,     0x003FF800,     0xFFC00000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R16_UINT",                  16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_UINT,              PIXEL_FORMAT_R16_UINT,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_R16_SINT",                  16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_SINT,              PIXEL_FORMAT_R16_SINT,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_R16_UNORM",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_UNORM,             PIXEL_FORMAT_R16_UNORM,             0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_R16_SNORM",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_SNORM,             PIXEL_FORMAT_R16_SNORM,             0x000000FF,     0x00000000,     0x00000000,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_R16_FLOAT",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_FLOAT,             PIXEL_FORMAT_R16_FLOAT,             0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_R16G16_UINT",               32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_UINT,           PIXEL_FORMAT_R16G16_UINT,           0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R16G16_SINT",               32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_SINT,           PIXEL_FORMAT_R16G16_SINT,           0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R16G16_UNORM",              32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_UNORM,          PIXEL_FORMAT_R16G16_UNORM,          0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R16G16_SNORM",              32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_SNORM,          PIXEL_FORMAT_R16G16_SNORM,          0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R16G16_FLOAT",              32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_FLOAT,          PIXEL_FORMAT_R16G16_FLOAT,          0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R16G16B16A16_UINT",         64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_UINT,     PIXEL_FORMAT_R16G16B16A16_UINT,     0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
+        { "PIXEL_FORMAT_R16G16B16A16_SINT",         64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_SINT,     PIXEL_FORMAT_R16G16B16A16_SINT,     0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
+        { "PIXEL_FORMAT_R16G16B16A16_UNORM",        64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_UNORM,    PIXEL_FORMAT_R16G16B16A16_UNORM,    0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
+        { "PIXEL_FORMAT_R16G16B16A16_SNORM",        64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_SNORM,    PIXEL_FORMAT_R16G16B16A16_SNORM,    0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
+        { "PIXEL_FORMAT_R16G16B16A16_FLOAT",        64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_FLOAT,    PIXEL_FORMAT_R16G16B16A16_FLOAT,    0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
+        { "PIXEL_FORMAT_R32_UINT",                  32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32_UINT,              PIXEL_FORMAT_R32_UINT,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R32_SINT",                  32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32_SINT,              PIXEL_FORMAT_R32_SINT,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R32_FLOAT",                 32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32_FLOAT,             PIXEL_FORMAT_R32_FLOAT,             0x000000FF,     0x00000000,     0x00000000,     0x00000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_R32G32_UINT",               64,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32_UINT,           PIXEL_FORMAT_R32G32_UINT,           0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     64,         0,          0           },
+        { "PIXEL_FORMAT_R32G32_SINT",               64,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32_SINT,           PIXEL_FORMAT_R32G32_SINT,           0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     64,         0,          0           },
+        { "PIXEL_FORMAT_R32G32_FLOAT",              64,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32_FLOAT,          PIXEL_FORMAT_R32G32_FLOAT,          0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     64,         0,          0           },
+        { "PIXEL_FORMAT_R32G32B32_UINT",            96,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32B32_UINT,        PIXEL_FORMAT_R32G32B32_UINT,        0x000000FF,     0x0000FF00,     0x00FF0000,     0x00000000,     96,         0,          0           },
+        { "PIXEL_FORMAT_R32G32B32_SINT",            96,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32B32_SINT,        PIXEL_FORMAT_R32G32B32_SINT,        0x000000FF,     0x0000FF00,     0x00FF0000,     0x00000000,     96,         0,          0           },
+        { "PIXEL_FORMAT_R32G32B32_FLOAT",           96,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32B32_FLOAT,       PIXEL_FORMAT_R32G32B32_FLOAT,       0x000000FF,     0x0000FF00,     0x00FF0000,     0x00000000,     96,         0,          0           },
+        { "PIXEL_FORMAT_R32G32B32A32_UINT",         128,            true,           true,       false,              0,              0,          PIXEL_FORMAT_R32G32B32A32_UINT,     PIXEL_FORMAT_R32G32B32A32_UINT,     0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     128,        0,          0           },
+        { "PIXEL_FORMAT_R32G32B32A32_SINT",         128,            true,           true,       false,              0,              0,          PIXEL_FORMAT_R32G32B32A32_SINT,     PIXEL_FORMAT_R32G32B32A32_SINT,     0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     128,        0,          0           },
+        { "PIXEL_FORMAT_R32G32B32A32_FLOAT",        128,            true,           true,       false,              0,              0,          PIXEL_FORMAT_R32G32B32A32_FLOAT,    PIXEL_FORMAT_R32G32B32A32_FLOAT,    0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     128,        0,          0           },
+        { "PIXEL_FORMAT_B8G8R8A8_UNORM",            32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B8G8R8A8_UNORM,        PIXEL_FORMAT_B8G8R8A8_UNORM,        0x00FF0000,     0x0000FF00,     0x000000FF,     0xFF000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_B8G8R8A8_UNORM_SRGB",       32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B8G8R8A8_UNORM_SRGB,   PIXEL_FORMAT_B8G8R8A8_UNORM_SRGB,   0x00FF0000,     0x0000FF00,     0x000000FF,     0xFF000000,     32,         0,          0           },
+        { "PIXEL_FORMAT_B8G8R8X8_UNORM",            32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B8G8R8X8_UNORM,        PIXEL_FORMAT_B8G8R8X8_UNORM,        0x00FF0000,     0x0000FF00,     0x000000FF,     0x00000000,     24,         0,          0           },
+        { "PIXEL_FORMAT_B8G8R8X8_UNORM_SRGB",       32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B8G8R8X8_UNORM_SRGB,   PIXEL_FORMAT_B8G8R8X8_UNORM_SRGB,   0x00FF0000,     0x0000FF00,     0x000000FF,     0x00000000,     24,         0,          0           },
+        { "PIXEL_FORMAT_B5G6R5_UNORM",              16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_B5G6R5_UNORM,          PIXEL_FORMAT_B5G6R5_UNORM,          0x0000F800,     0x000007E0,     0x0000001F,     0x00000000,     16,         0,          0           },
+        { "PIXEL_FORMAT_B5G5R5A1_UNORM",            16,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B5G5R5A1_UNORM,        PIXEL_FORMAT_B5G5R5A1_UNORM,        0x0000F800,     0x000007C0,     0x0000003E,     0x00000001,     15,         0,          0           },
+        { "PIXEL_FORMAT_BC1_UNORM",                 4,              true,           true,       true,               8,              4,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_BC1_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     4,          0,          0           },
+        { "PIXEL_FORMAT_BC1_UNORM_SRGB",            4,              true,           true,       true,               8,              4,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_BC1_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     4,          0,          0           },
+        { "PIXEL_FORMAT_BC2_UNORM",                 4,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_BC2_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     4,          0,          0           },
+        { "PIXEL_FORMAT_BC2_UNORM_SRGB",            4,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_BC2_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     4,          0,          0           },
+        { "PIXEL_FORMAT_BC3_UNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_BC3_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_BC3_UNORM_SRGB",            8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_BC3_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_BC4_UNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R16_UNORM,             PIXEL_FORMAT_BC4_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_BC4_SNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R16_SNORM,             PIXEL_FORMAT_BC4_SNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_BC5_UNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R16G16_UNORM,          PIXEL_FORMAT_BC5_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_BC5_SNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R16G16_SNORM,          PIXEL_FORMAT_BC5_SNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_BC6H_UF16",                 8,              false,          true,       true,               16,             4,          PIXEL_FORMAT_R16G16_UNORM,          PIXEL_FORMAT_BC6H_UF16,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_BC6H_SF16",                 8,              false,          true,       true,               16,             4,          PIXEL_FORMAT_R16G16_SNORM,          PIXEL_FORMAT_BC6H_SF16,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_BC7_UNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_BC7_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_BC7_UNORM_SRGB",            8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_BC7_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
+        { "PIXEL_FORMAT_D16_UNORM",                 16,             false,          false,      false,              0,              0,          PIXEL_FORMAT_D16_UNORM,             PIXEL_FORMAT_D16_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     0,          16,         0           },
+        { "PIXEL_FORMAT_D24_UNORM_S8_UINT",         32,             false,          false,      false,              0,              0,          PIXEL_FORMAT_D24_UNORM_S8_UINT,     PIXEL_FORMAT_D24_UNORM_S8_UINT,     0x00000000,     0x00000000,     0x00000000,     0x00000000,     0,          24,         8           },
+        { "PIXEL_FORMAT_D32_FLOAT",                 32,             false,          false,      false,              0,              0,          PIXEL_FORMAT_D32_FLOAT,             PIXEL_FORMAT_D32_FLOAT,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     0,          32,         0           },
+        { "PIXEL_FORMAT_D32_FLOAT_S8X24_UINT",      64,             false,          false,      false,              0,              0,          PIXEL_FORMAT_D32_FLOAT_S8X24_UINT,  PIXEL_FORMAT_D32_FLOAT_S8X24_UINT,  0x00000000,     0x00000000,     0x00000000,     0x00000000,     0,          32,         8           },
+        { "PIXEL_FORMAT_R8G8B8_UNORM",              24,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8B8_UNORM,          PIXEL_FORMAT_R8G8B8_UNORM,          0x000000FF,     0x0000FF00,     0x00FF0000,     0x00000000,     24,         0,          0           },
+        { "PIXEL_FORMAT_B8G8R8_UNORM",              24,             true,           false,      false,              0,              0,          PIXEL_FORMAT_B8G8R8_UNORM,          PIXEL_FORMAT_B8G8R8_UNORM,          0x00FF0000,     0x0000FF00,     0x000000FF,     0x00000000,     24,         0,          0           },
+    };
+};
+
 const char *PixelFormat_GetPixelFormatName(PIXEL_FORMAT Format);
-const PIXEL_FORMAT_INFO *PixelFormat_GetPixelFormatInfo(PIXEL_FORMAT Format);
-uint32 PixelFormat_CalculateRowPitch(PIXEL_FORMAT Format, uint32 uWidth);
-uint32 PixelFormat_CalculateSlicePitch(PIXEL_FORMAT Format, uint32 uWidth, uint32 uHeight);
-uint32 PixelFormat_CalculateImageNumRows(PIXEL_FORMAT Format, uint32 Width, uint32 Height);
-uint32 PixelFormat_CalculateImageSize(PIXEL_FORMAT Format, uint32 uWidth, uint32 uHeight, uint32 uDepth);
+
+// Out of line so it can assert, only reached for formats outside the table, e.g. PIXEL_FORMAT_UNKNOWN.
+const PIXEL_FORMAT_INFO *PixelFormat_GetInvalidPixelFormatInfo(PIXEL_FORMAT Format);
+
+constexpr const PIXEL_FORMAT_INFO *PixelFormat_GetPixelFormatInfo(PIXEL_FORMAT Format)
+{
+    return (Format < PIXEL_FORMAT_COUNT) ? &PixelFormatInfoTable::Entries[Format] : PixelFormat_GetInvalidPixelFormatInfo(Format);
+}
+
+// Blocks needed to cover a dimension, partial blocks at the edges count as whole ones.
+constexpr uint32 PixelFormat_CalculateBlockCount(uint32 Dimension, uint32 BlockSize)
+{
+    return (Dimension > BlockSize) ? ((Dimension + BlockSize - 1) / BlockSize) : 1;
+}
+
+// Uncompressed rows are padded to 32 bits. Written as single expressions for C++11 constexpr.
+constexpr uint32 PixelFormat_CalculateRowPitch(PIXEL_FORMAT Format, uint32 uWidth)
+{
+    return (PixelFormat_GetPixelFormatInfo(Format)->IsBlockCompressed) ?
+        (PixelFormat_CalculateBlockCount(uWidth, PixelFormat_GetPixelFormatInfo(Format)->BlockSize) * PixelFormat_GetPixelFormatInfo(Format)->BytesPerBlock) :
+        (((uWidth * PixelFormat_GetPixelFormatInfo(Format)->BitsPerPixel + 31) / 32) * 4);
+}
+
+// rows of pixels, or of blocks for block-compressed formats
+constexpr uint32 PixelFormat_CalculateImageNumRows(PIXEL_FORMAT Format, uint32 Height)
+{
+    return (PixelFormat_GetPixelFormatInfo(Format)->IsBlockCompressed) ? PixelFormat_CalculateBlockCount(Height, PixelFormat_GetPixelFormatInfo(Format)->BlockSize) : Height;
+}
+
+constexpr uint32 PixelFormat_CalculateSlicePitch(PIXEL_FORMAT Format, uint32 uWidth, uint32 uHeight)
+{
+    return PixelFormat_CalculateRowPitch(Format, uWidth) * PixelFormat_CalculateImageNumRows(Format, uHeight);
+}
+
+constexpr uint32 PixelFormat_CalculateImageSize(PIXEL_FORMAT Format, uint32 uWidth, uint32 uHeight, uint32 uDepth)
+{
+    return PixelFormat_CalculateSlicePitch(Format, uWidth, uHeight) * uDepth;
+}
+
+// Compile-time properties of a format, for code specialized on it:
+//   static_assert(PixelFormatTraits<PIXEL_FORMAT_R8G8B8A8_UNORM>::BitsPerPixel == 32, "");
+//   uint32 pitch = PixelFormatTraits<PIXEL_FORMAT_BC1_UNORM>::CalculateRowPitch(width);
+template<PIXEL_FORMAT FORMAT>
+struct PixelFormatTraits
+{
+    static constexpr PIXEL_FORMAT Format = FORMAT;
+    static constexpr uint32 BitsPerPixel = PixelFormatInfoTable::Entries[FORMAT].BitsPerPixel;
+    static constexpr bool HasAlpha = PixelFormatInfoTable::Entries[FORMAT].HasAlpha;
+    static constexpr bool IsBlockCompressed = PixelFormatInfoTable::Entries[FORMAT].IsBlockCompressed;
+    static constexpr uint32 BytesPerBlock = PixelFormatInfoTable::Entries[FORMAT].BytesPerBlock;
+    static constexpr uint32 BlockSize = PixelFormatInfoTable::Entries[FORMAT].BlockSize;
+    static constexpr PIXEL_FORMAT LinearFormat = PixelFormatInfoTable::Entries[FORMAT].LinearFormat;
+
+    static constexpr uint32 CalculateRowPitch(uint32 width) { return PixelFormat_CalculateRowPitch(FORMAT, width); }
+    static constexpr uint32 CalculateImageNumRows(uint32 height) { return PixelFormat_CalculateImageNumRows(FORMAT, height); }
+    static constexpr uint32 CalculateSlicePitch(uint32 width, uint32 height) { return PixelFormat_CalculateSlicePitch(FORMAT, width, height); }
+    static constexpr uint32 CalculateImageSize(uint32 width, uint32 height, uint32 depth) { return PixelFormat_CalculateImageSize(FORMAT, width, height, depth); }
+};
+
 bool PixelFormat_ConvertPixels(uint32 Width, uint32 Height, const void *SourcePixels, uint32 SourcePitch, PIXEL_FORMAT SourceFormat, void *DestinationPixels, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat, uint32 *DestinationPixelSize);
+
+// Decode to/encode from R32G32B32A32_FLOAT, with the float pixels tightly packed (Width * 4 floats per row).
+bool PixelFormat_IsConvertible(PIXEL_FORMAT Format);
+bool PixelFormat_DecodePixels(uint32 Width, uint32 Height, const void *SourcePixels, uint32 SourcePitch, PIXEL_FORMAT SourceFormat, float *DestinationPixels);
+bool PixelFormat_EncodePixels(uint32 Width, uint32 Height, const float *SourcePixels, void *DestinationPixels, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat);
+
 void PixelFormat_FlipImageInPlace(void *pPixels, uint32 rowPitch, uint32 rowCount);
 void PixelFormat_FlipImage(void *pDestinationPixels, const void *pPixels, uint32 rowPitch, uint32 rowCount);
 
@@ -156,7 +295,22 @@ Vector3f ConvertSRGBToLinear(const Vector3f &color);
 Vector4f ConvertSRGBToLinear(const Vector4f &color);
 #endif
 
+// Single packed RGBA8 pixel, alpha is left alone. Linear 8-bit loses most of the dark range, prefer the batch versions.
 uint32 ConvertLinearToSRGB(const uint32 rgba);
 uint32 ConvertSRGBToLinear(const uint32 rgba);
 
+// Batch conversions following the IEC 61966-2-1 curve. 8-bit results are the correctly rounded value of the curve,
+// float results are within 1e-6 relative of it and aren't clamped to [0, 1], so HDR values extend the curve (the SSE
+// path saturates at huge magnitudes, around 1e15).
+// Counts are in values, except for the RGBA8 variants which count pixels and pass alpha through as plain UNORM.
+// The destination may alias the source when both have the same element size.
+void ConvertLinearToSRGB(float *pDestination, const float *pSource, uint32 count);
+void ConvertSRGBToLinear(float *pDestination, const float *pSource, uint32 count);
+void ConvertLinearToSRGB8(uint8 *pDestination, const float *pSource, uint32 count);
+void ConvertLinearToSRGB8(uint8 *pDestination, const uint16 *pSource, uint32 count);
+void ConvertSRGB8ToLinear(float *pDestination, const uint8 *pSource, uint32 count);
+void ConvertSRGB8ToLinear(uint16 *pDestination, const uint8 *pSource, uint32 count);
+void ConvertLinearToSRGBA8(uint8 *pDestination, const float *pSource, uint32 pixelCount);
+void ConvertSRGBA8ToLinear(float *pDestination, const uint8 *pSource, uint32 pixelCount);
+
 };
@@ -0,0 +1,77 @@
+#pragma once
+#include "YRenderLib/Renderer.h"
+#include "YBaseLib/PODArray.h"
+
+// A render target borrowed from the pool for the duration of a pass.
+struct TransientRenderTarget
+{
+    GPUTexture2D *pTexture;
+    GPURenderTargetView *pRenderTargetView;             // null for depth-stencil targets
+    GPUDepthStencilBufferView *pDepthStencilBufferView; // null for color targets
+};
+
+// Hands out render targets by description for short-lived passes. A released target goes back to the pool
+// and is handed to the next pass asking for an identical texture, view and sampler description, so passes
+// with non-overlapping lifetimes within a frame share textures. Targets that go unused for a number of frames
+// are destroyed, which cleans up after resolution changes. Commands execute in submission order on a single
+// context, so a target may be reacquired as soon as the pass that used it has been submitted.
+class RenderTargetPool
+{
+public:
+    RenderTargetPool();
+    ~RenderTargetPool();
+
+    void Initialize(GPUDevice *pGPUDevice);
+    void Shutdown();
+
+    // targets unused for this many frames are destroyed, defaults to 30
+    void SetUnusedFrameLimit(uint32 frames) { m_unusedFrameLimit = frames; }
+
+    // The texture must have GPU_TEXTURE_FLAG_BIND_RENDER_TARGET/GPU_TEXTURE_FLAG_BIND_DEPTH_STENCIL_BUFFER.
+    // A null view description views the first mip level in the texture format. A null sampler description
+    // uses linear filtering with clamping, and is only needed when the texture is shader bindable.
+    const TransientRenderTarget *AcquireRenderTarget(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_RENDER_TARGET_VIEW_DESC *pViewDesc = nullptr, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc = nullptr);
+    const TransientRenderTarget *AcquireDepthStencilBuffer(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_DEPTH_STENCIL_BUFFER_VIEW_DESC *pViewDesc = nullptr, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc = nullptr);
+    void ReleaseTarget(const TransientRenderTarget *pTarget);
+
+    // Call once per frame, after all targets for the frame have been released.
+    void EndFrame();
+
+    // Destroys every target not currently acquired.
+    void Purge();
+
+    // statistics, peaks are high-water marks since creation or the last ResetPeaks
+    uint32 GetTargetCount() const { return m_targets.GetSize(); }
+    uint64 GetPooledMemory() const { return m_pooledMemory; }
+    uint64 GetAcquiredMemory() const { return m_acquiredMemory; }
+    uint64 GetPeakPooledMemory() const { return m_peakPooledMemory; }
+    uint64 GetPeakAcquiredMemory() const { return m_peakAcquiredMemory; }
+    void ResetPeaks();
+
+private:
+    struct PooledTarget : public TransientRenderTarget
+    {
+        GPU_TEXTURE2D_DESC TextureDesc;
+        GPU_SAMPLER_STATE_DESC SamplerStateDesc;
+        GPU_RENDER_TARGET_VIEW_DESC RenderTargetViewDesc;
+        GPU_DEPTH_STENCIL_BUFFER_VIEW_DESC DepthStencilBufferViewDesc;
+        bool IsDepthStencil;
+        bool Acquired;
+        uint32 LastUsedFrame;
+        uint64 MemoryUsage;
+    };
+
+    PooledTarget *FindOrCreateTarget(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, bool isDepthStencil, const void *pViewDesc, uint32 viewDescSize);
+    void AcquireTarget(PooledTarget *pTarget);
+    void DestroyTarget(PooledTarget *pTarget);
+
+    GPUDevice *m_pGPUDevice;
+    PODArray<PooledTarget *> m_targets;
+    uint32 m_frameNumber;
+    uint32 m_unusedFrameLimit;
+
+    uint64 m_pooledMemory;
+    uint64 m_acquiredMemory;
+    uint64 m_peakPooledMemory;
+    uint64 m_peakAcquiredMemory;
+};
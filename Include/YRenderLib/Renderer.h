@@ -518,6 +518,15 @@ public:
     void OnResourceCreated(const GPUResource *pResource);
     void OnResourceDeleted(const GPUResource *pResource);
 
+    // Resource memory queries, peaks are high-water marks since creation or the last ResetMemoryPeaks
+    ptrdiff_t GetResourceCPUMemoryUsage(GPU_RESOURCE_TYPE type) const { return m_resourceCPUMemoryUsage[type]; }
+    ptrdiff_t GetResourceGPUMemoryUsage(GPU_RESOURCE_TYPE type) const { return m_resourceGPUMemoryUsage[type]; }
+    ptrdiff_t GetResourceGPUMemoryPeak(GPU_RESOURCE_TYPE type) const { return m_resourceGPUMemoryPeak[type]; }
+    ptrdiff_t GetTotalCPUMemoryUsage() const;
+    ptrdiff_t GetTotalGPUMemoryUsage() const;
+    ptrdiff_t GetTotalGPUMemoryPeak() const { return m_totalGPUMemoryPeak; }
+    void ResetMemoryPeaks();
+
 private:
     uint32 m_frameNumber;
 
@@ -528,6 +537,11 @@ private:
 
     Y_ATOMIC_DECL ptrdiff_t m_resourceCPUMemoryUsage[GPU_RESOURCE_TYPE_COUNT];
     Y_ATOMIC_DECL ptrdiff_t m_resourceGPUMemoryUsage[GPU_RESOURCE_TYPE_COUNT];
+    Y_ATOMIC_DECL ptrdiff_t m_totalGPUMemoryUsage;
+
+    // updated without atomics, may briefly miss a peak when resources are created concurrently
+    ptrdiff_t m_resourceGPUMemoryPeak[GPU_RESOURCE_TYPE_COUNT];
+    ptrdiff_t m_totalGPUMemoryPeak;
 };
 
 class GPUDevice : public ReferenceCounted
@@ -577,8 +591,15 @@ public:
     // CreateComputePipeline
 
     // When creating resources off-thread, there is an implicit flush/wait after each resource creation. This forces a group to be batched together.
+    // Backends may stage the initial data of resources created inside a batch per thread and upload it at the next GPUContext::BeginFrame,
+    // so such resources must not be used for rendering until a frame has begun after EndResourceBatchUpload. Batches ended on the render
+    // thread are uploaded before EndResourceBatchUpload returns, and their resources are usable immediately. Batches may be nested.
     virtual void BeginResourceBatchUpload() = 0;
     virtual void EndResourceBatchUpload() = 0;
+
+    // Releases a reference once the GPU can no longer be using the resource, i.e. after GPUFrameLatency + 1 calls
+    // to GPUContext::BeginFrame. Can be called from any thread.
+    virtual void ReleaseResourceDeferred(GPUResource *pResource) = 0;
 };
 
 class GPUCommandList : public ReferenceCounted
@@ -632,6 +653,10 @@ public:
     virtual void ClearTargets(bool clearColor = true, bool clearDepth = true, bool clearStencil = true, const FloatColor &clearColorValue = FloatColor::Black, float clearDepthValue = 1.0f, uint8 clearStencilValue = 0) = 0;
     virtual void DiscardTargets(bool discardColor = true, bool discardDepth = true, bool discardStencil = true) = 0;
 
+    // Discards the contents of a single view, whether or not it is currently bound.
+    virtual void DiscardRenderTargetView(GPURenderTargetView *pRenderTargetView) = 0;
+    virtual void DiscardDepthStencilBufferView(GPUDepthStencilBufferView *pDepthStencilBufferView) = 0;
+
     // Swap chain changing
     virtual GPUOutputBuffer *GetOutputBuffer() = 0;
     virtual void SetOutputBuffer(GPUOutputBuffer *pOutputBuffer) = 0;
@@ -759,7 +784,7 @@ struct RendererInitializationParameters
     // Implicit swap chain vsync behaviour
     RENDERER_VSYNC_TYPE ImplicitSwapChainVSyncType;
 
-    // Frame latency
+    // Frame latency, at least 1
     uint32 GPUFrameLatency;
 
     // Debug device, backend-specific behavior
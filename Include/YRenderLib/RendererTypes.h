@@ -44,6 +44,7 @@ enum RENDERER_PLATFORM
     RENDERER_PLATFORM_OPENGL,
     RENDERER_PLATFORM_OPENGLES2,
     RENDERER_PLATFORM_VULKAN,
+    RENDERER_PLATFORM_NULL,
     RENDERER_PLATFORM_COUNT,
 };
 
@@ -303,6 +304,9 @@ enum GPU_VERTEX_ELEMENT_TYPE
     GPU_VERTEX_ELEMENT_TYPE_UINT4,
     GPU_VERTEX_ELEMENT_TYPE_SNORM4,
     GPU_VERTEX_ELEMENT_TYPE_UNORM4,
+    GPU_VERTEX_ELEMENT_TYPE_SNORM16_2,
+    GPU_VERTEX_ELEMENT_TYPE_SNORM16_4,
+    GPU_VERTEX_ELEMENT_TYPE_UNORM10_10_10_2,
     GPU_VERTEX_ELEMENT_TYPE_COUNT,
 };
 
@@ -347,6 +351,10 @@ struct GPU_VERTEX_ELEMENT_DESC
 
 };
 
+// size in bytes and number of shader-visible components of a vertex element type
+uint32 GPUVertexElementTypeSize(GPU_VERTEX_ELEMENT_TYPE Type);
+uint32 GPUVertexElementTypeComponentCount(GPU_VERTEX_ELEMENT_TYPE Type);
+
 enum GPU_QUERY_TYPE
 {
     GPU_QUERY_TYPE_SAMPLES_PASSED,            // uint64
@@ -0,0 +1,130 @@
+#pragma once
+#include "YRenderLib/Renderer.h"
+#include "YRenderLib/Math/Vectorf.h"
+#include "YBaseLib/NonCopyable.h"
+#include "YBaseLib/PODArray.h"
+
+// Rectangle packer for a single page, using MaxRects with the best short side fit heuristic. The free space is kept as
+// a list of maximal (possibly overlapping) rectangles, each insert picks the free rectangle that leaves the least
+// space along its shorter side, then splits and prunes the list. Rectangles are never rotated.
+class TextureAtlasPacker
+{
+public:
+    TextureAtlasPacker();
+    TextureAtlasPacker(uint32 width, uint32 height);
+    ~TextureAtlasPacker();
+
+    // discards everything packed so far
+    void Reset(uint32 width, uint32 height);
+
+    // returns false if there's no space left for the rectangle
+    bool Insert(uint32 width, uint32 height, uint32 *pX, uint32 *pY);
+
+    uint32 GetWidth() const { return m_width; }
+    uint32 GetHeight() const { return m_height; }
+
+    // fraction of the page covered by inserted rectangles
+    float GetOccupancy() const { return static_cast<float>(m_usedArea) / static_cast<float>((uint64)m_width * (uint64)m_height); }
+
+private:
+    struct Rect
+    {
+        uint32 X, Y;
+        uint32 Width, Height;
+    };
+
+    void SplitFreeRects(const Rect &usedRect);
+    void PruneFreeRects();
+
+    uint32 m_width;
+    uint32 m_height;
+    uint64 m_usedArea;
+    PODArray<Rect> m_freeRects;
+};
+
+// Where an image ended up. Page is the array slice, or which texture when the pages are created separately.
+// Image UVs map to page UVs with uv * UVScale + UVOffset.
+struct TEXTURE_ATLAS_ENTRY
+{
+    uint32 Page;
+    uint32 X;
+    uint32 Y;
+    uint32 Width;
+    uint32 Height;
+    Vector2f UVScale;
+    Vector2f UVOffset;
+};
+
+// Packs many small images into pages of a single format, for creating as one GPUTexture2DArray (or a GPUTexture2D per
+// page) instead of a texture per image.
+//
+// Each image is surrounded by a gutter of its own edge pixels, so bilinear filtering at its border doesn't pick up its
+// neighbours. With mipmaps, images are placed on a grid of 1 << (mipLevels - 1) pixels, which keeps every texel of every
+// level inside a single image and its gutter. Images spill onto new pages when one fills, up to maxPages.
+//
+// Images are converted to the atlas format as they're added, any format pair PixelFormat_ConvertPixels handles works.
+// Block-compressed atlas formats aren't supported.
+class TextureAtlasBuilder
+{
+    DeclareNonCopyable(TextureAtlasBuilder);
+
+public:
+    TextureAtlasBuilder();
+    ~TextureAtlasBuilder();
+
+    // padding is the gutter width at the top level. A mipLevels of 0 picks up to 5 levels (a 16 pixel grid), as a
+    // longer chain makes every cell larger, pass a count to go further.
+    bool Initialize(PIXEL_FORMAT format, uint32 pageWidth, uint32 pageHeight, uint32 mipLevels = 1, uint32 padding = 2, uint32 maxPages = 1);
+
+    // Queues a copy of the image, returning its entry index, or 0xFFFFFFFF if it can't be converted or can never fit.
+    uint32 AddImage(const void *pPixels, uint32 width, uint32 height, uint32 pitch, PIXEL_FORMAT format);
+
+    // Packs every queued image, largest first, writes the pages and generates their mip levels.
+    // Fails if the images don't fit in maxPages.
+    bool Build();
+
+    PIXEL_FORMAT GetFormat() const { return m_format; }
+    uint32 GetPageWidth() const { return m_pageWidth; }
+    uint32 GetPageHeight() const { return m_pageHeight; }
+    uint32 GetMipLevels() const { return m_mipLevels; }
+    uint32 GetPageCount() const { return m_pageCount; }
+    uint32 GetImageCount() const { return m_images.GetSize(); }
+    const TEXTURE_ATLAS_ENTRY *GetEntry(uint32 index) const { return &m_entries[index]; }
+
+    // page data after Build, subresources are page-major as CreateTexture2DArray expects
+    const void *GetPageData(uint32 page, uint32 mipLevel) const { return m_subresourceData[page * m_mipLevels + mipLevel]; }
+    uint32 GetPagePitch(uint32 mipLevel) const { return m_subresourcePitches[mipLevel]; }
+
+    GPUTexture2D *CreateTexture2D(GPUDevice *pGPUDevice, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, uint32 page, uint32 flags = GPU_TEXTURE_FLAG_SHADER_BINDABLE) const;
+    GPUTexture2DArray *CreateTexture2DArray(GPUDevice *pGPUDevice, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, uint32 flags = GPU_TEXTURE_FLAG_SHADER_BINDABLE) const;
+
+private:
+    struct QueuedImage
+    {
+        size_t DataOffset;
+        uint32 Width;
+        uint32 Height;
+    };
+
+    void WriteImage(const QueuedImage *pImage, const TEXTURE_ATLAS_ENTRY *pEntry, uint32 cellX, uint32 cellY, uint32 cellWidth, uint32 cellHeight);
+    bool GenerateMipLevels(uint32 page);
+    void FreePages();
+
+    PIXEL_FORMAT m_format;
+    uint32 m_bytesPerPixel;
+    uint32 m_pageWidth;
+    uint32 m_pageHeight;
+    uint32 m_mipLevels;
+    uint32 m_padding;
+    uint32 m_alignment;
+    uint32 m_maxPages;
+
+    PODArray<byte> m_imageData;
+    PODArray<QueuedImage> m_images;
+    PODArray<TEXTURE_ATLAS_ENTRY> m_entries;
+
+    uint32 m_pageCount;
+    byte *m_pPageMemory;
+    PODArray<const void *> m_subresourceData;
+    PODArray<uint32> m_subresourcePitches;
+};
@@ -0,0 +1,133 @@
+#pragma once
+#include "YRenderLib/Renderer.h"
+#include "YBaseLib/PODArray.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct TextureStreamingRequest;
+
+// Supplies mip data for a streamed texture. ReadMipLevel is called from the streamer's I/O threads, though
+// never concurrently for the same source, and once from the creating thread for the mip tail.
+class TextureStreamingSource
+{
+public:
+    virtual ~TextureStreamingSource() {}
+
+    // Reads a single mip level, rows are destinationRowPitch bytes apart as given by PixelFormat_CalculateRowPitch.
+    virtual bool ReadMipLevel(uint32 mipLevel, void *pDestination, uint32 destinationRowPitch, uint32 destinationSize) = 0;
+};
+
+// A texture whose most detailed mip levels are loaded on demand. The GPU texture is replaced whenever the
+// resident range changes, so it should be fetched every frame rather than cached.
+class StreamedTexture
+{
+    friend class TextureStreamer;
+
+public:
+    // texture holding levels [GetResidentMipLevel(), MipLevels), never null
+    GPUTexture2D *GetGPUTexture() const { return m_pGPUTexture; }
+
+    // full texture description, including the levels that aren't resident
+    const GPU_TEXTURE2D_DESC *GetDesc() const { return &m_desc; }
+
+    // most detailed level currently resident, and the level the streamer is working towards
+    uint32 GetResidentMipLevel() const { return m_residentMipLevel; }
+    uint32 GetTargetMipLevel() const { return m_targetMipLevel; }
+
+    // Screen-size feedback, the largest extent in pixels the texture covered on screen this frame.
+    // May be called any number of times per frame, the largest value is kept until TextureStreamer::Update.
+    void RequestScreenSize(float screenSize) { m_requestedScreenSize = Max(m_requestedScreenSize, screenSize); }
+
+private:
+    StreamedTexture() {}
+    ~StreamedTexture() {}
+
+    uint64 GetMipChainSize(uint32 firstMipLevel) const { return m_mipChainSizes[firstMipLevel]; }
+
+    GPU_TEXTURE2D_DESC m_desc;
+    GPU_SAMPLER_STATE_DESC m_samplerStateDesc;
+    TextureStreamingSource *m_pSource;
+    GPUTexture2D *m_pGPUTexture;
+    uint64 m_mipChainSizes[TEXTURE_MAX_MIPMAP_COUNT];         // bytes from each level to the end of the chain
+    uint32 m_tailMipLevel;                                      // first level of the always-resident tail
+    uint32 m_residentMipLevel;
+    uint32 m_targetMipLevel;
+    float m_requestedScreenSize;
+    float m_priority;                                           // last requested screen size, zero once evicted
+    uint32 m_lastRequestedFrame;
+    TextureStreamingRequest *m_pRequest;
+    bool m_streamingFailed;
+    bool m_destroyed;
+};
+
+// Streams texture mip levels in and out within a memory budget. Creating a texture loads only its mip tail,
+// more detailed levels are read on background I/O threads based on screen-size feedback, and are uploaded
+// with WriteTexture on the render thread within a per-frame upload budget. When the requested levels don't
+// fit in the budget, the least important textures are dropped back towards their tails first.
+class TextureStreamer
+{
+public:
+    TextureStreamer();
+    ~TextureStreamer();
+
+    // budget applies to everything above the mip tails, which are always resident
+    bool Initialize(GPUDevice *pGPUDevice, GPUContext *pGPUContext, uint64 memoryBudget, uint32 ioThreadCount = 2);
+    void Shutdown();
+
+    void SetMemoryBudget(uint64 memoryBudget) { m_memoryBudget = memoryBudget; }
+    void SetUploadBudgetPerFrame(uint32 uploadBytesPerFrame) { m_uploadBudgetPerFrame = uploadBytesPerFrame; }
+
+    // tails are the levels at or below this size in both dimensions, defaults to 64
+    void SetTailSize(uint32 tailSize) { m_tailSize = tailSize; }
+
+    // textures not requested for this many frames fall back to their tails, defaults to 60
+    void SetEvictionDelay(uint32 frames) { m_evictionDelay = frames; }
+
+    // Takes ownership of pSource. The mip tail is read synchronously so the texture is usable immediately.
+    StreamedTexture *CreateTexture(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, TextureStreamingSource *pSource);
+    void DestroyTexture(StreamedTexture *pTexture);
+
+    // Call once per frame on the render thread, after screen sizes have been requested.
+    void Update();
+
+    // statistics
+    uint64 GetMemoryBudget() const { return m_memoryBudget; }
+    uint64 GetResidentMemory() const { return m_residentMemory; }
+    uint32 GetTextureCount() const { return m_textures.GetSize(); }
+    uint32 GetPendingRequestCount() const { return m_inFlightRequestCount; }
+
+private:
+    uint32 CalculateWantedMipLevel(const StreamedTexture *pTexture) const;
+    void UpdateTargets();
+    void IssueRequests();
+    void ProcessCompletedRequests(uint32 *pUploadBytesRemaining);
+    bool UploadRequest(TextureStreamingRequest *pRequest, uint32 *pUploadBytesRemaining);
+    void FinishRequest(TextureStreamingRequest *pRequest);
+    void FreeTexture(StreamedTexture *pTexture);
+    void IOThreadMain();
+
+    GPUDevice *m_pGPUDevice;
+    GPUContext *m_pGPUContext;
+    uint64 m_memoryBudget;
+    uint64 m_residentMemory;
+    uint32 m_uploadBudgetPerFrame;
+    uint32 m_tailSize;
+    uint32 m_evictionDelay;
+    uint32 m_frameNumber;
+    uint32 m_inFlightRequestCount;
+
+    PODArray<StreamedTexture *> m_textures;
+    PODArray<StreamedTexture *> m_sortedTextures;            // ascending priority, rebuilt every update
+    PODArray<StreamedTexture *> m_destroyedTextures;         // waiting for their request to come back
+    PODArray<TextureStreamingRequest *> m_uploadingRequests;  // read, partially uploaded
+
+    // shared with the I/O threads
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCondition;
+    PODArray<TextureStreamingRequest *> m_queuedRequests;
+    PODArray<TextureStreamingRequest *> m_completedRequests;
+    bool m_shutdownThreads;
+
+    PODArray<std::thread *> m_ioThreads;
+};
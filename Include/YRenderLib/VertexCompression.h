@@ -0,0 +1,49 @@
+#pragma once
+#include "YBaseLib/Common.h"
+#include "YRenderLib/RendererTypes.h"
+#include "YRenderLib/Math/Vectorf.h"
+
+// Bulk conversion of float vertex data to compact GPU formats, intended to be run at import time.
+//
+// Encodings produced:
+//   HALF/HALF2/HALF4           IEEE half precision, round to nearest even
+//   SNORM16_2/SNORM16_4        signed normalized 16-bit, or an octahedral-encoded unit vector when
+//                              a 3 component normal/tangent/binormal is written to SNORM16_2
+//   UNORM10_10_10_2            unit vector mapped to [0, 1] in xyz, alpha is 1 when w >= 0 and 0 otherwise,
+//                              decode in the shader with xyz * 2 - 1 and w = a * 2 - 1
+//   UNORM4                     8-bit unsigned normalized, e.g. colors
+//
+// SSE2 is used when available, F16C is used for half conversions when the build targets AVX2.
+enum VERTEX_COMPRESSION_FLAGS
+{
+    VERTEX_COMPRESSION_FLAG_HALF_POSITIONS      = (1 << 0),     // Store positions as HALF4 instead of keeping them as floats.
+};
+
+namespace VertexCompression {
+
+    // contiguous stream converters
+    void FloatToHalf(uint16 *pDestination, const float *pSource, uint32 count);
+    void HalfToFloat(float *pDestination, const uint16 *pSource, uint32 count);
+    void FloatToSNorm16(int16 *pDestination, const float *pSource, uint32 count);
+    void SNorm16ToFloat(float *pDestination, const int16 *pSource, uint32 count);
+    void FloatToUNorm8(uint8 *pDestination, const float *pSource, uint32 count);
+
+    // unit normals <-> two SNORM16 components per normal
+    void EncodeOctahedralNormals(int16 *pDestination, const Vector3f *pNormals, uint32 count);
+    void DecodeOctahedralNormals(Vector3f *pDestination, const int16 *pSource, uint32 count);
+
+    // unit tangents with handedness in w <-> R10G10B10A2
+    void EncodeTangents(uint32 *pDestination, const Vector4f *pTangents, uint32 count);
+    void DecodeTangents(Vector4f *pDestination, const uint32 *pSource, uint32 count);
+
+    // Builds the compressed equivalent of a single-stream layout, returns the new vertex stride.
+    // Offsets are repacked in element order and kept 4-byte aligned, stream indices are preserved.
+    uint32 BuildCompressedLayout(const GPU_VERTEX_ELEMENT_DESC *pSourceElements, uint32 nElements, uint32 flags, GPU_VERTEX_ELEMENT_DESC *pDestinationElements);
+
+    // Converts interleaved vertices between two single-stream layouts. Destination elements are matched to
+    // source elements by semantic and semantic index. Source elements being converted must be float types,
+    // elements with identical types are copied. Returns false if a destination element can't be produced.
+    bool CompressVertices(const GPU_VERTEX_ELEMENT_DESC *pSourceElements, uint32 nSourceElements, const void *pSourceVertices, uint32 sourceStride,
+                          const GPU_VERTEX_ELEMENT_DESC *pDestinationElements, uint32 nDestinationElements, void *pDestinationVertices, uint32 destinationStride,
+                          uint32 vertexCount);
+}
@@ -188,6 +188,9 @@ const char *D3D11TypeConversion::VertexElementTypeToShaderTypeString(GPU_VERTEX_
         "uint4",            // GPU_VERTEX_ELEMENT_TYPE_UINT4
         "float4",           // GPU_VERTEX_ELEMENT_TYPE_SNORM4
         "float4",           // GPU_VERTEX_ELEMENT_TYPE_UNORM4
+        "float2",           // GPU_VERTEX_ELEMENT_TYPE_SNORM16_2
+        "float4",           // GPU_VERTEX_ELEMENT_TYPE_SNORM16_4
+        "float4",           // GPU_VERTEX_ELEMENT_TYPE_UNORM10_10_10_2
     };
 
     DebugAssert(type < GPU_VERTEX_ELEMENT_TYPE_COUNT);
@@ -222,6 +225,9 @@ DXGI_FORMAT D3D11TypeConversion::VertexElementTypeToDXGIFormat(GPU_VERTEX_ELEMEN
         DXGI_FORMAT_R32G32B32A32_UINT,  // GPU_VERTEX_ELEMENT_TYPE_UINT4
         DXGI_FORMAT_R8G8B8A8_SNORM,     // GPU_VERTEX_ELEMENT_TYPE_SNORM4
         DXGI_FORMAT_R8G8B8A8_UNORM,     // GPU_VERTEX_ELEMENT_TYPE_UNORM4
+        DXGI_FORMAT_R16G16_SNORM,       // GPU_VERTEX_ELEMENT_TYPE_SNORM16_2
+        DXGI_FORMAT_R16G16B16A16_SNORM, // GPU_VERTEX_ELEMENT_TYPE_SNORM16_4
+        DXGI_FORMAT_R10G10B10A2_UNORM,  // GPU_VERTEX_ELEMENT_TYPE_UNORM10_10_10_2
     };
 
     DebugAssert(type < GPU_VERTEX_ELEMENT_TYPE_COUNT);
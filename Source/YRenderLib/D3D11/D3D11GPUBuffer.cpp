@@ -62,6 +62,12 @@ GPUBuffer *D3D11GPUDevice::CreateBuffer(const GPU_BUFFER_DESC *pDesc, const void
         D3DBufferDesc.CPUAccessFlags = 0;
     }
 
+    // inside a batch, stage the data for the render thread instead of handing it to the runtime here
+    // dynamic buffers can't be updated with UpdateSubresource, so are always created with their data
+    bool stageInitialData = (pInitialData != NULL && D3DBufferDesc.Usage != D3D11_USAGE_DYNAMIC && IsInResourceBatch());
+    if (stageInitialData)
+        D3DBufferDesc.Usage = D3D11_USAGE_DEFAULT;
+
     if (pDesc->Flags & GPU_BUFFER_FLAG_BIND_VERTEX_BUFFER)
         D3DBufferDesc.BindFlags |= D3D11_BIND_VERTEX_BUFFER;
     if (pDesc->Flags & GPU_BUFFER_FLAG_BIND_INDEX_BUFFER)
@@ -78,7 +84,7 @@ GPUBuffer *D3D11GPUDevice::CreateBuffer(const GPU_BUFFER_DESC *pDesc, const void
 
     // create buffer
     ID3D11Buffer *pBuffer;
-    hResult = m_pD3DDevice->CreateBuffer(&D3DBufferDesc, (pInitialData != NULL) ? &subResourceData : NULL, &pBuffer);
+    hResult = m_pD3DDevice->CreateBuffer(&D3DBufferDesc, (pInitialData != NULL && !stageInitialData) ? &subResourceData : NULL, &pBuffer);
     if (FAILED(hResult))
     {
         Log_ErrorPrintf("D3D11GPUDevice::CreateBuffer: Could not create buffer (%u bytes): %08X", pDesc->Size, hResult);
@@ -90,12 +96,12 @@ GPUBuffer *D3D11GPUDevice::CreateBuffer(const GPU_BUFFER_DESC *pDesc, const void
     if (pDesc->Flags & GPU_BUFFER_FLAG_READABLE)
     {
         D3D11_BUFFER_DESC D3DStagingBufferDesc;
-        D3DBufferDesc.ByteWidth = pDesc->Size;
-        D3DBufferDesc.Usage = D3D11_USAGE_STAGING;
-        D3DBufferDesc.BindFlags = 0;
-        D3DBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;// | D3D11_CPU_ACCESS_WRITE;
-        D3DBufferDesc.MiscFlags = 0;
-        D3DBufferDesc.StructureByteStride = 0;
+        D3DStagingBufferDesc.ByteWidth = pDesc->Size;
+        D3DStagingBufferDesc.Usage = D3D11_USAGE_STAGING;
+        D3DStagingBufferDesc.BindFlags = 0;
+        D3DStagingBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;// | D3D11_CPU_ACCESS_WRITE;
+        D3DStagingBufferDesc.MiscFlags = 0;
+        D3DStagingBufferDesc.StructureByteStride = 0;
 
         hResult = m_pD3DDevice->CreateBuffer(&D3DStagingBufferDesc, NULL, &pStagingBuffer);
         if (FAILED(hResult))
@@ -111,6 +117,9 @@ GPUBuffer *D3D11GPUDevice::CreateBuffer(const GPU_BUFFER_DESC *pDesc, const void
         pStagingBuffer = NULL;
     }
 
+    if (stageInitialData)
+        StageInitialData(pBuffer, 0, pInitialData, pDesc->Size, 0, 0);
+
     return new D3D11GPUBuffer(pDesc, pBuffer, pStagingBuffer);
 }
 
@@ -158,6 +158,9 @@ bool D3D11GPUContext::Create()
 {
     HRESULT hResult;
 
+    // until the first frame, assume the context is used on the thread creating it
+    m_pDevice->SetRenderThread();
+
     // set initial state
     m_pD3DContext->RSSetState(m_pDevice->GetDefaultRasterizerState());
     m_pD3DContext->OMSetDepthStencilState(m_pDevice->GetDefaultDepthStencilState(), 0);
@@ -543,6 +546,18 @@ void D3D11GPUContext::DiscardTargets(bool discardColor /* = true */, bool discar
     }
 }
 
+void D3D11GPUContext::DiscardRenderTargetView(GPURenderTargetView *pRenderTargetView)
+{
+    if (m_pD3DContext1 != nullptr)
+        m_pD3DContext1->DiscardView(static_cast<D3D11GPURenderTargetView *>(pRenderTargetView)->GetD3DRTV());
+}
+
+void D3D11GPUContext::DiscardDepthStencilBufferView(GPUDepthStencilBufferView *pDepthStencilBufferView)
+{
+    if (m_pD3DContext1 != nullptr)
+        m_pD3DContext1->DiscardView(static_cast<D3D11GPUDepthStencilBufferView *>(pDepthStencilBufferView)->GetD3DDSV());
+}
+
 GPUOutputBuffer *D3D11GPUContext::GetOutputBuffer()
 {
     return m_pCurrentSwapChain;
@@ -753,7 +768,9 @@ void D3D11GPUContext::PresentOutputBuffer(GPU_PRESENT_BEHAVIOUR presentBehaviour
 
 void D3D11GPUContext::BeginFrame()
 {
-
+    m_pDevice->SetRenderThread();
+    m_pDevice->ApplyPendingUploads(m_pD3DContext);
+    m_pDevice->GetDeferredReleaseQueue()->BeginFrame();
 }
 
 void D3D11GPUContext::Flush()
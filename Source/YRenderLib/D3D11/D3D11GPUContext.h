@@ -96,6 +96,8 @@ public:
     // RT Clearing
     virtual void ClearTargets(bool clearColor = true, bool clearDepth = true, bool clearStencil = true, const FloatColor &clearColorValue = FloatColor::Black, float clearDepthValue = 1.0f, uint8 clearStencilValue = 0) override final;
     virtual void DiscardTargets(bool discardColor = true, bool discardDepth = true, bool discardStencil = true) override final;
+    virtual void DiscardRenderTargetView(GPURenderTargetView *pRenderTargetView) override final;
+    virtual void DiscardDepthStencilBufferView(GPUDepthStencilBufferView *pDepthStencilBufferView) override final;
 
     // Swap chain
     virtual GPUOutputBuffer *GetOutputBuffer() override final;
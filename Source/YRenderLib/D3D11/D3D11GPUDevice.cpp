@@ -9,7 +9,7 @@
 #include "YRenderLib/D3D11/D3D11GPUTexture.h"
 Log_SetChannel(D3D11GPUDevice);
 
-D3D11GPUDevice::D3D11GPUDevice(IDXGIFactory *pDXGIFactory, IDXGIAdapter *pDXGIAdapter, ID3D11Device *pD3DDevice, ID3D11Device1 *pD3DDevice1, D3D_FEATURE_LEVEL D3DFeatureLevel, RENDERER_FEATURE_LEVEL featureLevel, TEXTURE_PLATFORM texturePlatform, SHADER_PROGRAM_BYTECODE_TYPE shaderProgramType, DXGI_FORMAT windowBackBufferFormat, DXGI_FORMAT windowDepthStencilFormat)
+D3D11GPUDevice::D3D11GPUDevice(IDXGIFactory *pDXGIFactory, IDXGIAdapter *pDXGIAdapter, ID3D11Device *pD3DDevice, ID3D11Device1 *pD3DDevice1, D3D_FEATURE_LEVEL D3DFeatureLevel, RENDERER_FEATURE_LEVEL featureLevel, TEXTURE_PLATFORM texturePlatform, SHADER_PROGRAM_BYTECODE_TYPE shaderProgramType, DXGI_FORMAT windowBackBufferFormat, DXGI_FORMAT windowDepthStencilFormat, uint32 gpuFrameLatency)
     : m_pDXGIFactory(pDXGIFactory)
     , m_pDXGIAdapter(pDXGIAdapter)
     , m_pD3DDevice(pD3DDevice)
@@ -20,6 +20,9 @@ D3D11GPUDevice::D3D11GPUDevice(IDXGIFactory *pDXGIFactory, IDXGIAdapter *pDXGIAd
     , m_shaderProgramType(shaderProgramType)
     , m_swapChainBackBufferFormat(windowBackBufferFormat)
     , m_swapChainDepthStencilBufferFormat(windowDepthStencilFormat)
+    , m_deferredReleaseQueue(gpuFrameLatency)
+    , m_pPublishedUploadBatches(nullptr)
+    , m_renderThreadId(std::thread::id())
 {
     m_pDXGIFactory->AddRef();
     m_pDXGIAdapter->AddRef();
@@ -28,6 +31,17 @@ D3D11GPUDevice::D3D11GPUDevice(IDXGIFactory *pDXGIFactory, IDXGIAdapter *pDXGIAd
 
 D3D11GPUDevice::~D3D11GPUDevice()
 {
+    // anything still queued has to go before the device
+    m_deferredReleaseQueue.ReleaseAll();
+    for (D3D11UploadBatch *pBatch = m_pPublishedUploadBatches.exchange(nullptr); pBatch != nullptr; )
+    {
+        D3D11UploadBatch *pNextBatch = pBatch->pNext;
+        for (uint32 i = 0; i < pBatch->Uploads.GetSize(); i++)
+            pBatch->Uploads[i].pResource->Release();
+        delete pBatch;
+        pBatch = pNextBatch;
+    }
+
     SAFE_RELEASE(m_pDefaultRasterizerState);
     SAFE_RELEASE(m_pDefaultDepthStencilState);
     SAFE_RELEASE(m_pDefaultBlendState);
@@ -155,14 +169,95 @@ float D3D11GPUDevice::GetTexelOffset() const
     return 0.0f;
 }
 
-void D3D11GPUDevice::BeginResourceBatchUpload()
+// per-thread batch state, a thread only ever stages for one device at a time
+static thread_local D3D11UploadBatch *s_pThreadUploadBatch = nullptr;
+static thread_local uint32 s_threadUploadBatchDepth = 0;
+
+// uploads and frees a single batch
+static void ApplyUploadBatch(ID3D11DeviceContext *pD3DContext, D3D11UploadBatch *pBatch)
 {
+    for (uint32 i = 0; i < pBatch->Uploads.GetSize(); i++)
+    {
+        const D3D11UploadBatch::Upload &upload = pBatch->Uploads[i];
+        pD3DContext->UpdateSubresource(upload.pResource, upload.Subresource, nullptr, pBatch->Data.GetBasePointer() + upload.DataOffset, upload.RowPitch, upload.DepthPitch);
+        upload.pResource->Release();
+    }
 
+    delete pBatch;
+}
+
+void D3D11GPUDevice::BeginResourceBatchUpload()
+{
+    s_threadUploadBatchDepth++;
 }
 
 void D3D11GPUDevice::EndResourceBatchUpload()
 {
+    DebugAssert(s_threadUploadBatchDepth > 0);
+    if (--s_threadUploadBatchDepth > 0 || s_pThreadUploadBatch == nullptr)
+        return;
+
+    D3D11UploadBatch *pBatch = s_pThreadUploadBatch;
+    s_pThreadUploadBatch = nullptr;
+
+    // the immediate context belongs to this thread, so upload now rather than leave the resources empty until the next frame
+    if (std::this_thread::get_id() == m_renderThreadId.load(std::memory_order_relaxed))
+    {
+        ID3D11DeviceContext *pD3DContext;
+        m_pD3DDevice->GetImmediateContext(&pD3DContext);
+        ApplyUploadBatch(pD3DContext, pBatch);
+        pD3DContext->Release();
+        return;
+    }
+
+    // publish without locking, the render thread takes the whole list at once
+    pBatch->pNext = m_pPublishedUploadBatches.load(std::memory_order_relaxed);
+    while (!m_pPublishedUploadBatches.compare_exchange_weak(pBatch->pNext, pBatch, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool D3D11GPUDevice::IsInResourceBatch() const
+{
+    return (s_threadUploadBatchDepth > 0);
+}
+
+void D3D11GPUDevice::StageInitialData(ID3D11Resource *pResource, uint32 subresource, const void *pData, uint32 dataSize, uint32 rowPitch, uint32 depthPitch)
+{
+    DebugAssert(s_threadUploadBatchDepth > 0);
+    if (s_pThreadUploadBatch == nullptr)
+    {
+        s_pThreadUploadBatch = new D3D11UploadBatch();
+        s_pThreadUploadBatch->pNext = nullptr;
+    }
+
+    D3D11UploadBatch::Upload upload;
+    upload.pResource = pResource;
+    upload.Subresource = subresource;
+    upload.DataOffset = s_pThreadUploadBatch->Data.GetSize();
+    upload.RowPitch = rowPitch;
+    upload.DepthPitch = depthPitch;
+    s_pThreadUploadBatch->Uploads.Add(upload);
+
+    // keeps the resource alive until the upload has happened
+    pResource->AddRef();
 
+    s_pThreadUploadBatch->Data.Resize(upload.DataOffset + dataSize);
+    Y_memcpy(s_pThreadUploadBatch->Data.GetBasePointer() + upload.DataOffset, pData, dataSize);
+}
+
+void D3D11GPUDevice::ApplyPendingUploads(ID3D11DeviceContext *pD3DContext)
+{
+    D3D11UploadBatch *pBatch = m_pPublishedUploadBatches.exchange(nullptr, std::memory_order_acquire);
+    while (pBatch != nullptr)
+    {
+        D3D11UploadBatch *pNextBatch = pBatch->pNext;
+        ApplyUploadBatch(pD3DContext, pBatch);
+        pBatch = pNextBatch;
+    }
+}
+
+void D3D11GPUDevice::ReleaseResourceDeferred(GPUResource *pResource)
+{
+    m_deferredReleaseQueue.Release(pResource);
 }
 
 D3D11GPUSamplerState::D3D11GPUSamplerState(const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, ID3D11SamplerState *pD3DSamplerState)
@@ -2,6 +2,10 @@
 #include "YRenderLib/D3D11/D3D11Common.h"
 #include "YRenderLib/D3D11/D3D11GPUContext.h"
 #include "YRenderLib/Renderer.h"
+#include "YRenderLib/DeferredReleaseQueue.h"
+#include "YBaseLib/PODArray.h"
+#include <atomic>
+#include <thread>
 
 class D3D11GPUSamplerState : public GPUSamplerState
 {
@@ -63,12 +67,31 @@ private:
     ID3D11BlendState *m_pD3DBlendState;
 };
 
+// Initial data for resources created inside a resource batch. Each thread fills its own batch without locking,
+// and EndResourceBatchUpload publishes it to the device for the render thread to apply, or applies it directly
+// when called on the render thread.
+struct D3D11UploadBatch
+{
+    struct Upload
+    {
+        ID3D11Resource *pResource;
+        uint32 Subresource;
+        uint32 DataOffset;
+        uint32 RowPitch;
+        uint32 DepthPitch;
+    };
+
+    D3D11UploadBatch *pNext;
+    PODArray<Upload> Uploads;
+    PODArray<byte> Data;
+};
+
 class D3D11GPUDevice : public GPUDevice
 {
 public:
     D3D11GPUDevice(IDXGIFactory *pDXGIFactory, IDXGIAdapter *pDXGIAdapter, ID3D11Device *pD3DDevice, ID3D11Device1 *pD3DDevice1,
                    D3D_FEATURE_LEVEL D3DFeatureLevel, RENDERER_FEATURE_LEVEL featureLevel, TEXTURE_PLATFORM texturePlatform,
-                   SHADER_PROGRAM_BYTECODE_TYPE shaderProgramType, DXGI_FORMAT windowBackBufferFormat, DXGI_FORMAT windowDepthStencilFormat);
+                   SHADER_PROGRAM_BYTECODE_TYPE shaderProgramType, DXGI_FORMAT windowBackBufferFormat, DXGI_FORMAT windowDepthStencilFormat, uint32 gpuFrameLatency);
 
     virtual ~D3D11GPUDevice();
 
@@ -80,6 +103,7 @@ public:
     DXGI_FORMAT GetSwapChainBackBufferFormat() const { return m_swapChainBackBufferFormat; }
     DXGI_FORMAT GetSwapChainDepthStencilBufferFormat() const { return m_swapChainDepthStencilBufferFormat; }
     RendererCounters* GetCounters() { return &m_counters; }
+    DeferredReleaseQueue* GetDeferredReleaseQueue() { return &m_deferredReleaseQueue; }
     ID3D11RasterizerState* GetDefaultRasterizerState() const { return m_pDefaultRasterizerState; }
     ID3D11DepthStencilState* GetDefaultDepthStencilState() const { return m_pDefaultDepthStencilState; }
     ID3D11BlendState* GetDefaultBlendState() const { return m_pDefaultBlendState; }
@@ -87,6 +111,16 @@ public:
     // create default states, etc.
     bool Create();
 
+    // Copies initial data into the calling thread's upload batch, returns false if the thread isn't inside a batch.
+    bool IsInResourceBatch() const;
+    void StageInitialData(ID3D11Resource *pResource, uint32 subresource, const void *pData, uint32 dataSize, uint32 rowPitch, uint32 depthPitch);
+
+    // Applies all published batches, called by the immediate context at the start of each frame.
+    void ApplyPendingUploads(ID3D11DeviceContext *pD3DContext);
+
+    // Records the calling thread as the one the immediate context is used on.
+    void SetRenderThread() { m_renderThreadId.store(std::this_thread::get_id(), std::memory_order_relaxed); }
+
     // Device queries.
     virtual RENDERER_PLATFORM GetPlatform() const override final;
     virtual RENDERER_FEATURE_LEVEL GetFeatureLevel() const override final;
@@ -126,6 +160,7 @@ public:
     // off-thread resource creation
     virtual void BeginResourceBatchUpload() override final;
     virtual void EndResourceBatchUpload() override final;
+    virtual void ReleaseResourceDeferred(GPUResource *pResource) override final;
 
 private:
     IDXGIFactory *m_pDXGIFactory;
@@ -143,6 +178,11 @@ private:
     DXGI_FORMAT m_swapChainDepthStencilBufferFormat;
 
     RendererCounters m_counters;
+    DeferredReleaseQueue m_deferredReleaseQueue;
+
+    // batches pushed by EndResourceBatchUpload, most recent first
+    std::atomic<D3D11UploadBatch *> m_pPublishedUploadBatches;
+    std::atomic<std::thread::id> m_renderThreadId;
 
     ID3D11RasterizerState* m_pDefaultRasterizerState;
     ID3D11DepthStencilState* m_pDefaultDepthStencilState;
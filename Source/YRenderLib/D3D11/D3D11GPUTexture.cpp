@@ -656,6 +656,11 @@ GPUTexture2D *D3D11GPUDevice::CreateTexture2D(const GPU_TEXTURE2D_DESC *pTexture
         D3DTextureDesc.Usage = D3D11_USAGE_IMMUTABLE;
     }
 
+    // inside a batch, stage the data for the render thread instead of handing it to the runtime here
+    bool stageInitialData = (ppInitialData != nullptr && IsInResourceBatch());
+    if (stageInitialData)
+        D3DTextureDesc.Usage = D3D11_USAGE_DEFAULT;
+
     // bindflags
     D3DTextureDesc.CPUAccessFlags = 0;
     D3DTextureDesc.BindFlags = MapTextureFlagsToD3DBindFlags(pTextureDesc->Flags);
@@ -663,7 +668,7 @@ GPUTexture2D *D3D11GPUDevice::CreateTexture2D(const GPU_TEXTURE2D_DESC *pTexture
 
     // initial data
     D3D11_SUBRESOURCE_DATA *pD3DInitialData = nullptr;
-    if (ppInitialData != nullptr)
+    if (ppInitialData != nullptr && !stageInitialData)
     {
         uint32 nInitializers = pTextureDesc->MipLevels;
         pD3DInitialData = (D3D11_SUBRESOURCE_DATA *)alloca(sizeof(D3D11_SUBRESOURCE_DATA)* nInitializers);
@@ -748,6 +753,19 @@ GPUTexture2D *D3D11GPUDevice::CreateTexture2D(const GPU_TEXTURE2D_DESC *pTexture
         }
     }
 
+    // copy initial data, the last row of each level may be shorter than the pitch
+    if (stageInitialData)
+    {
+        for (uint32 i = 0; i < pTextureDesc->MipLevels; i++)
+        {
+            uint32 mipWidth = Max(pTextureDesc->Width >> i, (uint32)1);
+            uint32 mipHeight = Max(pTextureDesc->Height >> i, (uint32)1);
+            uint32 tightRowPitch = PixelFormat_CalculateRowPitch(pTextureDesc->Format, mipWidth);
+            uint32 rowCount = PixelFormat_CalculateImageSize(pTextureDesc->Format, mipWidth, mipHeight, 1) / tightRowPitch;
+            StageInitialData(pD3DTexture, i, ppInitialData[i], pInitialDataPitch[i] * (rowCount - 1) + tightRowPitch, pInitialDataPitch[i], 0);
+        }
+    }
+
     // create class
     return new D3D11GPUTexture2D(pTextureDesc, pD3DTexture, pD3DStagingTexture, pD3DSRV, pD3DSamplerState);
 }
@@ -29,6 +29,9 @@ bool D3D11RenderBackend_Create(const RendererInitializationParameters *pCreatePa
         return false;
     }
 
+    // DXGI treats a maximum frame latency of zero as its default of three, which the deferred release queue wouldn't know about
+    uint32 gpuFrameLatency = Max(pCreateParameters->GPUFrameLatency, (uint32)1);
+
     // determine driver type
     D3D_DRIVER_TYPE driverType;
     if (pCreateParameters->D3DForceWarpDevice)
@@ -128,6 +131,13 @@ bool D3D11RenderBackend_Create(const RendererInitializationParameters *pCreatePa
         }
     }
 
+    // limit queued frames to the configured latency, resources released with ReleaseResourceDeferred rely on this
+    {
+        Microsoft::WRL::ComPtr<IDXGIDevice1> pDXGIDevice1;
+        if (FAILED(hResult = pD3DDevice.As(&pDXGIDevice1)) || FAILED(hResult = pDXGIDevice1->SetMaximumFrameLatency(gpuFrameLatency)))
+            Log_WarningPrintf("D3D11RenderBackend::Create: Failed to set maximum frame latency with hResult %08X.", hResult);
+    }
+
     // print device name
     {
         // get adapter desc
@@ -162,7 +172,7 @@ bool D3D11RenderBackend_Create(const RendererInitializationParameters *pCreatePa
         Log_InfoPrintf("Using Direct3D 11.1 features.");
 
     // create device wrapper class
-    D3D11GPUDevice *pGPUDevice = new D3D11GPUDevice(pDXGIFactory.Get(), pDXGIAdapter.Get(), pD3DDevice.Get(), pD3DDevice1.Get(), acquiredFeatureLevel, featureLevel, texturePlatform, shaderProgramType, swapChainBackBufferFormat, swapChainDepthStencilBufferFormat);
+    D3D11GPUDevice *pGPUDevice = new D3D11GPUDevice(pDXGIFactory.Get(), pDXGIAdapter.Get(), pD3DDevice.Get(), pD3DDevice1.Get(), acquiredFeatureLevel, featureLevel, texturePlatform, shaderProgramType, swapChainBackBufferFormat, swapChainDepthStencilBufferFormat, gpuFrameLatency);
 
     // create context wrapper class
     D3D11GPUContext *pGPUContext = new D3D11GPUContext(pGPUDevice, pD3DDevice.Get(), pD3DDevice1.Get(), pD3DImmediateContext.Get());
@@ -0,0 +1,76 @@
+#include "YRenderLib/DeferredReleaseQueue.h"
+
+DeferredReleaseQueue::DeferredReleaseQueue(uint32 frameLatency)
+    : m_bucketCount(frameLatency + 1)
+    , m_currentBucket(0)
+{
+    m_pBuckets = new PODArray<GPUResource *>[m_bucketCount];
+}
+
+DeferredReleaseQueue::~DeferredReleaseQueue()
+{
+    ReleaseAll();
+    delete[] m_pBuckets;
+}
+
+void DeferredReleaseQueue::Release(GPUResource *pResource)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pBuckets[m_currentBucket].Add(pResource);
+}
+
+void DeferredReleaseQueue::BeginFrame()
+{
+    // the next slot was last filled frameLatency + 1 frames ago, it's emptied in the same critical section that
+    // advances to it so a concurrent Release can't land in it and be freed a frame early
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_currentBucket = (m_currentBucket + 1) % m_bucketCount;
+        TakeBucket(m_currentBucket);
+    }
+
+    ReleaseTakenResources();
+}
+
+void DeferredReleaseQueue::ReleaseAll()
+{
+    for (uint32 i = 0; i < m_bucketCount; i++)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            TakeBucket(i);
+        }
+
+        ReleaseTakenResources();
+    }
+}
+
+uint32 DeferredReleaseQueue::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32 count = 0;
+    for (uint32 i = 0; i < m_bucketCount; i++)
+        count += m_pBuckets[i].GetSize();
+
+    return count;
+}
+
+void DeferredReleaseQueue::TakeBucket(uint32 bucketIndex)
+{
+    // copied out rather than released in place, a destructor may queue further releases
+    PODArray<GPUResource *> &bucket = m_pBuckets[bucketIndex];
+    if (bucket.IsEmpty())
+        return;
+
+    m_releaseList.Resize(bucket.GetSize());
+    Y_memcpy(m_releaseList.GetBasePointer(), bucket.GetBasePointer(), sizeof(GPUResource *) * bucket.GetSize());
+    bucket.Clear();
+}
+
+void DeferredReleaseQueue::ReleaseTakenResources()
+{
+    for (uint32 i = 0; i < m_releaseList.GetSize(); i++)
+        m_releaseList[i]->Release();
+
+    m_releaseList.Clear();
+}
@@ -0,0 +1,670 @@
+#include "YRenderLib/FrameGraph.h"
+#include "YRenderLib/RenderTargetPool.h"
+#include "YBaseLib/Log.h"
+#include <algorithm>
+Log_SetChannel(FrameGraph);
+
+FrameGraph::FrameGraph()
+    : m_pOutputRenderTargetPool(nullptr)
+    , m_compiled(false)
+{
+
+}
+
+FrameGraph::~FrameGraph()
+{
+    Reset();
+}
+
+void FrameGraph::Reset()
+{
+    ReleaseOutputs();
+    m_resources.Clear();
+    m_passes.Clear();
+    m_uses.Clear();
+    m_schedule.Clear();
+    m_compiled = false;
+}
+
+FrameGraphResource FrameGraph::AddResource(const char *name, const GPU_TEXTURE2D_DESC *pTextureDesc, bool isDepthStencil)
+{
+    Resource resource;
+    Y_memzero(&resource, sizeof(resource));
+    resource.Name = name;
+    if (pTextureDesc != nullptr)
+        resource.TextureDesc = *pTextureDesc;
+    resource.IsDepthStencil = isDepthStencil;
+    resource.FirstPass = FRAME_GRAPH_INVALID_RESOURCE;
+    resource.LastPass = FRAME_GRAPH_INVALID_RESOURCE;
+    m_resources.Add(resource);
+    m_compiled = false;
+    return m_resources.GetSize() - 1;
+}
+
+FrameGraphResource FrameGraph::CreateRenderTarget(const char *name, const GPU_TEXTURE2D_DESC *pTextureDesc)
+{
+    DebugAssert(pTextureDesc->Flags & GPU_TEXTURE_FLAG_BIND_RENDER_TARGET);
+    return AddResource(name, pTextureDesc, false);
+}
+
+FrameGraphResource FrameGraph::CreateDepthStencilBuffer(const char *name, const GPU_TEXTURE2D_DESC *pTextureDesc)
+{
+    DebugAssert(pTextureDesc->Flags & GPU_TEXTURE_FLAG_BIND_DEPTH_STENCIL_BUFFER);
+    return AddResource(name, pTextureDesc, true);
+}
+
+FrameGraphResource FrameGraph::ImportRenderTarget(const char *name, GPUTexture2D *pTexture, GPURenderTargetView *pRenderTargetView)
+{
+    FrameGraphResource handle = AddResource(name, (pTexture != nullptr) ? pTexture->GetDesc() : nullptr, false);
+    Resource &resource = m_resources[handle];
+    resource.IsImported = true;
+    resource.pTexture = pTexture;
+    resource.pRenderTargetView = pRenderTargetView;
+    return handle;
+}
+
+FrameGraphResource FrameGraph::ImportDepthStencilBuffer(const char *name, GPUTexture2D *pTexture, GPUDepthStencilBufferView *pDepthStencilBufferView)
+{
+    FrameGraphResource handle = AddResource(name, pTexture->GetDesc(), true);
+    Resource &resource = m_resources[handle];
+    resource.IsImported = true;
+    resource.pTexture = pTexture;
+    resource.pDepthStencilBufferView = pDepthStencilBufferView;
+    return handle;
+}
+
+void FrameGraph::MarkOutput(FrameGraphResource resource)
+{
+    m_resources[resource].IsOutput = true;
+    m_compiled = false;
+}
+
+void FrameGraph::ReleaseOutputs()
+{
+    if (m_pOutputRenderTargetPool == nullptr)
+        return;
+
+    for (uint32 i = 0; i < m_resources.GetSize(); i++)
+    {
+        Resource &resource = m_resources[i];
+        if (resource.pTransientTarget != nullptr)
+        {
+            m_pOutputRenderTargetPool->ReleaseTarget(resource.pTransientTarget);
+            resource.pTransientTarget = nullptr;
+            resource.pTexture = nullptr;
+            resource.pRenderTargetView = nullptr;
+            resource.pDepthStencilBufferView = nullptr;
+        }
+    }
+
+    m_pOutputRenderTargetPool = nullptr;
+}
+
+uint32 FrameGraph::AddPass(const char *name, FrameGraphExecuteFunction executeFunction, void *pUserData)
+{
+    Pass pass;
+    Y_memzero(&pass, sizeof(pass));
+    pass.Name = name;
+    pass.ExecuteFunction = executeFunction;
+    pass.pUserData = pUserData;
+    pass.ClearColor = FloatColor::Black;
+    pass.ClearDepth = 1.0f;
+    pass.ClearStencil = 0;
+    m_passes.Add(pass);
+    m_compiled = false;
+    return m_passes.GetSize() - 1;
+}
+
+void FrameGraph::AddResourceUse(uint32 pass, FrameGraphResource resource, RESOURCE_USAGE usage, FRAME_GRAPH_LOAD_OP loadOp)
+{
+    DebugAssert(pass < m_passes.GetSize() && resource < m_resources.GetSize());
+
+    ResourceUse use;
+    use.Pass = pass;
+    use.Resource = resource;
+    use.Usage = usage;
+    use.LoadOp = loadOp;
+    use.CompiledLoadOp = loadOp;
+    use.Order = m_uses.GetSize();
+    m_uses.Add(use);
+    m_compiled = false;
+}
+
+void FrameGraph::PassRead(uint32 pass, FrameGraphResource resource)
+{
+    AddResourceUse(pass, resource, RESOURCE_USAGE_READ, FRAME_GRAPH_LOAD_OP_LOAD);
+}
+
+void FrameGraph::PassWriteRenderTarget(uint32 pass, FrameGraphResource resource, FRAME_GRAPH_LOAD_OP loadOp /* = FRAME_GRAPH_LOAD_OP_LOAD */)
+{
+    AddResourceUse(pass, resource, RESOURCE_USAGE_RENDER_TARGET, loadOp);
+}
+
+void FrameGraph::PassWriteDepthStencilBuffer(uint32 pass, FrameGraphResource resource, FRAME_GRAPH_LOAD_OP loadOp /* = FRAME_GRAPH_LOAD_OP_LOAD */)
+{
+    AddResourceUse(pass, resource, RESOURCE_USAGE_DEPTH_STENCIL_BUFFER, loadOp);
+}
+
+void FrameGraph::SetPassClearValues(uint32 pass, const FloatColor &clearColor, float clearDepth /* = 1.0f */, uint8 clearStencil /* = 0 */)
+{
+    m_passes[pass].ClearColor = clearColor;
+    m_passes[pass].ClearDepth = clearDepth;
+    m_passes[pass].ClearStencil = clearStencil;
+}
+
+void FrameGraph::SetPassHasSideEffects(uint32 pass)
+{
+    m_passes[pass].HasSideEffects = true;
+    m_compiled = false;
+}
+
+bool FrameGraph::Compile()
+{
+    // group uses by pass, keeping declaration order so render target slots follow the calls
+    std::sort(m_uses.GetBasePointer(), m_uses.GetBasePointer() + m_uses.GetSize(), [](const ResourceUse &lhs, const ResourceUse &rhs) {
+        return (lhs.Pass != rhs.Pass) ? (lhs.Pass < rhs.Pass) : (lhs.Order < rhs.Order);
+    });
+
+    for (uint32 i = 0; i < m_passes.GetSize(); i++)
+    {
+        Pass &pass = m_passes[i];
+        pass.Culled = false;
+        pass.ReferenceCount = 0;
+        pass.FirstUse = 0;
+        pass.UseCount = 0;
+    }
+    for (uint32 i = 0; i < m_resources.GetSize(); i++)
+    {
+        Resource &resource = m_resources[i];
+        resource.ReferenceCount = 0;
+        resource.FirstPass = FRAME_GRAPH_INVALID_RESOURCE;
+        resource.LastPass = FRAME_GRAPH_INVALID_RESOURCE;
+    }
+    for (uint32 i = 0; i < m_uses.GetSize(); i++)
+    {
+        m_uses[i].CompiledLoadOp = m_uses[i].LoadOp;
+
+        Pass &pass = m_passes[m_uses[i].Pass];
+        if (pass.UseCount == 0)
+            pass.FirstUse = i;
+        pass.UseCount++;
+
+        // count writers for validation
+        if (m_uses[i].Usage != RESOURCE_USAGE_READ)
+            m_resources[m_uses[i].Resource].ReferenceCount++;
+    }
+
+    // validate
+    for (uint32 passIndex = 0; passIndex < m_passes.GetSize(); passIndex++)
+    {
+        const Pass &pass = m_passes[passIndex];
+        uint32 colorTargetCount = 0;
+        bool writesOutputBuffer = false;
+        bool writesDepthStencilBuffer = false;
+        for (uint32 i = pass.FirstUse; i < pass.FirstUse + pass.UseCount; i++)
+        {
+            const ResourceUse &use = m_uses[i];
+            Resource &resource = m_resources[use.Resource];
+            if (use.Usage == RESOURCE_USAGE_READ)
+            {
+                if (!resource.IsImported && resource.ReferenceCount == 0)
+                {
+                    Log_ErrorPrintf("FrameGraph::Compile: Pass '%s' reads '%s' but no pass writes it", pass.Name, resource.Name);
+                    return false;
+                }
+
+                for (uint32 j = pass.FirstUse; j < pass.FirstUse + pass.UseCount; j++)
+                {
+                    if (m_uses[j].Resource == use.Resource && m_uses[j].Usage != RESOURCE_USAGE_READ)
+                    {
+                        Log_ErrorPrintf("FrameGraph::Compile: Pass '%s' both reads and writes '%s'", pass.Name, resource.Name);
+                        return false;
+                    }
+                }
+
+                continue;
+            }
+
+            if (resource.IsDepthStencil != (use.Usage == RESOURCE_USAGE_DEPTH_STENCIL_BUFFER))
+            {
+                Log_ErrorPrintf("FrameGraph::Compile: Pass '%s' writes '%s' as the wrong kind of target", pass.Name, resource.Name);
+                return false;
+            }
+
+            if (use.Usage == RESOURCE_USAGE_RENDER_TARGET)
+            {
+                colorTargetCount++;
+                writesOutputBuffer |= (resource.IsImported && resource.pRenderTargetView == nullptr);
+            }
+            else
+            {
+                if (writesDepthStencilBuffer)
+                {
+                    Log_ErrorPrintf("FrameGraph::Compile: Pass '%s' writes more than one depth-stencil buffer", pass.Name);
+                    return false;
+                }
+                writesDepthStencilBuffer = true;
+            }
+        }
+
+        if (colorTargetCount > GPU_MAX_SIMULTANEOUS_RENDER_TARGETS || (writesOutputBuffer && (colorTargetCount > 1 || writesDepthStencilBuffer)))
+        {
+            Log_ErrorPrintf("FrameGraph::Compile: Pass '%s' has an unsupported combination of render targets", pass.Name);
+            return false;
+        }
+    }
+
+    if (!SchedulePasses())
+        return false;
+
+    // cull passes that don't contribute, starting from resources nothing reads
+    for (uint32 i = 0; i < m_resources.GetSize(); i++)
+        m_resources[i].ReferenceCount = 0;
+    for (uint32 i = 0; i < m_uses.GetSize(); i++)
+    {
+        const ResourceUse &use = m_uses[i];
+        if (use.Usage == RESOURCE_USAGE_READ)
+            m_resources[use.Resource].ReferenceCount++;
+        else
+            m_passes[use.Pass].ReferenceCount++;
+    }
+
+    PODArray<FrameGraphResource> unreferencedResources;
+    for (uint32 i = 0; i < m_resources.GetSize(); i++)
+    {
+        const Resource &resource = m_resources[i];
+        if (resource.ReferenceCount == 0 && !resource.IsImported && !resource.IsOutput)
+            unreferencedResources.Add(i);
+    }
+    while (!unreferencedResources.IsEmpty())
+    {
+        FrameGraphResource resourceIndex = unreferencedResources.LastElement();
+        unreferencedResources.PopBack();
+
+        for (uint32 i = 0; i < m_uses.GetSize(); i++)
+        {
+            const ResourceUse &writeUse = m_uses[i];
+            if (writeUse.Resource != resourceIndex || writeUse.Usage == RESOURCE_USAGE_READ)
+                continue;
+
+            Pass &pass = m_passes[writeUse.Pass];
+            DebugAssert(pass.ReferenceCount > 0);
+            if (--pass.ReferenceCount > 0 || pass.HasSideEffects)
+                continue;
+
+            // nothing this pass writes is needed, so neither is anything it reads
+            pass.Culled = true;
+            for (uint32 j = pass.FirstUse; j < pass.FirstUse + pass.UseCount; j++)
+            {
+                const ResourceUse &readUse = m_uses[j];
+                if (readUse.Usage != RESOURCE_USAGE_READ)
+                    continue;
+
+                Resource &readResource = m_resources[readUse.Resource];
+                if (--readResource.ReferenceCount == 0 && !readResource.IsImported && !readResource.IsOutput)
+                    unreferencedResources.Add(readUse.Resource);
+            }
+        }
+    }
+
+    // lifetimes over the remaining passes, outputs live until the end of the graph
+    uint32 lastPass = FRAME_GRAPH_INVALID_RESOURCE;
+    for (uint32 position = 0; position < m_schedule.GetSize(); position++)
+    {
+        uint32 passIndex = m_schedule[position];
+        const Pass &pass = m_passes[passIndex];
+        if (pass.Culled)
+            continue;
+
+        for (uint32 i = pass.FirstUse; i < pass.FirstUse + pass.UseCount; i++)
+        {
+            ResourceUse &use = m_uses[i];
+            Resource &resource = m_resources[use.Resource];
+            if (resource.FirstPass == FRAME_GRAPH_INVALID_RESOURCE)
+            {
+                // a new transient target has no contents worth loading
+                resource.FirstPass = passIndex;
+                if (!resource.IsImported && use.LoadOp == FRAME_GRAPH_LOAD_OP_LOAD)
+                    use.CompiledLoadOp = FRAME_GRAPH_LOAD_OP_DONT_CARE;
+            }
+            resource.LastPass = passIndex;
+        }
+
+        lastPass = passIndex;
+    }
+    for (uint32 i = 0; i < m_resources.GetSize(); i++)
+    {
+        Resource &resource = m_resources[i];
+        if (resource.IsOutput && resource.FirstPass != FRAME_GRAPH_INVALID_RESOURCE)
+            resource.LastPass = lastPass;
+    }
+
+    m_compiled = true;
+    return true;
+}
+
+bool FrameGraph::SchedulePasses()
+{
+    struct Dependency
+    {
+        uint32 Before;
+        uint32 After;
+    };
+
+    PODArray<Dependency> dependencies;
+    auto addDependency = [&dependencies](uint32 before, uint32 after)
+    {
+        if (before != after)
+        {
+            Dependency dependency = { before, after };
+            dependencies.Add(dependency);
+        }
+    };
+
+    // uses are grouped by pass, so walking them visits each resource's readers and writers in the order they were added
+    PODArray<uint32> readers;
+    for (uint32 resourceIndex = 0; resourceIndex < m_resources.GetSize(); resourceIndex++)
+    {
+        const Resource &resource = m_resources[resourceIndex];
+        uint32 firstWriter = FRAME_GRAPH_INVALID_RESOURCE;
+        for (uint32 i = 0; i < m_uses.GetSize() && firstWriter == FRAME_GRAPH_INVALID_RESOURCE; i++)
+        {
+            if (m_uses[i].Resource == resourceIndex && m_uses[i].Usage != RESOURCE_USAGE_READ)
+                firstWriter = m_uses[i].Pass;
+        }
+
+        // readers holds the passes reading the current contents, which the next writer has to wait for
+        uint32 lastWriter = FRAME_GRAPH_INVALID_RESOURCE;
+        readers.Clear();
+        for (uint32 i = 0; i < m_uses.GetSize(); i++)
+        {
+            const ResourceUse &use = m_uses[i];
+            if (use.Resource != resourceIndex)
+                continue;
+
+            if (use.Usage == RESOURCE_USAGE_READ)
+            {
+                uint32 writer = (lastWriter != FRAME_GRAPH_INVALID_RESOURCE || resource.IsImported) ? lastWriter : firstWriter;
+                if (writer != FRAME_GRAPH_INVALID_RESOURCE)
+                    addDependency(writer, use.Pass);
+
+                readers.Add(use.Pass);
+                continue;
+            }
+
+            // the first write of a transient produces the contents earlier reads see, every other write replaces them
+            if (lastWriter != FRAME_GRAPH_INVALID_RESOURCE || resource.IsImported)
+            {
+                for (uint32 j = 0; j < readers.GetSize(); j++)
+                    addDependency(readers[j], use.Pass);
+                readers.Clear();
+            }
+            if (lastWriter != FRAME_GRAPH_INVALID_RESOURCE)
+                addDependency(lastWriter, use.Pass);
+
+            lastWriter = use.Pass;
+        }
+    }
+
+    // repeatedly take the earliest added pass with nothing left to wait for, so independent passes keep their order
+    static const uint32 SCHEDULED = 0xFFFFFFFF;
+    PODArray<uint32> waitCounts;
+    waitCounts.Resize(m_passes.GetSize());
+    for (uint32 i = 0; i < m_passes.GetSize(); i++)
+        waitCounts[i] = 0;
+    for (uint32 i = 0; i < dependencies.GetSize(); i++)
+        waitCounts[dependencies[i].After]++;
+
+    m_schedule.Clear();
+    while (m_schedule.GetSize() < m_passes.GetSize())
+    {
+        uint32 nextPass = 0;
+        while (nextPass < m_passes.GetSize() && waitCounts[nextPass] != 0)
+            nextPass++;
+
+        if (nextPass == m_passes.GetSize())
+        {
+            for (nextPass = 0; waitCounts[nextPass] == SCHEDULED; nextPass++);
+            Log_ErrorPrintf("FrameGraph::Compile: Reads and writes form a cycle, pass '%s' can't be scheduled", m_passes[nextPass].Name);
+            return false;
+        }
+
+        waitCounts[nextPass] = SCHEDULED;
+        m_schedule.Add(nextPass);
+        for (uint32 i = 0; i < dependencies.GetSize(); i++)
+        {
+            if (dependencies[i].Before == nextPass)
+                waitCounts[dependencies[i].After]--;
+        }
+    }
+
+    return true;
+}
+
+bool FrameGraph::Execute(GPUContext *pGPUContext, RenderTargetPool *pRenderTargetPool)
+{
+    DebugAssert((pGPUContext == nullptr) == (pRenderTargetPool == nullptr));
+    if (!m_compiled && !Compile())
+        return false;
+
+    // outputs of the previous run go back first, they may be allocated again below
+    ReleaseOutputs();
+
+    // headless, nothing to bind or allocate
+    if (pGPUContext == nullptr)
+    {
+        for (uint32 position = 0; position < m_schedule.GetSize(); position++)
+        {
+            const Pass &pass = m_passes[m_schedule[position]];
+            if (!pass.Culled)
+                pass.ExecuteFunction(this, nullptr, pass.pUserData);
+        }
+
+        return true;
+    }
+
+    bool result = true;
+    for (uint32 position = 0; position < m_schedule.GetSize(); position++)
+    {
+        uint32 passIndex = m_schedule[position];
+        if (m_passes[passIndex].Culled)
+            continue;
+
+        if (!ExecutePass(passIndex, pGPUContext, pRenderTargetPool))
+        {
+            result = false;
+            break;
+        }
+    }
+
+    // back to the output buffer, outputs are kept for the caller unless something failed
+    pGPUContext->SetRenderTargets(0, nullptr, nullptr);
+    for (uint32 i = 0; i < m_resources.GetSize(); i++)
+    {
+        Resource &resource = m_resources[i];
+        if (resource.pTransientTarget != nullptr && resource.IsOutput && result)
+        {
+            m_pOutputRenderTargetPool = pRenderTargetPool;
+        }
+        else if (resource.pTransientTarget != nullptr)
+        {
+            pRenderTargetPool->ReleaseTarget(resource.pTransientTarget);
+            resource.pTransientTarget = nullptr;
+            resource.pTexture = nullptr;
+            resource.pRenderTargetView = nullptr;
+            resource.pDepthStencilBufferView = nullptr;
+        }
+    }
+
+    return result;
+}
+
+bool FrameGraph::ExecutePass(uint32 passIndex, GPUContext *pGPUContext, RenderTargetPool *pRenderTargetPool)
+{
+    const Pass &pass = m_passes[passIndex];
+    GPURenderTargetView *pColorTargets[GPU_MAX_SIMULTANEOUS_RENDER_TARGETS];
+    GPURenderTargetView *pClearColorTargets[GPU_MAX_SIMULTANEOUS_RENDER_TARGETS];
+    GPURenderTargetView *pDiscardColorTargets[GPU_MAX_SIMULTANEOUS_RENDER_TARGETS];
+    GPURenderTargetView *pDyingColorTargets[GPU_MAX_SIMULTANEOUS_RENDER_TARGETS];
+    uint32 colorTargetCount = 0, clearColorTargetCount = 0, discardColorTargetCount = 0, dyingColorTargetCount = 0;
+    GPUDepthStencilBufferView *pDepthStencilBuffer = nullptr;
+    FRAME_GRAPH_LOAD_OP depthStencilLoadOp = FRAME_GRAPH_LOAD_OP_LOAD;
+    bool depthStencilBufferDying = false;
+    bool writesOutputBuffer = false;
+    GPUTexture *pViewportTexture = nullptr;
+
+    for (uint32 i = pass.FirstUse; i < pass.FirstUse + pass.UseCount; i++)
+    {
+        const ResourceUse &use = m_uses[i];
+        Resource &resource = m_resources[use.Resource];
+
+        // allocate transients on first use
+        if (!resource.IsImported && resource.pTransientTarget == nullptr)
+        {
+            DebugAssert(resource.FirstPass == passIndex);
+            resource.pTransientTarget = (resource.IsDepthStencil) ? pRenderTargetPool->AcquireDepthStencilBuffer(&resource.TextureDesc) : pRenderTargetPool->AcquireRenderTarget(&resource.TextureDesc);
+            if (resource.pTransientTarget == nullptr)
+            {
+                Log_ErrorPrintf("FrameGraph::Execute: Failed to allocate '%s' for pass '%s'", resource.Name, pass.Name);
+                return false;
+            }
+
+            resource.pTexture = resource.pTransientTarget->pTexture;
+            resource.pRenderTargetView = resource.pTransientTarget->pRenderTargetView;
+            resource.pDepthStencilBufferView = resource.pTransientTarget->pDepthStencilBufferView;
+        }
+
+        bool dying = (!resource.IsImported && !resource.IsOutput && resource.LastPass == passIndex);
+        if (use.Usage == RESOURCE_USAGE_RENDER_TARGET)
+        {
+            if (resource.pRenderTargetView == nullptr)
+            {
+                writesOutputBuffer = true;
+                if (use.CompiledLoadOp == FRAME_GRAPH_LOAD_OP_CLEAR)
+                    clearColorTargetCount++;
+                else if (use.CompiledLoadOp == FRAME_GRAPH_LOAD_OP_DONT_CARE)
+                    discardColorTargetCount++;
+                continue;
+            }
+
+            if (pViewportTexture == nullptr)
+                pViewportTexture = resource.pTexture;
+
+            pColorTargets[colorTargetCount++] = resource.pRenderTargetView;
+            if (use.CompiledLoadOp == FRAME_GRAPH_LOAD_OP_CLEAR)
+                pClearColorTargets[clearColorTargetCount++] = resource.pRenderTargetView;
+            else if (use.CompiledLoadOp == FRAME_GRAPH_LOAD_OP_DONT_CARE)
+                pDiscardColorTargets[discardColorTargetCount++] = resource.pRenderTargetView;
+            if (dying)
+                pDyingColorTargets[dyingColorTargetCount++] = resource.pRenderTargetView;
+        }
+        else if (use.Usage == RESOURCE_USAGE_DEPTH_STENCIL_BUFFER)
+        {
+            if (pViewportTexture == nullptr)
+                pViewportTexture = resource.pTexture;
+
+            pDepthStencilBuffer = resource.pDepthStencilBufferView;
+            depthStencilLoadOp = use.CompiledLoadOp;
+            depthStencilBufferDying = dying;
+        }
+    }
+
+    // Binding nothing selects the output buffer, so subsets are only bound when they contain something.
+    // Clears are issued on just the targets that need them before binding the full set, discards go by view.
+    bool hasTargets = (writesOutputBuffer || colorTargetCount > 0 || pDepthStencilBuffer != nullptr);
+    if (hasTargets)
+    {
+        bool clearDepthStencil = (pDepthStencilBuffer != nullptr && depthStencilLoadOp == FRAME_GRAPH_LOAD_OP_CLEAR);
+        bool discardDepthStencil = (pDepthStencilBuffer != nullptr && depthStencilLoadOp == FRAME_GRAPH_LOAD_OP_DONT_CARE);
+        if (writesOutputBuffer)
+        {
+            pGPUContext->SetRenderTargets(0, nullptr, nullptr);
+            if (clearColorTargetCount > 0)
+                pGPUContext->ClearTargets(true, false, false, pass.ClearColor);
+            else if (discardColorTargetCount > 0)
+                pGPUContext->DiscardTargets(true, false, false);
+        }
+        else
+        {
+            if (clearColorTargetCount > 0 || clearDepthStencil)
+            {
+                pGPUContext->SetRenderTargets(clearColorTargetCount, pClearColorTargets, (clearDepthStencil) ? pDepthStencilBuffer : nullptr);
+                pGPUContext->ClearTargets(clearColorTargetCount > 0, clearDepthStencil, clearDepthStencil, pass.ClearColor, pass.ClearDepth, pass.ClearStencil);
+            }
+            for (uint32 i = 0; i < discardColorTargetCount; i++)
+                pGPUContext->DiscardRenderTargetView(pDiscardColorTargets[i]);
+            if (discardDepthStencil)
+                pGPUContext->DiscardDepthStencilBufferView(pDepthStencilBuffer);
+
+            pGPUContext->SetRenderTargets(colorTargetCount, pColorTargets, pDepthStencilBuffer);
+        }
+
+        pGPUContext->SetFullViewport(pViewportTexture);
+    }
+
+    pass.ExecuteFunction(this, pGPUContext, pass.pUserData);
+
+    // contents of targets that are about to go back to the pool don't need to be kept, the execute
+    // function may have rebound targets so they're discarded by view
+    for (uint32 i = 0; i < dyingColorTargetCount; i++)
+        pGPUContext->DiscardRenderTargetView(pDyingColorTargets[i]);
+    if (depthStencilBufferDying)
+        pGPUContext->DiscardDepthStencilBufferView(pDepthStencilBuffer);
+
+    // return transients whose lifetime ends here
+    for (uint32 i = pass.FirstUse; i < pass.FirstUse + pass.UseCount; i++)
+    {
+        Resource &resource = m_resources[m_uses[i].Resource];
+        if (resource.pTransientTarget != nullptr && resource.LastPass == passIndex && !resource.IsOutput)
+        {
+            pRenderTargetPool->ReleaseTarget(resource.pTransientTarget);
+            resource.pTransientTarget = nullptr;
+            resource.pTexture = nullptr;
+            resource.pRenderTargetView = nullptr;
+            resource.pDepthStencilBufferView = nullptr;
+        }
+    }
+
+    return true;
+}
+
+GPUTexture2D *FrameGraph::GetTexture(FrameGraphResource resource) const
+{
+    DebugAssert(resource < m_resources.GetSize());
+    return m_resources[resource].pTexture;
+}
+
+uint32 FrameGraph::GetCulledPassCount() const
+{
+    uint32 count = 0;
+    for (uint32 i = 0; i < m_passes.GetSize(); i++)
+    {
+        if (m_passes[i].Culled)
+            count++;
+    }
+
+    return count;
+}
+
+void FrameGraph::GetResourceLifetime(FrameGraphResource resource, uint32 *pFirstPass, uint32 *pLastPass) const
+{
+    DebugAssert(m_compiled);
+    *pFirstPass = m_resources[resource].FirstPass;
+    *pLastPass = m_resources[resource].LastPass;
+}
+
+void FrameGraph::DumpToLog() const
+{
+    Log_DevPrintf("FrameGraph: %u passes (%u culled), %u resources", m_passes.GetSize(), GetCulledPassCount(), m_resources.GetSize());
+    for (uint32 i = 0; i < m_passes.GetSize(); i++)
+        Log_DevPrintf("  pass %u '%s'%s", i, m_passes[i].Name, m_passes[i].Culled ? " (culled)" : "");
+
+    for (uint32 i = 0; i < m_resources.GetSize(); i++)
+    {
+        const Resource &resource = m_resources[i];
+        if (resource.FirstPass == FRAME_GRAPH_INVALID_RESOURCE)
+            Log_DevPrintf("  resource '%s' unused", resource.Name);
+        else
+            Log_DevPrintf("  resource '%s'%s lives from pass %u to %u", resource.Name, resource.IsImported ? " (imported)" : "", resource.FirstPass, resource.LastPass);
+    }
+}
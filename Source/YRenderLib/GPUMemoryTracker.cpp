@@ -0,0 +1,365 @@
+#include "YRenderLib/GPUMemoryTracker.h"
+#include "YBaseLib/Log.h"
+#include "YBaseLib/StringConverter.h"
+Log_SetChannel(GPUMemoryTracker);
+
+static const uint32 INVALID_ENTRY = 0xFFFFFFFF;
+
+GPUMemoryTracker::GPUMemoryTracker()
+    : m_totalUsage(0)
+    , m_totalPeakUsage(0)
+    , m_totalBudget(0)
+    , m_frameNumber(0)
+{
+
+}
+
+GPUMemoryTracker::~GPUMemoryTracker()
+{
+    for (auto &it : m_resourceMap)
+        m_entries[it.second].pResource->Release();
+}
+
+uint32 GPUMemoryTracker::RegisterCategory(const char *name, uint64 budget)
+{
+    uint32 existingCategory = FindCategory(name);
+    if (existingCategory != GPU_MEMORY_INVALID_CATEGORY)
+    {
+        m_categories[existingCategory].Budget = budget;
+        return existingCategory;
+    }
+
+    if (m_categories.GetSize() == GPU_MEMORY_MAX_CATEGORIES)
+    {
+        Log_ErrorPrintf("GPUMemoryTracker::RegisterCategory: Too many categories, can't register '%s'", name);
+        return GPU_MEMORY_INVALID_CATEGORY;
+    }
+
+    Category category;
+    Y_strncpy(category.Name, sizeof(category.Name), name);
+    category.Usage = 0;
+    category.PeakUsage = 0;
+    category.Budget = budget;
+    category.ResourceCount = 0;
+    category.EvictionCount = 0;
+    category.Head = INVALID_ENTRY;
+    category.Tail = INVALID_ENTRY;
+    m_categories.Add(category);
+    return m_categories.GetSize() - 1;
+}
+
+uint32 GPUMemoryTracker::FindCategory(const char *name) const
+{
+    for (uint32 i = 0; i < m_categories.GetSize(); i++)
+    {
+        if (Y_strcmp(m_categories[i].Name, name) == 0)
+            return i;
+    }
+
+    return GPU_MEMORY_INVALID_CATEGORY;
+}
+
+void GPUMemoryTracker::SetCategoryBudget(uint32 category, uint64 budget)
+{
+    DebugAssert(category < m_categories.GetSize());
+    m_categories[category].Budget = budget;
+}
+
+void GPUMemoryTracker::TrackResource(GPUResource *pResource, uint32 category, GPUMemoryEvictionCallback evictionCallback, void *pUserData)
+{
+    DebugAssert(category < m_categories.GetSize());
+    if (IsResourceTracked(pResource))
+    {
+        Log_WarningPrintf("GPUMemoryTracker::TrackResource: Resource %p is already tracked", pResource);
+        return;
+    }
+
+    uint32 cpuMemoryUsage, gpuMemoryUsage;
+    pResource->GetMemoryUsage(&cpuMemoryUsage, &gpuMemoryUsage);
+
+    uint32 entryIndex;
+    if (!m_freeEntries.IsEmpty())
+    {
+        entryIndex = m_freeEntries.LastElement();
+        m_freeEntries.PopBack();
+    }
+    else
+    {
+        entryIndex = m_entries.GetSize();
+        m_entries.Resize(entryIndex + 1);
+    }
+
+    Entry &entry = m_entries[entryIndex];
+    entry.pResource = pResource;
+    entry.EvictionCallback = evictionCallback;
+    entry.pUserData = pUserData;
+    entry.Size = gpuMemoryUsage;
+    entry.Category = category;
+    entry.LastUsedFrame = m_frameNumber;
+    LinkEntry(entryIndex);
+
+    pResource->AddRef();
+    m_resourceMap.insert(std::make_pair(pResource, entryIndex));
+
+    Category &cat = m_categories[category];
+    cat.Usage += entry.Size;
+    cat.PeakUsage = Max(cat.PeakUsage, cat.Usage);
+    cat.ResourceCount++;
+    m_totalUsage += entry.Size;
+    m_totalPeakUsage = Max(m_totalPeakUsage, m_totalUsage);
+}
+
+void GPUMemoryTracker::UntrackResource(GPUResource *pResource)
+{
+    auto it = m_resourceMap.find(pResource);
+    if (it == m_resourceMap.end())
+        return;
+
+    RemoveEntry(it->second);
+}
+
+void GPUMemoryTracker::TouchResource(GPUResource *pResource)
+{
+    auto it = m_resourceMap.find(pResource);
+    if (it == m_resourceMap.end())
+        return;
+
+    uint32 entryIndex = it->second;
+    Entry &entry = m_entries[entryIndex];
+    if (entry.LastUsedFrame == m_frameNumber)
+        return;
+
+    entry.LastUsedFrame = m_frameNumber;
+    UnlinkEntry(entryIndex);
+    LinkEntry(entryIndex);
+}
+
+void GPUMemoryTracker::BeginFrame()
+{
+    m_frameNumber++;
+    EnforceBudgets();
+}
+
+bool GPUMemoryTracker::MakeRoom(uint32 category, uint64 size)
+{
+    DebugAssert(category < m_categories.GetSize());
+    const Category &cat = m_categories[category];
+
+    // work out how much has to go before evicting anything, so a failed request doesn't throw resources away
+    uint64 categoryExcess = (cat.Budget != 0 && cat.Usage + size > cat.Budget) ? (cat.Usage + size - cat.Budget) : 0;
+    uint64 totalExcess = (m_totalBudget != 0 && m_totalUsage + size > m_totalBudget) ? (m_totalUsage + size - m_totalBudget) : 0;
+    if (categoryExcess == 0 && totalExcess == 0)
+        return true;
+
+    if ((cat.Budget != 0 && size > cat.Budget) || (m_totalBudget != 0 && size > m_totalBudget))
+        return false;
+
+    uint64 categoryEvictable = GetEvictableUsage(category);
+    if (categoryExcess > categoryEvictable)
+        return false;
+    if (totalExcess > 0)
+    {
+        uint64 totalEvictable = 0;
+        for (uint32 i = 0; i < m_categories.GetSize(); i++)
+            totalEvictable += (i == category) ? categoryEvictable : GetEvictableUsage(i);
+        if (totalExcess > totalEvictable)
+            return false;
+    }
+
+    // freeing from this category also counts towards the total
+    uint64 freed = (categoryExcess > 0) ? EvictFromCategory(category, categoryExcess) : 0;
+    if (freed < categoryExcess)
+        return false;
+    if (totalExcess > freed)
+        freed += EvictFromAll(totalExcess - freed);
+    if (freed < Max(categoryExcess, totalExcess))
+        Log_WarningPrintf("GPUMemoryTracker::MakeRoom: Eviction callbacks refused, %s could not be freed", StringConverter::SizeToHumanReadableString(Max(categoryExcess, totalExcess) - freed).GetCharArray());
+
+    return (freed >= Max(categoryExcess, totalExcess));
+}
+
+void GPUMemoryTracker::EnforceBudgets()
+{
+    for (uint32 i = 0; i < m_categories.GetSize(); i++)
+    {
+        const Category &cat = m_categories[i];
+        if (cat.Budget != 0 && cat.Usage > cat.Budget)
+        {
+            uint64 excess = cat.Usage - cat.Budget;
+            uint64 freed = EvictFromCategory(i, excess);
+            if (freed < excess)
+                Log_WarningPrintf("GPUMemoryTracker: Category '%s' is %s over budget with nothing left to evict", cat.Name, StringConverter::SizeToHumanReadableString(excess - freed).GetCharArray());
+        }
+    }
+
+    if (m_totalBudget != 0 && m_totalUsage > m_totalBudget)
+    {
+        uint64 excess = m_totalUsage - m_totalBudget;
+        uint64 freed = EvictFromAll(excess);
+        if (freed < excess)
+            Log_WarningPrintf("GPUMemoryTracker: Total usage is %s over budget with nothing left to evict", StringConverter::SizeToHumanReadableString(excess - freed).GetCharArray());
+    }
+}
+
+void GPUMemoryTracker::ResetPeakUsage()
+{
+    for (uint32 i = 0; i < m_categories.GetSize(); i++)
+        m_categories[i].PeakUsage = m_categories[i].Usage;
+
+    m_totalPeakUsage = m_totalUsage;
+}
+
+void GPUMemoryTracker::GetSnapshot(GPU_MEMORY_SNAPSHOT *pSnapshot) const
+{
+    pSnapshot->FrameNumber = m_frameNumber;
+    pSnapshot->TotalUsage = m_totalUsage;
+    pSnapshot->TotalPeakUsage = m_totalPeakUsage;
+    pSnapshot->TotalBudget = m_totalBudget;
+    pSnapshot->CategoryCount = m_categories.GetSize();
+    for (uint32 i = 0; i < m_categories.GetSize(); i++)
+    {
+        const Category &cat = m_categories[i];
+        GPU_MEMORY_CATEGORY_SNAPSHOT &out = pSnapshot->Categories[i];
+        out.Name = cat.Name;
+        out.Usage = cat.Usage;
+        out.PeakUsage = cat.PeakUsage;
+        out.Budget = cat.Budget;
+        out.ResourceCount = cat.ResourceCount;
+        out.EvictionCount = cat.EvictionCount;
+    }
+}
+
+void GPUMemoryTracker::LinkEntry(uint32 entryIndex)
+{
+    Entry &entry = m_entries[entryIndex];
+    Category &cat = m_categories[entry.Category];
+    entry.Previous = cat.Tail;
+    entry.Next = INVALID_ENTRY;
+    if (cat.Tail != INVALID_ENTRY)
+        m_entries[cat.Tail].Next = entryIndex;
+    else
+        cat.Head = entryIndex;
+    cat.Tail = entryIndex;
+}
+
+void GPUMemoryTracker::UnlinkEntry(uint32 entryIndex)
+{
+    Entry &entry = m_entries[entryIndex];
+    Category &cat = m_categories[entry.Category];
+    if (entry.Previous != INVALID_ENTRY)
+        m_entries[entry.Previous].Next = entry.Next;
+    else
+        cat.Head = entry.Next;
+    if (entry.Next != INVALID_ENTRY)
+        m_entries[entry.Next].Previous = entry.Previous;
+    else
+        cat.Tail = entry.Previous;
+}
+
+void GPUMemoryTracker::RemoveEntry(uint32 entryIndex)
+{
+    UnlinkEntry(entryIndex);
+
+    Entry &entry = m_entries[entryIndex];
+    Category &cat = m_categories[entry.Category];
+    cat.Usage -= entry.Size;
+    cat.ResourceCount--;
+    m_totalUsage -= entry.Size;
+
+    GPUResource *pResource = entry.pResource;
+    m_resourceMap.erase(pResource);
+    entry.pResource = nullptr;
+    m_freeEntries.Add(entryIndex);
+
+    // may destroy the resource, so do it last
+    pResource->Release();
+}
+
+uint64 GPUMemoryTracker::EvictFromCategory(uint32 category, uint64 bytesToFree)
+{
+    uint64 freed = 0;
+    uint32 entryIndex = m_categories[category].Head;
+    while (entryIndex != INVALID_ENTRY && freed < bytesToFree)
+    {
+        // everything past this point was used this frame
+        const Entry &entry = m_entries[entryIndex];
+        if (entry.LastUsedFrame == m_frameNumber)
+            break;
+
+        uint32 nextEntryIndex = entry.Next;
+        if (entry.EvictionCallback != nullptr)
+        {
+            GPUResource *pResource = entry.pResource;
+            uint64 size = entry.Size;
+            if (entry.EvictionCallback(pResource, entry.pUserData))
+            {
+                // the callback is allowed to untrack the resource itself
+                if (m_entries[entryIndex].pResource == pResource)
+                    RemoveEntry(entryIndex);
+
+                m_categories[category].EvictionCount++;
+                freed += size;
+            }
+        }
+
+        entryIndex = nextEntryIndex;
+    }
+
+    return freed;
+}
+
+uint64 GPUMemoryTracker::EvictFromAll(uint64 bytesToFree)
+{
+    // repeatedly evict from whichever category holds the least recently used resource
+    uint64 freed = 0;
+    uint32 exhaustedCategoryMask = 0;
+    while (freed < bytesToFree)
+    {
+        uint32 oldestCategory = GPU_MEMORY_INVALID_CATEGORY;
+        uint32 oldestFrame = m_frameNumber;
+        for (uint32 i = 0; i < m_categories.GetSize(); i++)
+        {
+            if (exhaustedCategoryMask & (1u << i))
+                continue;
+
+            for (uint32 entryIndex = m_categories[i].Head; entryIndex != INVALID_ENTRY; entryIndex = m_entries[entryIndex].Next)
+            {
+                const Entry &entry = m_entries[entryIndex];
+                if (entry.LastUsedFrame >= oldestFrame)
+                    break;
+                if (entry.EvictionCallback != nullptr)
+                {
+                    oldestCategory = i;
+                    oldestFrame = entry.LastUsedFrame;
+                    break;
+                }
+            }
+        }
+        if (oldestCategory == GPU_MEMORY_INVALID_CATEGORY)
+            break;
+
+        // a single resource at a time, so the next-oldest category gets a turn
+        uint64 categoryFreed = EvictFromCategory(oldestCategory, 1);
+        if (categoryFreed == 0)
+            exhaustedCategoryMask |= (1u << oldestCategory);
+
+        freed += categoryFreed;
+    }
+
+    return freed;
+}
+
+uint64 GPUMemoryTracker::GetEvictableUsage(uint32 category) const
+{
+    uint64 usage = 0;
+    for (uint32 entryIndex = m_categories[category].Head; entryIndex != INVALID_ENTRY; entryIndex = m_entries[entryIndex].Next)
+    {
+        const Entry &entry = m_entries[entryIndex];
+        if (entry.LastUsedFrame == m_frameNumber)
+            break;
+        if (entry.EvictionCallback != nullptr)
+            usage += entry.Size;
+    }
+
+    return usage;
+}
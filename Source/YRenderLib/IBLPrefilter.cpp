@@ -0,0 +1,761 @@
+#include "YBaseLib/Assert.h"
+#include "YBaseLib/Math.h"
+#include "YBaseLib/Memory.h"
+#include "YBaseLib/Log.h"
+#include "YRenderLib/IBLPrefilter.h"
+#include <atomic>
+#include <cmath>
+#include <thread>
+Log_SetChannel(IBLPrefilter);
+
+// rows of a face handed to a thread at once
+static const uint32 ROWS_PER_WORK_ITEM = 8;
+
+// irradiance is low frequency, the source is box filtered down to this size before projecting
+static const uint32 MAX_SH_FACE_SIZE = 64;
+
+// most source texels along each axis averaged into one destination texel when converting equirectangular images
+static const uint32 MAX_EQUIRECTANGULAR_SUPERSAMPLE = 4;
+
+//------------------------------------------------------------------ IBLCubeMapData --------------------------------------------------------------------------------------------------
+
+static uint32 GetFullMipChainLength(uint32 size)
+{
+    uint32 mipLevels = 1;
+    while (size > 1)
+    {
+        size >>= 1;
+        mipLevels++;
+    }
+
+    return mipLevels;
+}
+
+static uint32 ResolveMipLevels(uint32 faceSize, uint32 mipLevels)
+{
+    uint32 fullChainLength = Min(GetFullMipChainLength(faceSize), (uint32)TEXTURE_MAX_MIPMAP_COUNT);
+    return (mipLevels == 0) ? fullChainLength : Min(mipLevels, fullChainLength);
+}
+
+IBLCubeMapData::IBLCubeMapData()
+    : m_format(PIXEL_FORMAT_UNKNOWN),
+      m_faceSize(0),
+      m_mipLevels(0),
+      m_pMemory(nullptr)
+{
+
+}
+
+IBLCubeMapData::~IBLCubeMapData()
+{
+    Destroy();
+}
+
+bool IBLCubeMapData::Create(PIXEL_FORMAT format, uint32 faceSize, uint32 mipLevels)
+{
+    Destroy();
+    if (faceSize == 0)
+    {
+        Log_ErrorPrintf("IBLCubeMapData::Create: Face size must be non-zero");
+        return false;
+    }
+
+    m_format = format;
+    m_faceSize = faceSize;
+    m_mipLevels = ResolveMipLevels(faceSize, mipLevels);
+
+    // one allocation for all subresources, pointers are filled in once the total is known
+    size_t totalSize = 0;
+    m_subresourceData.Resize(CUBEMAP_FACE_COUNT * m_mipLevels);
+    m_subresourcePitches.Resize(CUBEMAP_FACE_COUNT * m_mipLevels);
+    for (uint32 face = 0; face < CUBEMAP_FACE_COUNT; face++)
+    {
+        for (uint32 mipLevel = 0; mipLevel < m_mipLevels; mipLevel++)
+        {
+            uint32 mipSize = GetMipSize(mipLevel);
+            m_subresourceData[face * m_mipLevels + mipLevel] = reinterpret_cast<const void *>(totalSize);
+            m_subresourcePitches[face * m_mipLevels + mipLevel] = PixelFormat_CalculateRowPitch(format, mipSize);
+            totalSize += PixelFormat_CalculateImageSize(format, mipSize, mipSize, 1);
+        }
+    }
+
+    m_pMemory = reinterpret_cast<byte *>(Y_malloc(totalSize));
+    for (uint32 i = 0; i < m_subresourceData.GetSize(); i++)
+        m_subresourceData[i] = m_pMemory + reinterpret_cast<size_t>(m_subresourceData[i]);
+
+    return true;
+}
+
+void IBLCubeMapData::Destroy()
+{
+    Y_free(m_pMemory);
+    m_pMemory = nullptr;
+    m_subresourceData.Clear();
+    m_subresourcePitches.Clear();
+    m_format = PIXEL_FORMAT_UNKNOWN;
+    m_faceSize = 0;
+    m_mipLevels = 0;
+}
+
+void IBLCubeMapData::GetTextureDesc(GPU_TEXTURECUBE_DESC *pTextureDesc, uint32 flags) const
+{
+    pTextureDesc->Set(m_faceSize, m_faceSize, m_format, flags, m_mipLevels);
+}
+
+//------------------------------------------------------------------ Float cube maps ---------------------------------------------------------------------------------------------------
+
+// RGBA float working copy of a cube map, every face holds the full chain of levels back to back
+struct FloatCubeMap
+{
+    uint32 Size;
+    uint32 MipLevels;
+    uint32 LevelOffsets[TEXTURE_MAX_MIPMAP_COUNT];
+    size_t FaceStride;
+    float *pData;
+
+    FloatCubeMap() : Size(0), MipLevels(0), FaceStride(0), pData(nullptr) {}
+    ~FloatCubeMap() { Y_free(pData); }
+
+    void Create(uint32 size, uint32 mipLevels)
+    {
+        Size = size;
+        MipLevels = mipLevels;
+        FaceStride = 0;
+        for (uint32 mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+        {
+            uint32 mipSize = GetMipSize(mipLevel);
+            LevelOffsets[mipLevel] = static_cast<uint32>(FaceStride);
+            FaceStride += mipSize * mipSize * 4;
+        }
+
+        pData = Y_mallocT<float>(FaceStride * CUBEMAP_FACE_COUNT);
+    }
+
+    uint32 GetMipSize(uint32 mipLevel) const { return Max(Size >> mipLevel, (uint32)1); }
+    float *GetLevel(uint32 face, uint32 mipLevel) const { return pData + face * FaceStride + LevelOffsets[mipLevel]; }
+};
+
+// each destination texel is the average of the 2x2 texels above it, odd sizes drop the last row/column
+static void DownsampleLevel(float *pDestination, uint32 destinationSize, const float *pSource, uint32 sourceSize)
+{
+    uint32 step = (sourceSize > 1) ? 1 : 0;
+    for (uint32 y = 0; y < destinationSize; y++)
+    {
+        const float *pRow0 = pSource + (y * 2) * sourceSize * 4;
+        const float *pRow1 = pRow0 + step * sourceSize * 4;
+        float *pDestinationRow = pDestination + y * destinationSize * 4;
+        for (uint32 x = 0; x < destinationSize; x++)
+        {
+            const float *pTexel00 = pRow0 + (x * 2) * 4;
+            const float *pTexel01 = pRow1 + (x * 2) * 4;
+            for (uint32 c = 0; c < 4; c++)
+                pDestinationRow[x * 4 + c] = (pTexel00[c] + pTexel00[step * 4 + c] + pTexel01[c] + pTexel01[step * 4 + c]) * 0.25f;
+        }
+    }
+}
+
+static void GenerateMipLevels(const FloatCubeMap *pCubeMap, uint32 firstMipLevel)
+{
+    for (uint32 face = 0; face < CUBEMAP_FACE_COUNT; face++)
+    {
+        for (uint32 mipLevel = Max(firstMipLevel, (uint32)1); mipLevel < pCubeMap->MipLevels; mipLevel++)
+            DownsampleLevel(pCubeMap->GetLevel(face, mipLevel), pCubeMap->GetMipSize(mipLevel), pCubeMap->GetLevel(face, mipLevel - 1), pCubeMap->GetMipSize(mipLevel - 1));
+    }
+}
+
+static bool ValidateFormat(const char *functionName, PIXEL_FORMAT format)
+{
+    if (!PixelFormat_IsConvertible(format) || PixelFormat_GetPixelFormatInfo(format)->IsBlockCompressed)
+    {
+        Log_ErrorPrintf("%s: Unsupported format %s", functionName, PixelFormat_GetPixelFormatName(format));
+        return false;
+    }
+
+    return true;
+}
+
+// decodes the top level of a cube map and builds mipLevels levels from it
+static bool DecodeCubeMap(FloatCubeMap *pDestination, const IBLCubeMapData *pSource, uint32 mipLevels)
+{
+    pDestination->Create(pSource->GetFaceSize(), mipLevels);
+    for (uint32 face = 0; face < CUBEMAP_FACE_COUNT; face++)
+    {
+        if (!PixelFormat_DecodePixels(pSource->GetFaceSize(), pSource->GetFaceSize(), pSource->GetFaceData(static_cast<CUBEMAP_FACE>(face), 0), pSource->GetFacePitch(0),
+                                      pSource->GetFormat(), pDestination->GetLevel(face, 0)))
+        {
+            return false;
+        }
+    }
+
+    GenerateMipLevels(pDestination, 1);
+    return true;
+}
+
+static bool EncodeCubeMap(IBLCubeMapData *pDestination, PIXEL_FORMAT format, const FloatCubeMap *pSource)
+{
+    if (!pDestination->Create(format, pSource->Size, pSource->MipLevels))
+        return false;
+
+    for (uint32 face = 0; face < CUBEMAP_FACE_COUNT; face++)
+    {
+        for (uint32 mipLevel = 0; mipLevel < pSource->MipLevels; mipLevel++)
+        {
+            uint32 mipSize = pSource->GetMipSize(mipLevel);
+            if (!PixelFormat_EncodePixels(mipSize, mipSize, pSource->GetLevel(face, mipLevel), pDestination->GetFaceData(static_cast<CUBEMAP_FACE>(face), mipLevel),
+                                          pDestination->GetFacePitch(mipLevel), format))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------ Directions ------------------------------------------------------------------------------------------------------
+
+// u and v are in [-1, 1] across the face, increasing right and down
+static Vector3f GetFaceDirection(uint32 face, float u, float v)
+{
+    Vector3f direction;
+    switch (face)
+    {
+    case CUBEMAP_FACE_POSITIVE_X:   direction.Set(1.0f, -v, -u);    break;
+    case CUBEMAP_FACE_NEGATIVE_X:   direction.Set(-1.0f, -v, u);    break;
+    case CUBEMAP_FACE_POSITIVE_Y:   direction.Set(u, 1.0f, v);      break;
+    case CUBEMAP_FACE_NEGATIVE_Y:   direction.Set(u, -1.0f, -v);    break;
+    case CUBEMAP_FACE_POSITIVE_Z:   direction.Set(u, -v, 1.0f);     break;
+    default:                        direction.Set(-u, -v, -1.0f);   break;
+    }
+
+    return direction.Normalize();
+}
+
+static Vector3f GetTexelDirection(uint32 face, uint32 x, uint32 y, float invSize)
+{
+    return GetFaceDirection(face, (static_cast<float>(x) + 0.5f) * 2.0f * invSize - 1.0f, (static_cast<float>(y) + 0.5f) * 2.0f * invSize - 1.0f);
+}
+
+// inverse of GetFaceDirection, returns the face with u and v in [0, 1]
+static uint32 GetDirectionFace(const Vector3f &direction, float *pU, float *pV)
+{
+    float absX = Y_fabs(direction.x);
+    float absY = Y_fabs(direction.y);
+    float absZ = Y_fabs(direction.z);
+    uint32 face;
+    float u, v, majorAxis;
+    if (absX >= absY && absX >= absZ)
+    {
+        face = (direction.x >= 0.0f) ? CUBEMAP_FACE_POSITIVE_X : CUBEMAP_FACE_NEGATIVE_X;
+        u = (direction.x >= 0.0f) ? -direction.z : direction.z;
+        v = -direction.y;
+        majorAxis = absX;
+    }
+    else if (absY >= absZ)
+    {
+        face = (direction.y >= 0.0f) ? CUBEMAP_FACE_POSITIVE_Y : CUBEMAP_FACE_NEGATIVE_Y;
+        u = direction.x;
+        v = (direction.y >= 0.0f) ? direction.z : -direction.z;
+        majorAxis = absY;
+    }
+    else
+    {
+        face = (direction.z >= 0.0f) ? CUBEMAP_FACE_POSITIVE_Z : CUBEMAP_FACE_NEGATIVE_Z;
+        u = (direction.z >= 0.0f) ? direction.x : -direction.x;
+        v = -direction.y;
+        majorAxis = absZ;
+    }
+
+    float scale = 0.5f / majorAxis;
+    *pU = u * scale + 0.5f;
+    *pV = v * scale + 0.5f;
+    return face;
+}
+
+// solid angle of a face texel, from the area of its projection onto the unit sphere
+static float GetTexelSolidAngle(uint32 x, uint32 y, float invSize)
+{
+    float u = (static_cast<float>(x) + 0.5f) * 2.0f * invSize - 1.0f;
+    float v = (static_cast<float>(y) + 0.5f) * 2.0f * invSize - 1.0f;
+    float distanceSquared = 1.0f + u * u + v * v;
+    return (4.0f * invSize * invSize) / (distanceSquared * Y_sqrtf(distanceSquared));
+}
+
+//------------------------------------------------------------------ Sampling --------------------------------------------------------------------------------------------------------
+
+// edges clamp within the face rather than filtering across to the neighbouring face
+static void SampleBilinear(float *pResult, const float *pPixels, uint32 width, uint32 height, float s, float t, bool wrapHorizontal)
+{
+    s = s * static_cast<float>(width) - 0.5f;
+    t = Min(Max(t * static_cast<float>(height) - 0.5f, 0.0f), static_cast<float>(height - 1));
+    if (!wrapHorizontal)
+        s = Min(Max(s, 0.0f), static_cast<float>(width - 1));
+
+    float floorS = Y_floorf(s);
+    float floorT = Y_floorf(t);
+    float fracS = s - floorS;
+    float fracT = t - floorT;
+
+    int32 x0 = static_cast<int32>(floorS);
+    int32 x1 = x0 + 1;
+    if (wrapHorizontal)
+    {
+        x0 = (x0 % static_cast<int32>(width) + static_cast<int32>(width)) % static_cast<int32>(width);
+        x1 = (x0 + 1) % static_cast<int32>(width);
+    }
+    else
+    {
+        x1 = Min(x1, static_cast<int32>(width - 1));
+    }
+
+    uint32 y0 = static_cast<uint32>(floorT);
+    uint32 y1 = Min(y0 + 1, height - 1);
+
+    const float *pTexel00 = pPixels + (y0 * width + x0) * 4;
+    const float *pTexel10 = pPixels + (y0 * width + x1) * 4;
+    const float *pTexel01 = pPixels + (y1 * width + x0) * 4;
+    const float *pTexel11 = pPixels + (y1 * width + x1) * 4;
+    for (uint32 c = 0; c < 4; c++)
+    {
+        float top = pTexel00[c] + (pTexel10[c] - pTexel00[c]) * fracS;
+        float bottom = pTexel01[c] + (pTexel11[c] - pTexel01[c]) * fracS;
+        pResult[c] = top + (bottom - top) * fracT;
+    }
+}
+
+// trilinear lookup, lod is clamped to the available levels
+static void SampleCubeMap(float *pResult, const FloatCubeMap *pCubeMap, const Vector3f &direction, float lod)
+{
+    float u, v;
+    uint32 face = GetDirectionFace(direction, &u, &v);
+
+    lod = Min(Max(lod, 0.0f), static_cast<float>(pCubeMap->MipLevels - 1));
+    uint32 mipLevel = static_cast<uint32>(lod);
+    float fraction = lod - static_cast<float>(mipLevel);
+
+    uint32 mipSize = pCubeMap->GetMipSize(mipLevel);
+    SampleBilinear(pResult, pCubeMap->GetLevel(face, mipLevel), mipSize, mipSize, u, v, false);
+    if (fraction > 0.0f && (mipLevel + 1) < pCubeMap->MipLevels)
+    {
+        float nextResult[4];
+        uint32 nextMipSize = pCubeMap->GetMipSize(mipLevel + 1);
+        SampleBilinear(nextResult, pCubeMap->GetLevel(face, mipLevel + 1), nextMipSize, nextMipSize, u, v, false);
+        for (uint32 c = 0; c < 4; c++)
+            pResult[c] += (nextResult[c] - pResult[c]) * fraction;
+    }
+}
+
+//------------------------------------------------------------------ Threading -------------------------------------------------------------------------------------------------------
+
+struct FaceRowsWorkItem
+{
+    uint32 Face;
+    uint32 MipLevel;
+    uint32 FirstRow;
+    uint32 EndRow;
+};
+
+static void BuildWorkItems(PODArray<FaceRowsWorkItem> *pWorkItems, uint32 firstMipLevel, uint32 endMipLevel, uint32 faceSize)
+{
+    for (uint32 mipLevel = firstMipLevel; mipLevel < endMipLevel; mipLevel++)
+    {
+        uint32 mipSize = Max(faceSize >> mipLevel, (uint32)1);
+        for (uint32 face = 0; face < CUBEMAP_FACE_COUNT; face++)
+        {
+            for (uint32 firstRow = 0; firstRow < mipSize; firstRow += ROWS_PER_WORK_ITEM)
+            {
+                FaceRowsWorkItem workItem = { face, mipLevel, firstRow, Min(firstRow + ROWS_PER_WORK_ITEM, mipSize) };
+                pWorkItems->Add(workItem);
+            }
+        }
+    }
+}
+
+// Runs callback once for each item, items are claimed by whichever thread is free next so uneven costs
+// (e.g. rough levels taking more samples per texel) still balance.
+static void RunWorkItems(void(*callback)(void *, uint32), void *pContext, uint32 itemCount, uint32 threadCount)
+{
+    if (threadCount == 0)
+        threadCount = Max(std::thread::hardware_concurrency(), 1u);
+    threadCount = Max(Min(threadCount, itemCount), 1u);
+
+    std::atomic<uint32> nextItem(0);
+    auto worker = [callback, pContext, itemCount, &nextItem]()
+    {
+        for (uint32 itemIndex = nextItem++; itemIndex < itemCount; itemIndex = nextItem++)
+            callback(pContext, itemIndex);
+    };
+
+    PODArray<std::thread *> threads;
+    for (uint32 i = 1; i < threadCount; i++)
+        threads.Add(new std::thread(worker));
+
+    worker();
+
+    for (uint32 i = 0; i < threads.GetSize(); i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
+
+//------------------------------------------------------------------ Equirectangular -------------------------------------------------------------------------------------------------
+
+struct EquirectangularJob
+{
+    const float *pSource;
+    uint32 SourceWidth;
+    uint32 SourceHeight;
+    const FloatCubeMap *pDestination;
+    uint32 SamplesPerAxis;
+    const FaceRowsWorkItem *pWorkItems;
+};
+
+static void EquirectangularWorkItem(void *pContext, uint32 itemIndex)
+{
+    const EquirectangularJob *pJob = reinterpret_cast<const EquirectangularJob *>(pContext);
+    const FaceRowsWorkItem *pWorkItem = &pJob->pWorkItems[itemIndex];
+    uint32 faceSize = pJob->pDestination->Size;
+    uint32 samplesPerAxis = pJob->SamplesPerAxis;
+    float invSize = 1.0f / static_cast<float>(faceSize);
+    float sampleStep = 1.0f / static_cast<float>(samplesPerAxis);
+    float sampleWeight = sampleStep * sampleStep;
+
+    float *pRow = pJob->pDestination->GetLevel(pWorkItem->Face, 0) + pWorkItem->FirstRow * faceSize * 4;
+    for (uint32 y = pWorkItem->FirstRow; y < pWorkItem->EndRow; y++)
+    {
+        for (uint32 x = 0; x < faceSize; x++, pRow += 4)
+        {
+            float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for (uint32 sy = 0; sy < samplesPerAxis; sy++)
+            {
+                float v = (static_cast<float>(y) + (static_cast<float>(sy) + 0.5f) * sampleStep) * 2.0f * invSize - 1.0f;
+                for (uint32 sx = 0; sx < samplesPerAxis; sx++)
+                {
+                    float u = (static_cast<float>(x) + (static_cast<float>(sx) + 0.5f) * sampleStep) * 2.0f * invSize - 1.0f;
+                    Vector3f direction(GetFaceDirection(pWorkItem->Face, u, v));
+
+                    float longitude = 0.5f + atan2f(direction.x, direction.z) * (0.5f / Y_PI);
+                    float latitude = acosf(Min(Max(direction.y, -1.0f), 1.0f)) * (1.0f / Y_PI);
+
+                    float sample[4];
+                    SampleBilinear(sample, pJob->pSource, pJob->SourceWidth, pJob->SourceHeight, longitude, latitude, true);
+                    for (uint32 c = 0; c < 4; c++)
+                        sum[c] += sample[c];
+                }
+            }
+
+            for (uint32 c = 0; c < 4; c++)
+                pRow[c] = sum[c] * sampleWeight;
+        }
+    }
+}
+
+bool IBLPrefilter::EquirectangularToCubeMap(IBLCubeMapData *pDestination, PIXEL_FORMAT destinationFormat, uint32 faceSize, uint32 mipLevels,
+                                            const void *pSourcePixels, uint32 sourceWidth, uint32 sourceHeight, uint32 sourcePitch, PIXEL_FORMAT sourceFormat,
+                                            uint32 threadCount /* = 0 */)
+{
+    if (!ValidateFormat("IBLPrefilter::EquirectangularToCubeMap", sourceFormat) || !ValidateFormat("IBLPrefilter::EquirectangularToCubeMap", destinationFormat))
+        return false;
+    if (faceSize == 0 || sourceWidth == 0 || sourceHeight == 0)
+    {
+        Log_ErrorPrintf("IBLPrefilter::EquirectangularToCubeMap: Invalid dimensions");
+        return false;
+    }
+
+    float *pSource = Y_mallocT<float>(sourceWidth * sourceHeight * 4);
+    if (!PixelFormat_DecodePixels(sourceWidth, sourceHeight, pSourcePixels, sourcePitch, sourceFormat, pSource))
+    {
+        Y_free(pSource);
+        return false;
+    }
+
+    FloatCubeMap cubeMap;
+    cubeMap.Create(faceSize, ResolveMipLevels(faceSize, mipLevels));
+
+    // a face spans a quarter of the source's width
+    uint32 sourceTexelsPerTexel = (sourceWidth + faceSize * 4 - 1) / (faceSize * 4);
+
+    PODArray<FaceRowsWorkItem> workItems;
+    BuildWorkItems(&workItems, 0, 1, faceSize);
+
+    EquirectangularJob job;
+    job.pSource = pSource;
+    job.SourceWidth = sourceWidth;
+    job.SourceHeight = sourceHeight;
+    job.pDestination = &cubeMap;
+    job.SamplesPerAxis = Min(Max(sourceTexelsPerTexel, (uint32)1), MAX_EQUIRECTANGULAR_SUPERSAMPLE);
+    job.pWorkItems = workItems.GetBasePointer();
+    RunWorkItems(EquirectangularWorkItem, &job, workItems.GetSize(), threadCount);
+    Y_free(pSource);
+
+    GenerateMipLevels(&cubeMap, 1);
+    return EncodeCubeMap(pDestination, destinationFormat, &cubeMap);
+}
+
+//------------------------------------------------------------------ Irradiance ------------------------------------------------------------------------------------------------------
+
+static void EvaluateSHBasis(float *pBasis, const Vector3f &direction)
+{
+    float x = direction.x;
+    float y = direction.y;
+    float z = direction.z;
+    pBasis[0] = 0.282095f;
+    pBasis[1] = 0.488603f * y;
+    pBasis[2] = 0.488603f * z;
+    pBasis[3] = 0.488603f * x;
+    pBasis[4] = 1.092548f * x * y;
+    pBasis[5] = 1.092548f * y * z;
+    pBasis[6] = 0.315392f * (3.0f * z * z - 1.0f);
+    pBasis[7] = 1.092548f * x * z;
+    pBasis[8] = 0.546274f * (x * x - y * y);
+}
+
+struct IrradianceJob
+{
+    const FloatCubeMap *pSource;
+    uint32 MipLevel;
+    double FaceSums[CUBEMAP_FACE_COUNT][9][3];
+    double FaceWeights[CUBEMAP_FACE_COUNT];
+};
+
+static void IrradianceWorkItem(void *pContext, uint32 face)
+{
+    // each face accumulates into its own slot, summed once every face is done
+    IrradianceJob *pJob = reinterpret_cast<IrradianceJob *>(pContext);
+    uint32 mipSize = pJob->pSource->GetMipSize(pJob->MipLevel);
+    const float *pTexel = pJob->pSource->GetLevel(face, pJob->MipLevel);
+    float invSize = 1.0f / static_cast<float>(mipSize);
+
+    double sums[9][3] = {};
+    double weight = 0.0;
+    for (uint32 y = 0; y < mipSize; y++)
+    {
+        for (uint32 x = 0; x < mipSize; x++, pTexel += 4)
+        {
+            float basis[9];
+            EvaluateSHBasis(basis, GetTexelDirection(face, x, y, invSize));
+
+            float solidAngle = GetTexelSolidAngle(x, y, invSize);
+            for (uint32 i = 0; i < 9; i++)
+            {
+                float scale = basis[i] * solidAngle;
+                sums[i][0] += pTexel[0] * scale;
+                sums[i][1] += pTexel[1] * scale;
+                sums[i][2] += pTexel[2] * scale;
+            }
+
+            weight += solidAngle;
+        }
+    }
+
+    Y_memcpy(pJob->FaceSums[face], sums, sizeof(sums));
+    pJob->FaceWeights[face] = weight;
+}
+
+bool IBLPrefilter::ComputeIrradianceSH(IBL_SH9 *pIrradiance, const IBLCubeMapData *pSource, uint32 threadCount /* = 0 */)
+{
+    if (!ValidateFormat("IBLPrefilter::ComputeIrradianceSH", pSource->GetFormat()))
+        return false;
+
+    // only the level nearest MAX_SH_FACE_SIZE is projected
+    uint32 mipLevels = 1;
+    while (Max(pSource->GetFaceSize() >> (mipLevels - 1), (uint32)1) > MAX_SH_FACE_SIZE)
+        mipLevels++;
+
+    FloatCubeMap cubeMap;
+    if (!DecodeCubeMap(&cubeMap, pSource, mipLevels))
+        return false;
+
+    IrradianceJob job;
+    job.pSource = &cubeMap;
+    job.MipLevel = mipLevels - 1;
+    RunWorkItems(IrradianceWorkItem, &job, CUBEMAP_FACE_COUNT, threadCount);
+
+    double sums[9][3] = {};
+    double totalWeight = 0.0;
+    for (uint32 face = 0; face < CUBEMAP_FACE_COUNT; face++)
+    {
+        for (uint32 i = 0; i < 9; i++)
+        {
+            for (uint32 c = 0; c < 3; c++)
+                sums[i][c] += job.FaceSums[face][i][c];
+        }
+
+        totalWeight += job.FaceWeights[face];
+    }
+
+    // renormalize so the texel solid angles sum to exactly 4pi, then convolve with the clamped cosine lobe
+    static const float bandScales[9] = { Y_PI, 2.0f * Y_PI / 3.0f, 2.0f * Y_PI / 3.0f, 2.0f * Y_PI / 3.0f, Y_PI / 4.0f, Y_PI / 4.0f, Y_PI / 4.0f, Y_PI / 4.0f, Y_PI / 4.0f };
+    double normalization = (4.0 * Y_PI) / totalWeight;
+    for (uint32 i = 0; i < 9; i++)
+    {
+        float scale = static_cast<float>(normalization) * bandScales[i];
+        pIrradiance->Coefficients[i].Set(static_cast<float>(sums[i][0]) * scale, static_cast<float>(sums[i][1]) * scale, static_cast<float>(sums[i][2]) * scale);
+    }
+
+    return true;
+}
+
+Vector3f IBLPrefilter::EvaluateIrradianceSH(const IBL_SH9 *pIrradiance, const Vector3f &normal)
+{
+    float basis[9];
+    EvaluateSHBasis(basis, normal);
+
+    Vector3f result(pIrradiance->Coefficients[0] * basis[0]);
+    for (uint32 i = 1; i < 9; i++)
+        result += pIrradiance->Coefficients[i] * basis[i];
+
+    return result;
+}
+
+//------------------------------------------------------------------ Specular --------------------------------------------------------------------------------------------------------
+
+// light direction in the tangent space of the normal (z), its cosine weight, and the source lod to read it from
+struct SpecularSample
+{
+    Vector3f Direction;
+    float Weight;
+    float Lod;
+};
+
+static float RadicalInverse(uint32 bits)
+{
+    bits = (bits << 16) | (bits >> 16);
+    bits = ((bits & 0x55555555u) << 1) | ((bits & 0xAAAAAAAAu) >> 1);
+    bits = ((bits & 0x33333333u) << 2) | ((bits & 0xCCCCCCCCu) >> 2);
+    bits = ((bits & 0x0F0F0F0Fu) << 4) | ((bits & 0xF0F0F0F0u) >> 4);
+    bits = ((bits & 0x00FF00FFu) << 8) | ((bits & 0xFF00FF00u) >> 8);
+    return static_cast<float>(bits) * 2.3283064365386963e-10f;
+}
+
+// Importance samples GGX with view = normal, so the sample set is the same for every texel of a level and only needs
+// rotating into each texel's frame. Samples are read from the source level whose texels cover about the same solid angle
+// as the sample does (filtered importance sampling), biased up one level to smooth the remaining noise.
+static void BuildSpecularSamples(PODArray<SpecularSample> *pSamples, float roughness, uint32 sampleCount, uint32 sourceSize)
+{
+    float alpha = roughness * roughness;
+    float alphaSquared = alpha * alpha;
+    float texelSolidAngle = (4.0f * Y_PI) / (6.0f * static_cast<float>(sourceSize) * static_cast<float>(sourceSize));
+
+    pSamples->Clear();
+    float totalWeight = 0.0f;
+    for (uint32 i = 0; i < sampleCount; i++)
+    {
+        float phi = 2.0f * Y_PI * (static_cast<float>(i) + 0.5f) / static_cast<float>(sampleCount);
+        float xi = RadicalInverse(i);
+        float cosTheta = Y_sqrtf((1.0f - xi) / (1.0f + (alphaSquared - 1.0f) * xi));
+        float sinTheta = Y_sqrtf(Max(1.0f - cosTheta * cosTheta, 0.0f));
+        Vector3f halfVector(sinTheta * cosf(phi), sinTheta * sinf(phi), cosTheta);
+
+        // reflect the normal about the half vector
+        Vector3f lightDirection(halfVector * (2.0f * cosTheta) - Vector3f(0.0f, 0.0f, 1.0f));
+        if (lightDirection.z <= 0.0f)
+            continue;
+
+        // pdf of the light direction is D(h) * (n.h) / (4 * v.h), with v = n that is D(h) / 4
+        float denominator = cosTheta * cosTheta * (alphaSquared - 1.0f) + 1.0f;
+        float pdf = alphaSquared / (4.0f * Y_PI * denominator * denominator);
+        float sampleSolidAngle = 1.0f / (static_cast<float>(sampleCount) * pdf);
+
+        SpecularSample sample;
+        sample.Direction = lightDirection;
+        sample.Weight = lightDirection.z;
+        sample.Lod = Max(0.5f * log2f(sampleSolidAngle / texelSolidAngle) + 1.0f, 0.0f);
+        pSamples->Add(sample);
+        totalWeight += sample.Weight;
+    }
+
+    for (uint32 i = 0; i < pSamples->GetSize(); i++)
+        (*pSamples)[i].Weight /= totalWeight;
+}
+
+struct SpecularJob
+{
+    const FloatCubeMap *pSource;
+    const FloatCubeMap *pDestination;
+    const PODArray<SpecularSample> *pLevelSamples;
+    const FaceRowsWorkItem *pWorkItems;
+};
+
+static void SpecularWorkItem(void *pContext, uint32 itemIndex)
+{
+    const SpecularJob *pJob = reinterpret_cast<const SpecularJob *>(pContext);
+    const FaceRowsWorkItem *pWorkItem = &pJob->pWorkItems[itemIndex];
+    const PODArray<SpecularSample> &samples = pJob->pLevelSamples[pWorkItem->MipLevel];
+    uint32 mipSize = pJob->pDestination->GetMipSize(pWorkItem->MipLevel);
+    float invSize = 1.0f / static_cast<float>(mipSize);
+
+    float *pRow = pJob->pDestination->GetLevel(pWorkItem->Face, pWorkItem->MipLevel) + pWorkItem->FirstRow * mipSize * 4;
+    for (uint32 y = pWorkItem->FirstRow; y < pWorkItem->EndRow; y++)
+    {
+        for (uint32 x = 0; x < mipSize; x++, pRow += 4)
+        {
+            Vector3f normal(GetTexelDirection(pWorkItem->Face, x, y, invSize));
+            Vector3f up((Y_fabs(normal.z) < 0.999f) ? Vector3f(0.0f, 0.0f, 1.0f) : Vector3f(1.0f, 0.0f, 0.0f));
+            Vector3f tangent(up.Cross(normal).Normalize());
+            Vector3f bitangent(normal.Cross(tangent));
+
+            float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for (uint32 i = 0; i < samples.GetSize(); i++)
+            {
+                const SpecularSample &sample = samples[i];
+                Vector3f direction(tangent * sample.Direction.x + bitangent * sample.Direction.y + normal * sample.Direction.z);
+
+                float value[4];
+                SampleCubeMap(value, pJob->pSource, direction, sample.Lod);
+                for (uint32 c = 0; c < 4; c++)
+                    sum[c] += value[c] * sample.Weight;
+            }
+
+            for (uint32 c = 0; c < 4; c++)
+                pRow[c] = sum[c];
+        }
+    }
+}
+
+float IBLPrefilter::GetMipRoughness(uint32 mipLevel, uint32 mipLevels)
+{
+    return (mipLevels > 1) ? (static_cast<float>(mipLevel) / static_cast<float>(mipLevels - 1)) : 0.0f;
+}
+
+bool IBLPrefilter::PrefilterSpecular(IBLCubeMapData *pDestination, PIXEL_FORMAT destinationFormat, uint32 faceSize, uint32 mipLevels,
+                                     const IBLCubeMapData *pSource, uint32 sampleCount /* = 256 */, uint32 threadCount /* = 0 */)
+{
+    if (!ValidateFormat("IBLPrefilter::PrefilterSpecular", pSource->GetFormat()) || !ValidateFormat("IBLPrefilter::PrefilterSpecular", destinationFormat))
+        return false;
+    if (faceSize == 0 || sampleCount == 0)
+    {
+        Log_ErrorPrintf("IBLPrefilter::PrefilterSpecular: Invalid face size or sample count");
+        return false;
+    }
+
+    FloatCubeMap sourceCubeMap;
+    if (!DecodeCubeMap(&sourceCubeMap, pSource, ResolveMipLevels(pSource->GetFaceSize(), 0)))
+        return false;
+
+    FloatCubeMap cubeMap;
+    cubeMap.Create(faceSize, ResolveMipLevels(faceSize, mipLevels));
+
+    // the mirror-like first level is a plain resample of the source
+    PODArray<SpecularSample> levelSamples[TEXTURE_MAX_MIPMAP_COUNT];
+    SpecularSample mirrorSample;
+    mirrorSample.Direction.Set(0.0f, 0.0f, 1.0f);
+    mirrorSample.Weight = 1.0f;
+    mirrorSample.Lod = 0.0f;
+    levelSamples[0].Add(mirrorSample);
+    for (uint32 mipLevel = 1; mipLevel < cubeMap.MipLevels; mipLevel++)
+        BuildSpecularSamples(&levelSamples[mipLevel], GetMipRoughness(mipLevel, cubeMap.MipLevels), sampleCount, sourceCubeMap.Size);
+
+    PODArray<FaceRowsWorkItem> workItems;
+    BuildWorkItems(&workItems, 0, cubeMap.MipLevels, faceSize);
+
+    SpecularJob job;
+    job.pSource = &sourceCubeMap;
+    job.pDestination = &cubeMap;
+    job.pLevelSamples = levelSamples;
+    job.pWorkItems = workItems.GetBasePointer();
+    RunWorkItems(SpecularWorkItem, &job, workItems.GetSize(), threadCount);
+
+    return EncodeCubeMap(pDestination, destinationFormat, &cubeMap);
+}
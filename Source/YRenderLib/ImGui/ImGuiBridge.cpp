@@ -1,10 +1,13 @@
 #include <SDL.h>
 #include "YBaseLib/AutoReleasePtr.h"
 #include "YBaseLib/ByteStream.h"
+#include "YBaseLib/FileSystem.h"
 #include "YBaseLib/Log.h"
+#include "YBaseLib/PODArray.h"
 #include "YBaseLib/StringConverter.h"
 #include "YBaseLib/Timer.h"
 #include "YRenderLib/ImGui/ImGuiBridge.h"
+#include "YRenderLib/ImGui/imgui/stb_rect_pack.h"
 #include "YRenderLib/Renderer.h"
 #include "YRenderLib/ShaderCompiler/ShaderCompiler.h"
 Log_SetChannel(ImGuiBridge);
@@ -16,110 +19,290 @@ static GPUDepthStencilState* s_pDepthStencilState = nullptr;
 static GPUBlendState* s_pBlendState = nullptr;
 static GPUInputLayout* s_pInputLayout = nullptr;
 static GPUShaderProgram* s_pShaderProgram = nullptr;
-static GPUBuffer* s_pVertexBuffer = nullptr;
-static GPUBuffer* s_pIndexBuffer = nullptr;
-static uint32 s_vertexBufferSize = 0;
-static uint32 s_indexBufferSize = 0;
+static GPUShaderProgram* s_pFontShaderProgram = nullptr;
 static bool s_supportsBaseVertex = false;
 static Timer s_lastFrameTime;
-
-static void RenderDrawListsCallback(ImDrawData *pDrawData)
+static String s_fontCacheFileName;
+static GPUTexture2D* s_pFontTexture = nullptr;
+static PIXEL_FORMAT s_fontTextureFormat = PIXEL_FORMAT_R8_UNORM;
+static PODArray<byte> s_fontTexturePixels;          // alpha8 copy of the uploaded atlas, which survives AddFont()
+static uint32 s_fontTextureWidth = 0;
+static uint32 s_fontTextureHeight = 0;
+static uint32 s_fontAtlasUsedHeight = 0;            // rows holding glyphs, the ones below are free
+static uint32 s_fontAtlasConfigCount = 0;           // io.Fonts->ConfigData entries rasterized into the texture
+
+// Vertex/index data is streamed through ring buffers: each frame appends after the previous one with
+// NO_OVERWRITE, and the buffer is only discarded when it wraps. Buffers are sized for the frame latency
+// plus one so a discard happens at most once every few frames, and shrunk if they stay mostly unused.
+struct StreamBuffer
 {
-    // check buffer size
-    if ((uint32)pDrawData->TotalVtxCount > s_vertexBufferSize)
-    {
-        uint32 newVertexCount = Max((s_vertexBufferSize != 0) ? (s_vertexBufferSize * 2) : 1024, (uint32)pDrawData->TotalVtxCount);
-        Log_PerfPrintf("Reallocating ImGui vertex buffer, new count = %u (%s)", newVertexCount, StringConverter::SizeToHumanReadableString(newVertexCount * sizeof(ImDrawVert)).GetCharArray());
+    GPUBuffer *pBuffer;
+    const char *Name;
+    uint32 BindFlags;
+    uint32 ElementSize;
+    uint32 Capacity;                // in elements
+    uint32 Position;                // next free element
+    uint32 PeakUsage;               // largest per-frame request since the last shrink check
+};
+static StreamBuffer s_vertexStream = { nullptr, "vertex", GPU_BUFFER_FLAG_BIND_VERTEX_BUFFER, sizeof(ImDrawVert), 0, 0, 0 };
+static StreamBuffer s_indexStream = { nullptr, "index", GPU_BUFFER_FLAG_BIND_INDEX_BUFFER, sizeof(ImDrawIdx), 0, 0, 0 };
+static uint32 s_frameLatency = 3;
+static uint32 s_framesSinceShrinkCheck = 0;
+static const uint32 STREAM_BUFFER_MIN_SIZE = 1024;
+static const uint32 STREAM_BUFFER_SHRINK_CHECK_INTERVAL = 600;
+
+// a run of adjacent ImDrawCmds sharing texture, clip rect and base vertex, or a single user callback
+struct DrawBatch
+{
+    RENDERER_SCISSOR_RECT ScissorRect;
+    ImTextureID TextureId;
+    const ImDrawList *pCallbackCmdList;
+    const ImDrawCmd *pCallbackCmd;
+    uint32 FirstIndex;
+    uint32 IndexCount;
+    uint32 BaseVertex;
+};
+static PODArray<DrawBatch> s_drawBatches;
+
+// Coalesces the frame's commands into batches. When flattenIndices is set, indices have been rebased
+// into one shared vertex range, so commands from different draw lists can be merged as well.
+static void BuildDrawBatches(const ImDrawData *pDrawData, bool flattenIndices)
+{
+    const ImGuiIO &io = ImGui::GetIO();
+    s_drawBatches.Clear();
 
-        GPU_BUFFER_DESC bufferDesc(GPU_BUFFER_FLAG_BIND_VERTEX_BUFFER, newVertexCount * sizeof(ImDrawVert));
-        if (s_pGPUDevice->GetFeatureLevel() >= RENDERER_FEATURE_LEVEL_ES3)
-            bufferDesc.Flags |= GPU_BUFFER_FLAG_MAPPABLE;
-        else
-            bufferDesc.Flags |= GPU_BUFFER_FLAG_WRITABLE;
+    uint32 baseVertex = 0;
+    uint32 baseIndex = 0;
+    for (int i = 0; i < pDrawData->CmdListsCount; i++)
+    {
+        const ImDrawList *pCmdList = pDrawData->CmdLists[i];
+        uint32 batchBaseVertex = (flattenIndices) ? 0 : baseVertex;
 
-        GPUBuffer *pNewVertexBuffer = s_pGPUDevice->CreateBuffer(&bufferDesc, nullptr);
-        if (pNewVertexBuffer == nullptr)
+        for (int j = 0; j < pCmdList->CmdBuffer.size(); j++)
         {
-            Log_ErrorPrint("Failed to allocate ImGui vertex buffer.");
-            return;
+            const ImDrawCmd *pCmd = &pCmdList->CmdBuffer[j];
+            uint32 firstIndex = baseIndex;
+            baseIndex += pCmd->ElemCount;
+
+            if (pCmd->UserCallback != nullptr)
+            {
+                DrawBatch callbackBatch;
+                Y_memzero(&callbackBatch, sizeof(callbackBatch));
+                callbackBatch.pCallbackCmdList = pCmdList;
+                callbackBatch.pCallbackCmd = pCmd;
+                s_drawBatches.Add(callbackBatch);
+                continue;
+            }
+
+            // clamp the clip rect to the display, negative values would wrap around as unsigned
+            uint32 left = (uint32)Max(pCmd->ClipRect.x, 0.0f);
+            uint32 top = (uint32)Max(pCmd->ClipRect.y, 0.0f);
+            uint32 right = (uint32)Min(Max(pCmd->ClipRect.z, 0.0f), io.DisplaySize.x);
+            uint32 bottom = (uint32)Min(Max(pCmd->ClipRect.w, 0.0f), io.DisplaySize.y);
+            if (pCmd->ElemCount == 0 || right <= left || bottom <= top)
+                continue;
+
+            // extend the previous batch if nothing but the index count changes
+            if (s_drawBatches.GetSize() > 0)
+            {
+                DrawBatch &lastBatch = s_drawBatches[s_drawBatches.GetSize() - 1];
+                if (lastBatch.pCallbackCmd == nullptr &&
+                    lastBatch.TextureId == pCmd->TextureId &&
+                    lastBatch.BaseVertex == batchBaseVertex &&
+                    (lastBatch.FirstIndex + lastBatch.IndexCount) == firstIndex &&
+                    lastBatch.ScissorRect.Left == left && lastBatch.ScissorRect.Top == top &&
+                    lastBatch.ScissorRect.Right == right && lastBatch.ScissorRect.Bottom == bottom)
+                {
+                    lastBatch.IndexCount += pCmd->ElemCount;
+                    continue;
+                }
+            }
+
+            DrawBatch batch;
+            batch.ScissorRect.Set(left, top, right, bottom);
+            batch.TextureId = pCmd->TextureId;
+            batch.pCallbackCmdList = nullptr;
+            batch.pCallbackCmd = nullptr;
+            batch.FirstIndex = firstIndex;
+            batch.IndexCount = pCmd->ElemCount;
+            batch.BaseVertex = batchBaseVertex;
+            s_drawBatches.Add(batch);
         }
 
-        if (s_pVertexBuffer != nullptr)
-            s_pVertexBuffer->Release();
+        baseVertex += pCmdList->VtxBuffer.size();
+    }
+}
+
+// copies indices, offsetting them into the combined vertex buffer when flattening
+static void CopyIndices(ImDrawIdx *pDestination, const ImDrawIdx *pSource, uint32 count, uint32 baseVertex)
+{
+    if (baseVertex == 0)
+    {
+        Y_memcpy(pDestination, pSource, sizeof(ImDrawIdx) * count);
+        return;
+    }
+
+    for (uint32 i = 0; i < count; i++)
+        pDestination[i] = (ImDrawIdx)(pSource[i] + baseVertex);
+}
+
+// smallest power of two holding count elements for every frame that can be in flight
+static uint32 GetStreamBufferSize(uint32 count)
+{
+    uint32 requiredSize = count * (s_frameLatency + 1);
+    uint32 size = STREAM_BUFFER_MIN_SIZE;
+    while (size < requiredSize)
+        size *= 2;
+
+    return size;
+}
+
+// replaces the stream's buffer, the old one is kept if creation fails
+static bool ResizeStreamBuffer(StreamBuffer *pStream, uint32 newCapacity)
+{
+    Log_PerfPrintf("Reallocating ImGui %s buffer, new count = %u (%s)", pStream->Name, newCapacity, StringConverter::SizeToHumanReadableString(newCapacity * pStream->ElementSize).GetCharArray());
 
-        s_pVertexBuffer = pNewVertexBuffer;
-        s_vertexBufferSize = newVertexCount;
+    GPU_BUFFER_DESC bufferDesc(pStream->BindFlags, newCapacity * pStream->ElementSize);
+    if (s_pGPUDevice->GetFeatureLevel() >= RENDERER_FEATURE_LEVEL_ES3)
+        bufferDesc.Flags |= GPU_BUFFER_FLAG_MAPPABLE;
+    else
+        bufferDesc.Flags |= GPU_BUFFER_FLAG_WRITABLE;
+
+    GPUBuffer *pNewBuffer = s_pGPUDevice->CreateBuffer(&bufferDesc, nullptr);
+    if (pNewBuffer == nullptr)
+    {
+        Log_ErrorPrintf("Failed to allocate ImGui %s buffer.", pStream->Name);
+        return false;
     }
-    if ((uint32)pDrawData->TotalIdxCount > s_indexBufferSize)
+
+    if (pStream->pBuffer != nullptr)
+        pStream->pBuffer->Release();
+
+    pStream->pBuffer = pNewBuffer;
+    pStream->Capacity = newCapacity;
+    pStream->Position = 0;
+    return true;
+}
+
+// Reserves count contiguous elements in the stream. Appending can use NO_OVERWRITE as in-flight frames only
+// read earlier regions, wrapping back to the start has to discard instead.
+static bool ReserveStreamSpace(StreamBuffer *pStream, uint32 count, uint32 *pOffset, GPU_MAP_TYPE *pMapType)
+{
+    pStream->PeakUsage = Max(pStream->PeakUsage, count);
+    if (count > pStream->Capacity && !ResizeStreamBuffer(pStream, GetStreamBufferSize(count)))
+        return false;
+
+    if (pStream->Position == 0 || (pStream->Position + count) > pStream->Capacity)
     {
-        uint32 newIndexCount = Max((s_indexBufferSize != 0) ? (s_indexBufferSize * 2) : 1024, (uint32)pDrawData->TotalIdxCount);
-        Log_PerfPrintf("Reallocating ImGui index buffer, new count = %u (%s)", newIndexCount, StringConverter::SizeToHumanReadableString(newIndexCount * sizeof(ImDrawIdx)).GetCharArray());
+        *pOffset = 0;
+        *pMapType = GPU_MAP_TYPE_WRITE_DISCARD;
+    }
+    else
+    {
+        *pOffset = pStream->Position;
+        *pMapType = GPU_MAP_TYPE_WRITE_NO_OVERWRITE;
+    }
 
-        GPU_BUFFER_DESC bufferDesc(GPU_BUFFER_FLAG_BIND_INDEX_BUFFER, newIndexCount * sizeof(ImDrawIdx));
-        if (s_pGPUDevice->GetFeatureLevel() >= RENDERER_FEATURE_LEVEL_ES3)
-            bufferDesc.Flags |= GPU_BUFFER_FLAG_MAPPABLE;
-        else
-            bufferDesc.Flags |= GPU_BUFFER_FLAG_WRITABLE;
+    pStream->Position = *pOffset + count;
+    return true;
+}
 
-        GPUBuffer *pNewIndexBuffer = s_pGPUDevice->CreateBuffer(&bufferDesc, nullptr);
-        if (pNewIndexBuffer == nullptr)
-        {
-            Log_ErrorPrint("Failed to allocate ImGui index buffer.");
-            return;
-        }
+// drop back down after a spike, e.g. a large debug window that has since been closed
+static void ShrinkStreamBuffer(StreamBuffer *pStream)
+{
+    uint32 requiredSize = GetStreamBufferSize(pStream->PeakUsage);
+    if (pStream->Capacity >= requiredSize * 4)
+        ResizeStreamBuffer(pStream, requiredSize);
+
+    pStream->PeakUsage = 0;
+}
+
+static void RenderDrawListsCallback(ImDrawData *pDrawData)
+{
+    uint32 totalVertexCount = (uint32)pDrawData->TotalVtxCount;
+    uint32 totalIndexCount = (uint32)pDrawData->TotalIdxCount;
+    if (totalVertexCount == 0 || totalIndexCount == 0)
+        return;
 
-        if (s_pIndexBuffer != nullptr)
-            s_pIndexBuffer->Release();
+    if ((++s_framesSinceShrinkCheck) >= STREAM_BUFFER_SHRINK_CHECK_INTERVAL)
+    {
+        ShrinkStreamBuffer(&s_vertexStream);
+        ShrinkStreamBuffer(&s_indexStream);
+        s_framesSinceShrinkCheck = 0;
+    }
 
-        s_pIndexBuffer = pNewIndexBuffer;
-        s_indexBufferSize = newIndexCount;
+    // find space for this frame's data
+    uint32 frameVertexOffset, frameIndexOffset;
+    GPU_MAP_TYPE vertexMapType, indexMapType;
+    if (!ReserveStreamSpace(&s_vertexStream, totalVertexCount, &frameVertexOffset, &vertexMapType) ||
+        !ReserveStreamSpace(&s_indexStream, totalIndexCount, &frameIndexOffset, &indexMapType))
+    {
+        return;
     }
 
+    // if every vertex is addressable with 16-bit indices, rebase the indices so the whole frame shares one
+    // vertex range, this lets batches span draw lists and avoids rebinding buffers without base vertex support
+    bool flattenIndices = (totalVertexCount <= ((uint32)1 << (sizeof(ImDrawIdx) * 8)));
+
     // write to buffers
     if (s_pGPUDevice->GetFeatureLevel() >= RENDERER_FEATURE_LEVEL_ES3)
     {
         ImDrawVert *pMappedVertexBuffer;
-        if (!s_pGPUContext->MapBuffer(s_pVertexBuffer, GPU_MAP_TYPE_WRITE_DISCARD, reinterpret_cast<void **>(&pMappedVertexBuffer)))
+        if (!s_pGPUContext->MapBuffer(s_vertexStream.pBuffer, vertexMapType, reinterpret_cast<void **>(&pMappedVertexBuffer)))
         {
             Log_ErrorPrint("Failed to map ImGui vertex buffer");
             return;
         }
 
         ImDrawIdx *pMappedIndexBuffer;
-        if (!s_pGPUContext->MapBuffer(s_pIndexBuffer, GPU_MAP_TYPE_WRITE_DISCARD, reinterpret_cast<void **>(&pMappedIndexBuffer)))
+        if (!s_pGPUContext->MapBuffer(s_indexStream.pBuffer, indexMapType, reinterpret_cast<void **>(&pMappedIndexBuffer)))
         {
-            s_pGPUContext->Unmapbuffer(s_pVertexBuffer, pMappedVertexBuffer);
+            s_pGPUContext->Unmapbuffer(s_vertexStream.pBuffer, pMappedVertexBuffer);
             Log_ErrorPrint("Failed to map ImGui index buffer");
             return;
         }
 
         // copy vertices in
-        ImDrawVert *pCurrentVertex = pMappedVertexBuffer;
-        ImDrawIdx *pCurrentIndex = pMappedIndexBuffer;
+        ImDrawVert *pCurrentVertex = pMappedVertexBuffer + frameVertexOffset;
+        ImDrawIdx *pCurrentIndex = pMappedIndexBuffer + frameIndexOffset;
+        uint32 baseVertex = 0;
         for (int i = 0; i < pDrawData->CmdListsCount; i++)
         {
-            Y_memcpy(pCurrentVertex, pDrawData->CmdLists[i]->VtxBuffer.Data, pDrawData->CmdLists[i]->VtxBuffer.size() * sizeof(ImDrawVert));
-            Y_memcpy(pCurrentIndex, pDrawData->CmdLists[i]->IdxBuffer.Data, pDrawData->CmdLists[i]->IdxBuffer.size() * sizeof(ImDrawIdx));
-            pCurrentVertex += pDrawData->CmdLists[i]->VtxBuffer.size();
-            pCurrentIndex += pDrawData->CmdLists[i]->IdxBuffer.size();
+            const ImDrawList *pCmdList = pDrawData->CmdLists[i];
+            Y_memcpy(pCurrentVertex, pCmdList->VtxBuffer.Data, pCmdList->VtxBuffer.size() * sizeof(ImDrawVert));
+            CopyIndices(pCurrentIndex, pCmdList->IdxBuffer.Data, pCmdList->IdxBuffer.size(), (flattenIndices) ? baseVertex : 0);
+            pCurrentVertex += pCmdList->VtxBuffer.size();
+            pCurrentIndex += pCmdList->IdxBuffer.size();
+            baseVertex += pCmdList->VtxBuffer.size();
         }
 
         // unmap again
-        s_pGPUContext->Unmapbuffer(s_pIndexBuffer, pMappedIndexBuffer);
-        s_pGPUContext->Unmapbuffer(s_pVertexBuffer, pMappedVertexBuffer);
+        s_pGPUContext->Unmapbuffer(s_indexStream.pBuffer, pMappedIndexBuffer);
+        s_pGPUContext->Unmapbuffer(s_vertexStream.pBuffer, pMappedVertexBuffer);
     }
     else
     {
-        // annoyingly, ES2 doesn't have the ability to map buffers
-        uint32 vertexBufferOffset = 0;
-        uint32 indexBufferOffset = 0;
+        // annoyingly, ES2 doesn't have the ability to map buffers, so gather the frame and upload it in one go
+        static PODArray<ImDrawVert> stagingVertices;
+        static PODArray<ImDrawIdx> stagingIndices;
+        stagingVertices.Resize(totalVertexCount);
+        stagingIndices.Resize(totalIndexCount);
+
+        ImDrawVert *pCurrentVertex = stagingVertices.GetBasePointer();
+        ImDrawIdx *pCurrentIndex = stagingIndices.GetBasePointer();
+        uint32 baseVertex = 0;
         for (int i = 0; i < pDrawData->CmdListsCount; i++)
         {
-            s_pGPUContext->WriteBuffer(s_pVertexBuffer, pDrawData->CmdLists[i]->VtxBuffer.Data, vertexBufferOffset, pDrawData->CmdLists[i]->VtxBuffer.size() * sizeof(ImDrawVert));
-            s_pGPUContext->WriteBuffer(s_pIndexBuffer, pDrawData->CmdLists[i]->IdxBuffer.Data, indexBufferOffset, pDrawData->CmdLists[i]->IdxBuffer.size() * sizeof(ImDrawIdx));
-            vertexBufferOffset += pDrawData->CmdLists[i]->VtxBuffer.size() * sizeof(ImDrawVert);
-            indexBufferOffset += pDrawData->CmdLists[i]->IdxBuffer.size() * sizeof(ImDrawIdx);
+            const ImDrawList *pCmdList = pDrawData->CmdLists[i];
+            Y_memcpy(pCurrentVertex, pCmdList->VtxBuffer.Data, pCmdList->VtxBuffer.size() * sizeof(ImDrawVert));
+            CopyIndices(pCurrentIndex, pCmdList->IdxBuffer.Data, pCmdList->IdxBuffer.size(), (flattenIndices) ? baseVertex : 0);
+            pCurrentVertex += pCmdList->VtxBuffer.size();
+            pCurrentIndex += pCmdList->IdxBuffer.size();
+            baseVertex += pCmdList->VtxBuffer.size();
         }
+
+        s_pGPUContext->WriteBuffer(s_vertexStream.pBuffer, stagingVertices.GetBasePointer(), frameVertexOffset * sizeof(ImDrawVert), totalVertexCount * sizeof(ImDrawVert));
+        s_pGPUContext->WriteBuffer(s_indexStream.pBuffer, stagingIndices.GetBasePointer(), frameIndexOffset * sizeof(ImDrawIdx), totalIndexCount * sizeof(ImDrawIdx));
     }
 
     // set up device
@@ -127,61 +310,78 @@ static void RenderDrawListsCallback(ImDrawData *pDrawData)
     s_pGPUContext->SetDepthStencilState(s_pDepthStencilState, 0);
     s_pGPUContext->SetBlendState(s_pBlendState);
 
-    // load shader
+    // load shader, the program itself is picked per texture below
     s_pGPUContext->SetInputLayout(s_pInputLayout);
-    s_pGPUContext->SetShaderProgram(s_pShaderProgram);
     s_pGPUContext->SetDrawTopology(DRAW_TOPOLOGY_TRIANGLE_LIST);
 
-    // set buffers
-    s_pGPUContext->SetVertexBuffer(0, s_pVertexBuffer, 0, sizeof(ImDrawVert));
-    s_pGPUContext->SetIndexBuffer(s_pIndexBuffer, GPU_INDEX_FORMAT_UINT16, 0);
+    // set buffers, offset to this frame's region so batch indices stay relative to the frame
+    s_pGPUContext->SetVertexBuffer(0, s_vertexStream.pBuffer, sizeof(ImDrawVert) * frameVertexOffset, sizeof(ImDrawVert));
+    s_pGPUContext->SetIndexBuffer(s_indexStream.pBuffer, GPU_INDEX_FORMAT_UINT16, sizeof(ImDrawIdx) * frameIndexOffset);
 
     // update screen size uniform
     const RENDERER_VIEWPORT* pViewport = s_pGPUContext->GetViewport();
     float inverseViewportSize[2] = { 1.0f / (float)pViewport->Width, 1.0f / (float)pViewport->Height };
-    s_pShaderProgram->SetUniform(0, SHADER_PARAMETER_TYPE_FLOAT2, inverseViewportSize);
 
-    // draw commands
-    unsigned int baseVertex = 0;
-    unsigned int baseIndex = 0;
-    for (int i = 0; i < pDrawData->CmdListsCount; i++)
+    // draw batches, only touching state that actually changes
+    BuildDrawBatches(pDrawData, flattenIndices);
+    const RENDERER_SCISSOR_RECT *pLastScissorRect = nullptr;
+    GPUShaderProgram *pBoundShaderProgram = nullptr;
+    ImTextureID lastTextureId = nullptr;
+    bool textureBound = false;
+    uint32 boundBaseVertex = 0;
+    uint32 boundBaseIndex = 0;
+    for (uint32 i = 0; i < s_drawBatches.GetSize(); i++)
     {
-        ImDrawList *pCmdList = pDrawData->CmdLists[i];
-        unsigned int firstIndex = 0;
-
-        for (int j = 0; j < pCmdList->CmdBuffer.size(); j++)
+        const DrawBatch *pBatch = &s_drawBatches[i];
+        if (pBatch->pCallbackCmd != nullptr)
         {
-            const ImDrawCmd *pCmd = &pCmdList->CmdBuffer[j];
-            if (pCmd->UserCallback != nullptr)
-            {
-                pCmd->UserCallback(pCmdList, pCmd);
-                continue;
-            }
+            // the callback may change anything, so forget what we think is bound
+            pBatch->pCallbackCmd->UserCallback(pBatch->pCallbackCmdList, pBatch->pCallbackCmd);
+            pLastScissorRect = nullptr;
+            pBoundShaderProgram = nullptr;
+            textureBound = false;
+            s_pGPUContext->SetVertexBuffer(0, s_vertexStream.pBuffer, sizeof(ImDrawVert) * (frameVertexOffset + boundBaseVertex), sizeof(ImDrawVert));
+            s_pGPUContext->SetIndexBuffer(s_indexStream.pBuffer, GPU_INDEX_FORMAT_UINT16, sizeof(ImDrawIdx) * (frameIndexOffset + boundBaseIndex));
+            continue;
+        }
 
-            // set up clip rect
-            RENDERER_SCISSOR_RECT scissorRect((uint32)pCmd->ClipRect.x, (uint32)pCmd->ClipRect.y, (uint32)pCmd->ClipRect.z, (uint32)pCmd->ClipRect.w);
-            s_pGPUContext->SetScissorRect(&scissorRect);
+        // set up clip rect
+        if (pLastScissorRect == nullptr || Y_memcmp(pLastScissorRect, &pBatch->ScissorRect, sizeof(RENDERER_SCISSOR_RECT)) != 0)
+        {
+            s_pGPUContext->SetScissorRect(&pBatch->ScissorRect);
+            pLastScissorRect = &pBatch->ScissorRect;
+        }
 
-            // bind texture
-            s_pGPUContext->SetShaderResource(0, reinterpret_cast<GPUTexture2D *>(pCmd->TextureId));
+        // bind texture
+        if (!textureBound || lastTextureId != pBatch->TextureId)
+        {
+            s_pGPUContext->SetShaderResource(0, reinterpret_cast<GPUTexture2D *>(pBatch->TextureId));
+            lastTextureId = pBatch->TextureId;
+            textureBound = true;
 
-            // adjust buffer pointer
-            if (!s_supportsBaseVertex && baseVertex > 0)
+            // single channel font atlas needs its own program, user textures go through the regular one
+            GPUShaderProgram *pShaderProgram = (pBatch->TextureId == s_pFontTexture && s_fontTextureFormat == PIXEL_FORMAT_R8_UNORM) ? s_pFontShaderProgram : s_pShaderProgram;
+            if (pShaderProgram != pBoundShaderProgram)
             {
-                s_pGPUContext->SetVertexBuffer(0, s_pVertexBuffer, sizeof(ImDrawVert) * baseVertex, sizeof(ImDrawVert));
-                s_pGPUContext->SetIndexBuffer(s_pIndexBuffer, GPU_INDEX_FORMAT_UINT16, sizeof(ImDrawIdx) * baseIndex);
-                s_pGPUContext->DrawIndexed(firstIndex, pCmd->ElemCount, 0);
-            }
-            else
-            {
-                s_pGPUContext->DrawIndexed(baseIndex + firstIndex, pCmd->ElemCount, baseVertex);
+                s_pGPUContext->SetShaderProgram(pShaderProgram);
+                pShaderProgram->SetUniform(0, SHADER_PARAMETER_TYPE_FLOAT2, inverseViewportSize);
+                pBoundShaderProgram = pShaderProgram;
             }
+        }
 
-            // update pointers
-            baseIndex += pCmd->ElemCount;
+        // without base vertex support, offset the buffers instead, which is only needed when the indices aren't flattened
+        if (!s_supportsBaseVertex && pBatch->BaseVertex != boundBaseVertex)
+        {
+            boundBaseVertex = pBatch->BaseVertex;
+            boundBaseIndex = pBatch->FirstIndex;
+            s_pGPUContext->SetVertexBuffer(0, s_vertexStream.pBuffer, sizeof(ImDrawVert) * (frameVertexOffset + boundBaseVertex), sizeof(ImDrawVert));
+            s_pGPUContext->SetIndexBuffer(s_indexStream.pBuffer, GPU_INDEX_FORMAT_UINT16, sizeof(ImDrawIdx) * (frameIndexOffset + boundBaseIndex));
         }
 
-        baseVertex += pCmdList->VtxBuffer.size();
+        if (!s_supportsBaseVertex)
+            s_pGPUContext->DrawIndexed(pBatch->FirstIndex - boundBaseIndex, pBatch->IndexCount, 0);
+        else
+            s_pGPUContext->DrawIndexed(pBatch->FirstIndex, pBatch->IndexCount, pBatch->BaseVertex);
     }
 
     // clear bindings
@@ -217,6 +417,30 @@ static bool CreateStates()
     return true;
 }
 
+static GPUShaderProgram *CompileShaderProgram(const char *vertexShaderSource, const char *pixelShaderSource)
+{
+    AutoReleasePtr<ShaderCompiler> pShaderCompiler = ShaderCompiler::Create();
+    pShaderCompiler->SetStageSourceCode(SHADER_PROGRAM_STAGE_VERTEX_SHADER, "", vertexShaderSource, "main");
+    pShaderCompiler->SetStageSourceCode(SHADER_PROGRAM_STAGE_PIXEL_SHADER, "", pixelShaderSource, "main");
+
+    AutoReleasePtr<ByteStream> pShaderBlob = ByteStream_CreateGrowableMemoryStream();
+    if (!pShaderCompiler->CompileSingleTypeProgram(s_pGPUDevice->GetShaderProgramType(), 0, pShaderBlob, nullptr, nullptr))
+    {
+        Log_ErrorPrintf("Failed to compile ImGui program");
+        return nullptr;
+    }
+
+    pShaderBlob->SeekAbsolute(0);
+    GPUShaderProgram *pShaderProgram = s_pGPUDevice->CreateGraphicsProgram(pShaderBlob);
+    if (pShaderProgram == nullptr)
+    {
+        Log_ErrorPrintf("Failed to create ImGui program");
+        return nullptr;
+    }
+
+    return pShaderProgram;
+}
+
 static bool CreateShaderProgram()
 {
     static const char* vertexShaderSource = R"(
@@ -252,24 +476,26 @@ static bool CreateShaderProgram()
         }
     )";
 
-    AutoReleasePtr<ShaderCompiler> pShaderCompiler = ShaderCompiler::Create();
-    pShaderCompiler->SetStageSourceCode(SHADER_PROGRAM_STAGE_VERTEX_SHADER, "", vertexShaderSource, "main");
-    pShaderCompiler->SetStageSourceCode(SHADER_PROGRAM_STAGE_PIXEL_SHADER, "", pixelShaderSource, "main");
+    // the font atlas is single channel, coverage is in red
+    static const char* fontPixelShaderSource = R"(
+        Texture2D fonttex : register(t0);
+        SamplerState fonttex_SamplerState : register(s0);
 
-    AutoReleasePtr<ByteStream> pShaderBlob = ByteStream_CreateGrowableMemoryStream();
-    if (!pShaderCompiler->CompileSingleTypeProgram(s_pGPUDevice->GetShaderProgramType(), 0, pShaderBlob, nullptr, nullptr))
-    {
-        Log_ErrorPrintf("Failed to compile ImGui program");
-        return false;
-    }
+        void main(in float2 iuv : TEXCOORD,
+                  in float4 icol : COLOR,
+                  out float4 ocol : SV_Target)
+        {
+            ocol = float4(icol.rgb, icol.a * fonttex.Sample(fonttex_SamplerState, iuv).r);
+        }
+    )";
 
-    pShaderBlob->SeekAbsolute(0);
-    s_pShaderProgram = s_pGPUDevice->CreateGraphicsProgram(pShaderBlob);
+    s_pShaderProgram = CompileShaderProgram(vertexShaderSource, pixelShaderSource);
     if (s_pShaderProgram == nullptr)
-    {
-        Log_ErrorPrintf("Failed to create ImGui program");
         return false;
-    }
+
+    s_pFontShaderProgram = CompileShaderProgram(vertexShaderSource, fontPixelShaderSource);
+    if (s_pFontShaderProgram == nullptr)
+        return false;
 
     return true;
 }
@@ -292,31 +518,531 @@ static bool CreateInputLayout()
     return true;
 }
 
-static bool CreateTextures()
+//----------------------------------------------------- Font Atlas -----------------------------------------------------------------------------------------------------------------
+
+// Baked atlases are cached on disk keyed by a hash of the font configuration, so startup doesn't have to
+// rasterize large glyph ranges again. The file holds the alpha8 pixels plus every font's glyph table. Glyphs
+// are stored as fixed records converted field by field, so the file doesn't depend on imgui's struct layout.
+static const uint32 FONT_CACHE_MAGIC = 0x43464749;      // 'IGFC'
+static const uint32 FONT_CACHE_VERSION = 2;
+
+// Rows kept free below the glyphs when the font texture is created, fonts added later are rasterized into them.
+static const uint32 FONT_ATLAS_RESERVED_ROWS = 256;
+
+struct FontCacheHeader
 {
-    ImGuiIO& io = ImGui::GetIO();
+    uint32 Magic;
+    uint32 Version;
+    uint64 ConfigHash;
+    uint32 GlyphRecordSize;
+    uint32 TextureWidth;
+    uint32 TextureHeight;
+    float WhitePixelU;
+    float WhitePixelV;
+    uint32 FontCount;
+};
+
+struct FontCacheFontHeader
+{
+    float FontSize;
+    float Ascent;
+    float Descent;
+    uint32 ConfigDataCount;
+    uint32 FallbackChar;
+    uint32 GlyphCount;
+};
+
+struct FontCacheGlyph
+{
+    uint32 Codepoint;
+    float XAdvance;
+    float X0, Y0, X1, Y1;
+    float U0, V0, U1, V1;
+};
+
+static void PackFontCacheGlyph(FontCacheGlyph *pRecord, const ImFont::Glyph &glyph)
+{
+    pRecord->Codepoint = (uint32)glyph.Codepoint;
+    pRecord->XAdvance = glyph.XAdvance;
+    pRecord->X0 = glyph.X0;
+    pRecord->Y0 = glyph.Y0;
+    pRecord->X1 = glyph.X1;
+    pRecord->Y1 = glyph.Y1;
+    pRecord->U0 = glyph.U0;
+    pRecord->V0 = glyph.V0;
+    pRecord->U1 = glyph.U1;
+    pRecord->V1 = glyph.V1;
+}
+
+static void UnpackFontCacheGlyph(ImFont::Glyph *pGlyph, const FontCacheGlyph &record)
+{
+    pGlyph->Codepoint = (ImWchar)record.Codepoint;
+    pGlyph->XAdvance = record.XAdvance;
+    pGlyph->X0 = record.X0;
+    pGlyph->Y0 = record.Y0;
+    pGlyph->X1 = record.X1;
+    pGlyph->Y1 = record.Y1;
+    pGlyph->U0 = record.U0;
+    pGlyph->V0 = record.V0;
+    pGlyph->U1 = record.U1;
+    pGlyph->V1 = record.V1;
+}
+
+// 64-bit FNV-1a
+static uint64 HashFontBytes(uint64 hash, const void *pData, uint32 size)
+{
+    const byte *pBytes = reinterpret_cast<const byte *>(pData);
+    for (uint32 i = 0; i < size; i++)
+        hash = (hash ^ pBytes[i]) * 1099511628211ULL;
 
-    // get font pixels
-    const void *pFontPixels;
-    int fontWidth, fontHeight;
-    uint32 pitch;
-    io.Fonts->GetTexDataAsRGBA32((unsigned char **)&pFontPixels, &fontWidth, &fontHeight);
-    pitch = PixelFormat_CalculateRowPitch(PIXEL_FORMAT_R8G8B8A8_UNORM, fontWidth);
+    return hash;
+}
+
+template<typename T>
+static uint64 HashFontValue(uint64 hash, const T &value)
+{
+    return HashFontBytes(hash, &value, sizeof(value));
+}
+
+// covers everything Build() consumes, including the TTF data itself
+static uint64 HashFontConfiguration(const ImFontAtlas *pAtlas)
+{
+    uint64 hash = 14695981039346656037ULL;
+    hash = HashFontValue(hash, FONT_CACHE_VERSION);
+    hash = HashFontValue(hash, pAtlas->TexDesiredWidth);
+    hash = HashFontValue(hash, pAtlas->ConfigData.Size);
+    for (int i = 0; i < pAtlas->ConfigData.Size; i++)
+    {
+        const ImFontConfig &config = pAtlas->ConfigData[i];
+        hash = HashFontValue(hash, config.FontDataSize);
+        hash = HashFontBytes(hash, config.FontData, (uint32)config.FontDataSize);
+        hash = HashFontValue(hash, config.FontNo);
+        hash = HashFontValue(hash, config.SizePixels);
+        hash = HashFontValue(hash, config.OversampleH);
+        hash = HashFontValue(hash, config.OversampleV);
+        hash = HashFontValue(hash, config.PixelSnapH);
+        hash = HashFontValue(hash, config.GlyphExtraSpacing.x);
+        hash = HashFontValue(hash, config.GlyphExtraSpacing.y);
+        hash = HashFontValue(hash, config.MergeMode);
+        hash = HashFontValue(hash, config.MergeGlyphCenterV);
+        for (int j = 0; j < pAtlas->Fonts.Size; j++)
+        {
+            if (pAtlas->Fonts[j] == config.DstFont)
+                hash = HashFontValue(hash, j);
+        }
+        for (const ImWchar *pRange = config.GlyphRanges; pRange != nullptr && *pRange != 0; pRange++)
+            hash = HashFontValue(hash, *pRange);
+    }
+
+    return hash;
+}
+
+// points every font at its first config, AddFont() may have moved the config array since the atlas was built
+static void LinkFontConfigs(ImFontAtlas *pAtlas)
+{
+    for (int i = 0; i < pAtlas->Fonts.Size; i++)
+    {
+        ImFont *pFont = pAtlas->Fonts[i];
+        pFont->ConfigData = nullptr;
+        for (int j = 0; j < pAtlas->ConfigData.Size && pFont->ConfigData == nullptr; j++)
+        {
+            if (pAtlas->ConfigData[j].DstFont == pFont)
+                pFont->ConfigData = &pAtlas->ConfigData[j];
+        }
+    }
+}
+
+// Renders the custom data block at the given texel, which also sets up the white pixel and mouse cursor uvs for the
+// current texture size. The white pixel sits at the top left texel of the block, so that is where it is recovered from.
+static void RenderFontAtlasCustomData(ImFontAtlas *pAtlas, uint32 x, uint32 y)
+{
+    ImVector<stbrp_rect> customRects;
+    customRects.resize(1);
+    Y_memzero(&customRects[0], sizeof(stbrp_rect));
+    customRects[0].x = (stbrp_coord)x;
+    customRects[0].y = (stbrp_coord)y;
+    pAtlas->RenderCustomTexData(1, &customRects);
+}
+
+// size of the top left region holding glyphs and the custom data block
+static void CalculateFontAtlasUsedSize(ImFontAtlas *pAtlas, uint32 *pUsedWidth, uint32 *pUsedHeight)
+{
+    ImVector<stbrp_rect> customRects;
+    pAtlas->RenderCustomTexData(0, &customRects);
+
+    float width = (float)pAtlas->TexWidth;
+    float height = (float)pAtlas->TexHeight;
+    uint32 usedWidth = (uint32)(pAtlas->TexUvWhitePixel.x * width) + (uint32)customRects[0].w;
+    uint32 usedHeight = (uint32)(pAtlas->TexUvWhitePixel.y * height) + (uint32)customRects[0].h;
+    for (int i = 0; i < pAtlas->Fonts.Size; i++)
+    {
+        const ImFont *pFont = pAtlas->Fonts[i];
+        for (int j = 0; j < pFont->Glyphs.Size; j++)
+        {
+            usedWidth = Max(usedWidth, (uint32)(pFont->Glyphs[j].U1 * width + 0.5f));
+            usedHeight = Max(usedHeight, (uint32)(pFont->Glyphs[j].V1 * height + 0.5f));
+        }
+    }
+
+    *pUsedWidth = Min(usedWidth, (uint32)pAtlas->TexWidth);
+    *pUsedHeight = Min(usedHeight, (uint32)pAtlas->TexHeight);
+}
+
+static bool LoadFontAtlasFromCache(ImFontAtlas *pAtlas, uint64 configHash)
+{
+    AutoReleasePtr<ByteStream> pStream = FileSystem::OpenFile(s_fontCacheFileName.GetCharArray(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
+    if (pStream == nullptr)
+        return false;
+
+    FontCacheHeader header;
+    if (!pStream->Read2(&header, sizeof(header)) ||
+        header.Magic != FONT_CACHE_MAGIC || header.Version != FONT_CACHE_VERSION || header.ConfigHash != configHash ||
+        header.GlyphRecordSize != sizeof(FontCacheGlyph) || header.FontCount != (uint32)pAtlas->Fonts.Size ||
+        header.TextureWidth == 0 || header.TextureHeight == 0)
+    {
+        return false;
+    }
+
+    // read everything before touching the atlas, so a truncated file leaves it untouched
+    PODArray<FontCacheFontHeader> fontHeaders;
+    PODArray<FontCacheGlyph> glyphs;
+    fontHeaders.Resize(header.FontCount);
+    for (uint32 i = 0; i < header.FontCount; i++)
+    {
+        if (!pStream->Read2(&fontHeaders[i], sizeof(FontCacheFontHeader)))
+            return false;
+
+        uint32 firstGlyph = glyphs.GetSize();
+        glyphs.Resize(firstGlyph + fontHeaders[i].GlyphCount);
+        if (fontHeaders[i].GlyphCount > 0 && !pStream->Read2(&glyphs[firstGlyph], sizeof(FontCacheGlyph) * fontHeaders[i].GlyphCount))
+            return false;
+    }
+
+    uint32 pixelCount = header.TextureWidth * header.TextureHeight;
+    unsigned char *pPixels = (unsigned char *)ImGui::MemAlloc(pixelCount);
+    if (!pStream->Read2(pPixels, pixelCount))
+    {
+        ImGui::MemFree(pPixels);
+        return false;
+    }
+
+    // fill in what Build() would have produced
+    pAtlas->ClearTexData();
+    pAtlas->TexPixelsAlpha8 = pPixels;
+    pAtlas->TexWidth = (int)header.TextureWidth;
+    pAtlas->TexHeight = (int)header.TextureHeight;
+
+    uint32 glyphIndex = 0;
+    for (uint32 i = 0; i < header.FontCount; i++)
+    {
+        ImFont *pFont = pAtlas->Fonts[i];
+        pFont->ContainerAtlas = pAtlas;
+        pFont->ConfigDataCount = (int)fontHeaders[i].ConfigDataCount;
+        pFont->FontSize = fontHeaders[i].FontSize;
+        pFont->Ascent = fontHeaders[i].Ascent;
+        pFont->Descent = fontHeaders[i].Descent;
+        pFont->FallbackChar = (ImWchar)fontHeaders[i].FallbackChar;
+        pFont->Glyphs.resize((int)fontHeaders[i].GlyphCount);
+        for (uint32 j = 0; j < fontHeaders[i].GlyphCount; j++)
+            UnpackFontCacheGlyph(&pFont->Glyphs[(int)j], glyphs[glyphIndex + j]);
+        glyphIndex += fontHeaders[i].GlyphCount;
+        pFont->BuildLookupTable();
+    }
+
+    LinkFontConfigs(pAtlas);
+    RenderFontAtlasCustomData(pAtlas, (uint32)(header.WhitePixelU * (float)header.TextureWidth), (uint32)(header.WhitePixelV * (float)header.TextureHeight));
+    return true;
+}
+
+static void SaveFontAtlasToCache(const ImFontAtlas *pAtlas, uint64 configHash)
+{
+    AutoReleasePtr<ByteStream> pStream = FileSystem::OpenFile(s_fontCacheFileName.GetCharArray(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_CREATE_PATH | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE | BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_STREAMED);
+    if (pStream == nullptr)
+    {
+        Log_WarningPrintf("Failed to open font cache '%s' for writing", s_fontCacheFileName.GetCharArray());
+        return;
+    }
+
+    FontCacheHeader header;
+    header.Magic = FONT_CACHE_MAGIC;
+    header.Version = FONT_CACHE_VERSION;
+    header.ConfigHash = configHash;
+    header.GlyphRecordSize = sizeof(FontCacheGlyph);
+    header.TextureWidth = (uint32)pAtlas->TexWidth;
+    header.TextureHeight = (uint32)pAtlas->TexHeight;
+    header.WhitePixelU = pAtlas->TexUvWhitePixel.x;
+    header.WhitePixelV = pAtlas->TexUvWhitePixel.y;
+    header.FontCount = (uint32)pAtlas->Fonts.Size;
+    bool result = pStream->Write2(&header, sizeof(header));
+
+    PODArray<FontCacheGlyph> glyphs;
+    for (int i = 0; i < pAtlas->Fonts.Size && result; i++)
+    {
+        const ImFont *pFont = pAtlas->Fonts[i];
+        FontCacheFontHeader fontHeader;
+        fontHeader.FontSize = pFont->FontSize;
+        fontHeader.Ascent = pFont->Ascent;
+        fontHeader.Descent = pFont->Descent;
+        fontHeader.ConfigDataCount = (uint32)pFont->ConfigDataCount;
+        fontHeader.FallbackChar = (uint32)pFont->FallbackChar;
+        fontHeader.GlyphCount = (uint32)pFont->Glyphs.Size;
+        result = pStream->Write2(&fontHeader, sizeof(fontHeader));
+        if (result && pFont->Glyphs.Size > 0)
+        {
+            glyphs.Resize(fontHeader.GlyphCount);
+            for (uint32 j = 0; j < fontHeader.GlyphCount; j++)
+                PackFontCacheGlyph(&glyphs[j], pFont->Glyphs[(int)j]);
+            result = pStream->Write2(glyphs.GetBasePointer(), sizeof(FontCacheGlyph) * fontHeader.GlyphCount);
+        }
+    }
+
+    if (result)
+        result = pStream->Write2(pAtlas->TexPixelsAlpha8, header.TextureWidth * header.TextureHeight);
+
+    if (!result || !pStream->Commit())
+    {
+        Log_WarningPrintf("Failed to write font cache '%s'", s_fontCacheFileName.GetCharArray());
+        pStream->Discard();
+    }
+}
+
+// builds the alpha8 atlas, going through the disk cache when one is configured
+static void BuildFontAtlas(ImFontAtlas *pAtlas)
+{
+    if (pAtlas->ConfigData.empty())
+        pAtlas->AddFontDefault();
+
+    if (s_fontCacheFileName.IsEmpty())
+    {
+        pAtlas->Build();
+        return;
+    }
+
+    uint64 configHash = HashFontConfiguration(pAtlas);
+    if (LoadFontAtlasFromCache(pAtlas, configHash))
+    {
+        Log_DevPrintf("Loaded font atlas from cache '%s'", s_fontCacheFileName.GetCharArray());
+        return;
+    }
 
-    // Create the font as a GPU texture
-    GPU_TEXTURE2D_DESC textureDesc(fontWidth, fontHeight, PIXEL_FORMAT_R8G8B8A8_UNORM, GPU_TEXTURE_FLAG_SHADER_BINDABLE, 1);
+    Timer buildTimer;
+    pAtlas->Build();
+    Log_PerfPrintf("Font atlas built in %.2f ms, writing to cache '%s'", buildTimer.GetTimeMilliseconds(), s_fontCacheFileName.GetCharArray());
+    SaveFontAtlasToCache(pAtlas, configHash);
+}
+
+// Grows the atlas until FONT_ATLAS_RESERVED_ROWS are free below the used rows, keeping the height a power of two.
+// Pixel rows stay where they are, so only the v coordinates of the glyphs and custom data need scaling.
+static void ReserveFontAtlasRows(ImFontAtlas *pAtlas, uint32 usedHeight)
+{
+    uint32 width = (uint32)pAtlas->TexWidth;
+    uint32 oldHeight = (uint32)pAtlas->TexHeight;
+    uint32 newHeight = Max(oldHeight, (uint32)1);
+    while (newHeight < usedHeight + FONT_ATLAS_RESERVED_ROWS)
+        newHeight *= 2;
+    if (newHeight == oldHeight)
+        return;
+
+    uint32 customX = (uint32)(pAtlas->TexUvWhitePixel.x * (float)width);
+    uint32 customY = (uint32)(pAtlas->TexUvWhitePixel.y * (float)oldHeight);
+
+    unsigned char *pPixels = (unsigned char *)ImGui::MemAlloc(width * newHeight);
+    Y_memcpy(pPixels, pAtlas->TexPixelsAlpha8, width * oldHeight);
+    Y_memzero(pPixels + width * oldHeight, width * (newHeight - oldHeight));
+    pAtlas->ClearTexData();
+    pAtlas->TexPixelsAlpha8 = pPixels;
+    pAtlas->TexHeight = (int)newHeight;
+
+    // both heights are powers of two, so this is exact
+    float scale = (float)oldHeight / (float)newHeight;
+    for (int i = 0; i < pAtlas->Fonts.Size; i++)
+    {
+        ImFont *pFont = pAtlas->Fonts[i];
+        for (int j = 0; j < pFont->Glyphs.Size; j++)
+        {
+            pFont->Glyphs[j].V0 *= scale;
+            pFont->Glyphs[j].V1 *= scale;
+        }
+    }
+
+    RenderFontAtlasCustomData(pAtlas, customX, customY);
+}
+
+// uploads a region of the alpha8 atlas, expanding to white RGBA when the device has no single channel format
+static bool UploadFontTextureRegion(const byte *pPixels, uint32 width, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const byte *pSource = pPixels + startY * width + startX;
+    if (s_fontTextureFormat == PIXEL_FORMAT_R8_UNORM)
+        return s_pGPUContext->WriteTexture(s_pFontTexture, pSource, width, width * countY, 0, startX, startY, countX, countY);
+
+    PODArray<uint32> expandedPixels;
+    expandedPixels.Resize(countX * countY);
+    for (uint32 y = 0; y < countY; y++)
+    {
+        for (uint32 x = 0; x < countX; x++)
+            expandedPixels[y * countX + x] = ((uint32)pSource[y * width + x] << 24) | 0x00FFFFFF;
+    }
+
+    return s_pGPUContext->WriteTexture(s_pFontTexture, expandedPixels.GetBasePointer(), countX * sizeof(uint32), countX * countY * sizeof(uint32), 0, startX, startY, countX, countY);
+}
+
+static bool CreateFontTexture(const byte *pPixels, uint32 width, uint32 height)
+{
+    // single channel saves 75% over RGBA, the font program reads coverage from the red channel
+    PIXEL_FORMAT compatibleFormat;
+    if (s_pGPUDevice->CheckTexturePixelFormatCompatibility(PIXEL_FORMAT_R8_UNORM, &compatibleFormat) && compatibleFormat == PIXEL_FORMAT_R8_UNORM)
+        s_fontTextureFormat = PIXEL_FORMAT_R8_UNORM;
+    else
+        s_fontTextureFormat = PIXEL_FORMAT_R8G8B8A8_UNORM;
+
+    PODArray<uint32> expandedPixels;
+    const void *pInitialData = pPixels;
+    uint32 pitch = PixelFormat_CalculateRowPitch(s_fontTextureFormat, width);
+    if (s_fontTextureFormat != PIXEL_FORMAT_R8_UNORM)
+    {
+        expandedPixels.Resize(width * height);
+        for (uint32 i = 0; i < width * height; i++)
+            expandedPixels[i] = ((uint32)pPixels[i] << 24) | 0x00FFFFFF;
+        pInitialData = expandedPixels.GetBasePointer();
+    }
+
+    GPU_TEXTURE2D_DESC textureDesc(width, height, s_fontTextureFormat, GPU_TEXTURE_FLAG_SHADER_BINDABLE | GPU_TEXTURE_FLAG_WRITABLE, 1);
     GPU_SAMPLER_STATE_DESC samplerStateDesc(TEXTURE_FILTER_MIN_MAG_LINEAR_MIP_POINT, TEXTURE_ADDRESS_MODE_CLAMP, TEXTURE_ADDRESS_MODE_CLAMP, TEXTURE_ADDRESS_MODE_CLAMP, FloatColor::Black, 0.0f, 0, 0, 1, GPU_COMPARISON_FUNC_NEVER);
-    GPUTexture2D *pFontTexture = s_pGPUDevice->CreateTexture2D(&textureDesc, &samplerStateDesc, &pFontPixels, &pitch);
+    GPUTexture2D *pFontTexture = s_pGPUDevice->CreateTexture2D(&textureDesc, &samplerStateDesc, &pInitialData, &pitch);
     if (pFontTexture == nullptr)
     {
         Log_ErrorPrintf("Failed to create font texture.");
         return false;
     }
 
-    io.Fonts->TexID = pFontTexture;
+    SAFE_RELEASE(s_pFontTexture);
+    s_pFontTexture = pFontTexture;
+    s_fontTextureWidth = width;
+    s_fontTextureHeight = height;
+    return true;
+}
+
+// Builds the whole atlas held by io.Fonts and creates the texture for it, with rows reserved for fonts added later.
+static bool CreateFontTextureFromAtlas(ImFontAtlas *pAtlas)
+{
+    BuildFontAtlas(pAtlas);
+
+    uint32 usedWidth, usedHeight;
+    CalculateFontAtlasUsedSize(pAtlas, &usedWidth, &usedHeight);
+    ReserveFontAtlasRows(pAtlas, usedHeight);
+
+    uint32 width = (uint32)pAtlas->TexWidth;
+    uint32 height = (uint32)pAtlas->TexHeight;
+    if (!CreateFontTexture(pAtlas->TexPixelsAlpha8, width, height))
+        return false;
+
+    // AddFont() frees imgui's pixels, so keep our own to append new fonts to
+    s_fontTexturePixels.Resize(width * height);
+    Y_memcpy(s_fontTexturePixels.GetBasePointer(), pAtlas->TexPixelsAlpha8, width * height);
+    s_fontAtlasUsedHeight = usedHeight;
+    s_fontAtlasConfigCount = (uint32)pAtlas->ConfigData.Size;
+    pAtlas->TexID = s_pFontTexture;
     return true;
 }
 
+// Rasterizes only the fonts added to io.Fonts since the texture was created, packing them into the reserved rows
+// and uploading the rectangle they cover. Returns false when a full rebuild is needed instead: the atlas was cleared,
+// a config merges into a font that is already in the texture, or the new glyphs don't fit.
+static bool AppendFontsToAtlas(ImFontAtlas *pAtlas)
+{
+    uint32 firstConfig = s_fontAtlasConfigCount;
+    if (firstConfig == 0 || (uint32)pAtlas->ConfigData.Size <= firstConfig ||
+        !pAtlas->ConfigData[firstConfig - 1].DstFont->IsLoaded() || pAtlas->ConfigData[firstConfig].MergeMode)
+    {
+        return false;
+    }
+
+    // build the new configs on their own at the texture width, sharing the TTF data rather than copying it
+    ImFontAtlas newAtlas;
+    newAtlas.TexDesiredWidth = (int)s_fontTextureWidth;
+    for (uint32 i = firstConfig; i < (uint32)pAtlas->ConfigData.Size; i++)
+    {
+        ImFontConfig config = pAtlas->ConfigData[i];
+        config.FontDataOwnedByAtlas = true;
+        config.DstFont = nullptr;
+        newAtlas.AddFont(&config);
+    }
+
+    bool built = newAtlas.Build();
+    for (int i = 0; i < newAtlas.ConfigData.Size; i++)
+        newAtlas.ConfigData[i].FontData = nullptr;
+    if (!built)
+        return false;
+
+    uint32 width = s_fontTextureWidth;
+    uint32 height = s_fontTextureHeight;
+    uint32 startY = s_fontAtlasUsedHeight;
+    uint32 countX, countY;
+    CalculateFontAtlasUsedSize(&newAtlas, &countX, &countY);
+    if (countY > height - startY)
+    {
+        Log_DevPrintf("New fonts need %u rows of the font atlas but only %u are free, rebuilding", countY, height - startY);
+        return false;
+    }
+
+    for (uint32 y = 0; y < countY; y++)
+        Y_memcpy(s_fontTexturePixels.GetBasePointer() + (startY + y) * width, newAtlas.TexPixelsAlpha8 + y * width, countX);
+
+    // move the new glyphs down into the reserved rows, exact as both heights are powers of two
+    float scaleV = (float)newAtlas.TexHeight / (float)height;
+    float offsetV = (float)startY / (float)height;
+    int newFontIndex = 0;
+    for (uint32 i = firstConfig; i < (uint32)pAtlas->ConfigData.Size; i++)
+    {
+        if (pAtlas->ConfigData[i].MergeMode)
+            continue;
+
+        const ImFont *pSourceFont = newAtlas.Fonts[newFontIndex++];
+        ImFont *pFont = pAtlas->ConfigData[i].DstFont;
+        pFont->ContainerAtlas = pAtlas;
+        pFont->ConfigDataCount = pSourceFont->ConfigDataCount;
+        pFont->FontSize = pSourceFont->FontSize;
+        pFont->Ascent = pSourceFont->Ascent;
+        pFont->Descent = pSourceFont->Descent;
+        pFont->Glyphs.resize(pSourceFont->Glyphs.Size);
+        for (int j = 0; j < pSourceFont->Glyphs.Size; j++)
+        {
+            ImFont::Glyph &glyph = pFont->Glyphs[j];
+            glyph = pSourceFont->Glyphs[j];
+            glyph.V0 = glyph.V0 * scaleV + offsetV;
+            glyph.V1 = glyph.V1 * scaleV + offsetV;
+        }
+        pFont->BuildLookupTable();
+    }
+    LinkFontConfigs(pAtlas);
+
+    // hand imgui the combined pixels again, so its tables and pixels agree if anything reads them, and put back the
+    // mouse cursor uvs which the scratch atlas overwrote with its own
+    pAtlas->ClearTexData();
+    pAtlas->TexPixelsAlpha8 = (unsigned char *)ImGui::MemAlloc(width * height);
+    Y_memcpy(pAtlas->TexPixelsAlpha8, s_fontTexturePixels.GetBasePointer(), width * height);
+    pAtlas->TexWidth = (int)width;
+    pAtlas->TexHeight = (int)height;
+    pAtlas->TexID = s_pFontTexture;
+    RenderFontAtlasCustomData(pAtlas, (uint32)(pAtlas->TexUvWhitePixel.x * (float)width), (uint32)(pAtlas->TexUvWhitePixel.y * (float)height));
+    s_fontAtlasUsedHeight = startY + countY;
+    s_fontAtlasConfigCount = (uint32)pAtlas->ConfigData.Size;
+
+    Log_DevPrintf("Appended %u font configs to font texture region %ux%u at 0,%u", s_fontAtlasConfigCount - firstConfig, countX, countY, startY);
+    if (!UploadFontTextureRegion(s_fontTexturePixels.GetBasePointer(), width, 0, startY, countX, countY))
+    {
+        Log_ErrorPrintf("Failed to update font texture.");
+        return false;
+    }
+
+    return true;
+}
+
+static bool CreateTextures()
+{
+    return CreateFontTextureFromAtlas(ImGui::GetIO().Fonts);
+}
+
 static void PopulateKeyMap()
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -340,7 +1066,7 @@ static void PopulateKeyMap()
     io.KeyMap[ImGuiKey_Z] = SDL_SCANCODE_Z;
 }
 
-bool ImGuiBridge::Initialize(GPUDevice* pGPUDevice, GPUContext* pGPUContext)
+bool ImGuiBridge::Initialize(GPUDevice* pGPUDevice, GPUContext* pGPUContext, uint32 gpuFrameLatency /* = 3 */)
 {
     GPUOutputBuffer *pOutputBuffer = pGPUContext->GetOutputBuffer();
 
@@ -355,6 +1081,7 @@ bool ImGuiBridge::Initialize(GPUDevice* pGPUDevice, GPUContext* pGPUContext)
     // set vars
     s_pGPUDevice = AddRefAndReturn(pGPUDevice);
     s_pGPUContext = AddRefAndReturn(pGPUContext);
+    s_frameLatency = Max(gpuFrameLatency, (uint32)1);
 
     // get caps
     RendererCapabilities capabilities;
@@ -479,23 +1206,47 @@ void ImGuiBridge::FreeResources()
 {
     // release font
     ImGuiIO& io = ImGui::GetIO();
-    if (io.Fonts->TexID != nullptr)
-    {
-        GPUTexture2D *pTexture = reinterpret_cast<GPUTexture2D *>(io.Fonts->TexID);
-        pTexture->Release();
-        io.Fonts->TexID = nullptr;
-    }
+    io.Fonts->TexID = nullptr;
+    SAFE_RELEASE(s_pFontTexture);
+    s_fontTexturePixels.Obliterate();
+    s_fontTextureWidth = 0;
+    s_fontTextureHeight = 0;
+    s_fontAtlasUsedHeight = 0;
+    s_fontAtlasConfigCount = 0;
 
     // release resources
-    s_vertexBufferSize = 0;
-    s_indexBufferSize = 0;
     SAFE_RELEASE(s_pRasterizerState);
     SAFE_RELEASE(s_pDepthStencilState);
     SAFE_RELEASE(s_pBlendState);
     SAFE_RELEASE(s_pInputLayout);
     SAFE_RELEASE(s_pShaderProgram);
-    SAFE_RELEASE(s_pVertexBuffer);
-    SAFE_RELEASE(s_pIndexBuffer);
+    SAFE_RELEASE(s_pFontShaderProgram);
+    SAFE_RELEASE(s_vertexStream.pBuffer);
+    SAFE_RELEASE(s_indexStream.pBuffer);
+    s_vertexStream.Capacity = s_vertexStream.Position = s_vertexStream.PeakUsage = 0;
+    s_indexStream.Capacity = s_indexStream.Position = s_indexStream.PeakUsage = 0;
+    s_framesSinceShrinkCheck = 0;
     SAFE_RELEASE(s_pGPUContext);
     SAFE_RELEASE(s_pGPUDevice);
 }
+
+void ImGuiBridge::SetFontCacheFileName(const char *fileName)
+{
+    s_fontCacheFileName = (fileName != nullptr) ? fileName : "";
+}
+
+bool ImGuiBridge::UpdateFontTexture()
+{
+    ImFontAtlas *pAtlas = ImGui::GetIO().Fonts;
+    if (s_pFontTexture != nullptr)
+    {
+        // nothing was added or cleared since the last upload
+        if ((uint32)pAtlas->ConfigData.Size == s_fontAtlasConfigCount && pAtlas->TexPixelsAlpha8 != nullptr)
+            return true;
+
+        if (AppendFontsToAtlas(pAtlas))
+            return true;
+    }
+
+    return CreateFontTextureFromAtlas(pAtlas);
+}
@@ -0,0 +1,323 @@
+#include "YBaseLib/Assert.h"
+#include "YBaseLib/Math.h"
+#include "YBaseLib/Memory.h"
+#include "YBaseLib/Log.h"
+#include "YBaseLib/PODArray.h"
+#include "YRenderLib/ImageResampler.h"
+#include <cmath>
+#include <thread>
+Log_SetChannel(ImageResampler);
+
+#if Y_CPU_SSE_LEVEL > 0
+    #include <intrin.h>
+#endif
+
+// rows are decoded and encoded this many at a time, so the converters' per-call overhead is amortized
+static const uint32 ROW_BATCH_SIZE = 16;
+
+// fewer destination pixels than this per thread isn't worth starting threads for
+static const uint32 MIN_PIXELS_PER_THREAD = 64 * 1024;
+
+//------------------------------------------------------------------ Filters -------------------------------------------------------------------------------------------------------------
+
+static float BoxFilter(float x)
+{
+    return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f;
+}
+
+static float TriangleFilter(float x)
+{
+    x = fabsf(x);
+    return (x < 1.0f) ? (1.0f - x) : 0.0f;
+}
+
+static float MitchellFilter(float x)
+{
+    // B = C = 1/3
+    x = fabsf(x);
+    if (x < 1.0f)
+        return (7.0f * x * x * x - 12.0f * x * x + 16.0f / 3.0f) / 6.0f;
+    else if (x < 2.0f)
+        return ((-7.0f / 3.0f) * x * x * x + 12.0f * x * x - 20.0f * x + 32.0f / 3.0f) / 6.0f;
+    else
+        return 0.0f;
+}
+
+static float Sinc(float x)
+{
+    if (x == 0.0f)
+        return 1.0f;
+
+    x *= Y_PI;
+    return sinf(x) / x;
+}
+
+static float Lanczos3Filter(float x)
+{
+    return (fabsf(x) < 3.0f) ? (Sinc(x) * Sinc(x / 3.0f)) : 0.0f;
+}
+
+struct ResampleFilter
+{
+    float (*Function)(float x);
+    float Radius;
+};
+
+static const ResampleFilter s_filters[IMAGE_RESAMPLE_FILTER_COUNT] =
+{
+    { BoxFilter,        0.5f    },      // IMAGE_RESAMPLE_FILTER_BOX
+    { TriangleFilter,   1.0f    },      // IMAGE_RESAMPLE_FILTER_TRIANGLE
+    { MitchellFilter,   2.0f    },      // IMAGE_RESAMPLE_FILTER_MITCHELL
+    { Lanczos3Filter,   3.0f    },      // IMAGE_RESAMPLE_FILTER_LANCZOS3
+};
+
+//------------------------------------------------------------------ Weight tables --------------------------------------------------------------------------------------------------------
+
+// Weights for one axis. Every destination pixel uses TapCount consecutive source pixels from FirstSource, windows
+// clipped by the edges are shifted inside the image and padded with zero weights, so the passes have no edge cases.
+struct AxisWeights
+{
+    uint32 TapCount;
+    PODArray<uint32> FirstSource;       // per destination pixel
+    PODArray<float> Weights;            // TapCount per destination pixel
+};
+
+static void BuildAxisWeights(AxisWeights *pAxis, uint32 sourceSize, uint32 destinationSize, const ResampleFilter *pFilter)
+{
+    // when minifying the filter is stretched over the source pixels covered by one destination pixel
+    float scale = (float)destinationSize / (float)sourceSize;
+    float stretch = (scale < 1.0f) ? (1.0f / scale) : 1.0f;
+    float support = pFilter->Radius * stretch;
+
+    pAxis->TapCount = Min((uint32)floorf(support * 2.0f) + 2, sourceSize);
+    pAxis->FirstSource.Resize(destinationSize);
+    pAxis->Weights.Resize(destinationSize * pAxis->TapCount);
+
+    for (uint32 i = 0; i < destinationSize; i++)
+    {
+        float center = ((float)i + 0.5f) / scale - 0.5f;
+        int32 first = Max((int32)ceilf(center - support), 0);
+        int32 last = Min((int32)floorf(center + support), (int32)sourceSize - 1);
+        uint32 start = Min((uint32)Max(first, 0), sourceSize - pAxis->TapCount);
+        DebugAssert(last < (int32)(start + pAxis->TapCount));
+
+        float *pWeights = &pAxis->Weights[i * pAxis->TapCount];
+        Y_memzero(pWeights, sizeof(float) * pAxis->TapCount);
+
+        float totalWeight = 0.0f;
+        for (int32 j = first; j <= last; j++)
+        {
+            float weight = pFilter->Function(((float)j - center) / stretch);
+            pWeights[j - (int32)start] = weight;
+            totalWeight += weight;
+        }
+
+        // normalize so flat areas stay flat, including near the edges where part of the filter was clipped
+        if (totalWeight != 0.0f)
+        {
+            for (uint32 j = 0; j < pAxis->TapCount; j++)
+                pWeights[j] /= totalWeight;
+        }
+        else
+        {
+            int32 nearest = Min(Max((int32)floorf(center + 0.5f), 0), (int32)sourceSize - 1);
+            pWeights[nearest - (int32)start] = 1.0f;
+        }
+
+        pAxis->FirstSource[i] = start;
+    }
+}
+
+//------------------------------------------------------------------ Passes --------------------------------------------------------------------------------------------------------------
+
+struct ResampleJob
+{
+    const byte *pSourcePixels;
+    uint32 SourceWidth;
+    uint32 SourcePitch;
+    PIXEL_FORMAT SourceFormat;
+
+    byte *pDestinationPixels;
+    uint32 DestinationWidth;
+    uint32 DestinationPitch;
+    PIXEL_FORMAT DestinationFormat;
+
+    AxisWeights Horizontal;
+    AxisWeights Vertical;
+
+    // SourceHeight rows of DestinationWidth RGBA pixels
+    float *pIntermediate;
+};
+
+// filters one decoded source row into a row of the intermediate image
+static void FilterRowHorizontal(float *pDestination, const float *pSource, const AxisWeights *pAxis, uint32 destinationWidth)
+{
+    uint32 tapCount = pAxis->TapCount;
+    const float *pWeights = pAxis->Weights.GetBasePointer();
+
+    for (uint32 i = 0; i < destinationWidth; i++, pWeights += tapCount)
+    {
+        const float *pSourcePixel = pSource + pAxis->FirstSource[i] * 4;
+
+#if Y_CPU_SSE_LEVEL > 0
+        __m128 sum = _mm_setzero_ps();
+        for (uint32 j = 0; j < tapCount; j++)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps1(&pWeights[j]), _mm_loadu_ps(pSourcePixel + j * 4)));
+
+        _mm_storeu_ps(pDestination + i * 4, sum);
+#else
+        float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+        for (uint32 j = 0; j < tapCount; j++)
+        {
+            r += pWeights[j] * pSourcePixel[j * 4 + 0];
+            g += pWeights[j] * pSourcePixel[j * 4 + 1];
+            b += pWeights[j] * pSourcePixel[j * 4 + 2];
+            a += pWeights[j] * pSourcePixel[j * 4 + 3];
+        }
+
+        pDestination[i * 4 + 0] = r;
+        pDestination[i * 4 + 1] = g;
+        pDestination[i * 4 + 2] = b;
+        pDestination[i * 4 + 3] = a;
+#endif
+    }
+}
+
+// produces one destination row as the weighted sum of intermediate rows
+static void FilterRowVertical(float *pDestination, const float *pIntermediate, const float *pWeights, uint32 firstRow, uint32 tapCount, uint32 componentCount)
+{
+    const float *pSourceRow = pIntermediate + (size_t)firstRow * componentCount;
+    Y_memzero(pDestination, sizeof(float) * componentCount);
+
+    for (uint32 j = 0; j < tapCount; j++, pSourceRow += componentCount)
+    {
+        float weight = pWeights[j];
+        if (weight == 0.0f)
+            continue;
+
+        uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+        __m128 weightVector = _mm_set_ps1(weight);
+        for (; (i + 8) <= componentCount; i += 8)
+        {
+            _mm_storeu_ps(pDestination + i, _mm_add_ps(_mm_loadu_ps(pDestination + i), _mm_mul_ps(weightVector, _mm_loadu_ps(pSourceRow + i))));
+            _mm_storeu_ps(pDestination + i + 4, _mm_add_ps(_mm_loadu_ps(pDestination + i + 4), _mm_mul_ps(weightVector, _mm_loadu_ps(pSourceRow + i + 4))));
+        }
+#endif
+
+        for (; i < componentCount; i++)
+            pDestination[i] += weight * pSourceRow[i];
+    }
+}
+
+// decodes and horizontally filters source rows [firstRow, endRow), pScratch holds ROW_BATCH_SIZE decoded rows
+static void HorizontalPass(const ResampleJob *pJob, uint32 firstRow, uint32 endRow, float *pScratch)
+{
+    for (uint32 batchStart = firstRow; batchStart < endRow; batchStart += ROW_BATCH_SIZE)
+    {
+        uint32 batchRows = Min(ROW_BATCH_SIZE, endRow - batchStart);
+        PixelFormat_DecodePixels(pJob->SourceWidth, batchRows, pJob->pSourcePixels + (size_t)batchStart * pJob->SourcePitch, pJob->SourcePitch, pJob->SourceFormat, pScratch);
+
+        for (uint32 i = 0; i < batchRows; i++)
+        {
+            FilterRowHorizontal(pJob->pIntermediate + (size_t)(batchStart + i) * pJob->DestinationWidth * 4, pScratch + (size_t)i * pJob->SourceWidth * 4,
+                                &pJob->Horizontal, pJob->DestinationWidth);
+        }
+    }
+}
+
+// vertically filters and encodes destination rows [firstRow, endRow), pScratch holds ROW_BATCH_SIZE filtered rows
+static void VerticalPass(const ResampleJob *pJob, uint32 firstRow, uint32 endRow, float *pScratch)
+{
+    uint32 componentCount = pJob->DestinationWidth * 4;
+    uint32 tapCount = pJob->Vertical.TapCount;
+
+    for (uint32 batchStart = firstRow; batchStart < endRow; batchStart += ROW_BATCH_SIZE)
+    {
+        uint32 batchRows = Min(ROW_BATCH_SIZE, endRow - batchStart);
+        for (uint32 i = 0; i < batchRows; i++)
+        {
+            uint32 row = batchStart + i;
+            FilterRowVertical(pScratch + (size_t)i * componentCount, pJob->pIntermediate, &pJob->Vertical.Weights[row * tapCount],
+                              pJob->Vertical.FirstSource[row], tapCount, componentCount);
+        }
+
+        PixelFormat_EncodePixels(pJob->DestinationWidth, batchRows, pScratch, pJob->pDestinationPixels + (size_t)batchStart * pJob->DestinationPitch, pJob->DestinationPitch, pJob->DestinationFormat);
+    }
+}
+
+// Splits rowCount rows into one band per thread and runs pass on each, the calling thread takes the first band.
+static void RunPass(void(*pass)(const ResampleJob *, uint32, uint32, float *), const ResampleJob *pJob, uint32 rowCount, uint32 threadCount, float *pScratch, uint32 scratchFloatsPerThread)
+{
+    threadCount = Min(threadCount, rowCount);
+    uint32 rowsPerThread = (rowCount + threadCount - 1) / threadCount;
+
+    PODArray<std::thread *> threads;
+    for (uint32 i = 1; i < threadCount; i++)
+    {
+        uint32 firstRow = i * rowsPerThread;
+        if (firstRow >= rowCount)
+            break;
+
+        uint32 endRow = Min(firstRow + rowsPerThread, rowCount);
+        float *pThreadScratch = pScratch + (size_t)i * scratchFloatsPerThread;
+        threads.Add(new std::thread([pass, pJob, firstRow, endRow, pThreadScratch]() { pass(pJob, firstRow, endRow, pThreadScratch); }));
+    }
+
+    pass(pJob, 0, Min(rowsPerThread, rowCount), pScratch);
+
+    for (uint32 i = 0; i < threads.GetSize(); i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
+
+bool ImageResampler::Resample(const void *pSourcePixels, uint32 sourceWidth, uint32 sourceHeight, uint32 sourcePitch, PIXEL_FORMAT sourceFormat,
+                              void *pDestinationPixels, uint32 destinationWidth, uint32 destinationHeight, uint32 destinationPitch, PIXEL_FORMAT destinationFormat,
+                              IMAGE_RESAMPLE_FILTER filter, uint32 threadCount /* = 0 */)
+{
+    DebugAssert(filter < IMAGE_RESAMPLE_FILTER_COUNT);
+    if (sourceWidth == 0 || sourceHeight == 0 || destinationWidth == 0 || destinationHeight == 0)
+    {
+        Log_ErrorPrintf("ImageResampler::Resample: Invalid dimensions %ux%u -> %ux%u", sourceWidth, sourceHeight, destinationWidth, destinationHeight);
+        return false;
+    }
+
+    if (PixelFormat_GetPixelFormatInfo(sourceFormat)->IsBlockCompressed || !PixelFormat_IsConvertible(sourceFormat) ||
+        PixelFormat_GetPixelFormatInfo(destinationFormat)->IsBlockCompressed || !PixelFormat_IsConvertible(destinationFormat))
+    {
+        Log_ErrorPrintf("ImageResampler::Resample: Can't resample from %s to %s", PixelFormat_GetPixelFormatName(sourceFormat), PixelFormat_GetPixelFormatName(destinationFormat));
+        return false;
+    }
+
+    ResampleJob job;
+    job.pSourcePixels = reinterpret_cast<const byte *>(pSourcePixels);
+    job.SourceWidth = sourceWidth;
+    job.SourcePitch = sourcePitch;
+    job.SourceFormat = sourceFormat;
+    job.pDestinationPixels = reinterpret_cast<byte *>(pDestinationPixels);
+    job.DestinationWidth = destinationWidth;
+    job.DestinationPitch = destinationPitch;
+    job.DestinationFormat = destinationFormat;
+    BuildAxisWeights(&job.Horizontal, sourceWidth, destinationWidth, &s_filters[filter]);
+    BuildAxisWeights(&job.Vertical, sourceHeight, destinationHeight, &s_filters[filter]);
+
+    if (threadCount == 0)
+        threadCount = Max(std::thread::hardware_concurrency(), 1u);
+    threadCount = Max(Min(threadCount, (destinationWidth * destinationHeight) / MIN_PIXELS_PER_THREAD), 1u);
+
+    // the intermediate image and every thread's batch of rows come from a single allocation
+    uint32 scratchFloatsPerThread = Max(sourceWidth, destinationWidth) * 4 * ROW_BATCH_SIZE;
+    size_t intermediateFloats = (size_t)sourceHeight * destinationWidth * 4;
+    float *pMemory = Y_mallocT<float>(intermediateFloats + (size_t)scratchFloatsPerThread * threadCount);
+    job.pIntermediate = pMemory;
+    float *pScratch = pMemory + intermediateFloats;
+
+    RunPass(HorizontalPass, &job, sourceHeight, threadCount, pScratch, scratchFloatsPerThread);
+    RunPass(VerticalPass, &job, destinationHeight, threadCount, pScratch, scratchFloatsPerThread);
+
+    Y_free(pMemory);
+    return true;
+}
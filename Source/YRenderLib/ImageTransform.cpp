@@ -0,0 +1,418 @@
+#include "YBaseLib/Assert.h"
+#include "YBaseLib/Math.h"
+#include "YBaseLib/Memory.h"
+#include "YBaseLib/Log.h"
+#include "YRenderLib/ImageTransform.h"
+Log_SetChannel(ImageTransform);
+
+#if Y_CPU_SSE_LEVEL > 0
+    #include <intrin.h>
+#endif
+
+// largest element the in-place transforms can swap, R32G32B32A32 or a 16-byte compressed block
+static const uint32 MAX_IN_PLACE_ELEMENT_SIZE = 16;
+
+// transposes work on square tiles of this many bytes per row, so a tile of source and destination rows stays in L1
+static const uint32 TILE_ROW_BYTES = 128;
+
+static inline uint32 GetTileSize(uint32 elementSize)
+{
+    return Max(TILE_ROW_BYTES / elementSize, (uint32)8);
+}
+
+static inline void CopyElement(byte *pDestination, const byte *pSource, uint32 elementSize)
+{
+    // constant sizes so the common cases become single moves
+    switch (elementSize)
+    {
+    case 1:     *pDestination = *pSource;                           break;
+    case 2:     Y_memcpy(pDestination, pSource, 2);                 break;
+    case 4:     Y_memcpy(pDestination, pSource, 4);                 break;
+    case 8:     Y_memcpy(pDestination, pSource, 8);                 break;
+    case 16:    Y_memcpy(pDestination, pSource, 16);                break;
+    default:    Y_memcpy(pDestination, pSource, elementSize);       break;
+    }
+}
+
+static inline void SwapElements(byte *pFirst, byte *pSecond, uint32 elementSize)
+{
+    byte temp[MAX_IN_PLACE_ELEMENT_SIZE];
+    CopyElement(temp, pFirst, elementSize);
+    CopyElement(pFirst, pSecond, elementSize);
+    CopyElement(pSecond, temp, elementSize);
+}
+
+// swaps two non-overlapping ranges without a temporary buffer
+static void SwapMemory(byte *pFirst, byte *pSecond, uint32 size)
+{
+    uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+    for (; (i + 16) <= size; i += 16)
+    {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pFirst + i));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSecond + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pFirst + i), second);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pSecond + i), first);
+    }
+#else
+    for (; (i + 8) <= size; i += 8)
+    {
+        uint64 first, second;
+        Y_memcpy(&first, pFirst + i, 8);
+        Y_memcpy(&second, pSecond + i, 8);
+        Y_memcpy(pFirst + i, &second, 8);
+        Y_memcpy(pSecond + i, &first, 8);
+    }
+#endif
+
+    for (; i < size; i++)
+    {
+        byte temp = pFirst[i];
+        pFirst[i] = pSecond[i];
+        pSecond[i] = temp;
+    }
+}
+
+//------------------------------------------------------------------ Rows --------------------------------------------------------------------------------------------------------------
+
+static void CopyRows(byte *pDestination, uint32 destinationPitch, const byte *pSource, uint32 sourcePitch, uint32 rowSize, uint32 height, bool reverseOrder)
+{
+    for (uint32 y = 0; y < height; y++)
+    {
+        uint32 destinationY = (reverseOrder) ? (height - 1 - y) : y;
+        Y_memcpy(pDestination + (size_t)destinationY * destinationPitch, pSource + (size_t)y * sourcePitch, rowSize);
+    }
+}
+
+// pDestination[i] = pSource[width - 1 - i]
+static void ReverseRow(byte *pDestination, const byte *pSource, uint32 width, uint32 elementSize)
+{
+    uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+    if (elementSize == 4)
+    {
+        for (; (i + 4) <= width; i += 4)
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource + (width - 4 - i) * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(pDestination + i * 4), _mm_shuffle_epi32(values, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+    }
+#endif
+
+    for (; i < width; i++)
+        CopyElement(pDestination + i * elementSize, pSource + (width - 1 - i) * elementSize, elementSize);
+}
+
+static void ReverseRowInPlace(byte *pRow, uint32 width, uint32 elementSize)
+{
+    // [left, right) is the part still to be reversed
+    uint32 left = 0;
+    uint32 right = width;
+
+#if Y_CPU_SSE_LEVEL > 0
+    if (elementSize == 4)
+    {
+        for (; (right - left) >= 8; left += 4, right -= 4)
+        {
+            __m128i leftValues = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow + left * 4));
+            __m128i rightValues = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow + (right - 4) * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(pRow + left * 4), _mm_shuffle_epi32(rightValues, _MM_SHUFFLE(0, 1, 2, 3)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(pRow + (right - 4) * 4), _mm_shuffle_epi32(leftValues, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+    }
+#endif
+
+    for (; (right - left) >= 2; left++)
+    {
+        right--;
+        SwapElements(pRow + left * elementSize, pRow + right * elementSize, elementSize);
+    }
+}
+
+//------------------------------------------------------------------ Transposes --------------------------------------------------------------------------------------------------------
+
+#if Y_CPU_SSE_LEVEL > 0
+
+// transposes a full tile of 4-byte elements as 4x4 blocks, see TransposeElements for the flips
+static void TransposeTile4x4(byte *pDestination, uint32 destinationPitch, const byte *pSource, uint32 sourcePitch, uint32 width, uint32 height,
+                             uint32 tileX, uint32 tileY, uint32 tileSize, bool flipRows, bool flipColumns)
+{
+    for (uint32 blockY = tileY; blockY < (tileY + tileSize); blockY += 4)
+    {
+        const byte *pSourceBlock = pSource + (size_t)blockY * sourcePitch;
+        uint32 destinationColumn = (flipColumns) ? (height - 4 - blockY) : blockY;
+
+        for (uint32 blockX = tileX; blockX < (tileX + tileSize); blockX += 4)
+        {
+            __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSourceBlock + blockX * 4));
+            __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSourceBlock + sourcePitch + blockX * 4));
+            __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSourceBlock + sourcePitch * 2 + blockX * 4));
+            __m128i row3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSourceBlock + sourcePitch * 3 + blockX * 4));
+
+            __m128i temp0 = _mm_unpacklo_epi32(row0, row1);
+            __m128i temp1 = _mm_unpacklo_epi32(row2, row3);
+            __m128i temp2 = _mm_unpackhi_epi32(row0, row1);
+            __m128i temp3 = _mm_unpackhi_epi32(row2, row3);
+
+            // columns of the source block, lanes in ascending source row order
+            __m128i columns[4] =
+            {
+                _mm_unpacklo_epi64(temp0, temp1),
+                _mm_unpackhi_epi64(temp0, temp1),
+                _mm_unpacklo_epi64(temp2, temp3),
+                _mm_unpackhi_epi64(temp2, temp3),
+            };
+
+            for (uint32 i = 0; i < 4; i++)
+            {
+                uint32 destinationRow = (flipRows) ? (width - 1 - (blockX + i)) : (blockX + i);
+                __m128i values = (flipColumns) ? _mm_shuffle_epi32(columns[i], _MM_SHUFFLE(0, 1, 2, 3)) : columns[i];
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(pDestination + (size_t)destinationRow * destinationPitch + destinationColumn * 4), values);
+            }
+        }
+    }
+}
+
+#endif
+
+// Source element (x, y) goes to destination row x and column y, mirrored to width - 1 - x and height - 1 - y by the flags.
+// This covers the transpose, transverse and both 90 degree rotations.
+static void TransposeElements(byte *pDestination, uint32 destinationPitch, const byte *pSource, uint32 sourcePitch, uint32 width, uint32 height, uint32 elementSize,
+                              bool flipRows, bool flipColumns)
+{
+    uint32 tileSize = GetTileSize(elementSize);
+
+    for (uint32 tileY = 0; tileY < height; tileY += tileSize)
+    {
+        uint32 tileEndY = Min(tileY + tileSize, height);
+        for (uint32 tileX = 0; tileX < width; tileX += tileSize)
+        {
+            uint32 tileEndX = Min(tileX + tileSize, width);
+
+#if Y_CPU_SSE_LEVEL > 0
+            // partial tiles at the right and bottom edges go through the generic path
+            if (elementSize == 4 && (tileEndX - tileX) == tileSize && (tileEndY - tileY) == tileSize)
+            {
+                TransposeTile4x4(pDestination, destinationPitch, pSource, sourcePitch, width, height, tileX, tileY, tileSize, flipRows, flipColumns);
+                continue;
+            }
+#endif
+
+            for (uint32 y = tileY; y < tileEndY; y++)
+            {
+                const byte *pSourceRow = pSource + (size_t)y * sourcePitch;
+                uint32 destinationColumn = (flipColumns) ? (height - 1 - y) : y;
+                for (uint32 x = tileX; x < tileEndX; x++)
+                {
+                    uint32 destinationRow = (flipRows) ? (width - 1 - x) : x;
+                    CopyElement(pDestination + (size_t)destinationRow * destinationPitch + destinationColumn * elementSize, pSourceRow + x * elementSize, elementSize);
+                }
+            }
+        }
+    }
+}
+
+// swaps the upper and lower triangles tile by tile, so both sides of each swap stay in cache
+static void TransposeSquareInPlace(byte *pPixels, uint32 pitch, uint32 size, uint32 elementSize)
+{
+    uint32 tileSize = GetTileSize(elementSize);
+
+    for (uint32 tileY = 0; tileY < size; tileY += tileSize)
+    {
+        uint32 tileEndY = Min(tileY + tileSize, size);
+        for (uint32 tileX = tileY; tileX < size; tileX += tileSize)
+        {
+            uint32 tileEndX = Min(tileX + tileSize, size);
+            for (uint32 y = tileY; y < tileEndY; y++)
+            {
+                for (uint32 x = Max(tileX, y + 1); x < tileEndX; x++)
+                    SwapElements(pPixels + (size_t)y * pitch + x * elementSize, pPixels + (size_t)x * pitch + y * elementSize, elementSize);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------ Interface ---------------------------------------------------------------------------------------------------------
+
+bool ImageTransform::SwapsDimensions(IMAGE_TRANSFORM transform)
+{
+    return (transform == IMAGE_TRANSFORM_ROTATE_90 || transform == IMAGE_TRANSFORM_ROTATE_270 || transform == IMAGE_TRANSFORM_TRANSPOSE || transform == IMAGE_TRANSFORM_TRANSVERSE);
+}
+
+void ImageTransform::TransformElements(void *pDestination, uint32 destinationPitch, const void *pSource, uint32 sourcePitch, uint32 width, uint32 height, uint32 elementSize, IMAGE_TRANSFORM transform)
+{
+    DebugAssert(elementSize > 0 && transform < IMAGE_TRANSFORM_COUNT);
+    byte *pDestinationBytes = reinterpret_cast<byte *>(pDestination);
+    const byte *pSourceBytes = reinterpret_cast<const byte *>(pSource);
+
+    switch (transform)
+    {
+    case IMAGE_TRANSFORM_IDENTITY:
+        CopyRows(pDestinationBytes, destinationPitch, pSourceBytes, sourcePitch, width * elementSize, height, false);
+        break;
+
+    case IMAGE_TRANSFORM_FLIP_VERTICAL:
+        CopyRows(pDestinationBytes, destinationPitch, pSourceBytes, sourcePitch, width * elementSize, height, true);
+        break;
+
+    case IMAGE_TRANSFORM_FLIP_HORIZONTAL:
+        for (uint32 y = 0; y < height; y++)
+            ReverseRow(pDestinationBytes + (size_t)y * destinationPitch, pSourceBytes + (size_t)y * sourcePitch, width, elementSize);
+        break;
+
+    case IMAGE_TRANSFORM_ROTATE_180:
+        for (uint32 y = 0; y < height; y++)
+            ReverseRow(pDestinationBytes + (size_t)(height - 1 - y) * destinationPitch, pSourceBytes + (size_t)y * sourcePitch, width, elementSize);
+        break;
+
+    case IMAGE_TRANSFORM_ROTATE_90:
+        TransposeElements(pDestinationBytes, destinationPitch, pSourceBytes, sourcePitch, width, height, elementSize, false, true);
+        break;
+
+    case IMAGE_TRANSFORM_ROTATE_270:
+        TransposeElements(pDestinationBytes, destinationPitch, pSourceBytes, sourcePitch, width, height, elementSize, true, false);
+        break;
+
+    case IMAGE_TRANSFORM_TRANSPOSE:
+        TransposeElements(pDestinationBytes, destinationPitch, pSourceBytes, sourcePitch, width, height, elementSize, false, false);
+        break;
+
+    case IMAGE_TRANSFORM_TRANSVERSE:
+        TransposeElements(pDestinationBytes, destinationPitch, pSourceBytes, sourcePitch, width, height, elementSize, true, true);
+        break;
+
+    default:
+        break;
+    }
+}
+
+bool ImageTransform::TransformElementsInPlace(void *pPixels, uint32 pitch, uint32 width, uint32 height, uint32 elementSize, IMAGE_TRANSFORM transform)
+{
+    DebugAssert(elementSize > 0 && transform < IMAGE_TRANSFORM_COUNT);
+    if (elementSize > MAX_IN_PLACE_ELEMENT_SIZE)
+    {
+        Log_ErrorPrintf("ImageTransform::TransformElementsInPlace: Element size %u is too large", elementSize);
+        return false;
+    }
+    if (SwapsDimensions(transform) && width != height)
+    {
+        Log_ErrorPrintf("ImageTransform::TransformElementsInPlace: Can't rotate or transpose a %ux%u image in place", width, height);
+        return false;
+    }
+
+    byte *pBytes = reinterpret_cast<byte *>(pPixels);
+    uint32 rowSize = width * elementSize;
+
+    // the rotations are a transpose followed by a flip
+    if (SwapsDimensions(transform))
+    {
+        TransposeSquareInPlace(pBytes, pitch, width, elementSize);
+        switch (transform)
+        {
+        case IMAGE_TRANSFORM_ROTATE_90:     transform = IMAGE_TRANSFORM_FLIP_HORIZONTAL;    break;
+        case IMAGE_TRANSFORM_ROTATE_270:    transform = IMAGE_TRANSFORM_FLIP_VERTICAL;      break;
+        case IMAGE_TRANSFORM_TRANSVERSE:    transform = IMAGE_TRANSFORM_ROTATE_180;         break;
+        default:                            transform = IMAGE_TRANSFORM_IDENTITY;           break;
+        }
+    }
+
+    switch (transform)
+    {
+    case IMAGE_TRANSFORM_FLIP_VERTICAL:
+        for (uint32 y = 0; y < height / 2; y++)
+            SwapMemory(pBytes + (size_t)y * pitch, pBytes + (size_t)(height - 1 - y) * pitch, rowSize);
+        break;
+
+    case IMAGE_TRANSFORM_FLIP_HORIZONTAL:
+        for (uint32 y = 0; y < height; y++)
+            ReverseRowInPlace(pBytes + (size_t)y * pitch, width, elementSize);
+        break;
+
+    case IMAGE_TRANSFORM_ROTATE_180:
+        for (uint32 y = 0; y < height / 2; y++)
+        {
+            byte *pTopRow = pBytes + (size_t)y * pitch;
+            byte *pBottomRow = pBytes + (size_t)(height - 1 - y) * pitch;
+            ReverseRowInPlace(pTopRow, width, elementSize);
+            ReverseRowInPlace(pBottomRow, width, elementSize);
+            SwapMemory(pTopRow, pBottomRow, rowSize);
+        }
+        if (height & 1)
+            ReverseRowInPlace(pBytes + (size_t)(height / 2) * pitch, width, elementSize);
+        break;
+
+    default:
+        break;
+    }
+
+    return true;
+}
+
+// element size and dimensions in elements, which are blocks for block-compressed formats
+static bool GetElementLayout(PIXEL_FORMAT format, uint32 width, uint32 height, uint32 *pElementSize, uint32 *pElementsWide, uint32 *pElementsHigh)
+{
+    const PIXEL_FORMAT_INFO *pFormatInfo = PixelFormat_GetPixelFormatInfo(format);
+    if (pFormatInfo->IsBlockCompressed)
+    {
+        *pElementSize = pFormatInfo->BytesPerBlock;
+        *pElementsWide = (width + pFormatInfo->BlockSize - 1) / pFormatInfo->BlockSize;
+        *pElementsHigh = (height + pFormatInfo->BlockSize - 1) / pFormatInfo->BlockSize;
+        return true;
+    }
+
+    if (pFormatInfo->BitsPerPixel == 0 || (pFormatInfo->BitsPerPixel % 8) != 0)
+    {
+        Log_ErrorPrintf("ImageTransform: Can't transform %s images", PixelFormat_GetPixelFormatName(format));
+        return false;
+    }
+
+    *pElementSize = pFormatInfo->BitsPerPixel / 8;
+    *pElementsWide = width;
+    *pElementsHigh = height;
+    return true;
+}
+
+bool ImageTransform::TransformImage(void *pDestination, uint32 destinationPitch, const void *pSource, uint32 sourcePitch, PIXEL_FORMAT format, uint32 width, uint32 height, IMAGE_TRANSFORM transform)
+{
+    uint32 elementSize, elementsWide, elementsHigh;
+    if (!GetElementLayout(format, width, height, &elementSize, &elementsWide, &elementsHigh))
+        return false;
+
+    TransformElements(pDestination, destinationPitch, pSource, sourcePitch, elementsWide, elementsHigh, elementSize, transform);
+    return true;
+}
+
+bool ImageTransform::TransformImageInPlace(void *pPixels, uint32 pitch, PIXEL_FORMAT format, uint32 width, uint32 height, IMAGE_TRANSFORM transform)
+{
+    uint32 elementSize, elementsWide, elementsHigh;
+    if (!GetElementLayout(format, width, height, &elementSize, &elementsWide, &elementsHigh))
+        return false;
+
+    return TransformElementsInPlace(pPixels, pitch, elementsWide, elementsHigh, elementSize, transform);
+}
+
+bool ImageTransform::TransformCubemapFaces(void *const *ppDestinationFaces, uint32 destinationPitch, const void *const *ppSourceFaces, uint32 sourcePitch, PIXEL_FORMAT format, uint32 faceSize,
+                                           const CUBEMAP_FACE_TRANSFORM *pFaceTransforms)
+{
+    for (uint32 i = 0; i < CUBEMAP_FACE_COUNT; i++)
+    {
+        DebugAssert(pFaceTransforms[i].SourceFace < CUBEMAP_FACE_COUNT);
+        if (!TransformImage(ppDestinationFaces[i], destinationPitch, ppSourceFaces[pFaceTransforms[i].SourceFace], sourcePitch, format, faceSize, faceSize, pFaceTransforms[i].Transform))
+            return false;
+    }
+
+    return true;
+}
+
+// Negating z swaps the Z faces, and mirrors every face along whichever of its axes followed z.
+const CUBEMAP_FACE_TRANSFORM ImageTransform::CubemapMirrorZFaceTransforms[CUBEMAP_FACE_COUNT] =
+{
+    { CUBEMAP_FACE_POSITIVE_X,      IMAGE_TRANSFORM_FLIP_HORIZONTAL     },      // CUBEMAP_FACE_POSITIVE_X
+    { CUBEMAP_FACE_NEGATIVE_X,      IMAGE_TRANSFORM_FLIP_HORIZONTAL     },      // CUBEMAP_FACE_NEGATIVE_X
+    { CUBEMAP_FACE_POSITIVE_Y,      IMAGE_TRANSFORM_FLIP_VERTICAL       },      // CUBEMAP_FACE_POSITIVE_Y
+    { CUBEMAP_FACE_NEGATIVE_Y,      IMAGE_TRANSFORM_FLIP_VERTICAL       },      // CUBEMAP_FACE_NEGATIVE_Y
+    { CUBEMAP_FACE_NEGATIVE_Z,      IMAGE_TRANSFORM_FLIP_HORIZONTAL     },      // CUBEMAP_FACE_POSITIVE_Z
+    { CUBEMAP_FACE_POSITIVE_Z,      IMAGE_TRANSFORM_FLIP_HORIZONTAL     },      // CUBEMAP_FACE_NEGATIVE_Z
+};
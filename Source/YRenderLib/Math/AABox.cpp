@@ -3,6 +3,7 @@
 #include "YRenderLib/Math/CollisionDetection.h"
 #include "YRenderLib/Math/Transform.h"
 #include "YRenderLib/Math/Sphere.h"
+#include "YRenderLib/Math/SIMDLanes.h"
 #include "YBaseLib/Assert.h"
 #include "YBaseLib/Memory.h"
 
@@ -342,40 +343,47 @@ AABox &AABox::operator=(const AABox &rCopy)
     return *this;
 }
 
-AABox AABox::FromPoints(const SIMDVector3f *pPoints, uint32 nPoints)
+// eight points per iteration into two independent sets of accumulators
+template<typename POINT_TYPE>
+static AABox ComputeBoundsFromPoints(const POINT_TYPE *pPoints, uint32 nPoints)
 {
     Assert(nPoints > 0);
 
-    SIMDVector3f minBounds(pPoints[0]);
-    SIMDVector3f maxBounds(minBounds);
+    Lanes x, y, z;
+    LanesLoadPointsPartial(pPoints, Min(nPoints, (uint32)4), x, y, z);
+    Lanes minX0 = x, minY0 = y, minZ0 = z, maxX0 = x, maxY0 = y, maxZ0 = z;
+    Lanes minX1 = x, minY1 = y, minZ1 = z, maxX1 = x, maxY1 = y, maxZ1 = z;
 
-    uint32 i;
-    for (i = 1; i < nPoints; i++)
+    uint32 i = 0;
+    for (; (i + 8) <= nPoints; i += 8)
+    {
+        Lanes x1, y1, z1;
+        LanesLoadPoints(pPoints + i, x, y, z);
+        LanesLoadPoints(pPoints + i + 4, x1, y1, z1);
+        minX0 = LanesMin(minX0, x); minY0 = LanesMin(minY0, y); minZ0 = LanesMin(minZ0, z);
+        maxX0 = LanesMax(maxX0, x); maxY0 = LanesMax(maxY0, y); maxZ0 = LanesMax(maxZ0, z);
+        minX1 = LanesMin(minX1, x1); minY1 = LanesMin(minY1, y1); minZ1 = LanesMin(minZ1, z1);
+        maxX1 = LanesMax(maxX1, x1); maxY1 = LanesMax(maxY1, y1); maxZ1 = LanesMax(maxZ1, z1);
+    }
+    for (; i < nPoints; i += 4)
     {
-        const SIMDVector3f point(pPoints[i]);
-        minBounds = minBounds.Min(point);
-        maxBounds = maxBounds.Max(point);
+        LanesLoadPointsPartial(pPoints + i, Min(nPoints - i, (uint32)4), x, y, z);
+        minX0 = LanesMin(minX0, x); minY0 = LanesMin(minY0, y); minZ0 = LanesMin(minZ0, z);
+        maxX0 = LanesMax(maxX0, x); maxY0 = LanesMax(maxY0, y); maxZ0 = LanesMax(maxZ0, z);
     }
 
-    return AABox(minBounds, maxBounds);
+    return AABox(LanesReduceMin(LanesMin(minX0, minX1)), LanesReduceMin(LanesMin(minY0, minY1)), LanesReduceMin(LanesMin(minZ0, minZ1)),
+                 LanesReduceMax(LanesMax(maxX0, maxX1)), LanesReduceMax(LanesMax(maxY0, maxY1)), LanesReduceMax(LanesMax(maxZ0, maxZ1)));
 }
 
-AABox AABox::FromPoints(const Vector3f *pPoints, uint32 nPoints)
+AABox AABox::FromPoints(const SIMDVector3f *pPoints, uint32 nPoints)
 {
-    Assert(nPoints > 0);
-
-    SIMDVector3f minBounds(pPoints[0]);
-    SIMDVector3f maxBounds(minBounds);
-
-    uint32 i;
-    for (i = 1; i < nPoints; i++)
-    {
-        const SIMDVector3f point(pPoints[i]);
-        minBounds = minBounds.Min(point);
-        maxBounds = maxBounds.Max(point);
-    }
+    return ComputeBoundsFromPoints(pPoints, nPoints);
+}
 
-    return AABox(minBounds, maxBounds);
+AABox AABox::FromPoints(const Vector3f *pPoints, uint32 nPoints)
+{
+    return ComputeBoundsFromPoints(pPoints, nPoints);
 }
 
 AABox AABox::FromSphere(const Sphere &sphere)
@@ -2,84 +2,222 @@
 #include "YRenderLib/Math/Vectorf.h"
 #include "YRenderLib/Math/Vectori.h"
 #include "YRenderLib/Math/Vectoru.h"
+#include "YBaseLib/Memory.h"
 
-HashType HashTrait<Vector2f>::GetHash(const Vector2f &Value)
+#if Y_CPU_SSE_LEVEL > 0
+    #include <intrin.h>
+#endif
+
+// Vectors hash as XXH32 (seed 0) of their components' bytes, which fully mixes every input bit, so grid-aligned
+// positions and small integer coordinates spread evenly over the table. Float components have -0 folded into +0
+// first, as they compare equal. The array versions run the same rounds on four vectors at a time, and
+// HashTrait_HashBytes runs them over arbitrary keys. Only XXH32's short input rounds are used, whatever the length.
+
+static const uint32 PRIME32_1 = 0x9E3779B1u;
+static const uint32 PRIME32_2 = 0x85EBCA77u;
+static const uint32 PRIME32_3 = 0xC2B2AE3Du;
+static const uint32 PRIME32_4 = 0x27D4EB2Fu;
+static const uint32 PRIME32_5 = 0x165667B1u;
+static const uint32 NEGATIVE_ZERO_BITS = 0x80000000u;
+
+static inline uint32 FloatHashBits(float value)
 {
-    uint32 xhash = *(uint32 *)&Value.x;
-    uint32 yhash = *(uint32 *)&Value.y;
+    uint32 bits;
+    Y_memcpy(&bits, &value, sizeof(bits));
+    return (bits != NEGATIVE_ZERO_BITS) ? bits : 0;
+}
 
-    return (xhash + yhash * 37);
+static inline uint32 RotateLeft(uint32 value, uint32 count)
+{
+    return (value << count) | (value >> (32 - count));
 }
 
-HashType HashTrait<Vector3f>::GetHash(const Vector3f &Value)
+static inline uint32 HashRound(uint32 hash, uint32 word)
 {
-    uint32 xhash = *(uint32 *)&Value.x;
-    uint32 yhash = *(uint32 *)&Value.y;
-    uint32 zhash = *(uint32 *)&Value.z;
+    return RotateLeft(hash + word * PRIME32_3, 17) * PRIME32_4;
+}
 
-    return (xhash + yhash * 37 + zhash * 101);
+static inline uint32 HashByteRound(uint32 hash, byte value)
+{
+    return RotateLeft(hash + value * PRIME32_5, 11) * PRIME32_1;
 }
 
-HashType HashTrait<Vector4f>::GetHash(const Vector4f &Value)
+static inline uint32 HashAvalanche(uint32 hash)
+{
+    hash ^= hash >> 15;
+    hash *= PRIME32_2;
+    hash ^= hash >> 13;
+    hash *= PRIME32_3;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+template<uint32 COMPONENTS>
+static inline uint32 HashComponents(const uint32 *pComponents)
 {
-    uint32 xhash = *(uint32 *)&Value.x;
-    uint32 yhash = *(uint32 *)&Value.y;
-    uint32 zhash = *(uint32 *)&Value.z;
-    uint32 whash = *(uint32 *)&Value.w;
+    uint32 hash = PRIME32_5 + COMPONENTS * sizeof(uint32);
+    for (uint32 i = 0; i < COMPONENTS; i++)
+        hash = HashRound(hash, pComponents[i]);
 
-    return (xhash + yhash * 37 + zhash * 101 + whash * 241);
+    return HashAvalanche(hash);
 }
 
-HashType HashTrait<Vector2i>::GetHash(const Vector2i &Value)
+#if Y_CPU_SSE_LEVEL > 0
+
+static inline __m128i Multiply4(__m128i a, __m128i b)
 {
-    uint32 xhash = *(uint32 *)&Value.x;
-    uint32 yhash = *(uint32 *)&Value.y;
+#if Y_CPU_SSE_LEVEL >= 4
+    return _mm_mullo_epi32(a, b);
+#else
+    // SSE2 only multiplies the even lanes
+    __m128i evenProducts = _mm_mul_epu32(a, b);
+    __m128i oddProducts = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(evenProducts, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(oddProducts, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
 
-    return (xhash + yhash * 37);
+template<uint32 COMPONENTS, bool FLOAT_COMPONENTS>
+static inline __m128i HashComponents4(const uint32 *pComponents)
+{
+    const __m128i prime2 = _mm_set1_epi32((int32)PRIME32_2);
+    const __m128i prime3 = _mm_set1_epi32((int32)PRIME32_3);
+    const __m128i prime4 = _mm_set1_epi32((int32)PRIME32_4);
+
+    __m128i hash = _mm_set1_epi32((int32)(PRIME32_5 + COMPONENTS * sizeof(uint32)));
+    for (uint32 i = 0; i < COMPONENTS; i++)
+    {
+        __m128i values = _mm_setr_epi32((int32)pComponents[i], (int32)pComponents[COMPONENTS + i], (int32)pComponents[COMPONENTS * 2 + i], (int32)pComponents[COMPONENTS * 3 + i]);
+        if (FLOAT_COMPONENTS)
+            values = _mm_andnot_si128(_mm_cmpeq_epi32(values, _mm_set1_epi32((int32)NEGATIVE_ZERO_BITS)), values);
+
+        hash = _mm_add_epi32(hash, Multiply4(values, prime3));
+        hash = Multiply4(_mm_or_si128(_mm_slli_epi32(hash, 17), _mm_srli_epi32(hash, 15)), prime4);
+    }
+
+    hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 15));
+    hash = Multiply4(hash, prime2);
+    hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 13));
+    hash = Multiply4(hash, prime3);
+    hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+    return hash;
 }
 
-HashType HashTrait<Vector3i>::GetHash(const Vector3i &Value)
+#endif
+
+template<uint32 COMPONENTS, bool FLOAT_COMPONENTS>
+static void HashComponentArray(HashType *pHashes, const uint32 *pComponents, uint32 count)
+{
+    uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+    for (; (i + 4) <= count; i += 4, pComponents += COMPONENTS * 4)
+    {
+        uint32 hashes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hashes), HashComponents4<COMPONENTS, FLOAT_COMPONENTS>(pComponents));
+        pHashes[i + 0] = hashes[0];
+        pHashes[i + 1] = hashes[1];
+        pHashes[i + 2] = hashes[2];
+        pHashes[i + 3] = hashes[3];
+    }
+#endif
+
+    for (; i < count; i++, pComponents += COMPONENTS)
+    {
+        uint32 components[COMPONENTS];
+        for (uint32 j = 0; j < COMPONENTS; j++)
+            components[j] = (FLOAT_COMPONENTS && pComponents[j] == NEGATIVE_ZERO_BITS) ? 0 : pComponents[j];
+
+        pHashes[i] = HashComponents<COMPONENTS>(components);
+    }
+}
+
+HashType HashTrait<Vector2f>::GetHash(const Vector2f &Value)
 {
-    uint32 xhash = *(uint32 *)&Value.x;
-    uint32 yhash = *(uint32 *)&Value.y;
-    uint32 zhash = *(uint32 *)&Value.z;
+    uint32 components[2] = { FloatHashBits(Value.x), FloatHashBits(Value.y) };
+    return HashComponents<2>(components);
+}
 
-    return (xhash + yhash * 37 + zhash * 101);
+HashType HashTrait<Vector3f>::GetHash(const Vector3f &Value)
+{
+    uint32 components[3] = { FloatHashBits(Value.x), FloatHashBits(Value.y), FloatHashBits(Value.z) };
+    return HashComponents<3>(components);
 }
 
-HashType HashTrait<Vector4i>::GetHash(const Vector4i &Value)
+HashType HashTrait<Vector4f>::GetHash(const Vector4f &Value)
 {
-    uint32 xhash = *(uint32 *)&Value.x;
-    uint32 yhash = *(uint32 *)&Value.y;
-    uint32 zhash = *(uint32 *)&Value.z;
-    uint32 whash = *(uint32 *)&Value.w;
+    uint32 components[4] = { FloatHashBits(Value.x), FloatHashBits(Value.y), FloatHashBits(Value.z), FloatHashBits(Value.w) };
+    return HashComponents<4>(components);
+}
 
-    return (xhash + yhash * 37 + zhash * 101 + whash * 241);
+HashType HashTrait<Vector2i>::GetHash(const Vector2i &Value)
+{
+    uint32 components[2] = { (uint32)Value.x, (uint32)Value.y };
+    return HashComponents<2>(components);
 }
 
-HashType HashTrait<Vector2u>::GetHash(const Vector2u &Value)
+HashType HashTrait<Vector3i>::GetHash(const Vector3i &Value)
 {
-    uint32 xhash = Value.x;
-    uint32 yhash = Value.y;
+    uint32 components[3] = { (uint32)Value.x, (uint32)Value.y, (uint32)Value.z };
+    return HashComponents<3>(components);
+}
 
-    return (xhash + yhash * 37);
+HashType HashTrait<Vector4i>::GetHash(const Vector4i &Value)
+{
+    uint32 components[4] = { (uint32)Value.x, (uint32)Value.y, (uint32)Value.z, (uint32)Value.w };
+    return HashComponents<4>(components);
 }
 
-HashType HashTrait<Vector3u>::GetHash(const Vector3u &Value)
+HashType HashTrait<Vector2u>::GetHash(const Vector2u &Value)
 {
-    uint32 xhash = Value.x;
-    uint32 yhash = Value.y;
-    uint32 zhash = Value.z;
+    uint32 components[2] = { Value.x, Value.y };
+    return HashComponents<2>(components);
+}
 
-    return (xhash + yhash * 37 + zhash * 101);
+HashType HashTrait<Vector3u>::GetHash(const Vector3u &Value)
+{
+    uint32 components[3] = { Value.x, Value.y, Value.z };
+    return HashComponents<3>(components);
 }
 
 HashType HashTrait<Vector4u>::GetHash(const Vector4u &Value)
 {
-    uint32 xhash = Value.x;
-    uint32 yhash = Value.y;
-    uint32 zhash = Value.z;
-    uint32 whash = Value.w;
+    uint32 components[4] = { Value.x, Value.y, Value.z, Value.w };
+    return HashComponents<4>(components);
+}
 
-    return (xhash + yhash * 37 + zhash * 101 + whash * 241);
+HashType HashTrait_HashBytes(const void *pData, uint32 size)
+{
+    const byte *pBytes = reinterpret_cast<const byte *>(pData);
+    uint32 hash = PRIME32_5 + size;
+    uint32 i = 0;
+    for (; (i + sizeof(uint32)) <= size; i += sizeof(uint32))
+    {
+        uint32 word;
+        Y_memcpy(&word, pBytes + i, sizeof(word));
+        hash = HashRound(hash, word);
+    }
+    for (; i < size; i++)
+        hash = HashByteRound(hash, pBytes[i]);
+
+    return HashAvalanche(hash);
 }
+
+// the vector types are plain runs of 32-bit components
+#define DEFINE_HASH_ARRAY(Type, Components, FloatComponents) \
+    static_assert(sizeof(Type) == sizeof(uint32) * Components, "unexpected vector layout"); \
+    void HashTrait_GetHashes(HashType *pHashes, const Type *pValues, uint32 count) \
+    { \
+        HashComponentArray<Components, FloatComponents>(pHashes, reinterpret_cast<const uint32 *>(pValues), count); \
+    }
+
+DEFINE_HASH_ARRAY(Vector2f, 2, true)
+DEFINE_HASH_ARRAY(Vector3f, 3, true)
+DEFINE_HASH_ARRAY(Vector4f, 4, true)
+DEFINE_HASH_ARRAY(Vector2i, 2, false)
+DEFINE_HASH_ARRAY(Vector3i, 3, false)
+DEFINE_HASH_ARRAY(Vector4i, 4, false)
+DEFINE_HASH_ARRAY(Vector2u, 2, false)
+DEFINE_HASH_ARRAY(Vector3u, 3, false)
+DEFINE_HASH_ARRAY(Vector4u, 4, false)
+
+#undef DEFINE_HASH_ARRAY
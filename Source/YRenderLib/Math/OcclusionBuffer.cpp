@@ -0,0 +1,554 @@
+#include "YRenderLib/Math/OcclusionBuffer.h"
+#include "YRenderLib/Math/SIMDVectorf.h"
+#include "YBaseLib/Memory.h"
+#include <atomic>
+#include <thread>
+
+// below this many binned triangles per thread, starting the threads costs more than it saves
+static const uint32 MIN_TRIANGLES_PER_THREAD = 256;
+
+// tiles start on a cache line, so threads rasterizing neighbouring tiles never write to the same line
+static const uint32 DEPTH_BUFFER_ALIGNMENT = 64;
+
+OcclusionBuffer::OcclusionBuffer(uint32 width /* = 256 */, uint32 height /* = 128 */)
+    : m_nearClipW(0.01f)
+{
+    m_tileCountX = Max((width + TILE_WIDTH - 1) / TILE_WIDTH, (uint32)1);
+    m_tileCountY = Max((height + TILE_HEIGHT - 1) / TILE_HEIGHT, (uint32)1);
+    m_width = m_tileCountX * TILE_WIDTH;
+    m_height = m_tileCountY * TILE_HEIGHT;
+    m_hizWidth = m_width / HIZ_BLOCK_SIZE;
+
+    m_pDepthBuffer = reinterpret_cast<float *>(Y_aligned_malloc(sizeof(float) * m_width * m_height, DEPTH_BUFFER_ALIGNMENT));
+    m_pHiZBuffer = reinterpret_cast<float *>(Y_aligned_malloc(sizeof(float) * m_hizWidth * (m_height / HIZ_BLOCK_SIZE), Y_SSE_ALIGNMENT));
+    Y_memzero(m_pDepthBuffer, sizeof(float) * m_width * m_height);
+    Y_memzero(m_pHiZBuffer, sizeof(float) * m_hizWidth * (m_height / HIZ_BLOCK_SIZE));
+
+    m_pTileBins = new PODArray<uint32>[m_tileCountX * m_tileCountY];
+    m_viewProjectionMatrix.SetIdentity();
+    m_frustum.SetFromMatrix(m_viewProjectionMatrix);
+}
+
+OcclusionBuffer::~OcclusionBuffer()
+{
+    delete[] m_pTileBins;
+    Y_aligned_free(m_pHiZBuffer);
+    Y_aligned_free(m_pDepthBuffer);
+}
+
+void OcclusionBuffer::BeginFrame(const Matrix4x4f &viewProjectionMatrix)
+{
+    m_viewProjectionMatrix = viewProjectionMatrix;
+    m_frustum.SetFromMatrix(viewProjectionMatrix);
+
+    m_triangles.Clear();
+    for (uint32 i = 0; i < GetTileCount(); i++)
+        m_pTileBins[i].Clear();
+}
+
+void OcclusionBuffer::AddOccluder(const Vector3f *pVertices, uint32 vertexCount, const uint16 *pIndices, uint32 indexCount, const Matrix4x4f &localToWorldMatrix)
+{
+    AddOccluderTriangles(pVertices, vertexCount, pIndices, indexCount, localToWorldMatrix);
+}
+
+void OcclusionBuffer::AddOccluder(const Vector3f *pVertices, uint32 vertexCount, const uint32 *pIndices, uint32 indexCount, const Matrix4x4f &localToWorldMatrix)
+{
+    AddOccluderTriangles(pVertices, vertexCount, pIndices, indexCount, localToWorldMatrix);
+}
+
+template<typename INDEX_TYPE>
+void OcclusionBuffer::AddOccluderTriangles(const Vector3f *pVertices, uint32 vertexCount, const INDEX_TYPE *pIndices, uint32 indexCount, const Matrix4x4f &localToWorldMatrix)
+{
+    DebugAssert((indexCount % 3) == 0);
+
+    // transform everything up front, vertices are usually shared between several triangles
+    Matrix4x4f localToClipMatrix(m_viewProjectionMatrix * localToWorldMatrix);
+    m_clipSpaceVertices.Resize(vertexCount);
+    for (uint32 i = 0; i < vertexCount; i++)
+        m_clipSpaceVertices[i] = localToClipMatrix * Vector4f(pVertices[i].x, pVertices[i].y, pVertices[i].z, 1.0f);
+
+    for (uint32 i = 0; i < indexCount; i += 3)
+    {
+        DebugAssert(pIndices[i + 0] < vertexCount && pIndices[i + 1] < vertexCount && pIndices[i + 2] < vertexCount);
+        BinTriangle(m_clipSpaceVertices[pIndices[i + 0]], m_clipSpaceVertices[pIndices[i + 1]], m_clipSpaceVertices[pIndices[i + 2]]);
+    }
+}
+
+void OcclusionBuffer::BinTriangle(const Vector4f &v0, const Vector4f &v1, const Vector4f &v2)
+{
+    // dropping an occluder only makes the result more conservative, so near plane clipping is skipped
+    if (v0.w < m_nearClipW || v1.w < m_nearClipW || v2.w < m_nearClipW)
+        return;
+
+    const float halfWidth = (float)m_width * 0.5f;
+    const float halfHeight = (float)m_height * 0.5f;
+    float invW[3] = { 1.0f / v0.w, 1.0f / v1.w, 1.0f / v2.w };
+    float x[3] = { (v0.x * invW[0] + 1.0f) * halfWidth, (v1.x * invW[1] + 1.0f) * halfWidth, (v2.x * invW[2] + 1.0f) * halfWidth };
+    float y[3] = { (1.0f - v0.y * invW[0]) * halfHeight, (1.0f - v1.y * invW[1]) * halfHeight, (1.0f - v2.y * invW[2]) * halfHeight };
+
+    // both windings are rasterized, flip to positive area
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area < 0.0f)
+    {
+        Swap(x[1], x[2]);
+        Swap(y[1], y[2]);
+        Swap(invW[1], invW[2]);
+        area = -area;
+    }
+    if (area < Y_FLT_EPSILON)
+        return;
+
+    // covered pixel centers, clamped in float space before converting as vertices near w=0 project very far away
+    float minX = Min(x[0], Min(x[1], x[2])) - 0.5f;
+    float maxX = Max(x[0], Max(x[1], x[2])) - 0.5f;
+    float minY = Min(y[0], Min(y[1], y[2])) - 0.5f;
+    float maxY = Max(y[0], Max(y[1], y[2])) - 0.5f;
+    if (maxX < 0.0f || maxY < 0.0f || minX > (float)(m_width - 1) || minY > (float)(m_height - 1))
+        return;
+
+    Triangle triangle;
+    triangle.MinX = (int32)Y_ceilf(Max(minX, 0.0f));
+    triangle.MinY = (int32)Y_ceilf(Max(minY, 0.0f));
+    triangle.MaxX = (int32)Y_floorf(Min(maxX, (float)(m_width - 1)));
+    triangle.MaxY = (int32)Y_floorf(Min(maxY, (float)(m_height - 1)));
+    if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY)
+        return;
+
+    // edge i runs from vertex i to vertex i+1, and is non-negative inside the triangle
+    for (uint32 i = 0; i < 3; i++)
+    {
+        uint32 j = (i + 1) % 3;
+        triangle.EdgeA[i] = -(y[j] - y[i]);
+        triangle.EdgeB[i] = x[j] - x[i];
+        triangle.EdgeC[i] = -(triangle.EdgeA[i] * x[i] + triangle.EdgeB[i] * y[i]);
+    }
+
+    // 1/w is affine in screen space, the barycentric weight of a vertex is the opposite edge over the area
+    float invArea = 1.0f / area;
+    triangle.DepthA = (triangle.EdgeA[1] * invW[0] + triangle.EdgeA[2] * invW[1] + triangle.EdgeA[0] * invW[2]) * invArea;
+    triangle.DepthB = (triangle.EdgeB[1] * invW[0] + triangle.EdgeB[2] * invW[1] + triangle.EdgeB[0] * invW[2]) * invArea;
+    triangle.DepthC = (triangle.EdgeC[1] * invW[0] + triangle.EdgeC[2] * invW[1] + triangle.EdgeC[0] * invW[2]) * invArea;
+
+    uint32 triangleIndex = m_triangles.GetSize();
+    m_triangles.Add(triangle);
+
+    uint32 firstTileX = (uint32)triangle.MinX / TILE_WIDTH;
+    uint32 lastTileX = (uint32)triangle.MaxX / TILE_WIDTH;
+    uint32 firstTileY = (uint32)triangle.MinY / TILE_HEIGHT;
+    uint32 lastTileY = (uint32)triangle.MaxY / TILE_HEIGHT;
+    for (uint32 tileY = firstTileY; tileY <= lastTileY; tileY++)
+    {
+        for (uint32 tileX = firstTileX; tileX <= lastTileX; tileX++)
+            m_pTileBins[tileY * m_tileCountX + tileX].Add(triangleIndex);
+    }
+}
+
+void OcclusionBuffer::RasterizeTile(uint32 tileIndex)
+{
+    DebugAssert(tileIndex < GetTileCount());
+
+    uint32 tileX = tileIndex % m_tileCountX;
+    uint32 tileY = tileIndex / m_tileCountX;
+    int32 tileMinX = (int32)(tileX * TILE_WIDTH);
+    int32 tileMinY = (int32)(tileY * TILE_HEIGHT);
+    int32 tileMaxX = tileMinX + (int32)TILE_WIDTH - 1;
+    int32 tileMaxY = tileMinY + (int32)TILE_HEIGHT - 1;
+
+    for (int32 y = tileMinY; y <= tileMaxY; y++)
+        Y_memzero(m_pDepthBuffer + y * m_width + tileMinX, sizeof(float) * TILE_WIDTH);
+
+    const PODArray<uint32> &bin = m_pTileBins[tileIndex];
+    for (uint32 i = 0; i < bin.GetSize(); i++)
+        RasterizeTriangle(m_triangles[bin[i]], tileMinX, tileMinY, tileMaxX, tileMaxY);
+
+    UpdateHiZ(tileX, tileY);
+}
+
+void OcclusionBuffer::RasterizeAllTiles()
+{
+    for (uint32 i = 0; i < GetTileCount(); i++)
+        RasterizeTile(i);
+}
+
+void OcclusionBuffer::Rasterize(uint32 threadCount /* = 0 */)
+{
+    uint32 tileCount = GetTileCount();
+    if (threadCount == 0)
+        threadCount = Max(std::thread::hardware_concurrency(), 1u);
+    threadCount = Max(Min(threadCount, Min(tileCount, m_triangles.GetSize() / MIN_TRIANGLES_PER_THREAD)), 1u);
+    if (threadCount == 1)
+    {
+        RasterizeAllTiles();
+        return;
+    }
+
+    // tiles are claimed by whichever thread is free next, tiles covered by many occluders take far longer than empty ones
+    std::atomic<uint32> nextTile(0);
+    auto worker = [this, tileCount, &nextTile]()
+    {
+        for (uint32 tileIndex = nextTile++; tileIndex < tileCount; tileIndex = nextTile++)
+            RasterizeTile(tileIndex);
+    };
+
+    PODArray<std::thread *> threads;
+    for (uint32 i = 1; i < threadCount; i++)
+        threads.Add(new std::thread(worker));
+
+    worker();
+
+    for (uint32 i = 0; i < threads.GetSize(); i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
+
+void OcclusionBuffer::RasterizeTriangle(const Triangle &triangle, int32 tileMinX, int32 tileMinY, int32 tileMaxX, int32 tileMaxY)
+{
+    // aligned to a group of four pixels, tiles are a multiple of four wide so this never leaves the tile
+    int32 minX = Max(triangle.MinX, tileMinX) & ~3;
+    int32 maxX = Min(triangle.MaxX, tileMaxX);
+    int32 minY = Max(triangle.MinY, tileMinY);
+    int32 maxY = Min(triangle.MaxY, tileMaxY);
+
+#if Y_CPU_SSE_LEVEL > 0
+    const __m128 pixelOffsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+    const __m128 edgeA0 = _mm_set_ps1(triangle.EdgeA[0]), edgeA1 = _mm_set_ps1(triangle.EdgeA[1]), edgeA2 = _mm_set_ps1(triangle.EdgeA[2]);
+    const __m128 depthA = _mm_set_ps1(triangle.DepthA);
+    const __m128 edgeStep0 = _mm_set_ps1(triangle.EdgeA[0] * 4.0f), edgeStep1 = _mm_set_ps1(triangle.EdgeA[1] * 4.0f), edgeStep2 = _mm_set_ps1(triangle.EdgeA[2] * 4.0f);
+    const __m128 depthStep = _mm_set_ps1(triangle.DepthA * 4.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (int32 y = minY; y <= maxY; y++)
+    {
+        // evaluate the edge and depth planes at the first group of the row, then step four pixels at a time
+        float centerY = (float)y + 0.5f;
+        __m128 px = _mm_add_ps(_mm_set_ps1((float)minX), pixelOffsets);
+        __m128 e0 = _mm_add_ps(_mm_mul_ps(edgeA0, px), _mm_set_ps1(triangle.EdgeB[0] * centerY + triangle.EdgeC[0]));
+        __m128 e1 = _mm_add_ps(_mm_mul_ps(edgeA1, px), _mm_set_ps1(triangle.EdgeB[1] * centerY + triangle.EdgeC[1]));
+        __m128 e2 = _mm_add_ps(_mm_mul_ps(edgeA2, px), _mm_set_ps1(triangle.EdgeB[2] * centerY + triangle.EdgeC[2]));
+        __m128 depth = _mm_add_ps(_mm_mul_ps(depthA, px), _mm_set_ps1(triangle.DepthB * centerY + triangle.DepthC));
+
+        float *pRow = m_pDepthBuffer + y * m_width;
+        for (int32 x = minX; x <= maxX; x += 4)
+        {
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+            if (_mm_movemask_ps(inside) != 0)
+            {
+                __m128 current = _mm_load_ps(pRow + x);
+                __m128 closest = _mm_max_ps(current, depth);
+                _mm_store_ps(pRow + x, _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, current)));
+            }
+
+            e0 = _mm_add_ps(e0, edgeStep0);
+            e1 = _mm_add_ps(e1, edgeStep1);
+            e2 = _mm_add_ps(e2, edgeStep2);
+            depth = _mm_add_ps(depth, depthStep);
+        }
+    }
+#else
+    for (int32 y = minY; y <= maxY; y++)
+    {
+        float centerY = (float)y + 0.5f;
+        float *pRow = m_pDepthBuffer + y * m_width;
+        for (int32 x = minX; x <= maxX; x++)
+        {
+            float centerX = (float)x + 0.5f;
+            float e0 = triangle.EdgeA[0] * centerX + triangle.EdgeB[0] * centerY + triangle.EdgeC[0];
+            float e1 = triangle.EdgeA[1] * centerX + triangle.EdgeB[1] * centerY + triangle.EdgeC[1];
+            float e2 = triangle.EdgeA[2] * centerX + triangle.EdgeB[2] * centerY + triangle.EdgeC[2];
+            if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f)
+            {
+                float depth = triangle.DepthA * centerX + triangle.DepthB * centerY + triangle.DepthC;
+                pRow[x] = Max(pRow[x], depth);
+            }
+        }
+    }
+#endif
+}
+
+void OcclusionBuffer::UpdateHiZ(uint32 tileX, uint32 tileY)
+{
+    // each block stores its farthest depth, so a box nearer than that is visible somewhere in the block
+    const uint32 blocksPerTileX = TILE_WIDTH / HIZ_BLOCK_SIZE;
+    const uint32 blocksPerTileY = TILE_HEIGHT / HIZ_BLOCK_SIZE;
+    for (uint32 by = 0; by < blocksPerTileY; by++)
+    {
+        uint32 blockY = tileY * blocksPerTileY + by;
+        for (uint32 bx = 0; bx < blocksPerTileX; bx++)
+        {
+            uint32 blockX = tileX * blocksPerTileX + bx;
+            const float *pBlock = m_pDepthBuffer + (blockY * HIZ_BLOCK_SIZE) * m_width + blockX * HIZ_BLOCK_SIZE;
+
+#if Y_CPU_SSE_LEVEL > 0
+            __m128 farthest = _mm_load_ps(pBlock);
+            for (uint32 row = 0; row < HIZ_BLOCK_SIZE; row++)
+            {
+                const float *pRow = pBlock + row * m_width;
+                for (uint32 col = 0; col < HIZ_BLOCK_SIZE; col += 4)
+                    farthest = _mm_min_ps(farthest, _mm_load_ps(pRow + col));
+            }
+            farthest = _mm_min_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(1, 0, 3, 2)));
+            farthest = _mm_min_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(2, 3, 0, 1)));
+            _mm_store_ss(&m_pHiZBuffer[blockY * m_hizWidth + blockX], farthest);
+#else
+            float farthest = pBlock[0];
+            for (uint32 row = 0; row < HIZ_BLOCK_SIZE; row++)
+            {
+                const float *pRow = pBlock + row * m_width;
+                for (uint32 col = 0; col < HIZ_BLOCK_SIZE; col++)
+                    farthest = Min(farthest, pRow[col]);
+            }
+            m_pHiZBuffer[blockY * m_hizWidth + blockX] = farthest;
+#endif
+        }
+    }
+}
+
+bool OcclusionBuffer::IsVisible(const AABox &box) const
+{
+    if (!m_frustum.AABoxIntersection(box))
+        return false;
+
+    // project the corners to find the screen rectangle and the nearest depth of the box
+    Vector3f cornerPoints[8];
+    box.GetCornerPoints(cornerPoints);
+
+    float minX, maxX, minY, maxY, nearestDepth;
+    const Matrix4x4f &m = m_viewProjectionMatrix;
+
+#if Y_CPU_SSE_LEVEL > 0
+    __m128 clipX[2], clipY[2], clipW[2];
+    for (uint32 half = 0; half < 2; half++)
+    {
+        const Vector3f *pCorners = cornerPoints + half * 4;
+        __m128 cx = _mm_set_ps(pCorners[3].x, pCorners[2].x, pCorners[1].x, pCorners[0].x);
+        __m128 cy = _mm_set_ps(pCorners[3].y, pCorners[2].y, pCorners[1].y, pCorners[0].y);
+        __m128 cz = _mm_set_ps(pCorners[3].z, pCorners[2].z, pCorners[1].z, pCorners[0].z);
+        clipX[half] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set_ps1(m(0, 0)), cx), _mm_mul_ps(_mm_set_ps1(m(0, 1)), cy)), _mm_add_ps(_mm_mul_ps(_mm_set_ps1(m(0, 2)), cz), _mm_set_ps1(m(0, 3))));
+        clipY[half] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set_ps1(m(1, 0)), cx), _mm_mul_ps(_mm_set_ps1(m(1, 1)), cy)), _mm_add_ps(_mm_mul_ps(_mm_set_ps1(m(1, 2)), cz), _mm_set_ps1(m(1, 3))));
+        clipW[half] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set_ps1(m(3, 0)), cx), _mm_mul_ps(_mm_set_ps1(m(3, 1)), cy)), _mm_add_ps(_mm_mul_ps(_mm_set_ps1(m(3, 2)), cz), _mm_set_ps1(m(3, 3))));
+    }
+
+    // a box crossing the near plane can't be projected, so treat it as visible
+    __m128 nearClipW = _mm_set_ps1(m_nearClipW);
+    if (_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(clipW[0], nearClipW), _mm_cmplt_ps(clipW[1], nearClipW))) != 0)
+        return true;
+
+    __m128 halfWidth = _mm_set_ps1((float)m_width * 0.5f);
+    __m128 halfHeight = _mm_set_ps1((float)m_height * 0.5f);
+    __m128 one = _mm_set_ps1(1.0f);
+    __m128 invW0 = _mm_div_ps(one, clipW[0]);
+    __m128 invW1 = _mm_div_ps(one, clipW[1]);
+    __m128 screenX0 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(clipX[0], invW0), one), halfWidth);
+    __m128 screenX1 = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(clipX[1], invW1), one), halfWidth);
+    __m128 screenY0 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(clipY[0], invW0)), halfHeight);
+    __m128 screenY1 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(clipY[1], invW1)), halfHeight);
+
+    // horizontal reductions
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float reduced[4][4];
+    _mm_store_ps(reduced[0], _mm_min_ps(screenX0, screenX1));
+    _mm_store_ps(reduced[1], _mm_max_ps(screenX0, screenX1));
+    _mm_store_ps(reduced[2], _mm_min_ps(screenY0, screenY1));
+    _mm_store_ps(reduced[3], _mm_max_ps(screenY0, screenY1));
+    minX = Min(Min(reduced[0][0], reduced[0][1]), Min(reduced[0][2], reduced[0][3]));
+    maxX = Max(Max(reduced[1][0], reduced[1][1]), Max(reduced[1][2], reduced[1][3]));
+    minY = Min(Min(reduced[2][0], reduced[2][1]), Min(reduced[2][2], reduced[2][3]));
+    maxY = Max(Max(reduced[3][0], reduced[3][1]), Max(reduced[3][2], reduced[3][3]));
+    _mm_store_ps(reduced[0], _mm_max_ps(invW0, invW1));
+    nearestDepth = Max(Max(reduced[0][0], reduced[0][1]), Max(reduced[0][2], reduced[0][3]));
+#else
+    minX = minY = Y_FLT_MAX;
+    maxX = maxY = -Y_FLT_MAX;
+    nearestDepth = 0.0f;
+    for (uint32 i = 0; i < 8; i++)
+    {
+        const Vector3f &p = cornerPoints[i];
+        float clipW = m(3, 0) * p.x + m(3, 1) * p.y + m(3, 2) * p.z + m(3, 3);
+        if (clipW < m_nearClipW)
+            return true;
+
+        float invW = 1.0f / clipW;
+        float screenX = ((m(0, 0) * p.x + m(0, 1) * p.y + m(0, 2) * p.z + m(0, 3)) * invW + 1.0f) * ((float)m_width * 0.5f);
+        float screenY = (1.0f - (m(1, 0) * p.x + m(1, 1) * p.y + m(1, 2) * p.z + m(1, 3)) * invW) * ((float)m_height * 0.5f);
+        minX = Min(minX, screenX);
+        maxX = Max(maxX, screenX);
+        minY = Min(minY, screenY);
+        maxY = Max(maxY, screenY);
+        nearestDepth = Max(nearestDepth, invW);
+    }
+#endif
+
+    return IsRectVisible(minX, maxX, minY, maxY, nearestDepth);
+}
+
+bool OcclusionBuffer::IsRectVisible(float minX, float maxX, float minY, float maxY, float nearestDepth) const
+{
+    // pixels touched by the rectangle
+    if (maxX < 0.0f || maxY < 0.0f || minX >= (float)m_width || minY >= (float)m_height)
+        return false;
+
+    int32 pixelMinX = (int32)Max(minX, 0.0f);
+    int32 pixelMinY = (int32)Max(minY, 0.0f);
+    int32 pixelMaxX = (int32)Min(maxX, (float)(m_width - 1));
+    int32 pixelMaxY = (int32)Min(maxY, (float)(m_height - 1));
+
+    int32 blockMinX = pixelMinX / (int32)HIZ_BLOCK_SIZE;
+    int32 blockMinY = pixelMinY / (int32)HIZ_BLOCK_SIZE;
+    int32 blockMaxX = pixelMaxX / (int32)HIZ_BLOCK_SIZE;
+    int32 blockMaxY = pixelMaxY / (int32)HIZ_BLOCK_SIZE;
+
+#if Y_CPU_SSE_LEVEL > 0
+    const __m128 depth = _mm_set_ps1(nearestDepth);
+    const __m128i laneOffsets = _mm_set_epi32(3, 2, 1, 0);
+    const __m128i columnMin = _mm_set1_epi32(pixelMinX - 1);
+    const __m128i columnMax = _mm_set1_epi32(pixelMaxX + 1);
+#endif
+
+    for (int32 blockY = blockMinY; blockY <= blockMaxY; blockY++)
+    {
+        for (int32 blockX = blockMinX; blockX <= blockMaxX; blockX++)
+        {
+            // whole block is in front of the box
+            if (m_pHiZBuffer[blockY * m_hizWidth + blockX] > nearestDepth)
+                continue;
+
+            // refine against the pixels of this block that the rectangle covers
+            int32 startY = Max(pixelMinY, blockY * (int32)HIZ_BLOCK_SIZE);
+            int32 endY = Min(pixelMaxY, blockY * (int32)HIZ_BLOCK_SIZE + (int32)HIZ_BLOCK_SIZE - 1);
+
+#if Y_CPU_SSE_LEVEL > 0
+            // blocks are two aligned groups of four pixels, masked to the columns inside the rectangle
+            int32 blockStartX = blockX * (int32)HIZ_BLOCK_SIZE;
+            __m128i columns0 = _mm_add_epi32(_mm_set1_epi32(blockStartX), laneOffsets);
+            __m128i columns1 = _mm_add_epi32(columns0, _mm_set1_epi32(4));
+            __m128 columnMask0 = _mm_castsi128_ps(_mm_and_si128(_mm_cmpgt_epi32(columns0, columnMin), _mm_cmplt_epi32(columns0, columnMax)));
+            __m128 columnMask1 = _mm_castsi128_ps(_mm_and_si128(_mm_cmpgt_epi32(columns1, columnMin), _mm_cmplt_epi32(columns1, columnMax)));
+
+            __m128 farther = _mm_setzero_ps();
+            for (int32 y = startY; y <= endY; y++)
+            {
+                const float *pRow = m_pDepthBuffer + y * m_width + blockStartX;
+                farther = _mm_or_ps(farther, _mm_and_ps(_mm_cmple_ps(_mm_load_ps(pRow), depth), columnMask0));
+                farther = _mm_or_ps(farther, _mm_and_ps(_mm_cmple_ps(_mm_load_ps(pRow + 4), depth), columnMask1));
+            }
+            if (_mm_movemask_ps(farther) != 0)
+                return true;
+#else
+            int32 startX = Max(pixelMinX, blockX * (int32)HIZ_BLOCK_SIZE);
+            int32 endX = Min(pixelMaxX, blockX * (int32)HIZ_BLOCK_SIZE + (int32)HIZ_BLOCK_SIZE - 1);
+            for (int32 y = startY; y <= endY; y++)
+            {
+                const float *pRow = m_pDepthBuffer + y * m_width;
+                for (int32 x = startX; x <= endX; x++)
+                {
+                    if (pRow[x] <= nearestDepth)
+                        return true;
+                }
+            }
+#endif
+        }
+    }
+
+    return false;
+}
+
+void OcclusionBuffer::TestVisibility(const AABox *pBoxes, uint32 count, bool *pVisibleResults) const
+{
+    uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+    // rows of the matrix needed for screen x, y and w
+    const Matrix4x4f &m = m_viewProjectionMatrix;
+    const __m128 mx0 = _mm_set_ps1(m(0, 0)), mx1 = _mm_set_ps1(m(0, 1)), mx2 = _mm_set_ps1(m(0, 2)), mx3 = _mm_set_ps1(m(0, 3));
+    const __m128 my0 = _mm_set_ps1(m(1, 0)), my1 = _mm_set_ps1(m(1, 1)), my2 = _mm_set_ps1(m(1, 2)), my3 = _mm_set_ps1(m(1, 3));
+    const __m128 mw0 = _mm_set_ps1(m(3, 0)), mw1 = _mm_set_ps1(m(3, 1)), mw2 = _mm_set_ps1(m(3, 2)), mw3 = _mm_set_ps1(m(3, 3));
+    const __m128 nearClipW = _mm_set_ps1(m_nearClipW);
+    const __m128 halfWidth = _mm_set_ps1((float)m_width * 0.5f);
+    const __m128 halfHeight = _mm_set_ps1((float)m_height * 0.5f);
+    const __m128 one = _mm_set_ps1(1.0f);
+
+    // one box per lane, each corner takes the min or max bound on each axis, so the per-axis products are shared between corners
+    for (; (i + 4) <= count; i += 4)
+    {
+        const AABox *pGroup = pBoxes + i;
+        ALIGN_DECL(Y_SSE_ALIGNMENT) float groupBounds[6][4];
+        for (uint32 lane = 0; lane < 4; lane++)
+        {
+            const Vector3f &minBounds = pGroup[lane].GetMinBounds();
+            const Vector3f &maxBounds = pGroup[lane].GetMaxBounds();
+            groupBounds[0][lane] = minBounds.x;
+            groupBounds[1][lane] = minBounds.y;
+            groupBounds[2][lane] = minBounds.z;
+            groupBounds[3][lane] = maxBounds.x;
+            groupBounds[4][lane] = maxBounds.y;
+            groupBounds[5][lane] = maxBounds.z;
+        }
+
+        __m128 bounds[3][2];
+        for (uint32 axis = 0; axis < 3; axis++)
+        {
+            bounds[axis][0] = _mm_load_ps(groupBounds[axis]);
+            bounds[axis][1] = _mm_load_ps(groupBounds[axis + 3]);
+        }
+
+        __m128 termX[3][2], termY[3][2], termW[3][2];
+        for (uint32 side = 0; side < 2; side++)
+        {
+            termX[0][side] = _mm_mul_ps(mx0, bounds[0][side]);
+            termX[1][side] = _mm_mul_ps(mx1, bounds[1][side]);
+            termX[2][side] = _mm_add_ps(_mm_mul_ps(mx2, bounds[2][side]), mx3);
+            termY[0][side] = _mm_mul_ps(my0, bounds[0][side]);
+            termY[1][side] = _mm_mul_ps(my1, bounds[1][side]);
+            termY[2][side] = _mm_add_ps(_mm_mul_ps(my2, bounds[2][side]), my3);
+            termW[0][side] = _mm_mul_ps(mw0, bounds[0][side]);
+            termW[1][side] = _mm_mul_ps(mw1, bounds[1][side]);
+            termW[2][side] = _mm_add_ps(_mm_mul_ps(mw2, bounds[2][side]), mw3);
+        }
+
+        __m128 minX = _mm_set_ps1(Y_FLT_MAX), maxX = _mm_set_ps1(-Y_FLT_MAX);
+        __m128 minY = _mm_set_ps1(Y_FLT_MAX), maxY = _mm_set_ps1(-Y_FLT_MAX);
+        __m128 nearestDepth = _mm_setzero_ps();
+        __m128 crossesNear = _mm_setzero_ps();
+        for (uint32 corner = 0; corner < 8; corner++)
+        {
+            uint32 sx = (corner >> 2) & 1, sy = (corner >> 1) & 1, sz = corner & 1;
+            __m128 clipX = _mm_add_ps(_mm_add_ps(termX[0][sx], termX[1][sy]), termX[2][sz]);
+            __m128 clipY = _mm_add_ps(_mm_add_ps(termY[0][sx], termY[1][sy]), termY[2][sz]);
+            __m128 clipW = _mm_add_ps(_mm_add_ps(termW[0][sx], termW[1][sy]), termW[2][sz]);
+            crossesNear = _mm_or_ps(crossesNear, _mm_cmplt_ps(clipW, nearClipW));
+
+            __m128 invW = _mm_div_ps(one, clipW);
+            __m128 screenX = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(clipX, invW), one), halfWidth);
+            __m128 screenY = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(clipY, invW)), halfHeight);
+            minX = _mm_min_ps(minX, screenX);
+            maxX = _mm_max_ps(maxX, screenX);
+            minY = _mm_min_ps(minY, screenY);
+            maxY = _mm_max_ps(maxY, screenY);
+            nearestDepth = _mm_max_ps(nearestDepth, invW);
+        }
+
+        ALIGN_DECL(Y_SSE_ALIGNMENT) float rect[5][4];
+        _mm_store_ps(rect[0], minX);
+        _mm_store_ps(rect[1], maxX);
+        _mm_store_ps(rect[2], minY);
+        _mm_store_ps(rect[3], maxY);
+        _mm_store_ps(rect[4], nearestDepth);
+        int crossesNearMask = _mm_movemask_ps(crossesNear);
+
+        // a box crossing the near plane can't be projected, so treat it as visible
+        for (uint32 lane = 0; lane < 4; lane++)
+        {
+            if (!m_frustum.AABoxIntersection(pGroup[lane]))
+                pVisibleResults[i + lane] = false;
+            else if (crossesNearMask & (1 << lane))
+                pVisibleResults[i + lane] = true;
+            else
+                pVisibleResults[i + lane] = IsRectVisible(rect[0][lane], rect[1][lane], rect[2][lane], rect[3][lane], rect[4][lane]);
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+        pVisibleResults[i] = IsVisible(pBoxes[i]);
+}
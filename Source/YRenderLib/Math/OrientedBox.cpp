@@ -0,0 +1,258 @@
+#include "YRenderLib/Math/OrientedBox.h"
+#include "YRenderLib/Math/AABox.h"
+#include "YRenderLib/Math/Sphere.h"
+#include "YRenderLib/Math/SIMDVectorf.h"
+#include "YRenderLib/Math/SIMDLanes.h"
+
+OrientedBox::OrientedBox(const Vector3f &center, const Vector3f &halfExtents, const Vector3f &axisX, const Vector3f &axisY, const Vector3f &axisZ)
+    : m_center(center),
+      m_halfExtents(halfExtents)
+{
+    m_axes[0] = axisX;
+    m_axes[1] = axisY;
+    m_axes[2] = axisZ;
+}
+
+OrientedBox::OrientedBox(const AABox &box)
+{
+    m_center = (box.GetMinBounds() + box.GetMaxBounds()) * 0.5f;
+    m_halfExtents = (box.GetMaxBounds() - box.GetMinBounds()) * 0.5f;
+    m_axes[0] = Vector3f::UnitX;
+    m_axes[1] = Vector3f::UnitY;
+    m_axes[2] = Vector3f::UnitZ;
+}
+
+OrientedBox::OrientedBox(const OrientedBox &copy)
+    : m_center(copy.m_center),
+      m_halfExtents(copy.m_halfExtents)
+{
+    m_axes[0] = copy.m_axes[0];
+    m_axes[1] = copy.m_axes[1];
+    m_axes[2] = copy.m_axes[2];
+}
+
+bool OrientedBox::ContainsPoint(const Vector3f &point) const
+{
+    Vector3f offset(point - m_center);
+    return (Y_fabsf(offset.Dot(m_axes[0])) <= m_halfExtents.x &&
+            Y_fabsf(offset.Dot(m_axes[1])) <= m_halfExtents.y &&
+            Y_fabsf(offset.Dot(m_axes[2])) <= m_halfExtents.z);
+}
+
+void OrientedBox::GetCornerPoints(Vector3f *pVertices) const
+{
+    Vector3f ex(m_axes[0] * m_halfExtents.x);
+    Vector3f ey(m_axes[1] * m_halfExtents.y);
+    Vector3f ez(m_axes[2] * m_halfExtents.z);
+
+    pVertices[0] = m_center - ex - ey - ez;
+    pVertices[1] = m_center - ex - ey + ez;
+    pVertices[2] = m_center - ex + ey - ez;
+    pVertices[3] = m_center - ex + ey + ez;
+    pVertices[4] = m_center + ex - ey - ez;
+    pVertices[5] = m_center + ex - ey + ez;
+    pVertices[6] = m_center + ex + ey - ez;
+    pVertices[7] = m_center + ex + ey + ez;
+}
+
+AABox OrientedBox::GetAABox() const
+{
+    // extent along each world axis is the sum of the projected half extents
+    Vector3f extents((m_axes[0] * m_halfExtents.x).Abs() + (m_axes[1] * m_halfExtents.y).Abs() + (m_axes[2] * m_halfExtents.z).Abs());
+    return AABox(m_center - extents, m_center + extents);
+}
+
+Sphere OrientedBox::GetBoundingSphere() const
+{
+    return Sphere(m_center, m_halfExtents.Length());
+}
+
+OrientedBox &OrientedBox::operator=(const OrientedBox &copy)
+{
+    m_center = copy.m_center;
+    m_halfExtents = copy.m_halfExtents;
+    m_axes[0] = copy.m_axes[0];
+    m_axes[1] = copy.m_axes[1];
+    m_axes[2] = copy.m_axes[2];
+    return *this;
+}
+
+// cyclic jacobi rotations on a symmetric 3x3 matrix, eigenvectors are returned in the columns of eigenVectors
+static void SymmetricEigenVectors(float matrix[3][3], float eigenVectors[3][3])
+{
+    for (uint32 i = 0; i < 3; i++)
+    {
+        for (uint32 j = 0; j < 3; j++)
+            eigenVectors[i][j] = (i == j) ? 1.0f : 0.0f;
+    }
+
+    static const uint32 MAX_SWEEPS = 16;
+    static const uint32 pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+    for (uint32 sweep = 0; sweep < MAX_SWEEPS; sweep++)
+    {
+        float offDiagonal = matrix[0][1] * matrix[0][1] + matrix[0][2] * matrix[0][2] + matrix[1][2] * matrix[1][2];
+        float diagonal = matrix[0][0] * matrix[0][0] + matrix[1][1] * matrix[1][1] + matrix[2][2] * matrix[2][2];
+        if (offDiagonal <= diagonal * 1.0e-12f)
+            break;
+
+        for (uint32 pairIndex = 0; pairIndex < countof(pairs); pairIndex++)
+        {
+            uint32 p = pairs[pairIndex][0];
+            uint32 q = pairs[pairIndex][1];
+            if (matrix[p][q] == 0.0f)
+                continue;
+
+            // rotation angle that zeroes matrix[p][q]
+            float theta = (matrix[q][q] - matrix[p][p]) / (2.0f * matrix[p][q]);
+            float t = 1.0f / (Y_fabsf(theta) + Y_sqrtf(theta * theta + 1.0f));
+            if (theta < 0.0f)
+                t = -t;
+            float c = 1.0f / Y_sqrtf(t * t + 1.0f);
+            float s = t * c;
+
+            for (uint32 k = 0; k < 3; k++)
+            {
+                float kp = matrix[k][p];
+                float kq = matrix[k][q];
+                matrix[k][p] = c * kp - s * kq;
+                matrix[k][q] = s * kp + c * kq;
+            }
+            for (uint32 k = 0; k < 3; k++)
+            {
+                float pk = matrix[p][k];
+                float qk = matrix[q][k];
+                matrix[p][k] = c * pk - s * qk;
+                matrix[q][k] = s * pk + c * qk;
+            }
+            for (uint32 k = 0; k < 3; k++)
+            {
+                float kp = eigenVectors[k][p];
+                float kq = eigenVectors[k][q];
+                eigenVectors[k][p] = c * kp - s * kq;
+                eigenVectors[k][q] = s * kp + c * kq;
+            }
+        }
+    }
+}
+
+template<typename POINT_TYPE>
+static OrientedBox ComputeOrientedBoxFromPoints(const POINT_TYPE *pPoints, uint32 nPoints)
+{
+    Assert(nPoints > 0);
+
+    // mean, the tail is summed in scalar as padded lanes would skew the result
+    Lanes x, y, z, x1, y1, z1;
+    Lanes sumX = LanesSplat(0.0f), sumY = LanesSplat(0.0f), sumZ = LanesSplat(0.0f);
+    uint32 i = 0;
+    for (; (i + 8) <= nPoints; i += 8)
+    {
+        LanesLoadPoints(pPoints + i, x, y, z);
+        LanesLoadPoints(pPoints + i + 4, x1, y1, z1);
+        sumX = sumX + x + x1;
+        sumY = sumY + y + y1;
+        sumZ = sumZ + z + z1;
+    }
+
+    Vector3f mean(LanesReduceSum(sumX), LanesReduceSum(sumY), LanesReduceSum(sumZ));
+    for (uint32 j = i; j < nPoints; j++)
+        mean += Vector3f(SIMDVector3f(pPoints[j]));
+    mean /= (float)nPoints;
+
+    // covariance
+    const Lanes meanX = LanesSplat(mean.x), meanY = LanesSplat(mean.y), meanZ = LanesSplat(mean.z);
+    Lanes xx = LanesSplat(0.0f), xy = xx, xz = xx, yy = xx, yz = xx, zz = xx;
+    for (i = 0; (i + 8) <= nPoints; i += 8)
+    {
+        LanesLoadPoints(pPoints + i, x, y, z);
+        LanesLoadPoints(pPoints + i + 4, x1, y1, z1);
+        x = x - meanX; y = y - meanY; z = z - meanZ;
+        x1 = x1 - meanX; y1 = y1 - meanY; z1 = z1 - meanZ;
+        xx = xx + x * x + x1 * x1;
+        xy = xy + x * y + x1 * y1;
+        xz = xz + x * z + x1 * z1;
+        yy = yy + y * y + y1 * y1;
+        yz = yz + y * z + y1 * z1;
+        zz = zz + z * z + z1 * z1;
+    }
+
+    float covariance[3][3];
+    covariance[0][0] = LanesReduceSum(xx);
+    covariance[0][1] = LanesReduceSum(xy);
+    covariance[0][2] = LanesReduceSum(xz);
+    covariance[1][1] = LanesReduceSum(yy);
+    covariance[1][2] = LanesReduceSum(yz);
+    covariance[2][2] = LanesReduceSum(zz);
+    for (uint32 j = i; j < nPoints; j++)
+    {
+        Vector3f d(Vector3f(SIMDVector3f(pPoints[j])) - mean);
+        covariance[0][0] += d.x * d.x;
+        covariance[0][1] += d.x * d.y;
+        covariance[0][2] += d.x * d.z;
+        covariance[1][1] += d.y * d.y;
+        covariance[1][2] += d.y * d.z;
+        covariance[2][2] += d.z * d.z;
+    }
+    covariance[1][0] = covariance[0][1];
+    covariance[2][0] = covariance[0][2];
+    covariance[2][1] = covariance[1][2];
+
+    float eigenVectors[3][3];
+    SymmetricEigenVectors(covariance, eigenVectors);
+
+    // right handed basis from the eigenvector columns
+    Vector3f axes[3];
+    axes[0] = Vector3f(eigenVectors[0][0], eigenVectors[1][0], eigenVectors[2][0]).Normalize();
+    axes[1] = Vector3f(eigenVectors[0][1], eigenVectors[1][1], eigenVectors[2][1]).Normalize();
+    axes[2] = axes[0].Cross(axes[1]);
+
+    // extents along the principal axes, padded lanes repeat a real point so they don't affect min/max
+    Lanes minProjection[3], maxProjection[3];
+    Lanes axisLanes[3][3];
+    for (uint32 axis = 0; axis < 3; axis++)
+    {
+        minProjection[axis] = LanesSplat(Y_FLT_MAX);
+        maxProjection[axis] = LanesSplat(-Y_FLT_MAX);
+        axisLanes[axis][0] = LanesSplat(axes[axis].x);
+        axisLanes[axis][1] = LanesSplat(axes[axis].y);
+        axisLanes[axis][2] = LanesSplat(axes[axis].z);
+    }
+    for (i = 0; i < nPoints; i += 4)
+    {
+        if ((i + 4) <= nPoints)
+            LanesLoadPoints(pPoints + i, x, y, z);
+        else
+            LanesLoadPointsPartial(pPoints + i, nPoints - i, x, y, z);
+
+        for (uint32 axis = 0; axis < 3; axis++)
+        {
+            Lanes projection = x * axisLanes[axis][0] + y * axisLanes[axis][1] + z * axisLanes[axis][2];
+            minProjection[axis] = LanesMin(minProjection[axis], projection);
+            maxProjection[axis] = LanesMax(maxProjection[axis], projection);
+        }
+    }
+
+    Vector3f center(Vector3f::Zero);
+    float halfExtents[3];
+    for (uint32 axis = 0; axis < 3; axis++)
+    {
+        float minValue = LanesReduceMin(minProjection[axis]);
+        float maxValue = LanesReduceMax(maxProjection[axis]);
+        center += axes[axis] * ((minValue + maxValue) * 0.5f);
+        halfExtents[axis] = (maxValue - minValue) * 0.5f;
+    }
+
+    // principal axes are not optimal for every shape, keep whichever box is tighter
+    OrientedBox orientedBox(center, Vector3f(halfExtents[0], halfExtents[1], halfExtents[2]), axes[0], axes[1], axes[2]);
+    OrientedBox axisAlignedBox(AABox::FromPoints(pPoints, nPoints));
+    return (axisAlignedBox.GetVolume() <= orientedBox.GetVolume()) ? axisAlignedBox : orientedBox;
+}
+
+OrientedBox OrientedBox::FromPoints(const SIMDVector3f *pPoints, uint32 nPoints)
+{
+    return ComputeOrientedBoxFromPoints(pPoints, nPoints);
+}
+
+OrientedBox OrientedBox::FromPoints(const Vector3f *pPoints, uint32 nPoints)
+{
+    return ComputeOrientedBoxFromPoints(pPoints, nPoints);
+}
@@ -0,0 +1,315 @@
+#include "YRenderLib/Math/PoseBlending.h"
+#include "YRenderLib/Math/SIMDLanes.h"
+#include "YBaseLib/Memory.h"
+
+struct QuaternionLanes
+{
+    Lanes x, y, z, w;
+};
+
+static inline void LoadQuaternionLanes(QuaternionLanes &q, const PoseSoA &pose, uint32 bone)
+{
+    q.x = LanesLoad(pose.GetStream(PoseSoA::STREAM_ROTATION_X) + bone);
+    q.y = LanesLoad(pose.GetStream(PoseSoA::STREAM_ROTATION_Y) + bone);
+    q.z = LanesLoad(pose.GetStream(PoseSoA::STREAM_ROTATION_Z) + bone);
+    q.w = LanesLoad(pose.GetStream(PoseSoA::STREAM_ROTATION_W) + bone);
+}
+
+static inline void StoreQuaternionLanes(PoseSoA *pPose, uint32 bone, const QuaternionLanes &q)
+{
+    LanesStore(pPose->GetStream(PoseSoA::STREAM_ROTATION_X) + bone, q.x);
+    LanesStore(pPose->GetStream(PoseSoA::STREAM_ROTATION_Y) + bone, q.y);
+    LanesStore(pPose->GetStream(PoseSoA::STREAM_ROTATION_Z) + bone, q.z);
+    LanesStore(pPose->GetStream(PoseSoA::STREAM_ROTATION_W) + bone, q.w);
+}
+
+static inline void NormalizeQuaternionLanes(QuaternionLanes &q)
+{
+    Lanes invLength = LanesRsqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    q.x = q.x * invLength;
+    q.y = q.y * invLength;
+    q.z = q.z * invLength;
+    q.w = q.w * invLength;
+}
+
+// same product as Quaternion::operator*
+static inline QuaternionLanes MultiplyQuaternionLanes(const QuaternionLanes &a, const QuaternionLanes &b)
+{
+    QuaternionLanes r;
+    r.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+    r.y = a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z;
+    r.z = a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x;
+    r.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+    return r;
+}
+
+// adjusts the interpolation factor so that nlerp follows slerp closely, given the absolute cosine between the two rotations
+// see "Approximating slerp", A. Kapoulkine
+static inline Lanes SlerpCorrectedFactor(const Lanes &absCosTheta, const Lanes &factor)
+{
+    const Lanes &d = absCosTheta;
+    Lanes A = LanesSplat(1.0904f) + d * (LanesSplat(-3.2452f) + d * (LanesSplat(3.55645f) - d * LanesSplat(1.43519f)));
+    Lanes B = LanesSplat(0.848013f) + d * (LanesSplat(-1.06021f) + d * LanesSplat(0.215638f));
+    Lanes tc = factor - LanesSplat(0.5f);
+    Lanes k = A * tc * tc + B;
+    return factor + factor * tc * (factor - LanesSplat(1.0f)) * k;
+}
+
+// interpolates along the shortest arc
+static inline QuaternionLanes InterpolateQuaternionLanes(const QuaternionLanes &a, const QuaternionLanes &b, const Lanes &factor, POSE_BLEND_ROTATION_MODE rotationMode)
+{
+    Lanes cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    Lanes t = (rotationMode == POSE_BLEND_ROTATION_MODE_SLERP) ? SlerpCorrectedFactor(LanesAbs(cosTheta), factor) : factor;
+
+    QuaternionLanes r;
+    r.x = a.x + (LanesXorSign(b.x, cosTheta) - a.x) * t;
+    r.y = a.y + (LanesXorSign(b.y, cosTheta) - a.y) * t;
+    r.z = a.z + (LanesXorSign(b.z, cosTheta) - a.z) * t;
+    r.w = a.w + (LanesXorSign(b.w, cosTheta) - a.w) * t;
+    NormalizeQuaternionLanes(r);
+    return r;
+}
+
+// weights for four bones, with the tail of the caller's array padded out
+static inline Lanes LoadBoneWeightLanes(const float *pBoneWeights, uint32 bone, uint32 boneCount, const Lanes &globalWeight)
+{
+    if (pBoneWeights == nullptr)
+        return globalWeight;
+
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float weights[4];
+    uint32 count = Min(boneCount - bone, (uint32)4);
+    for (uint32 i = 0; i < 4; i++)
+        weights[i] = (i < count) ? pBoneWeights[bone + i] : 0.0f;
+
+    return LanesLoad(weights) * globalWeight;
+}
+
+//----------------------------------------------------- PoseSoA --------------------------------------------------------------------------------------------------------------------
+
+PoseSoA::PoseSoA()
+    : m_pData(nullptr),
+      m_boneCount(0),
+      m_paddedBoneCount(0)
+{
+
+}
+
+PoseSoA::PoseSoA(uint32 boneCount)
+    : m_pData(nullptr),
+      m_boneCount(0),
+      m_paddedBoneCount(0)
+{
+    Resize(boneCount);
+}
+
+PoseSoA::~PoseSoA()
+{
+    if (m_pData != nullptr)
+        Y_aligned_free(m_pData);
+}
+
+void PoseSoA::Resize(uint32 boneCount)
+{
+    uint32 paddedBoneCount = (boneCount + 3) & ~3u;
+    if (paddedBoneCount != m_paddedBoneCount)
+    {
+        if (m_pData != nullptr)
+            Y_aligned_free(m_pData);
+
+        m_pData = (paddedBoneCount > 0) ? reinterpret_cast<float *>(Y_aligned_malloc(sizeof(float) * STREAM_COUNT * paddedBoneCount, Y_SSE_ALIGNMENT)) : nullptr;
+        m_paddedBoneCount = paddedBoneCount;
+    }
+
+    m_boneCount = boneCount;
+
+    // keep the padding lanes as valid unit quaternions so normalization never produces NaNs
+    for (uint32 i = boneCount; i < paddedBoneCount; i++)
+        SetTransform(i, Transform::Identity);
+}
+
+void PoseSoA::SetIdentity()
+{
+    for (uint32 i = 0; i < m_paddedBoneCount; i++)
+        SetTransform(i, Transform::Identity);
+}
+
+void PoseSoA::LoadTransforms(const Transform *pTransforms, uint32 count)
+{
+    DebugAssert(count == m_boneCount);
+    for (uint32 i = 0; i < count; i++)
+        SetTransform(i, pTransforms[i]);
+}
+
+void PoseSoA::StoreTransforms(Transform *pTransforms, uint32 count) const
+{
+    DebugAssert(count == m_boneCount);
+    for (uint32 i = 0; i < count; i++)
+        GetTransform(i, &pTransforms[i]);
+}
+
+void PoseSoA::GetTransform(uint32 bone, Transform *pTransform) const
+{
+    DebugAssert(bone < m_paddedBoneCount);
+    const float *pStreams = m_pData + bone;
+    const uint32 stride = m_paddedBoneCount;
+    pTransform->Set(Vector3f(pStreams[STREAM_POSITION_X * stride], pStreams[STREAM_POSITION_Y * stride], pStreams[STREAM_POSITION_Z * stride]),
+                    Quaternion(pStreams[STREAM_ROTATION_X * stride], pStreams[STREAM_ROTATION_Y * stride], pStreams[STREAM_ROTATION_Z * stride], pStreams[STREAM_ROTATION_W * stride]),
+                    Vector3f(pStreams[STREAM_SCALE_X * stride], pStreams[STREAM_SCALE_Y * stride], pStreams[STREAM_SCALE_Z * stride]));
+}
+
+void PoseSoA::SetTransform(uint32 bone, const Transform &transform)
+{
+    DebugAssert(bone < m_paddedBoneCount);
+    float *pStreams = m_pData + bone;
+    const uint32 stride = m_paddedBoneCount;
+    const Vector3f &position = transform.GetPosition();
+    const Quaternion &rotation = transform.GetRotation();
+    const Vector3f &scale = transform.GetScale();
+    pStreams[STREAM_POSITION_X * stride] = position.x;
+    pStreams[STREAM_POSITION_Y * stride] = position.y;
+    pStreams[STREAM_POSITION_Z * stride] = position.z;
+    pStreams[STREAM_ROTATION_X * stride] = rotation.x;
+    pStreams[STREAM_ROTATION_Y * stride] = rotation.y;
+    pStreams[STREAM_ROTATION_Z * stride] = rotation.z;
+    pStreams[STREAM_ROTATION_W * stride] = rotation.w;
+    pStreams[STREAM_SCALE_X * stride] = scale.x;
+    pStreams[STREAM_SCALE_Y * stride] = scale.y;
+    pStreams[STREAM_SCALE_Z * stride] = scale.z;
+}
+
+//----------------------------------------------------- PoseBlending ---------------------------------------------------------------------------------------------------------------
+
+void PoseBlending::Blend(PoseSoA *pOutPose, const PoseSoA &poseA, const PoseSoA &poseB, float weight, POSE_BLEND_ROTATION_MODE rotationMode, const float *pBoneWeights /* = nullptr */)
+{
+    DebugAssert(poseA.GetBoneCount() == poseB.GetBoneCount() && pOutPose->GetBoneCount() == poseA.GetBoneCount());
+
+    const uint32 boneCount = poseA.GetBoneCount();
+    const Lanes globalWeight = LanesSplat(weight);
+    for (uint32 bone = 0; bone < boneCount; bone += 4)
+    {
+        Lanes t = LoadBoneWeightLanes(pBoneWeights, bone, boneCount, globalWeight);
+
+        // position and scale streams are plain lerps
+        static const PoseSoA::STREAM lerpStreams[] = { PoseSoA::STREAM_POSITION_X, PoseSoA::STREAM_POSITION_Y, PoseSoA::STREAM_POSITION_Z, PoseSoA::STREAM_SCALE_X, PoseSoA::STREAM_SCALE_Y, PoseSoA::STREAM_SCALE_Z };
+        for (uint32 i = 0; i < countof(lerpStreams); i++)
+        {
+            Lanes a = LanesLoad(poseA.GetStream(lerpStreams[i]) + bone);
+            Lanes b = LanesLoad(poseB.GetStream(lerpStreams[i]) + bone);
+            LanesStore(pOutPose->GetStream(lerpStreams[i]) + bone, a + (b - a) * t);
+        }
+
+        QuaternionLanes qa, qb;
+        LoadQuaternionLanes(qa, poseA, bone);
+        LoadQuaternionLanes(qb, poseB, bone);
+        StoreQuaternionLanes(pOutPose, bone, InterpolateQuaternionLanes(qa, qb, t, rotationMode));
+    }
+}
+
+void PoseBlending::Add(PoseSoA *pOutPose, const PoseSoA &basePose, const PoseSoA &additivePose, float weight, const float *pBoneWeights /* = nullptr */)
+{
+    DebugAssert(basePose.GetBoneCount() == additivePose.GetBoneCount() && pOutPose->GetBoneCount() == basePose.GetBoneCount());
+
+    const uint32 boneCount = basePose.GetBoneCount();
+    const Lanes globalWeight = LanesSplat(weight);
+    const Lanes one = LanesSplat(1.0f);
+    for (uint32 bone = 0; bone < boneCount; bone += 4)
+    {
+        Lanes t = LoadBoneWeightLanes(pBoneWeights, bone, boneCount, globalWeight);
+
+        for (uint32 i = 0; i < 3; i++)
+        {
+            PoseSoA::STREAM positionStream = (PoseSoA::STREAM)(PoseSoA::STREAM_POSITION_X + i);
+            Lanes basePosition = LanesLoad(basePose.GetStream(positionStream) + bone);
+            Lanes deltaPosition = LanesLoad(additivePose.GetStream(positionStream) + bone);
+            LanesStore(pOutPose->GetStream(positionStream) + bone, basePosition + deltaPosition * t);
+
+            PoseSoA::STREAM scaleStream = (PoseSoA::STREAM)(PoseSoA::STREAM_SCALE_X + i);
+            Lanes baseScale = LanesLoad(basePose.GetStream(scaleStream) + bone);
+            Lanes deltaScale = LanesLoad(additivePose.GetStream(scaleStream) + bone);
+            LanesStore(pOutPose->GetStream(scaleStream) + bone, baseScale * (one + (deltaScale - one) * t));
+        }
+
+        // nlerp from identity, which reduces to scaling the vector part
+        QuaternionLanes base, delta;
+        LoadQuaternionLanes(base, basePose, bone);
+        LoadQuaternionLanes(delta, additivePose, bone);
+        delta.x = LanesXorSign(delta.x, delta.w) * t;
+        delta.y = LanesXorSign(delta.y, delta.w) * t;
+        delta.z = LanesXorSign(delta.z, delta.w) * t;
+        delta.w = one + (LanesAbs(delta.w) - one) * t;
+        NormalizeQuaternionLanes(delta);
+        StoreQuaternionLanes(pOutPose, bone, MultiplyQuaternionLanes(base, delta));
+    }
+}
+
+void PoseBlending::MakeAdditive(PoseSoA *pOutPose, const PoseSoA &sourcePose, const PoseSoA &referencePose)
+{
+    DebugAssert(sourcePose.GetBoneCount() == referencePose.GetBoneCount() && pOutPose->GetBoneCount() == sourcePose.GetBoneCount());
+
+    const uint32 boneCount = sourcePose.GetBoneCount();
+    for (uint32 bone = 0; bone < boneCount; bone += 4)
+    {
+        for (uint32 i = 0; i < 3; i++)
+        {
+            PoseSoA::STREAM positionStream = (PoseSoA::STREAM)(PoseSoA::STREAM_POSITION_X + i);
+            Lanes sourcePosition = LanesLoad(sourcePose.GetStream(positionStream) + bone);
+            Lanes referencePosition = LanesLoad(referencePose.GetStream(positionStream) + bone);
+            LanesStore(pOutPose->GetStream(positionStream) + bone, sourcePosition - referencePosition);
+
+            // scale deltas are ratios, the padded lanes hold a scale of one so this never divides by zero there
+            PoseSoA::STREAM scaleStream = (PoseSoA::STREAM)(PoseSoA::STREAM_SCALE_X + i);
+            const float *pSourceScale = sourcePose.GetStream(scaleStream) + bone;
+            const float *pReferenceScale = referencePose.GetStream(scaleStream) + bone;
+            float *pOutScale = pOutPose->GetStream(scaleStream) + bone;
+            for (uint32 j = 0; j < 4; j++)
+                pOutScale[j] = (pReferenceScale[j] != 0.0f) ? (pSourceScale[j] / pReferenceScale[j]) : 1.0f;
+        }
+
+        // delta = conjugate(reference) * source, so reference * delta == source
+        QuaternionLanes source, reference;
+        LoadQuaternionLanes(source, sourcePose, bone);
+        LoadQuaternionLanes(reference, referencePose, bone);
+        reference.x = LanesSplat(0.0f) - reference.x;
+        reference.y = LanesSplat(0.0f) - reference.y;
+        reference.z = LanesSplat(0.0f) - reference.z;
+        StoreQuaternionLanes(pOutPose, bone, MultiplyQuaternionLanes(reference, source));
+    }
+}
+
+// AoS quaternions are transposed four at a time into lanes, the tail is padded with identity
+static void InterpolateQuaternionArray(Quaternion *pOut, const Quaternion *pStart, const Quaternion *pEnd, uint32 count, float factor, POSE_BLEND_ROTATION_MODE rotationMode)
+{
+    const Lanes t = LanesSplat(factor);
+    for (uint32 base = 0; base < count; base += 4)
+    {
+        uint32 groupCount = Min(count - base, (uint32)4);
+        ALIGN_DECL(Y_SSE_ALIGNMENT) float startComponents[4][4];
+        ALIGN_DECL(Y_SSE_ALIGNMENT) float endComponents[4][4];
+        for (uint32 i = 0; i < 4; i++)
+        {
+            const Quaternion &start = (i < groupCount) ? pStart[base + i] : Quaternion::Identity;
+            const Quaternion &end = (i < groupCount) ? pEnd[base + i] : Quaternion::Identity;
+            startComponents[0][i] = start.x; startComponents[1][i] = start.y; startComponents[2][i] = start.z; startComponents[3][i] = start.w;
+            endComponents[0][i] = end.x; endComponents[1][i] = end.y; endComponents[2][i] = end.z; endComponents[3][i] = end.w;
+        }
+
+        QuaternionLanes qa, qb;
+        qa.x = LanesLoad(startComponents[0]); qa.y = LanesLoad(startComponents[1]); qa.z = LanesLoad(startComponents[2]); qa.w = LanesLoad(startComponents[3]);
+        qb.x = LanesLoad(endComponents[0]); qb.y = LanesLoad(endComponents[1]); qb.z = LanesLoad(endComponents[2]); qb.w = LanesLoad(endComponents[3]);
+
+        QuaternionLanes r = InterpolateQuaternionLanes(qa, qb, t, rotationMode);
+        LanesStore(startComponents[0], r.x); LanesStore(startComponents[1], r.y); LanesStore(startComponents[2], r.z); LanesStore(startComponents[3], r.w);
+        for (uint32 i = 0; i < groupCount; i++)
+            pOut[base + i].Set(startComponents[0][i], startComponents[1][i], startComponents[2][i], startComponents[3][i]);
+    }
+}
+
+void PoseBlending::NLerpQuaternions(Quaternion *pOut, const Quaternion *pStart, const Quaternion *pEnd, uint32 count, float factor)
+{
+    InterpolateQuaternionArray(pOut, pStart, pEnd, count, factor, POSE_BLEND_ROTATION_MODE_NLERP);
+}
+
+void PoseBlending::SLerpQuaternions(Quaternion *pOut, const Quaternion *pStart, const Quaternion *pEnd, uint32 count, float factor)
+{
+    InterpolateQuaternionArray(pOut, pStart, pEnd, count, factor, POSE_BLEND_ROTATION_MODE_SLERP);
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include "YRenderLib/Math/Common.h"
+#include "YRenderLib/Math/Vectorf.h"
+#include "YRenderLib/Math/SIMDVectorf.h"
+
+// Four-wide float helpers shared by the batch kernels in the math library. Kernels are written
+// once against these, which map to SSE when available and to a plain four element loop otherwise.
+// Loads and stores through LanesLoad/LanesStore must be 16-byte aligned.
+
+#if Y_CPU_SSE_LEVEL > 0
+
+struct Lanes
+{
+    __m128 v;
+};
+
+static const ALIGN_DECL(Y_SSE_ALIGNMENT) uint32 g_lanesSignMask[4] = { 0x80000000, 0x80000000, 0x80000000, 0x80000000 };
+
+static inline Lanes LanesLoad(const float *p) { Lanes r; r.v = _mm_load_ps(p); return r; }
+static inline Lanes LanesLoadUnaligned(const float *p) { Lanes r; r.v = _mm_loadu_ps(p); return r; }
+static inline void LanesStore(float *p, const Lanes &a) { _mm_store_ps(p, a.v); }
+static inline Lanes LanesSplat(float f) { Lanes r; r.v = _mm_set_ps1(f); return r; }
+static inline Lanes LanesSet(float x, float y, float z, float w) { Lanes r; r.v = _mm_set_ps(w, z, y, x); return r; }
+static inline Lanes operator+(const Lanes &a, const Lanes &b) { Lanes r; r.v = _mm_add_ps(a.v, b.v); return r; }
+static inline Lanes operator-(const Lanes &a, const Lanes &b) { Lanes r; r.v = _mm_sub_ps(a.v, b.v); return r; }
+static inline Lanes operator*(const Lanes &a, const Lanes &b) { Lanes r; r.v = _mm_mul_ps(a.v, b.v); return r; }
+static inline Lanes LanesMin(const Lanes &a, const Lanes &b) { Lanes r; r.v = _mm_min_ps(a.v, b.v); return r; }
+static inline Lanes LanesMax(const Lanes &a, const Lanes &b) { Lanes r; r.v = _mm_max_ps(a.v, b.v); return r; }
+static inline Lanes LanesSqrt(const Lanes &a) { Lanes r; r.v = _mm_sqrt_ps(a.v); return r; }
+static inline Lanes LanesAbs(const Lanes &a) { Lanes r; r.v = _mm_andnot_ps(_mm_load_ps(reinterpret_cast<const float *>(g_lanesSignMask)), a.v); return r; }
+
+// negates lanes of a where the matching lane of s is negative
+static inline Lanes LanesXorSign(const Lanes &a, const Lanes &s) { Lanes r; r.v = _mm_xor_ps(a.v, _mm_and_ps(s.v, _mm_load_ps(reinterpret_cast<const float *>(g_lanesSignMask)))); return r; }
+
+// a > b ? ifGreater : otherwise
+static inline Lanes LanesSelectGreater(const Lanes &a, const Lanes &b, const Lanes &ifGreater, const Lanes &otherwise)
+{
+    __m128 mask = _mm_cmpgt_ps(a.v, b.v);
+    Lanes r;
+    r.v = _mm_or_ps(_mm_and_ps(mask, ifGreater.v), _mm_andnot_ps(mask, otherwise.v));
+    return r;
+}
+
+// estimate refined with one newton-raphson step
+static inline Lanes LanesRsqrt(const Lanes &a)
+{
+    __m128 est = _mm_rsqrt_ps(a.v);
+    __m128 muls = _mm_mul_ps(_mm_mul_ps(a.v, est), est);
+    Lanes r;
+    r.v = _mm_mul_ps(_mm_mul_ps(_mm_set_ps1(0.5f), est), _mm_sub_ps(_mm_set_ps1(3.0f), muls));
+    return r;
+}
+
+static inline float LanesReduceMin(const Lanes &a)
+{
+    __m128 t = _mm_min_ps(a.v, _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    t = _mm_min_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(t);
+}
+
+static inline float LanesReduceMax(const Lanes &a)
+{
+    __m128 t = _mm_max_ps(a.v, _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    t = _mm_max_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(t);
+}
+
+static inline float LanesReduceSum(const Lanes &a)
+{
+    __m128 t = _mm_add_ps(a.v, _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    t = _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(t);
+}
+
+// transposes four tightly packed Vector3fs (three loads) into x/y/z lanes
+static inline void LanesLoadPoints(const Vector3f *pPoints, Lanes &x, Lanes &y, Lanes &z)
+{
+    const float *p = &pPoints[0].x;
+    __m128 a = _mm_loadu_ps(p + 0);     // x0 y0 z0 x1
+    __m128 b = _mm_loadu_ps(p + 4);     // y1 z1 x2 y2
+    __m128 c = _mm_loadu_ps(p + 8);     // z2 x3 y3 z3
+    x.v = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 3, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+    y.v = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z.v = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static inline void LanesLoadPoints(const SIMDVector3f *pPoints, Lanes &x, Lanes &y, Lanes &z)
+{
+    __m128 r0 = pPoints[0].m128, r1 = pPoints[1].m128, r2 = pPoints[2].m128, r3 = pPoints[3].m128;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    x.v = r0;
+    y.v = r1;
+    z.v = r2;
+}
+
+#else       // Y_CPU_SSE_LEVEL
+
+struct Lanes
+{
+    float v[4];
+};
+
+static inline Lanes LanesLoad(const float *p) { Lanes r; r.v[0] = p[0]; r.v[1] = p[1]; r.v[2] = p[2]; r.v[3] = p[3]; return r; }
+static inline Lanes LanesLoadUnaligned(const float *p) { return LanesLoad(p); }
+static inline void LanesStore(float *p, const Lanes &a) { p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3]; }
+static inline Lanes LanesSplat(float f) { Lanes r; r.v[0] = f; r.v[1] = f; r.v[2] = f; r.v[3] = f; return r; }
+static inline Lanes LanesSet(float x, float y, float z, float w) { Lanes r; r.v[0] = x; r.v[1] = y; r.v[2] = z; r.v[3] = w; return r; }
+static inline Lanes operator+(const Lanes &a, const Lanes &b) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = a.v[i] + b.v[i]; } return r; }
+static inline Lanes operator-(const Lanes &a, const Lanes &b) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = a.v[i] - b.v[i]; } return r; }
+static inline Lanes operator*(const Lanes &a, const Lanes &b) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = a.v[i] * b.v[i]; } return r; }
+static inline Lanes LanesMin(const Lanes &a, const Lanes &b) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = Min(a.v[i], b.v[i]); } return r; }
+static inline Lanes LanesMax(const Lanes &a, const Lanes &b) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = Max(a.v[i], b.v[i]); } return r; }
+static inline Lanes LanesSqrt(const Lanes &a) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = Y_sqrtf(a.v[i]); } return r; }
+static inline Lanes LanesAbs(const Lanes &a) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = Y_fabsf(a.v[i]); } return r; }
+static inline Lanes LanesXorSign(const Lanes &a, const Lanes &s) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = (s.v[i] < 0.0f) ? -a.v[i] : a.v[i]; } return r; }
+static inline Lanes LanesSelectGreater(const Lanes &a, const Lanes &b, const Lanes &ifGreater, const Lanes &otherwise) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = (a.v[i] > b.v[i]) ? ifGreater.v[i] : otherwise.v[i]; } return r; }
+static inline Lanes LanesRsqrt(const Lanes &a) { Lanes r; for (uint32 i = 0; i < 4; i++) { r.v[i] = 1.0f / Y_sqrtf(a.v[i]); } return r; }
+static inline float LanesReduceMin(const Lanes &a) { return Min(Min(a.v[0], a.v[1]), Min(a.v[2], a.v[3])); }
+static inline float LanesReduceMax(const Lanes &a) { return Max(Max(a.v[0], a.v[1]), Max(a.v[2], a.v[3])); }
+static inline float LanesReduceSum(const Lanes &a) { return (a.v[0] + a.v[1]) + (a.v[2] + a.v[3]); }
+
+static inline void LanesLoadPoints(const Vector3f *pPoints, Lanes &x, Lanes &y, Lanes &z)
+{
+    for (uint32 i = 0; i < 4; i++)
+    {
+        x.v[i] = pPoints[i].x;
+        y.v[i] = pPoints[i].y;
+        z.v[i] = pPoints[i].z;
+    }
+}
+
+static inline void LanesLoadPoints(const SIMDVector3f *pPoints, Lanes &x, Lanes &y, Lanes &z)
+{
+    for (uint32 i = 0; i < 4; i++)
+    {
+        x.v[i] = pPoints[i].x;
+        y.v[i] = pPoints[i].y;
+        z.v[i] = pPoints[i].z;
+    }
+}
+
+#endif      // Y_CPU_SSE_LEVEL
+
+// loads up to four points, duplicating the first point into the unused lanes so min/max/distance reductions are unaffected
+template<typename POINT_TYPE>
+static inline void LanesLoadPointsPartial(const POINT_TYPE *pPoints, uint32 count, Lanes &x, Lanes &y, Lanes &z)
+{
+    DebugAssert(count > 0 && count <= 4);
+    POINT_TYPE points[4];
+    for (uint32 i = 0; i < 4; i++)
+        points[i] = pPoints[(i < count) ? i : 0];
+
+    LanesLoadPoints(points, x, y, z);
+}
@@ -3,6 +3,7 @@
 #include "YRenderLib/Math/CollisionDetection.h"
 #include "YRenderLib/Math/Transform.h"
 #include "YRenderLib/Math/SIMDVectorf.h"
+#include "YRenderLib/Math/SIMDLanes.h"
 
 static const float __SphereZero[] = { 0.0f, 0.0f, 0.0f, 0.0f };
 static const float __SphereMaxSize[] = { 0.0f, 0.0f, 0.0f, Y_FLT_MAX };
@@ -153,38 +154,208 @@ Sphere Sphere::FromAABox(const AABox &box)
     return Sphere(center, radius);    
 }
 
-Sphere Sphere::FromPoints(const SIMDVector3f *pPoints, uint32 nPoints)
+// extremal points along the axes and the four cube diagonals (EPOS-14)
+static const float s_extremalPointNormals[7][3] =
 {
-    uint32 i;
-    Assert(nPoints > 0);
+    { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+    { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, -1.0f }, { 1.0f, -1.0f, 1.0f }, { 1.0f, -1.0f, -1.0f }
+};
 
-    SIMDVector3f center(pPoints[0]);
-    for (i = 1; i < nPoints; i++)
-        center += pPoints[i];
-    center /= (float)nPoints;
-    
-    float squaredRadius = 0.0f;
-    for (i = 0; i < nPoints; i++)
-        squaredRadius = Max(squaredRadius, (pPoints[i] - center).SquaredLength());
+struct ExtremalPointLanes
+{
+    Lanes MinProjection[countof(s_extremalPointNormals)];
+    Lanes MinIndex[countof(s_extremalPointNormals)];
+    Lanes MaxProjection[countof(s_extremalPointNormals)];
+    Lanes MaxIndex[countof(s_extremalPointNormals)];
+};
+
+// indices for a group loaded with LanesLoadPointsPartial, the padding lanes repeat the first point so they share its index
+static inline Lanes PartialGroupIndices(uint32 firstIndex, uint32 count)
+{
+    float base = (float)firstIndex;
+    return LanesSet(base, base + ((count > 1) ? 1.0f : 0.0f), base + ((count > 2) ? 2.0f : 0.0f), base + ((count > 3) ? 3.0f : 0.0f));
+}
 
-    return Sphere(center, Math::Sqrt(squaredRadius));
+static inline void UpdateExtremalPoints(ExtremalPointLanes &state, const Lanes &x, const Lanes &y, const Lanes &z, const Lanes &indices)
+{
+    for (uint32 i = 0; i < countof(s_extremalPointNormals); i++)
+    {
+        const float *n = s_extremalPointNormals[i];
+        Lanes projection = x * LanesSplat(n[0]) + y * LanesSplat(n[1]) + z * LanesSplat(n[2]);
+        state.MinIndex[i] = LanesSelectGreater(state.MinProjection[i], projection, indices, state.MinIndex[i]);
+        state.MinProjection[i] = LanesMin(state.MinProjection[i], projection);
+        state.MaxIndex[i] = LanesSelectGreater(projection, state.MaxProjection[i], indices, state.MaxIndex[i]);
+        state.MaxProjection[i] = LanesMax(state.MaxProjection[i], projection);
+    }
 }
 
-Sphere Sphere::FromPoints(const Vector3f *pPoints, uint32 nPoints)
+// returns the squared distance and index of the point farthest from center
+template<typename POINT_TYPE>
+static float FindFarthestPoint(const POINT_TYPE *pPoints, uint32 nPoints, const SIMDVector3f &center, uint32 *pFarthestIndex)
+{
+    const Lanes centerX = LanesSplat(center.x), centerY = LanesSplat(center.y), centerZ = LanesSplat(center.z);
+    Lanes bestDistance0 = LanesSplat(-1.0f), bestIndex0 = LanesSplat(0.0f);
+    Lanes bestDistance1 = bestDistance0, bestIndex1 = bestIndex0;
+    Lanes indices = LanesSet(0.0f, 1.0f, 2.0f, 3.0f);
+    const Lanes four = LanesSplat(4.0f), eight = LanesSplat(8.0f);
+
+    Lanes x, y, z, x1, y1, z1;
+    uint32 i = 0;
+    for (; (i + 8) <= nPoints; i += 8)
+    {
+        LanesLoadPoints(pPoints + i, x, y, z);
+        LanesLoadPoints(pPoints + i + 4, x1, y1, z1);
+        x = x - centerX; y = y - centerY; z = z - centerZ;
+        x1 = x1 - centerX; y1 = y1 - centerY; z1 = z1 - centerZ;
+        Lanes distance0 = x * x + y * y + z * z;
+        Lanes distance1 = x1 * x1 + y1 * y1 + z1 * z1;
+        bestIndex0 = LanesSelectGreater(distance0, bestDistance0, indices, bestIndex0);
+        bestDistance0 = LanesMax(bestDistance0, distance0);
+        bestIndex1 = LanesSelectGreater(distance1, bestDistance1, indices + four, bestIndex1);
+        bestDistance1 = LanesMax(bestDistance1, distance1);
+        indices = indices + eight;
+    }
+    for (; i < nPoints; i += 4)
+    {
+        uint32 count = Min(nPoints - i, (uint32)4);
+        LanesLoadPointsPartial(pPoints + i, count, x, y, z);
+        x = x - centerX; y = y - centerY; z = z - centerZ;
+        Lanes distance = x * x + y * y + z * z;
+        bestIndex0 = LanesSelectGreater(distance, bestDistance0, PartialGroupIndices(i, count), bestIndex0);
+        bestDistance0 = LanesMax(bestDistance0, distance);
+    }
+
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float distances[8];
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float bestIndices[8];
+    LanesStore(distances, bestDistance0);
+    LanesStore(distances + 4, bestDistance1);
+    LanesStore(bestIndices, bestIndex0);
+    LanesStore(bestIndices + 4, bestIndex1);
+
+    uint32 best = 0;
+    for (uint32 lane = 1; lane < 8; lane++)
+    {
+        if (distances[lane] > distances[best])
+            best = lane;
+    }
+
+    *pFarthestIndex = (uint32)bestIndices[best];
+    return distances[best];
+}
+
+// EPOS initial sphere, then grow towards the farthest point until every point is enclosed
+template<typename POINT_TYPE>
+static Sphere ComputeSphereFromPoints(const POINT_TYPE *pPoints, uint32 nPoints)
 {
-    uint32 i;
     Assert(nPoints > 0);
 
-    SIMDVector3f center(pPoints[0]);
-    for (i = 1; i < nPoints; i++)
-        center += SIMDVector3f(pPoints[i]);
-    center /= (float)nPoints;
+    // indices are tracked in float lanes
+    DebugAssert(nPoints < (1u << 24));
 
+    ExtremalPointLanes state;
+    for (uint32 i = 0; i < countof(s_extremalPointNormals); i++)
+    {
+        state.MinProjection[i] = LanesSplat(Y_FLT_MAX);
+        state.MaxProjection[i] = LanesSplat(-Y_FLT_MAX);
+        state.MinIndex[i] = LanesSplat(0.0f);
+        state.MaxIndex[i] = LanesSplat(0.0f);
+    }
+
+    Lanes x, y, z;
+    Lanes indices = LanesSet(0.0f, 1.0f, 2.0f, 3.0f);
+    const Lanes four = LanesSplat(4.0f);
+    uint32 i = 0;
+    for (; (i + 8) <= nPoints; i += 8)
+    {
+        LanesLoadPoints(pPoints + i, x, y, z);
+        UpdateExtremalPoints(state, x, y, z, indices);
+        indices = indices + four;
+        LanesLoadPoints(pPoints + i + 4, x, y, z);
+        UpdateExtremalPoints(state, x, y, z, indices);
+        indices = indices + four;
+    }
+    for (; i < nPoints; i += 4)
+    {
+        uint32 count = Min(nPoints - i, (uint32)4);
+        LanesLoadPointsPartial(pPoints + i, count, x, y, z);
+        UpdateExtremalPoints(state, x, y, z, PartialGroupIndices(i, count));
+    }
+
+    // widest pair of extremal points gives the initial sphere
+    SIMDVector3f center(pPoints[0]);
     float squaredRadius = 0.0f;
-    for (i = 0; i < nPoints; i++)
-        squaredRadius = Max(squaredRadius, (SIMDVector3f(pPoints[i]) - center).SquaredLength());
+    for (uint32 normal = 0; normal < countof(s_extremalPointNormals); normal++)
+    {
+        ALIGN_DECL(Y_SSE_ALIGNMENT) float minProjections[4], maxProjections[4], minIndices[4], maxIndices[4];
+        LanesStore(minProjections, state.MinProjection[normal]);
+        LanesStore(maxProjections, state.MaxProjection[normal]);
+        LanesStore(minIndices, state.MinIndex[normal]);
+        LanesStore(maxIndices, state.MaxIndex[normal]);
+
+        uint32 minLane = 0, maxLane = 0;
+        for (uint32 lane = 1; lane < 4; lane++)
+        {
+            if (minProjections[lane] < minProjections[minLane])
+                minLane = lane;
+            if (maxProjections[lane] > maxProjections[maxLane])
+                maxLane = lane;
+        }
+
+        SIMDVector3f minPoint(pPoints[(uint32)minIndices[minLane]]);
+        SIMDVector3f maxPoint(pPoints[(uint32)maxIndices[maxLane]]);
+        float diameterSquared = (maxPoint - minPoint).SquaredLength();
+        if ((diameterSquared * 0.25f) > squaredRadius)
+        {
+            center = (minPoint + maxPoint) * 0.5f;
+            squaredRadius = diameterSquared * 0.25f;
+        }
+    }
 
-    return Sphere(center, Math::Sqrt(squaredRadius));
+    // each pass brings the farthest point onto the surface, this converges in a handful of passes
+    float radius = Math::Sqrt(squaredRadius);
+    static const uint32 MAX_GROW_PASSES = 16;
+    uint32 pass;
+    for (pass = 0; pass < MAX_GROW_PASSES; pass++)
+    {
+        uint32 farthestIndex;
+        float farthestSquaredDistance = FindFarthestPoint(pPoints, nPoints, center, &farthestIndex);
+        if (farthestSquaredDistance <= (radius * radius))
+            break;
+
+        float distance = Math::Sqrt(farthestSquaredDistance);
+        float newRadius = (radius + distance) * 0.5f;
+        center += (SIMDVector3f(pPoints[farthestIndex]) - center) * ((newRadius - radius) / distance);
+        radius = newRadius;
+    }
+
+    // did not converge, a final ritter pass guarantees containment
+    if (pass == MAX_GROW_PASSES)
+    {
+        for (i = 0; i < nPoints; i++)
+        {
+            SIMDVector3f offset(SIMDVector3f(pPoints[i]) - center);
+            float squaredDistance = offset.SquaredLength();
+            if (squaredDistance > (radius * radius))
+            {
+                float distance = Math::Sqrt(squaredDistance);
+                float newRadius = (radius + distance) * 0.5f;
+                center += offset * ((newRadius - radius) / distance);
+                radius = newRadius;
+            }
+        }
+    }
+
+    return Sphere(center, radius);
+}
+
+Sphere Sphere::FromPoints(const SIMDVector3f *pPoints, uint32 nPoints)
+{
+    return ComputeSphereFromPoints(pPoints, nPoints);
+}
+
+Sphere Sphere::FromPoints(const Vector3f *pPoints, uint32 nPoints)
+{
+    return ComputeSphereFromPoints(pPoints, nPoints);
 }
 
 void Sphere::ApplyTransform(const Transform &transform)
@@ -3,10 +3,13 @@
 #include "YRenderLib/Math/Vectori.h"
 #include "YRenderLib/Math/Vectoru.h"
 #include "YRenderLib/Math/Quaternion.h"
+#include "YRenderLib/Math/Matrixf.h"
+#include "YRenderLib/Math/Transform.h"
 #include "YRenderLib/Math/AABox.h"
 #include "YRenderLib/Math/Sphere.h"
 #include "YBaseLib/BinaryReader.h"
 #include "YBaseLib/BinaryWriter.h"
+#include "YBaseLib/Memory.h"
 
 BinaryReader &operator>>(BinaryReader &binaryReader, Vector2f &value)
 {
@@ -137,3 +140,186 @@ BinaryWriter &operator<<(BinaryWriter &binaryWriter, const Sphere &value)
 {
     return binaryWriter << value.GetCenter() << value.GetRadius();
 }
+
+//------------------------------------------------------------------ Arrays --------------------------------------------------------------------------------------------------------------
+
+// folds to a constant, the byte swapping paths only exist for big-endian hosts
+static inline bool IsLittleEndianHost()
+{
+    const uint32 value = 1;
+    uint8 firstByte;
+    Y_memcpy(&firstByte, &value, sizeof(firstByte));
+    return (firstByte == 1);
+}
+
+static void SwapComponents(uint32 *pComponents, size_t componentCount)
+{
+    for (size_t i = 0; i < componentCount; i++)
+    {
+        uint32 value = pComponents[i];
+        pComponents[i] = (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+    }
+}
+
+// stream calls take 32-bit sizes, so large arrays are split
+static const size_t MAX_BYTES_PER_CALL = 0x40000000;
+
+static bool ReadComponents(BinaryReader &binaryReader, void *pDestination, size_t componentCount)
+{
+    byte *pBytes = reinterpret_cast<byte *>(pDestination);
+    size_t remainingBytes = componentCount * sizeof(uint32);
+    while (remainingBytes > 0)
+    {
+        uint32 chunkSize = (uint32)Min(remainingBytes, MAX_BYTES_PER_CALL);
+        if (!binaryReader.SafeReadBytes(pBytes, chunkSize))
+            return false;
+
+        pBytes += chunkSize;
+        remainingBytes -= chunkSize;
+    }
+
+    if (!IsLittleEndianHost())
+        SwapComponents(reinterpret_cast<uint32 *>(pDestination), componentCount);
+
+    return true;
+}
+
+static bool WriteComponents(BinaryWriter &binaryWriter, const void *pSource, size_t componentCount)
+{
+    const byte *pBytes = reinterpret_cast<const byte *>(pSource);
+    if (IsLittleEndianHost())
+    {
+        size_t remainingBytes = componentCount * sizeof(uint32);
+        while (remainingBytes > 0)
+        {
+            uint32 chunkSize = (uint32)Min(remainingBytes, MAX_BYTES_PER_CALL);
+            if (!binaryWriter.WriteBytes(pBytes, chunkSize))
+                return false;
+
+            pBytes += chunkSize;
+            remainingBytes -= chunkSize;
+        }
+
+        return true;
+    }
+
+    // swapped a block at a time, the source is const
+    uint32 swapBuffer[256];
+    while (componentCount > 0)
+    {
+        size_t blockCount = Min(componentCount, (size_t)countof(swapBuffer));
+        Y_memcpy(swapBuffer, pBytes, blockCount * sizeof(uint32));
+        SwapComponents(swapBuffer, blockCount);
+        if (!binaryWriter.WriteBytes(swapBuffer, (uint32)(blockCount * sizeof(uint32))))
+            return false;
+
+        pBytes += blockCount * sizeof(uint32);
+        componentCount -= blockCount;
+    }
+
+    return true;
+}
+
+static void DecodeComponents(void *pDestination, const void *pData, size_t componentCount)
+{
+    Y_memcpy(pDestination, pData, componentCount * sizeof(uint32));
+    if (!IsLittleEndianHost())
+        SwapComponents(reinterpret_cast<uint32 *>(pDestination), componentCount);
+}
+
+template<typename T>
+const T *StreamMapArray(const void *pData, size_t dataSize, uint32 count)
+{
+    if (!IsLittleEndianHost() || dataSize < (size_t)count * sizeof(T) || (reinterpret_cast<size_t>(pData) % alignof(T)) != 0)
+        return nullptr;
+
+    return reinterpret_cast<const T *>(pData);
+}
+
+// types whose memory layout is their stream layout
+#define DEFINE_COMPONENT_ARRAY_FUNCTIONS(Type) \
+    static_assert(sizeof(Type) % sizeof(uint32) == 0, "stream types are runs of 32-bit components"); \
+    bool StreamReadArray(BinaryReader &binaryReader, Type *pValues, uint32 count) { return ReadComponents(binaryReader, pValues, (size_t)count * (sizeof(Type) / sizeof(uint32))); } \
+    bool StreamWriteArray(BinaryWriter &binaryWriter, const Type *pValues, uint32 count) { return WriteComponents(binaryWriter, pValues, (size_t)count * (sizeof(Type) / sizeof(uint32))); } \
+    void StreamDecodeArray(Type *pValues, const void *pData, uint32 count) { DecodeComponents(pValues, pData, (size_t)count * (sizeof(Type) / sizeof(uint32))); } \
+    template const Type *StreamMapArray<Type>(const void *pData, size_t dataSize, uint32 count);
+
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Vector2f)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Vector3f)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Vector4f)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Vector2i)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Vector3i)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Vector4i)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Vector2u)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Vector3u)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Vector4u)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Quaternion)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Matrix3x3f)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Matrix3x4f)
+DEFINE_COMPONENT_ARRAY_FUNCTIONS(Matrix4x4f)
+
+#undef DEFINE_COMPONENT_ARRAY_FUNCTIONS
+
+// Transforms go through a block of floats, since their members are private
+static const uint32 TRANSFORM_COMPONENT_COUNT = 10;
+static const uint32 TRANSFORM_BLOCK_SIZE = 64;
+
+static void UnpackTransforms(Transform *pValues, const float *pComponents, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++, pComponents += TRANSFORM_COMPONENT_COUNT)
+        pValues[i].Set(Vector3f(pComponents), Quaternion(pComponents[3], pComponents[4], pComponents[5], pComponents[6]), Vector3f(pComponents + 7));
+}
+
+bool StreamReadArray(BinaryReader &binaryReader, Transform *pValues, uint32 count)
+{
+    float components[TRANSFORM_BLOCK_SIZE * TRANSFORM_COMPONENT_COUNT];
+    for (uint32 i = 0; i < count; )
+    {
+        uint32 blockCount = Min(count - i, TRANSFORM_BLOCK_SIZE);
+        if (!ReadComponents(binaryReader, components, blockCount * TRANSFORM_COMPONENT_COUNT))
+            return false;
+
+        UnpackTransforms(pValues + i, components, blockCount);
+        i += blockCount;
+    }
+
+    return true;
+}
+
+bool StreamWriteArray(BinaryWriter &binaryWriter, const Transform *pValues, uint32 count)
+{
+    float components[TRANSFORM_BLOCK_SIZE * TRANSFORM_COMPONENT_COUNT];
+    for (uint32 i = 0; i < count; )
+    {
+        uint32 blockCount = Min(count - i, TRANSFORM_BLOCK_SIZE);
+        float *pComponents = components;
+        for (uint32 j = 0; j < blockCount; j++, pComponents += TRANSFORM_COMPONENT_COUNT)
+        {
+            const Transform &value = pValues[i + j];
+            Y_memcpy(pComponents, &value.GetPosition(), sizeof(float) * 3);
+            Y_memcpy(pComponents + 3, &value.GetRotation(), sizeof(float) * 4);
+            Y_memcpy(pComponents + 7, &value.GetScale(), sizeof(float) * 3);
+        }
+
+        if (!WriteComponents(binaryWriter, components, blockCount * TRANSFORM_COMPONENT_COUNT))
+            return false;
+
+        i += blockCount;
+    }
+
+    return true;
+}
+
+void StreamDecodeArray(Transform *pValues, const void *pData, uint32 count)
+{
+    float components[TRANSFORM_BLOCK_SIZE * TRANSFORM_COMPONENT_COUNT];
+    const byte *pBytes = reinterpret_cast<const byte *>(pData);
+    for (uint32 i = 0; i < count; )
+    {
+        uint32 blockCount = Min(count - i, TRANSFORM_BLOCK_SIZE);
+        DecodeComponents(components, pBytes, blockCount * TRANSFORM_COMPONENT_COUNT);
+        UnpackTransforms(pValues + i, components, blockCount);
+        pBytes += blockCount * TRANSFORM_COMPONENT_COUNT * sizeof(float);
+        i += blockCount;
+    }
+}
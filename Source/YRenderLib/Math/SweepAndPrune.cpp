@@ -0,0 +1,343 @@
+#include "YRenderLib/Math/SweepAndPrune.h"
+#include "YRenderLib/Math/SIMDVectorf.h"
+#include <stdlib.h>
+
+// min endpoints sort before max endpoints of the same value, so touching boxes are reported as overlapping
+static inline bool EndpointLess(float aValue, uint32 aData, float bValue, uint32 bData)
+{
+    return (aValue < bValue || (aValue == bValue && (aData & 1) < (bData & 1)));
+}
+
+static int EndpointCompare(const void *pLeft, const void *pRight)
+{
+    const float leftValue = reinterpret_cast<const float *>(pLeft)[0];
+    const uint32 leftData = reinterpret_cast<const uint32 *>(pLeft)[1];
+    const float rightValue = reinterpret_cast<const float *>(pRight)[0];
+    const uint32 rightData = reinterpret_cast<const uint32 *>(pRight)[1];
+    if (EndpointLess(leftValue, leftData, rightValue, rightData))
+        return -1;
+    else if (EndpointLess(rightValue, rightData, leftValue, leftData))
+        return 1;
+    else
+        return 0;
+}
+
+SweepAndPrune::SweepAndPrune(uint32 sortAxis /* = 0 */)
+    : m_sortAxis(sortAxis),
+      m_liveProxyCount(0),
+      m_pendingAddCount(0),
+      m_hasRemovedProxies(false)
+{
+    DebugAssert(sortAxis < 3);
+}
+
+SweepAndPrune::~SweepAndPrune()
+{
+
+}
+
+uint32 SweepAndPrune::AddProxy(const AABox &bounds, void *pUserData /* = nullptr */)
+{
+    uint32 proxyIndex;
+    if (m_freeProxies.GetSize() > 0)
+    {
+        proxyIndex = m_freeProxies[m_freeProxies.GetSize() - 1];
+        m_freeProxies.Resize(m_freeProxies.GetSize() - 1);
+    }
+    else
+    {
+        proxyIndex = m_proxies.GetSize();
+        m_proxies.Resize(proxyIndex + 1);
+    }
+
+    Proxy &proxy = m_proxies[proxyIndex];
+    proxy.pUserData = pUserData;
+    proxy.Flags = PROXY_FLAG_ALLOCATED;
+    proxy.ActiveIndex = 0;
+    UpdateProxy(proxyIndex, bounds);
+
+    // appended unsorted, the next Update() moves them into place
+    Endpoint minEndpoint = { proxy.MinBounds[m_sortAxis], (proxyIndex << 1) };
+    Endpoint maxEndpoint = { proxy.MaxBounds[m_sortAxis], (proxyIndex << 1) | 1 };
+    m_endpoints.Add(minEndpoint);
+    m_endpoints.Add(maxEndpoint);
+    m_pendingAddCount++;
+    m_liveProxyCount++;
+    return proxyIndex;
+}
+
+void SweepAndPrune::RemoveProxy(uint32 proxy)
+{
+    DebugAssert(proxy < m_proxies.GetSize() && (m_proxies[proxy].Flags & (PROXY_FLAG_ALLOCATED | PROXY_FLAG_REMOVED)) == PROXY_FLAG_ALLOCATED);
+
+    // endpoints are stripped and the index recycled on the next update
+    m_proxies[proxy].Flags |= PROXY_FLAG_REMOVED;
+    m_proxies[proxy].pUserData = nullptr;
+    m_hasRemovedProxies = true;
+    m_liveProxyCount--;
+}
+
+void SweepAndPrune::UpdateProxy(uint32 proxy, const AABox &bounds)
+{
+    DebugAssert(proxy < m_proxies.GetSize() && (m_proxies[proxy].Flags & PROXY_FLAG_ALLOCATED));
+
+    Proxy &proxyRef = m_proxies[proxy];
+    const Vector3f &minBounds = bounds.GetMinBounds();
+    const Vector3f &maxBounds = bounds.GetMaxBounds();
+    proxyRef.MinBounds[0] = minBounds.x;
+    proxyRef.MinBounds[1] = minBounds.y;
+    proxyRef.MinBounds[2] = minBounds.z;
+    proxyRef.MaxBounds[0] = maxBounds.x;
+    proxyRef.MaxBounds[1] = maxBounds.y;
+    proxyRef.MaxBounds[2] = maxBounds.z;
+}
+
+void SweepAndPrune::RemoveAllProxies()
+{
+    m_proxies.Clear();
+    m_freeProxies.Clear();
+    m_endpoints.Clear();
+    m_pairs.Clear();
+    m_liveProxyCount = 0;
+    m_pendingAddCount = 0;
+    m_hasRemovedProxies = false;
+}
+
+AABox SweepAndPrune::GetProxyBounds(uint32 proxy) const
+{
+    DebugAssert(proxy < m_proxies.GetSize());
+    const Proxy &proxyRef = m_proxies[proxy];
+    return AABox(proxyRef.MinBounds[0], proxyRef.MinBounds[1], proxyRef.MinBounds[2], proxyRef.MaxBounds[0], proxyRef.MaxBounds[1], proxyRef.MaxBounds[2]);
+}
+
+void SweepAndPrune::SetSortAxis(uint32 sortAxis)
+{
+    DebugAssert(sortAxis < 3);
+    if (m_sortAxis == sortAxis)
+        return;
+
+    // the existing order is meaningless on the new axis, so treat everything as freshly added
+    m_sortAxis = sortAxis;
+    m_pendingAddCount = m_endpoints.GetSize() / 2;
+}
+
+void SweepAndPrune::SelectSortAxis()
+{
+    if (m_liveProxyCount < 2)
+        return;
+
+    // Welford's running mean and variance, in double so large world coordinates don't cancel out
+    double mean[3] = { 0.0, 0.0, 0.0 };
+    double sumSquaredDeviations[3] = { 0.0, 0.0, 0.0 };
+    uint32 count = 0;
+    for (uint32 i = 0; i < m_proxies.GetSize(); i++)
+    {
+        const Proxy &proxy = m_proxies[i];
+        if ((proxy.Flags & (PROXY_FLAG_ALLOCATED | PROXY_FLAG_REMOVED)) != PROXY_FLAG_ALLOCATED)
+            continue;
+
+        count++;
+        for (uint32 axis = 0; axis < 3; axis++)
+        {
+            double center = ((double)proxy.MinBounds[axis] + (double)proxy.MaxBounds[axis]) * 0.5;
+            double delta = center - mean[axis];
+            mean[axis] += delta / (double)count;
+            sumSquaredDeviations[axis] += delta * (center - mean[axis]);
+        }
+    }
+
+    // variance scaled by n, only the relative magnitude matters
+    double bestVariance = -1.0;
+    uint32 bestAxis = m_sortAxis;
+    for (uint32 axis = 0; axis < 3; axis++)
+    {
+        if (sumSquaredDeviations[axis] > bestVariance)
+        {
+            bestVariance = sumSquaredDeviations[axis];
+            bestAxis = axis;
+        }
+    }
+
+    SetSortAxis(bestAxis);
+}
+
+void SweepAndPrune::RemoveDeadEndpoints()
+{
+    uint32 outIndex = 0;
+    for (uint32 i = 0; i < m_endpoints.GetSize(); i++)
+    {
+        if (!(m_proxies[m_endpoints[i].Data >> 1].Flags & PROXY_FLAG_REMOVED))
+            m_endpoints[outIndex++] = m_endpoints[i];
+    }
+    m_endpoints.Resize(outIndex);
+
+    // now nothing references the removed proxies, so the indices can be reused
+    for (uint32 i = 0; i < m_proxies.GetSize(); i++)
+    {
+        if (m_proxies[i].Flags & PROXY_FLAG_REMOVED)
+        {
+            m_proxies[i].Flags = 0;
+            m_freeProxies.Add(i);
+        }
+    }
+
+    m_hasRemovedProxies = false;
+}
+
+void SweepAndPrune::RefreshEndpointValues()
+{
+    Endpoint *pEndpoints = m_endpoints.GetBasePointer();
+    const Proxy *pProxies = m_proxies.GetBasePointer();
+    const uint32 axis = m_sortAxis;
+    const uint32 endpointCount = m_endpoints.GetSize();
+    for (uint32 i = 0; i < endpointCount; i++)
+    {
+        const Proxy &proxy = pProxies[pEndpoints[i].Data >> 1];
+        pEndpoints[i].Value = (pEndpoints[i].Data & 1) ? proxy.MaxBounds[axis] : proxy.MinBounds[axis];
+    }
+}
+
+void SweepAndPrune::SortEndpoints()
+{
+    Endpoint *pEndpoints = m_endpoints.GetBasePointer();
+    const uint32 endpointCount = m_endpoints.GetSize();
+
+    // a large batch of new proxies would degrade insertion sort to quadratic time
+    if (m_pendingAddCount > 0 && m_pendingAddCount * 8 > endpointCount)
+    {
+        qsort(pEndpoints, endpointCount, sizeof(Endpoint), EndpointCompare);
+        m_pendingAddCount = 0;
+        return;
+    }
+
+    // objects move little between frames, so most endpoints only shift a few places
+    for (uint32 i = 1; i < endpointCount; i++)
+    {
+        Endpoint key = pEndpoints[i];
+        uint32 j = i;
+        while (j > 0 && EndpointLess(key.Value, key.Data, pEndpoints[j - 1].Value, pEndpoints[j - 1].Data))
+        {
+            pEndpoints[j] = pEndpoints[j - 1];
+            j--;
+        }
+        pEndpoints[j] = key;
+    }
+
+    m_pendingAddCount = 0;
+}
+
+void SweepAndPrune::Sweep()
+{
+    const uint32 axisA = (m_sortAxis + 1) % 3;
+    const uint32 axisB = (m_sortAxis + 2) % 3;
+
+    // padded so the SIMD loop can always load a full group of four
+    const uint32 activeCapacity = ((m_proxies.GetSize() + 3) & ~3u) + 4;
+    if (m_activeProxies.GetSize() < activeCapacity)
+    {
+        m_activeMinA.Resize(activeCapacity);
+        m_activeMaxA.Resize(activeCapacity);
+        m_activeMinB.Resize(activeCapacity);
+        m_activeMaxB.Resize(activeCapacity);
+        m_activeProxies.Resize(activeCapacity);
+    }
+
+    float *pActiveMinA = m_activeMinA.GetBasePointer();
+    float *pActiveMaxA = m_activeMaxA.GetBasePointer();
+    float *pActiveMinB = m_activeMinB.GetBasePointer();
+    float *pActiveMaxB = m_activeMaxB.GetBasePointer();
+    uint32 *pActiveProxies = m_activeProxies.GetBasePointer();
+    uint32 activeCount = 0;
+
+    Proxy *pProxies = m_proxies.GetBasePointer();
+    const Endpoint *pEndpoints = m_endpoints.GetBasePointer();
+    const uint32 endpointCount = m_endpoints.GetSize();
+
+    m_pairs.Clear();
+
+    for (uint32 endpointIndex = 0; endpointIndex < endpointCount; endpointIndex++)
+    {
+        const uint32 proxyIndex = pEndpoints[endpointIndex].Data >> 1;
+        Proxy &proxy = pProxies[proxyIndex];
+
+        if (pEndpoints[endpointIndex].Data & 1)
+        {
+            // max endpoint, swap the last active proxy into this slot
+            uint32 slot = proxy.ActiveIndex;
+            uint32 last = --activeCount;
+            if (slot != last)
+            {
+                pActiveMinA[slot] = pActiveMinA[last];
+                pActiveMaxA[slot] = pActiveMaxA[last];
+                pActiveMinB[slot] = pActiveMinB[last];
+                pActiveMaxB[slot] = pActiveMaxB[last];
+                pActiveProxies[slot] = pActiveProxies[last];
+                pProxies[pActiveProxies[slot]].ActiveIndex = slot;
+            }
+
+            continue;
+        }
+
+        // min endpoint, everything in the active set overlaps on the sort axis
+        const float minA = proxy.MinBounds[axisA];
+        const float maxA = proxy.MaxBounds[axisA];
+        const float minB = proxy.MinBounds[axisB];
+        const float maxB = proxy.MaxBounds[axisB];
+
+#if Y_CPU_SSE_LEVEL > 0
+        const __m128 vMinA = _mm_set_ps1(minA);
+        const __m128 vMaxA = _mm_set_ps1(maxA);
+        const __m128 vMinB = _mm_set_ps1(minB);
+        const __m128 vMaxB = _mm_set_ps1(maxB);
+        for (uint32 i = 0; i < activeCount; i += 4)
+        {
+            __m128 overlapA = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(pActiveMinA + i), vMaxA), _mm_cmple_ps(vMinA, _mm_loadu_ps(pActiveMaxA + i)));
+            __m128 overlapB = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(pActiveMinB + i), vMaxB), _mm_cmple_ps(vMinB, _mm_loadu_ps(pActiveMaxB + i)));
+            uint32 mask = (uint32)_mm_movemask_ps(_mm_and_ps(overlapA, overlapB));
+            if ((activeCount - i) < 4)
+                mask &= (1u << (activeCount - i)) - 1;
+
+            for (uint32 j = 0; mask != 0; j++, mask >>= 1)
+            {
+                if (mask & 1)
+                {
+                    uint32 otherIndex = pActiveProxies[i + j];
+                    OverlapPair pair = { Min(proxyIndex, otherIndex), Max(proxyIndex, otherIndex) };
+                    m_pairs.Add(pair);
+                }
+            }
+        }
+#else
+        for (uint32 i = 0; i < activeCount; i++)
+        {
+            if (pActiveMinA[i] <= maxA && minA <= pActiveMaxA[i] && pActiveMinB[i] <= maxB && minB <= pActiveMaxB[i])
+            {
+                uint32 otherIndex = pActiveProxies[i];
+                OverlapPair pair = { Min(proxyIndex, otherIndex), Max(proxyIndex, otherIndex) };
+                m_pairs.Add(pair);
+            }
+        }
+#endif
+
+        // add to the active set
+        uint32 slot = activeCount++;
+        pActiveMinA[slot] = minA;
+        pActiveMaxA[slot] = maxA;
+        pActiveMinB[slot] = minB;
+        pActiveMaxB[slot] = maxB;
+        pActiveProxies[slot] = proxyIndex;
+        proxy.ActiveIndex = slot;
+    }
+
+    DebugAssert(activeCount == 0);
+}
+
+void SweepAndPrune::Update()
+{
+    if (m_hasRemovedProxies)
+        RemoveDeadEndpoints();
+
+    RefreshEndpointValues();
+    SortEndpoints();
+    Sweep();
+}
@@ -0,0 +1,653 @@
+#include "YRenderLib/MeshOptimizer.h"
+#include "YRenderLib/Math/HashTraits.h"
+#include "YRenderLib/Math/Vectorf.h"
+#include "YBaseLib/Memory.h"
+#include "YBaseLib/Log.h"
+#include <algorithm>
+#include <cmath>
+Log_SetChannel(MeshOptimizer);
+
+static const uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+//------------------------------------------------------------------ Indices -------------------------------------------------------------------------------------------------------------
+
+// Everything works on 32-bit indices internally. Reading into a copy first is also what makes in-place output safe.
+static bool ReadIndices(uint32 *pDestination, const void *pIndices, GPU_INDEX_FORMAT indexFormat, uint32 indexCount, uint32 vertexCount, const char *functionName)
+{
+    if (indexFormat == GPU_INDEX_FORMAT_UINT16)
+    {
+        const uint16 *pSource = reinterpret_cast<const uint16 *>(pIndices);
+        for (uint32 i = 0; i < indexCount; i++)
+            pDestination[i] = pSource[i];
+    }
+    else
+    {
+        Y_memcpy(pDestination, pIndices, sizeof(uint32) * indexCount);
+    }
+
+    for (uint32 i = 0; i < indexCount; i++)
+    {
+        if (pDestination[i] >= vertexCount)
+        {
+            Log_ErrorPrintf("MeshOptimizer::%s: Index %u at %u is out of range for %u vertices", functionName, pDestination[i], i, vertexCount);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void WriteIndices(void *pDestination, const uint32 *pIndices, GPU_INDEX_FORMAT indexFormat, uint32 indexCount)
+{
+    if (indexFormat == GPU_INDEX_FORMAT_UINT16)
+    {
+        uint16 *pDestinationIndices = reinterpret_cast<uint16 *>(pDestination);
+        for (uint32 i = 0; i < indexCount; i++)
+            pDestinationIndices[i] = (uint16)pIndices[i];
+    }
+    else
+    {
+        Y_memcpy(pDestination, pIndices, sizeof(uint32) * indexCount);
+    }
+}
+
+static bool CheckTriangleList(uint32 indexCount, const char *functionName)
+{
+    if ((indexCount % 3) != 0)
+    {
+        Log_ErrorPrintf("MeshOptimizer::%s: %u indices isn't a whole number of triangles", functionName, indexCount);
+        return false;
+    }
+
+    return true;
+}
+
+// FIFO cache simulation: a vertex is in the cache if fewer than cacheSize misses happened since it was loaded.
+// Advancing the timestamp by more than cacheSize flushes it.
+static inline uint32 SimulateTriangle(uint32 *pCacheTimestamps, uint32 *pTimestamp, uint32 cacheSize, const uint32 *pTriangle)
+{
+    uint32 misses = 0;
+    for (uint32 i = 0; i < 3; i++)
+    {
+        uint32 vertex = pTriangle[i];
+        if ((*pTimestamp - pCacheTimestamps[vertex]) > cacheSize)
+        {
+            pCacheTimestamps[vertex] = (*pTimestamp)++;
+            misses++;
+        }
+    }
+
+    return misses;
+}
+
+float MeshOptimizer::AnalyzeVertexCache(const void *pIndices, GPU_INDEX_FORMAT indexFormat, uint32 indexCount, uint32 vertexCount, uint32 cacheSize)
+{
+    if (indexCount < 3 || !CheckTriangleList(indexCount, "AnalyzeVertexCache"))
+        return 0.0f;
+
+    uint32 *pMemory = Y_mallocT<uint32>(indexCount + vertexCount);
+    uint32 *pIndices32 = pMemory;
+    uint32 *pCacheTimestamps = pMemory + indexCount;
+    if (!ReadIndices(pIndices32, pIndices, indexFormat, indexCount, vertexCount, "AnalyzeVertexCache"))
+    {
+        Y_free(pMemory);
+        return 0.0f;
+    }
+
+    // starting the clock past the cache size makes every vertex start out cold
+    for (uint32 i = 0; i < vertexCount; i++)
+        pCacheTimestamps[i] = 0;
+
+    uint32 timestamp = cacheSize + 1;
+    uint32 misses = 0;
+    for (uint32 i = 0; i < indexCount; i += 3)
+        misses += SimulateTriangle(pCacheTimestamps, &timestamp, cacheSize, pIndices32 + i);
+
+    Y_free(pMemory);
+    return (float)misses / (float)(indexCount / 3);
+}
+
+//------------------------------------------------------------------ Vertex welding ------------------------------------------------------------------------------------------------------
+
+// Part of the vertex compared when welding. Float and half components have their sign bit cleared when the rest is zero.
+struct VertexKeyRange
+{
+    uint32 Offset;
+    uint32 Size;
+    uint32 ComponentSize;           // 4 for float, 2 for half, 0 to compare raw bytes
+};
+
+static void BuildVertexKey(byte *pKey, const byte *pVertex, const VertexKeyRange *pRanges, uint32 rangeCount)
+{
+    for (uint32 i = 0; i < rangeCount; i++)
+    {
+        const VertexKeyRange &range = pRanges[i];
+        Y_memcpy(pKey, pVertex + range.Offset, range.Size);
+
+        if (range.ComponentSize == 4)
+        {
+            for (uint32 j = 0; j < range.Size; j += 4)
+            {
+                uint32 bits;
+                Y_memcpy(&bits, pKey + j, sizeof(bits));
+                if (bits == 0x80000000u)
+                    Y_memzero(pKey + j, sizeof(bits));
+            }
+        }
+        else if (range.ComponentSize == 2)
+        {
+            for (uint32 j = 0; j < range.Size; j += 2)
+            {
+                uint16 bits;
+                Y_memcpy(&bits, pKey + j, sizeof(bits));
+                if (bits == 0x8000u)
+                    Y_memzero(pKey + j, sizeof(bits));
+            }
+        }
+
+        pKey += range.Size;
+    }
+}
+
+uint32 MeshOptimizer::GenerateVertexRemap(uint32 *pRemap, const GPU_VERTEX_ELEMENT_DESC *pElements, uint32 nElements,
+                                          const void *pVertices, uint32 vertexStride, uint32 vertexCount)
+{
+    VertexKeyRange ranges[GPU_INPUT_LAYOUT_MAX_ELEMENTS];
+    uint32 rangeCount = 0;
+    uint32 keySize = 0;
+    for (uint32 i = 0; i < nElements; i++)
+    {
+        const GPU_VERTEX_ELEMENT_DESC &element = pElements[i];
+        uint32 elementSize = GPUVertexElementTypeSize(element.Type);
+        if (rangeCount == countof(ranges) || (element.StreamOffset + elementSize) > vertexStride)
+        {
+            Log_ErrorPrintf("MeshOptimizer::GenerateVertexRemap: Element %u doesn't fit in a %u byte vertex", i, vertexStride);
+            return 0;
+        }
+
+        VertexKeyRange &range = ranges[rangeCount++];
+        range.Offset = element.StreamOffset;
+        range.Size = elementSize;
+        switch (element.Type)
+        {
+        case GPU_VERTEX_ELEMENT_TYPE_FLOAT:
+        case GPU_VERTEX_ELEMENT_TYPE_FLOAT2:
+        case GPU_VERTEX_ELEMENT_TYPE_FLOAT3:
+        case GPU_VERTEX_ELEMENT_TYPE_FLOAT4:
+            range.ComponentSize = 4;
+            break;
+
+        case GPU_VERTEX_ELEMENT_TYPE_HALF:
+        case GPU_VERTEX_ELEMENT_TYPE_HALF2:
+        case GPU_VERTEX_ELEMENT_TYPE_HALF4:
+            range.ComponentSize = 2;
+            break;
+
+        default:
+            range.ComponentSize = 0;
+            break;
+        }
+
+        keySize += elementSize;
+    }
+
+    // open addressing with linear probing, kept at most half full
+    uint32 tableSize = 16;
+    while (tableSize < vertexCount * 2)
+        tableSize *= 2;
+
+    uint32 *pMemory = Y_mallocT<uint32>(tableSize + vertexCount);
+    uint32 *pTable = pMemory;
+    uint32 *pHashes = pMemory + tableSize;
+    byte *pKeyMemory = Y_mallocT<byte>(keySize * 2 + 1);
+    byte *pKey = pKeyMemory;
+    byte *pOtherKey = pKeyMemory + keySize;
+    for (uint32 i = 0; i < tableSize; i++)
+        pTable[i] = INVALID_INDEX;
+
+    const byte *pVertexBytes = reinterpret_cast<const byte *>(pVertices);
+    uint32 uniqueCount = 0;
+    for (uint32 i = 0; i < vertexCount; i++)
+    {
+        BuildVertexKey(pKey, pVertexBytes + i * vertexStride, ranges, rangeCount);
+        uint32 hash = HashTrait_HashBytes(pKey, keySize);
+        pHashes[i] = hash;
+
+        uint32 slot = hash & (tableSize - 1);
+        for (;;)
+        {
+            uint32 other = pTable[slot];
+            if (other == INVALID_INDEX)
+            {
+                pTable[slot] = i;
+                pRemap[i] = uniqueCount++;
+                break;
+            }
+
+            if (pHashes[other] == hash)
+            {
+                BuildVertexKey(pOtherKey, pVertexBytes + other * vertexStride, ranges, rangeCount);
+                if (Y_memcmp(pKey, pOtherKey, keySize) == 0)
+                {
+                    pRemap[i] = pRemap[other];
+                    break;
+                }
+            }
+
+            slot = (slot + 1) & (tableSize - 1);
+        }
+    }
+
+    Y_free(pKeyMemory);
+    Y_free(pMemory);
+    return uniqueCount;
+}
+
+void MeshOptimizer::RemapVertices(void *pDestinationVertices, const void *pVertices, uint32 vertexStride, uint32 vertexCount, const uint32 *pRemap)
+{
+    DebugAssert(pDestinationVertices != pVertices);
+
+    byte *pDestinationBytes = reinterpret_cast<byte *>(pDestinationVertices);
+    const byte *pSourceBytes = reinterpret_cast<const byte *>(pVertices);
+    for (uint32 i = 0; i < vertexCount; i++)
+    {
+        if (pRemap[i] != INVALID_INDEX)
+            Y_memcpy(pDestinationBytes + pRemap[i] * vertexStride, pSourceBytes + i * vertexStride, vertexStride);
+    }
+}
+
+void MeshOptimizer::RemapIndices(void *pDestinationIndices, const void *pIndices, GPU_INDEX_FORMAT indexFormat, uint32 indexCount, const uint32 *pRemap)
+{
+    if (indexFormat == GPU_INDEX_FORMAT_UINT16)
+    {
+        uint16 *pDestination = reinterpret_cast<uint16 *>(pDestinationIndices);
+        const uint16 *pSource = reinterpret_cast<const uint16 *>(pIndices);
+        for (uint32 i = 0; i < indexCount; i++)
+            pDestination[i] = (uint16)pRemap[pSource[i]];
+    }
+    else
+    {
+        uint32 *pDestination = reinterpret_cast<uint32 *>(pDestinationIndices);
+        const uint32 *pSource = reinterpret_cast<const uint32 *>(pIndices);
+        for (uint32 i = 0; i < indexCount; i++)
+            pDestination[i] = pRemap[pSource[i]];
+    }
+}
+
+//------------------------------------------------------------------ Vertex cache --------------------------------------------------------------------------------------------------------
+
+// Tom Forsyth, "Linear-Speed Vertex Cache Optimisation". Vertices score higher the more recently they were used and
+// the fewer triangles they have left, and the triangle with the best total score next to the cache is emitted next.
+static const uint32 FORSYTH_CACHE_SIZE = 32;
+static const uint32 FORSYTH_MAX_VALENCE = 64;
+
+struct ForsythScoreTables
+{
+    ForsythScoreTables()
+    {
+        // the last triangle's vertices score the same whatever their order, so it isn't simply repeated
+        for (uint32 i = 0; i < FORSYTH_CACHE_SIZE; i++)
+            Cache[i] = (i < 3) ? 0.75f : powf(1.0f - (float)(i - 3) / (float)(FORSYTH_CACHE_SIZE - 3), 1.5f);
+
+        // boosts vertices with few triangles left, so they're finished off instead of leaving lone triangles behind
+        Valence[0] = 0.0f;
+        for (uint32 i = 1; i < FORSYTH_MAX_VALENCE; i++)
+            Valence[i] = 2.0f * powf((float)i, -0.5f);
+    }
+
+    float Cache[FORSYTH_CACHE_SIZE + 3];
+    float Valence[FORSYTH_MAX_VALENCE];
+};
+
+static const ForsythScoreTables s_ForsythScoreTables;
+
+static inline float ForsythVertexScore(uint32 cachePosition, uint32 remainingTriangles)
+{
+    float score = (cachePosition < FORSYTH_CACHE_SIZE) ? s_ForsythScoreTables.Cache[cachePosition] : 0.0f;
+    return score + s_ForsythScoreTables.Valence[Min(remainingTriangles, FORSYTH_MAX_VALENCE - 1)];
+}
+
+bool MeshOptimizer::OptimizeVertexCache(void *pDestinationIndices, const void *pIndices, GPU_INDEX_FORMAT indexFormat, uint32 indexCount, uint32 vertexCount)
+{
+    if (!CheckTriangleList(indexCount, "OptimizeVertexCache"))
+        return false;
+
+    uint32 triangleCount = indexCount / 3;
+    if (triangleCount == 0)
+        return true;
+
+    // indices, per-vertex triangle lists, then per-vertex and per-triangle state
+    uint32 *pMemory = Y_mallocT<uint32>(indexCount * 2 + vertexCount * 3 + 1);
+    uint32 *pIndices32 = pMemory;
+    uint32 *pVertexTriangles = pIndices32 + indexCount;
+    uint32 *pTriangleListStart = pVertexTriangles + indexCount;
+    uint32 *pRemainingTriangles = pTriangleListStart + vertexCount + 1;
+    uint32 *pCachePosition = pRemainingTriangles + vertexCount;
+    float *pScoreMemory = Y_mallocT<float>(vertexCount + triangleCount);
+    float *pVertexScores = pScoreMemory;
+    float *pTriangleScores = pScoreMemory + vertexCount;
+    if (!ReadIndices(pIndices32, pIndices, indexFormat, indexCount, vertexCount, "OptimizeVertexCache"))
+    {
+        Y_free(pScoreMemory);
+        Y_free(pMemory);
+        return false;
+    }
+
+    for (uint32 i = 0; i < vertexCount; i++)
+        pRemainingTriangles[i] = 0;
+    for (uint32 i = 0; i < indexCount; i++)
+        pRemainingTriangles[pIndices32[i]]++;
+
+    uint32 listStart = 0;
+    for (uint32 i = 0; i < vertexCount; i++)
+    {
+        pTriangleListStart[i] = listStart;
+        listStart += pRemainingTriangles[i];
+        pRemainingTriangles[i] = 0;
+        pCachePosition[i] = INVALID_INDEX;
+    }
+    pTriangleListStart[vertexCount] = listStart;
+
+    for (uint32 i = 0; i < indexCount; i++)
+    {
+        uint32 vertex = pIndices32[i];
+        pVertexTriangles[pTriangleListStart[vertex] + pRemainingTriangles[vertex]++] = i / 3;
+    }
+
+    for (uint32 i = 0; i < vertexCount; i++)
+        pVertexScores[i] = ForsythVertexScore(INVALID_INDEX, pRemainingTriangles[i]);
+
+    uint32 bestTriangle = 0;
+    for (uint32 i = 0; i < triangleCount; i++)
+    {
+        const uint32 *pTriangle = pIndices32 + i * 3;
+        pTriangleScores[i] = pVertexScores[pTriangle[0]] + pVertexScores[pTriangle[1]] + pVertexScores[pTriangle[2]];
+        if (pTriangleScores[i] > pTriangleScores[bestTriangle])
+            bestTriangle = i;
+    }
+
+    // the output goes to its own buffer, as pIndices32 is still read while emitting
+    uint32 *pOutput = Y_mallocT<uint32>(indexCount);
+    uint32 outputCount = 0;
+    uint32 cache[FORSYTH_CACHE_SIZE + 3];
+    uint32 cacheCount = 0;
+    uint32 nextUnemittedTriangle = 0;
+    while (outputCount < indexCount)
+    {
+        // dead end, carry on from the earliest triangle not yet emitted
+        if (bestTriangle == INVALID_INDEX)
+        {
+            while (pTriangleScores[nextUnemittedTriangle] < 0.0f)
+                nextUnemittedTriangle++;
+
+            bestTriangle = nextUnemittedTriangle;
+        }
+
+        const uint32 *pTriangle = pIndices32 + bestTriangle * 3;
+        pTriangleScores[bestTriangle] = -1.0f;
+        pOutput[outputCount++] = pTriangle[0];
+        pOutput[outputCount++] = pTriangle[1];
+        pOutput[outputCount++] = pTriangle[2];
+
+        // drop the triangle from its vertices' lists
+        for (uint32 i = 0; i < 3; i++)
+        {
+            uint32 vertex = pTriangle[i];
+            uint32 *pList = pVertexTriangles + pTriangleListStart[vertex];
+            uint32 count = pRemainingTriangles[vertex];
+            for (uint32 j = 0; j < count; j++)
+            {
+                if (pList[j] == bestTriangle)
+                {
+                    pList[j] = pList[count - 1];
+                    break;
+                }
+            }
+
+            pRemainingTriangles[vertex] = count - 1;
+        }
+
+        // the triangle's vertices move to the front of the cache, pushing the rest back
+        uint32 newCache[FORSYTH_CACHE_SIZE + 3];
+        uint32 newCacheCount = 3;
+        newCache[0] = pTriangle[0];
+        newCache[1] = pTriangle[1];
+        newCache[2] = pTriangle[2];
+        for (uint32 i = 0; i < cacheCount; i++)
+        {
+            uint32 vertex = cache[i];
+            if (vertex != pTriangle[0] && vertex != pTriangle[1] && vertex != pTriangle[2])
+                newCache[newCacheCount++] = vertex;
+        }
+
+        // rescore everything that moved, including the vertices that fell out, then the triangles around them
+        for (uint32 i = 0; i < newCacheCount; i++)
+        {
+            uint32 vertex = newCache[i];
+            pCachePosition[vertex] = (i < FORSYTH_CACHE_SIZE) ? i : INVALID_INDEX;
+            pVertexScores[vertex] = ForsythVertexScore(pCachePosition[vertex], pRemainingTriangles[vertex]);
+        }
+
+        bestTriangle = INVALID_INDEX;
+        float bestScore = -1.0f;
+        for (uint32 i = 0; i < newCacheCount; i++)
+        {
+            uint32 vertex = newCache[i];
+            const uint32 *pList = pVertexTriangles + pTriangleListStart[vertex];
+            for (uint32 j = 0; j < pRemainingTriangles[vertex]; j++)
+            {
+                uint32 triangle = pList[j];
+                const uint32 *pOtherTriangle = pIndices32 + triangle * 3;
+                float score = pVertexScores[pOtherTriangle[0]] + pVertexScores[pOtherTriangle[1]] + pVertexScores[pOtherTriangle[2]];
+                pTriangleScores[triangle] = score;
+                if (score > bestScore)
+                {
+                    bestTriangle = triangle;
+                    bestScore = score;
+                }
+            }
+        }
+
+        cacheCount = Min(newCacheCount, FORSYTH_CACHE_SIZE);
+        Y_memcpy(cache, newCache, sizeof(uint32) * cacheCount);
+    }
+
+    WriteIndices(pDestinationIndices, pOutput, indexFormat, indexCount);
+    Y_free(pOutput);
+    Y_free(pScoreMemory);
+    Y_free(pMemory);
+    return true;
+}
+
+//------------------------------------------------------------------ Overdraw ------------------------------------------------------------------------------------------------------------
+
+// Sander, Nehab, Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw".
+static const uint32 OVERDRAW_CACHE_SIZE = 16;
+
+bool MeshOptimizer::OptimizeOverdraw(void *pDestinationIndices, const void *pIndices, GPU_INDEX_FORMAT indexFormat, uint32 indexCount,
+                                     const GPU_VERTEX_ELEMENT_DESC *pElements, uint32 nElements, const void *pVertices, uint32 vertexStride, uint32 vertexCount,
+                                     float threshold)
+{
+    if (!CheckTriangleList(indexCount, "OptimizeOverdraw"))
+        return false;
+
+    const GPU_VERTEX_ELEMENT_DESC *pPositionElement = nullptr;
+    for (uint32 i = 0; i < nElements; i++)
+    {
+        if (pElements[i].Semantic == GPU_VERTEX_ELEMENT_SEMANTIC_POSITION && pElements[i].SemanticIndex == 0)
+        {
+            pPositionElement = &pElements[i];
+            break;
+        }
+    }
+    if (pPositionElement == nullptr || (pPositionElement->Type != GPU_VERTEX_ELEMENT_TYPE_FLOAT3 && pPositionElement->Type != GPU_VERTEX_ELEMENT_TYPE_FLOAT4))
+    {
+        Log_ErrorPrintf("MeshOptimizer::OptimizeOverdraw: Vertices need a FLOAT3 or FLOAT4 position");
+        return false;
+    }
+
+    uint32 triangleCount = indexCount / 3;
+    if (triangleCount == 0)
+        return true;
+
+    // indices, output, cache timestamps, cluster starts (plus the end) and the cluster order
+    uint32 *pMemory = Y_mallocT<uint32>(indexCount * 2 + vertexCount + triangleCount * 2 + 1);
+    uint32 *pIndices32 = pMemory;
+    uint32 *pOutput = pIndices32 + indexCount;
+    uint32 *pCacheTimestamps = pOutput + indexCount;
+    uint32 *pClusterStarts = pCacheTimestamps + vertexCount;
+    uint32 *pClusterOrder = pClusterStarts + triangleCount + 1;
+    if (!ReadIndices(pIndices32, pIndices, indexFormat, indexCount, vertexCount, "OptimizeOverdraw"))
+    {
+        Y_free(pMemory);
+        return false;
+    }
+
+    // Hard boundaries are triangles that miss on all three vertices, the cache is cold there whatever comes before.
+    // The starts go in the output buffer for now, which is big enough and not needed yet.
+    uint32 *pHardStarts = pOutput;
+    uint32 hardCount = 0;
+    uint32 timestamp = OVERDRAW_CACHE_SIZE + 1;
+    for (uint32 i = 0; i < vertexCount; i++)
+        pCacheTimestamps[i] = 0;
+    for (uint32 i = 0; i < triangleCount; i++)
+    {
+        if (SimulateTriangle(pCacheTimestamps, &timestamp, OVERDRAW_CACHE_SIZE, pIndices32 + i * 3) == 3 || i == 0)
+            pHardStarts[hardCount++] = i;
+    }
+    pHardStarts[hardCount] = triangleCount;
+
+    // Each hard cluster is split again wherever its running miss ratio from a cold cache drops to threshold times the
+    // ratio of the whole cluster, so drawing the pieces in any order costs at most that much.
+    uint32 clusterCount = 0;
+    for (uint32 i = 0; i < hardCount; i++)
+    {
+        uint32 start = pHardStarts[i];
+        uint32 end = pHardStarts[i + 1];
+
+        uint32 hardMisses = 0;
+        timestamp += OVERDRAW_CACHE_SIZE + 1;
+        for (uint32 j = start; j < end; j++)
+            hardMisses += SimulateTriangle(pCacheTimestamps, &timestamp, OVERDRAW_CACHE_SIZE, pIndices32 + j * 3);
+
+        float clusterThreshold = threshold * (float)hardMisses / (float)(end - start);
+        uint32 runningMisses = 0;
+        uint32 runningTriangles = 0;
+        timestamp += OVERDRAW_CACHE_SIZE + 1;
+        pClusterStarts[clusterCount++] = start;
+        for (uint32 j = start; (j + 1) < end; j++)
+        {
+            runningMisses += SimulateTriangle(pCacheTimestamps, &timestamp, OVERDRAW_CACHE_SIZE, pIndices32 + j * 3);
+            runningTriangles++;
+            if ((float)runningMisses <= clusterThreshold * (float)runningTriangles)
+            {
+                pClusterStarts[clusterCount++] = j + 1;
+                timestamp += OVERDRAW_CACHE_SIZE + 1;
+                runningMisses = 0;
+                runningTriangles = 0;
+            }
+        }
+    }
+    pClusterStarts[clusterCount] = triangleCount;
+
+    // Clusters facing away from the centre of the mesh are more likely to occlude the rest, so they're drawn first.
+    // Centroids and normals are area weighted.
+    const byte *pPositionBytes = reinterpret_cast<const byte *>(pVertices) + pPositionElement->StreamOffset;
+    float *pClusterKeys = Y_mallocT<float>(clusterCount);
+    Vector3f *pClusterCentroids = Y_mallocT<Vector3f>(clusterCount);
+    Vector3f *pClusterNormals = Y_mallocT<Vector3f>(clusterCount);
+    Vector3f meshCentroid(0.0f, 0.0f, 0.0f);
+    float meshArea = 0.0f;
+    for (uint32 i = 0; i < clusterCount; i++)
+    {
+        Vector3f centroid(0.0f, 0.0f, 0.0f);
+        Vector3f normal(0.0f, 0.0f, 0.0f);
+        float area = 0.0f;
+        for (uint32 j = pClusterStarts[i]; j < pClusterStarts[i + 1]; j++)
+        {
+            Vector3f positions[3];
+            for (uint32 k = 0; k < 3; k++)
+                Y_memcpy(&positions[k], pPositionBytes + pIndices32[j * 3 + k] * vertexStride, sizeof(float) * 3);
+
+            Vector3f triangleNormal = (positions[1] - positions[0]).Cross(positions[2] - positions[0]);
+            float triangleArea = triangleNormal.Length();
+            centroid += (positions[0] + positions[1] + positions[2]) * (triangleArea / 3.0f);
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        meshCentroid += centroid;
+        meshArea += area;
+        pClusterCentroids[i] = (area > 0.0f) ? (centroid / area) : centroid;
+        pClusterNormals[i] = normal;
+    }
+    if (meshArea > 0.0f)
+        meshCentroid /= meshArea;
+
+    for (uint32 i = 0; i < clusterCount; i++)
+    {
+        float normalLength = pClusterNormals[i].Length();
+        pClusterKeys[i] = (normalLength > 0.0f) ? ((pClusterCentroids[i] - meshCentroid).Dot(pClusterNormals[i]) / normalLength) : 0.0f;
+        pClusterOrder[i] = i;
+    }
+
+    std::sort(pClusterOrder, pClusterOrder + clusterCount, [pClusterKeys](uint32 lhs, uint32 rhs)
+    {
+        return (pClusterKeys[lhs] != pClusterKeys[rhs]) ? (pClusterKeys[lhs] > pClusterKeys[rhs]) : (lhs < rhs);
+    });
+
+    uint32 outputCount = 0;
+    for (uint32 i = 0; i < clusterCount; i++)
+    {
+        uint32 cluster = pClusterOrder[i];
+        uint32 clusterIndexCount = (pClusterStarts[cluster + 1] - pClusterStarts[cluster]) * 3;
+        Y_memcpy(pOutput + outputCount, pIndices32 + pClusterStarts[cluster] * 3, sizeof(uint32) * clusterIndexCount);
+        outputCount += clusterIndexCount;
+    }
+
+    WriteIndices(pDestinationIndices, pOutput, indexFormat, indexCount);
+    Y_free(pClusterNormals);
+    Y_free(pClusterCentroids);
+    Y_free(pClusterKeys);
+    Y_free(pMemory);
+    return true;
+}
+
+//------------------------------------------------------------------ Vertex fetch ------------------------------------------------------------------------------------------------------
+
+uint32 MeshOptimizer::OptimizeVertexFetch(void *pDestinationVertices, void *pIndices, GPU_INDEX_FORMAT indexFormat, uint32 indexCount,
+                                          const void *pVertices, uint32 vertexStride, uint32 vertexCount)
+{
+    DebugAssert(pDestinationVertices != pVertices);
+
+    uint32 *pMemory = Y_mallocT<uint32>(indexCount + vertexCount);
+    uint32 *pIndices32 = pMemory;
+    uint32 *pRemap = pMemory + indexCount;
+    if (!ReadIndices(pIndices32, pIndices, indexFormat, indexCount, vertexCount, "OptimizeVertexFetch"))
+    {
+        Y_free(pMemory);
+        return 0;
+    }
+
+    for (uint32 i = 0; i < vertexCount; i++)
+        pRemap[i] = INVALID_INDEX;
+
+    byte *pDestinationBytes = reinterpret_cast<byte *>(pDestinationVertices);
+    const byte *pSourceBytes = reinterpret_cast<const byte *>(pVertices);
+    uint32 newVertexCount = 0;
+    for (uint32 i = 0; i < indexCount; i++)
+    {
+        uint32 vertex = pIndices32[i];
+        if (pRemap[vertex] == INVALID_INDEX)
+        {
+            Y_memcpy(pDestinationBytes + newVertexCount * vertexStride, pSourceBytes + vertex * vertexStride, vertexStride);
+            pRemap[vertex] = newVertexCount++;
+        }
+
+        pIndices32[i] = pRemap[vertex];
+    }
+
+    WriteIndices(pIndices, pIndices32, indexFormat, indexCount);
+    Y_free(pMemory);
+    return newVertexCount;
+}
@@ -0,0 +1,89 @@
+#include "YBaseLib/Log.h"
+#include "YRenderLib/Null/NullGPUBuffer.h"
+#include "YRenderLib/Null/NullGPUContext.h"
+#include "YRenderLib/Null/NullGPUDevice.h"
+Log_SetChannel(Renderer);
+
+NullGPUBuffer::NullGPUBuffer(const GPU_BUFFER_DESC *pBufferDesc)
+    : GPUBuffer(pBufferDesc),
+      m_pMapMemory(nullptr),
+      m_pMappedContext(nullptr),
+      m_pMappedPointer(nullptr)
+{
+
+}
+
+NullGPUBuffer::~NullGPUBuffer()
+{
+    DebugAssert(m_pMappedContext == nullptr);
+    if (m_pMapMemory != nullptr)
+        Y_free(m_pMapMemory);
+}
+
+void NullGPUBuffer::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this) + ((m_pMapMemory != nullptr) ? m_desc.Size : 0);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = m_desc.Size;
+}
+
+byte *NullGPUBuffer::GetMapMemory()
+{
+    if (m_pMapMemory == nullptr)
+        m_pMapMemory = Y_mallocT<byte>(m_desc.Size);
+
+    return m_pMapMemory;
+}
+
+GPUBuffer *NullGPUDevice::CreateBuffer(const GPU_BUFFER_DESC *pDesc, const void *pInitialData /* = NULL */)
+{
+    // immutable buffers have to be created with their contents, as on the other backends
+    DebugAssert(pInitialData != nullptr || (pDesc->Flags & (GPU_BUFFER_FLAG_READABLE | GPU_BUFFER_FLAG_WRITABLE | GPU_BUFFER_FLAG_MAPPABLE)) != 0);
+    if (pDesc->Size == 0)
+    {
+        Log_ErrorPrintf("NullGPUDevice::CreateBuffer: Could not create zero-sized buffer");
+        return nullptr;
+    }
+
+    return new NullGPUBuffer(pDesc);
+}
+
+bool NullGPUContext::ReadBuffer(GPUBuffer *pBuffer, void *pDestination, uint32 start, uint32 count)
+{
+    DebugAssert((start + count) <= pBuffer->GetDesc()->Size);
+    DebugAssert(pBuffer->GetDesc()->Flags & GPU_BUFFER_FLAG_READABLE);
+
+    Y_memzero(pDestination, count);
+    return true;
+}
+
+bool NullGPUContext::WriteBuffer(GPUBuffer *pBuffer, const void *pSource, uint32 start, uint32 count)
+{
+    DebugAssert(pBuffer->GetDesc()->Flags & GPU_BUFFER_FLAG_WRITABLE);
+    DebugAssert((start + count) <= pBuffer->GetDesc()->Size);
+    return true;
+}
+
+bool NullGPUContext::MapBuffer(GPUBuffer *pBuffer, GPU_MAP_TYPE mapType, void **ppPointer)
+{
+    NullGPUBuffer *pNullBuffer = static_cast<NullGPUBuffer *>(pBuffer);
+    DebugAssert(pNullBuffer->GetDesc()->Flags & GPU_BUFFER_FLAG_MAPPABLE);
+    DebugAssert(pNullBuffer->GetMappedContext() == nullptr && pNullBuffer->GetMappedPointer() == nullptr);
+
+    // the same memory is handed out every time, reads see whatever was last written through a map
+    byte *pMapMemory = pNullBuffer->GetMapMemory();
+    pNullBuffer->SetMappedContextPointer(this, pMapMemory);
+    *ppPointer = pMapMemory;
+    return true;
+}
+
+void NullGPUContext::Unmapbuffer(GPUBuffer *pBuffer, void *pPointer)
+{
+    NullGPUBuffer *pNullBuffer = static_cast<NullGPUBuffer *>(pBuffer);
+    DebugAssert(pNullBuffer->GetDesc()->Flags & GPU_BUFFER_FLAG_MAPPABLE);
+    DebugAssert(pNullBuffer->GetMappedContext() == this && pNullBuffer->GetMappedPointer() == pPointer);
+
+    pNullBuffer->SetMappedContextPointer(nullptr, nullptr);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "YRenderLib/Renderer.h"
+
+class NullGPUContext;
+
+class NullGPUBuffer : public GPUBuffer
+{
+public:
+    NullGPUBuffer(const GPU_BUFFER_DESC *pBufferDesc);
+    virtual ~NullGPUBuffer();
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *debugName) override {}
+
+    // Memory handed out by MapBuffer, allocated on the first map and kept until the buffer is released.
+    byte *GetMapMemory();
+
+    NullGPUContext *GetMappedContext() const { return m_pMappedContext; }
+    void *GetMappedPointer() const { return m_pMappedPointer; }
+    void SetMappedContextPointer(NullGPUContext *pContext, void *pPointer) { m_pMappedContext = pContext; m_pMappedPointer = pPointer; }
+
+private:
+    byte *m_pMapMemory;
+    NullGPUContext *m_pMappedContext;
+    void *m_pMappedPointer;
+};
@@ -0,0 +1,631 @@
+#include "YBaseLib/Log.h"
+#include "YRenderLib/Null/NullGPUBuffer.h"
+#include "YRenderLib/Null/NullGPUContext.h"
+#include "YRenderLib/Null/NullGPUDevice.h"
+#include "YRenderLib/Null/NullGPUTexture.h"
+#include "YRenderLib/Util.h"
+Log_SetChannel(NullGPUContext);
+
+NullGPUContext::NullGPUContext(NullGPUDevice *pDevice)
+    : m_pDevice(pDevice)
+{
+    // add references
+    m_pDevice->AddRef();
+
+    // null memory
+    Y_memzero(&m_currentViewport, sizeof(m_currentViewport));
+    Y_memzero(&m_scissorRect, sizeof(m_scissorRect));
+    m_currentTopology = DRAW_TOPOLOGY_UNDEFINED;
+
+    // null current states
+    Y_memzero(m_pCurrentVertexBuffers, sizeof(m_pCurrentVertexBuffers));
+    Y_memzero(m_currentVertexBufferOffsets, sizeof(m_currentVertexBufferOffsets));
+    Y_memzero(m_currentVertexBufferStrides, sizeof(m_currentVertexBufferStrides));
+    m_currentVertexBufferBindCount = 0;
+
+    m_pCurrentIndexBuffer = nullptr;
+    m_currentIndexFormat = GPU_INDEX_FORMAT_COUNT;
+    m_currentIndexBufferOffset = 0;
+
+    m_pCurrentRasterizerState = nullptr;
+    m_pCurrentDepthStencilState = nullptr;
+    m_currentDepthStencilRef = 0;
+    m_pCurrentBlendState = nullptr;
+    m_currentBlendStateBlendFactors = FloatColor::White;
+
+    m_pCurrentOutputBuffer = nullptr;
+
+    Y_memzero(m_pCurrentRenderTargetViews, sizeof(m_pCurrentRenderTargetViews));
+    m_pCurrentDepthBufferView = nullptr;
+    m_nCurrentRenderTargets = 0;
+}
+
+NullGPUContext::~NullGPUContext()
+{
+    // release our references to states and targets
+    ClearState(true, true, true, true);
+
+    // clear output buffer last, like the other backends
+    SetOutputBuffer(nullptr);
+    m_pDevice->Release();
+}
+
+void NullGPUContext::ClearState(bool clearShaders /* = true */, bool clearBuffers /* = true */, bool clearStates /* = true */, bool clearRenderTargets /* = true */)
+{
+    // shader bindings are never held, see SetShaderProgram
+
+    if (clearBuffers)
+    {
+        if (m_currentVertexBufferBindCount > 0)
+        {
+            static GPUBuffer *nullVertexBuffers[NULL_MAX_VERTEX_BUFFERS] = { nullptr };
+            static const uint32 nullSizeOrOffset[NULL_MAX_VERTEX_BUFFERS] = { 0 };
+            SetVertexBuffers(0, m_currentVertexBufferBindCount, nullVertexBuffers, nullSizeOrOffset, nullSizeOrOffset);
+        }
+
+        if (m_pCurrentIndexBuffer != nullptr)
+            SetIndexBuffer(nullptr, GPU_INDEX_FORMAT_UINT16, 0);
+    }
+
+    if (clearStates)
+    {
+        SetRasterizerState(nullptr);
+        SetDepthStencilState(nullptr, 0);
+        SetBlendState(nullptr);
+        SetDrawTopology(DRAW_TOPOLOGY_UNDEFINED);
+
+        RENDERER_SCISSOR_RECT scissor(0, 0, 0, 0);
+        SetFullViewport(nullptr);
+        SetScissorRect(&scissor);
+    }
+
+    if (clearRenderTargets)
+    {
+        SetRenderTargets(0, nullptr, nullptr);
+    }
+}
+
+void NullGPUContext::BeginFrame()
+{
+    m_pDevice->GetDeferredReleaseQueue()->BeginFrame();
+}
+
+void NullGPUContext::Flush()
+{
+
+}
+
+void NullGPUContext::Finish()
+{
+
+}
+
+bool NullGPUContext::GetExclusiveFullScreen()
+{
+    return false;
+}
+
+bool NullGPUContext::SetExclusiveFullScreen(bool enabled, uint32 width, uint32 height, uint32 refreshRate)
+{
+    return !enabled;
+}
+
+bool NullGPUContext::ResizeOutputBuffer(uint32 width /* = 0 */, uint32 height /* = 0 */)
+{
+    if (m_pCurrentOutputBuffer == nullptr)
+        return false;
+
+    // there is no window to query, so keep the current size
+    if (width == 0 || height == 0)
+        return true;
+
+    m_pCurrentOutputBuffer->Resize(width, height);
+    return true;
+}
+
+void NullGPUContext::PresentOutputBuffer(GPU_PRESENT_BEHAVIOUR presentBehaviour)
+{
+
+}
+
+GPUCommandList *NullGPUContext::CreateCommandList()
+{
+    return nullptr;
+}
+
+bool NullGPUContext::OpenCommandList(GPUCommandList *pCommandList)
+{
+    return false;
+}
+
+bool NullGPUContext::CloseCommandList(GPUCommandList *pCommandList)
+{
+    return false;
+}
+
+void NullGPUContext::ExecuteCommandList(GPUCommandList *pCommandList)
+{
+    Panic("Not available.");
+}
+
+GPURasterizerState *NullGPUContext::GetRasterizerState()
+{
+    return m_pCurrentRasterizerState;
+}
+
+void NullGPUContext::SetRasterizerState(GPURasterizerState *pRasterizerState)
+{
+    if (m_pCurrentRasterizerState != pRasterizerState)
+    {
+        if (m_pCurrentRasterizerState)
+            m_pCurrentRasterizerState->Release();
+
+        if ((m_pCurrentRasterizerState = pRasterizerState) != nullptr)
+            m_pCurrentRasterizerState->AddRef();
+    }
+}
+
+GPUDepthStencilState *NullGPUContext::GetDepthStencilState()
+{
+    return m_pCurrentDepthStencilState;
+}
+
+uint8 NullGPUContext::GetDepthStencilStateStencilRef()
+{
+    return m_currentDepthStencilRef;
+}
+
+void NullGPUContext::SetDepthStencilState(GPUDepthStencilState *pDepthStencilState, uint8 stencilRef)
+{
+    if (m_pCurrentDepthStencilState != pDepthStencilState)
+    {
+        if (m_pCurrentDepthStencilState)
+            m_pCurrentDepthStencilState->Release();
+
+        if ((m_pCurrentDepthStencilState = pDepthStencilState) != nullptr)
+            m_pCurrentDepthStencilState->AddRef();
+    }
+
+    m_currentDepthStencilRef = stencilRef;
+}
+
+GPUBlendState *NullGPUContext::GetBlendState()
+{
+    return m_pCurrentBlendState;
+}
+
+const FloatColor &NullGPUContext::GetBlendStateBlendFactor()
+{
+    return m_currentBlendStateBlendFactors;
+}
+
+void NullGPUContext::SetBlendState(GPUBlendState *pBlendState, const FloatColor &blendFactor /* = FloatColor::White */)
+{
+    if (m_pCurrentBlendState != pBlendState)
+    {
+        if (m_pCurrentBlendState)
+            m_pCurrentBlendState->Release();
+
+        if ((m_pCurrentBlendState = pBlendState) != nullptr)
+            m_pCurrentBlendState->AddRef();
+    }
+
+    m_currentBlendStateBlendFactors = blendFactor;
+}
+
+const RENDERER_VIEWPORT *NullGPUContext::GetViewport()
+{
+    return &m_currentViewport;
+}
+
+void NullGPUContext::SetViewport(const RENDERER_VIEWPORT *pNewViewport)
+{
+    Y_memcpy(&m_currentViewport, pNewViewport, sizeof(m_currentViewport));
+}
+
+void NullGPUContext::SetFullViewport(GPUTexture *pForRenderTarget /* = NULL */)
+{
+    RENDERER_VIEWPORT viewport;
+    viewport.TopLeftX = 0;
+    viewport.TopLeftY = 0;
+
+    if (pForRenderTarget == nullptr && m_nCurrentRenderTargets == 0 && m_pCurrentDepthBufferView == nullptr)
+    {
+        if (m_pCurrentOutputBuffer != nullptr)
+        {
+            viewport.Width = m_pCurrentOutputBuffer->GetWidth();
+            viewport.Height = m_pCurrentOutputBuffer->GetHeight();
+        }
+        else
+        {
+            viewport.Width = 1;
+            viewport.Height = 1;
+        }
+    }
+    else
+    {
+        DebugAssert(m_pCurrentRenderTargetViews[0] != nullptr || pForRenderTarget != nullptr);
+
+        GPUTexture *pRT = pForRenderTarget;
+        if (pRT != nullptr || m_nCurrentRenderTargets > 0)
+        {
+            Util::GetTextureDimensions((pRT != nullptr) ? pRT : m_pCurrentRenderTargetViews[0]->GetTargetTexture(), &viewport.Width, &viewport.Height, nullptr);
+        }
+        else if (m_pCurrentOutputBuffer != nullptr)
+        {
+            viewport.Width = m_pCurrentOutputBuffer->GetWidth();
+            viewport.Height = m_pCurrentOutputBuffer->GetHeight();
+        }
+        else
+        {
+            viewport.Width = 1;
+            viewport.Height = 1;
+        }
+    }
+
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+
+    SetViewport(&viewport);
+}
+
+const RENDERER_SCISSOR_RECT *NullGPUContext::GetScissorRect()
+{
+    return &m_scissorRect;
+}
+
+void NullGPUContext::SetScissorRect(const RENDERER_SCISSOR_RECT *pScissorRect)
+{
+    Y_memcpy(&m_scissorRect, pScissorRect, sizeof(m_scissorRect));
+}
+
+bool NullGPUContext::CopyTexture(GPUTexture2D *pSourceTexture, GPUTexture2D *pDestinationTexture)
+{
+    // textures have to be compatible, same rules as the d3d11 backend
+    if (pSourceTexture->GetDesc()->Width != pDestinationTexture->GetDesc()->Width ||
+        pSourceTexture->GetDesc()->Height != pDestinationTexture->GetDesc()->Height ||
+        pSourceTexture->GetDesc()->Format != pDestinationTexture->GetDesc()->Format ||
+        pSourceTexture->GetDesc()->MipLevels != pDestinationTexture->GetDesc()->MipLevels)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool NullGPUContext::CopyTextureRegion(GPUTexture2D *pSourceTexture, uint32 sourceX, uint32 sourceY, uint32 width, uint32 height, uint32 sourceMipLevel, GPUTexture2D *pDestinationTexture, uint32 destX, uint32 destY, uint32 destMipLevel)
+{
+    if (pSourceTexture->GetDesc()->Format != pDestinationTexture->GetDesc()->Format ||
+        pSourceTexture->GetDesc()->MipLevels != pDestinationTexture->GetDesc()->MipLevels)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void NullGPUContext::BlitFrameBuffer(GPUTexture2D *pTexture, uint32 sourceX, uint32 sourceY, uint32 sourceWidth, uint32 sourceHeight, uint32 destX, uint32 destY, uint32 destWidth, uint32 destHeight, RENDERER_FRAMEBUFFER_BLIT_RESIZE_FILTER resizeFilter /*= RENDERER_FRAMEBUFFER_BLIT_RESIZE_FILTER_NEAREST*/)
+{
+
+}
+
+void NullGPUContext::GenerateMips(GPUTexture *pTexture)
+{
+
+}
+
+bool NullGPUContext::BeginQuery(GPUQuery *pQuery)
+{
+    return true;
+}
+
+bool NullGPUContext::EndQuery(GPUQuery *pQuery)
+{
+    return true;
+}
+
+void NullGPUContext::SetPredication(GPUQuery *pQuery)
+{
+
+}
+
+GPU_QUERY_GETDATA_RESULT NullGPUContext::GetQueryData(GPUQuery *pQuery, void *pData, uint32 cbData, uint32 flags)
+{
+    // every query completes immediately with nothing counted
+    Y_memzero(pData, cbData);
+    return GPU_QUERY_GETDATA_RESULT_OK;
+}
+
+void NullGPUContext::ClearTargets(bool clearColor /* = true */, bool clearDepth /* = true */, bool clearStencil /* = true */, const FloatColor &clearColorValue /* = FloatColor::Black */, float clearDepthValue /* = 1.0f */, uint8 clearStencilValue /* = 0 */)
+{
+
+}
+
+void NullGPUContext::DiscardTargets(bool discardColor /* = true */, bool discardDepth /* = true */, bool discardStencil /* = true */)
+{
+
+}
+
+void NullGPUContext::DiscardRenderTargetView(GPURenderTargetView *pRenderTargetView)
+{
+
+}
+
+void NullGPUContext::DiscardDepthStencilBufferView(GPUDepthStencilBufferView *pDepthStencilBufferView)
+{
+
+}
+
+GPUOutputBuffer *NullGPUContext::GetOutputBuffer()
+{
+    return m_pCurrentOutputBuffer;
+}
+
+void NullGPUContext::SetOutputBuffer(GPUOutputBuffer *pOutputBuffer)
+{
+    if (m_pCurrentOutputBuffer == pOutputBuffer)
+        return;
+
+    if (m_pCurrentOutputBuffer != nullptr)
+        m_pCurrentOutputBuffer->Release();
+
+    if ((m_pCurrentOutputBuffer = static_cast<NullGPUOutputBuffer *>(pOutputBuffer)) != nullptr)
+        m_pCurrentOutputBuffer->AddRef();
+}
+
+uint32 NullGPUContext::GetRenderTargets(uint32 nRenderTargets, GPURenderTargetView **ppRenderTargetViews, GPUDepthStencilBufferView **ppDepthBufferView)
+{
+    uint32 i, j;
+
+    for (i = 0; i < m_nCurrentRenderTargets && i < nRenderTargets; i++)
+        ppRenderTargetViews[i] = m_pCurrentRenderTargetViews[i];
+
+    for (j = i; j < nRenderTargets; j++)
+        ppRenderTargetViews[j] = nullptr;
+
+    if (ppDepthBufferView != nullptr)
+        *ppDepthBufferView = m_pCurrentDepthBufferView;
+
+    return i;
+}
+
+void NullGPUContext::SetRenderTargets(uint32 nRenderTargets, GPURenderTargetView **ppRenderTargets, GPUDepthStencilBufferView *pDepthBufferView)
+{
+    // to system framebuffer?
+    if ((nRenderTargets == 0 || (nRenderTargets == 1 && ppRenderTargets[0] == nullptr)) && pDepthBufferView == nullptr)
+    {
+        // kill current targets
+        for (uint32 i = 0; i < m_nCurrentRenderTargets; i++)
+        {
+            m_pCurrentRenderTargetViews[i]->Release();
+            m_pCurrentRenderTargetViews[i] = nullptr;
+        }
+        if (m_pCurrentDepthBufferView != nullptr)
+        {
+            m_pCurrentDepthBufferView->Release();
+            m_pCurrentDepthBufferView = nullptr;
+        }
+
+        m_nCurrentRenderTargets = 0;
+    }
+    else
+    {
+        DebugAssert(nRenderTargets < countof(m_pCurrentRenderTargetViews));
+
+        uint32 slot;
+        uint32 newRenderTargetCount = 0;
+
+        // set inclusive slots
+        for (slot = 0; slot < nRenderTargets; slot++)
+        {
+            if (m_pCurrentRenderTargetViews[slot] != ppRenderTargets[slot])
+            {
+                if (m_pCurrentRenderTargetViews[slot] != nullptr)
+                    m_pCurrentRenderTargetViews[slot]->Release();
+
+                if ((m_pCurrentRenderTargetViews[slot] = ppRenderTargets[slot]) != nullptr)
+                    m_pCurrentRenderTargetViews[slot]->AddRef();
+            }
+
+            if (m_pCurrentRenderTargetViews[slot] != nullptr)
+                newRenderTargetCount = slot + 1;
+        }
+
+        // clear extra slots
+        for (; slot < m_nCurrentRenderTargets; slot++)
+        {
+            if (m_pCurrentRenderTargetViews[slot] != nullptr)
+            {
+                m_pCurrentRenderTargetViews[slot]->Release();
+                m_pCurrentRenderTargetViews[slot] = nullptr;
+            }
+        }
+
+        m_nCurrentRenderTargets = newRenderTargetCount;
+
+        if (m_pCurrentDepthBufferView != pDepthBufferView)
+        {
+            if (m_pCurrentDepthBufferView != nullptr)
+                m_pCurrentDepthBufferView->Release();
+
+            if ((m_pCurrentDepthBufferView = pDepthBufferView) != nullptr)
+                m_pCurrentDepthBufferView->AddRef();
+        }
+    }
+}
+
+DRAW_TOPOLOGY NullGPUContext::GetDrawTopology()
+{
+    return m_currentTopology;
+}
+
+void NullGPUContext::SetDrawTopology(DRAW_TOPOLOGY topology)
+{
+    DebugAssert(topology < DRAW_TOPOLOGY_COUNT);
+    m_currentTopology = topology;
+}
+
+uint32 NullGPUContext::GetVertexBuffers(uint32 firstBuffer, uint32 nBuffers, GPUBuffer **ppVertexBuffers, uint32 *pVertexBufferOffsets, uint32 *pVertexBufferStrides)
+{
+    DebugAssert(firstBuffer + nBuffers < countof(m_pCurrentVertexBuffers));
+
+    uint32 saveCount;
+    for (saveCount = 0; saveCount < nBuffers; saveCount++)
+    {
+        if ((firstBuffer + saveCount) > m_currentVertexBufferBindCount)
+            break;
+
+        ppVertexBuffers[saveCount] = m_pCurrentVertexBuffers[firstBuffer + saveCount];
+        pVertexBufferOffsets[saveCount] = m_currentVertexBufferOffsets[firstBuffer + saveCount];
+        pVertexBufferStrides[saveCount] = m_currentVertexBufferStrides[firstBuffer + saveCount];
+    }
+
+    return saveCount;
+}
+
+void NullGPUContext::SetVertexBuffers(uint32 firstBuffer, uint32 nBuffers, GPUBuffer *const *ppVertexBuffers, const uint32 *pVertexBufferOffsets, const uint32 *pVertexBufferStrides)
+{
+    DebugAssert(firstBuffer + nBuffers <= countof(m_pCurrentVertexBuffers));
+
+    for (uint32 i = 0; i < nBuffers; i++)
+    {
+        uint32 bufferIndex = firstBuffer + i;
+        if (m_pCurrentVertexBuffers[bufferIndex] != nullptr)
+        {
+            m_pCurrentVertexBuffers[bufferIndex]->Release();
+            m_pCurrentVertexBuffers[bufferIndex] = nullptr;
+        }
+
+        if ((m_pCurrentVertexBuffers[bufferIndex] = ppVertexBuffers[i]) != nullptr)
+        {
+            m_pCurrentVertexBuffers[bufferIndex]->AddRef();
+            m_currentVertexBufferOffsets[bufferIndex] = pVertexBufferOffsets[i];
+            m_currentVertexBufferStrides[bufferIndex] = pVertexBufferStrides[i];
+        }
+        else
+        {
+            m_currentVertexBufferOffsets[bufferIndex] = 0;
+            m_currentVertexBufferStrides[bufferIndex] = 0;
+        }
+    }
+
+    // update new bind count
+    uint32 bindCount = 0;
+    uint32 searchCount = Max((firstBuffer + nBuffers), m_currentVertexBufferBindCount);
+    for (uint32 i = 0; i < searchCount; i++)
+    {
+        if (m_pCurrentVertexBuffers[i] != nullptr)
+            bindCount = i + 1;
+    }
+    m_currentVertexBufferBindCount = bindCount;
+}
+
+void NullGPUContext::SetVertexBuffer(uint32 bufferIndex, GPUBuffer *pVertexBuffer, uint32 offset, uint32 stride)
+{
+    DebugAssert(bufferIndex < countof(m_pCurrentVertexBuffers));
+
+    if (m_pCurrentVertexBuffers[bufferIndex] != pVertexBuffer)
+    {
+        if (m_pCurrentVertexBuffers[bufferIndex] != nullptr)
+            m_pCurrentVertexBuffers[bufferIndex]->Release();
+
+        if ((m_pCurrentVertexBuffers[bufferIndex] = pVertexBuffer) != nullptr)
+            m_pCurrentVertexBuffers[bufferIndex]->AddRef();
+    }
+
+    m_currentVertexBufferOffsets[bufferIndex] = (pVertexBuffer != nullptr) ? offset : 0;
+    m_currentVertexBufferStrides[bufferIndex] = (pVertexBuffer != nullptr) ? stride : 0;
+
+    // update new bind count
+    uint32 bindCount = 0;
+    uint32 searchCount = Max((bufferIndex + 1), m_currentVertexBufferBindCount);
+    for (uint32 i = 0; i < searchCount; i++)
+    {
+        if (m_pCurrentVertexBuffers[i] != nullptr)
+            bindCount = i + 1;
+    }
+    m_currentVertexBufferBindCount = bindCount;
+}
+
+void NullGPUContext::GetIndexBuffer(GPUBuffer **ppBuffer, GPU_INDEX_FORMAT *pFormat, uint32 *pOffset)
+{
+    *ppBuffer = m_pCurrentIndexBuffer;
+    *pFormat = m_currentIndexFormat;
+    *pOffset = m_currentIndexBufferOffset;
+}
+
+void NullGPUContext::SetIndexBuffer(GPUBuffer *pBuffer, GPU_INDEX_FORMAT format, uint32 offset)
+{
+    if (m_pCurrentIndexBuffer != pBuffer)
+    {
+        if (m_pCurrentIndexBuffer != nullptr)
+            m_pCurrentIndexBuffer->Release();
+
+        if ((m_pCurrentIndexBuffer = pBuffer) != nullptr)
+            m_pCurrentIndexBuffer->AddRef();
+    }
+
+    m_currentIndexFormat = format;
+    m_currentIndexBufferOffset = offset;
+}
+
+void NullGPUContext::SetInputLayout(GPUInputLayout *pInputLayout)
+{
+
+}
+
+void NullGPUContext::SetShaderProgram(GPUShaderProgram *pShaderProgram)
+{
+    // the device never creates programs, so there is nothing to bind or reference
+    DebugAssert(pShaderProgram == nullptr);
+}
+
+void NullGPUContext::SetShaderConstantBuffer(uint32 index, GPUBuffer *pBuffer)
+{
+
+}
+
+void NullGPUContext::SetShaderSampler(uint32 index, GPUSamplerState *pSamplerState)
+{
+
+}
+
+void NullGPUContext::SetShaderResource(uint32 index, GPUResource *pResource)
+{
+
+}
+
+void NullGPUContext::SetShaderRWResource(uint32 index, GPUResource *pResource)
+{
+
+}
+
+void NullGPUContext::Draw(uint32 firstVertex, uint32 nVertices)
+{
+
+}
+
+void NullGPUContext::DrawInstanced(uint32 firstVertex, uint32 nVertices, uint32 nInstances)
+{
+
+}
+
+void NullGPUContext::DrawIndexed(uint32 startIndex, uint32 nIndices, uint32 baseVertex)
+{
+
+}
+
+void NullGPUContext::DrawIndexedInstanced(uint32 startIndex, uint32 nIndices, uint32 baseVertex, uint32 nInstances)
+{
+
+}
+
+void NullGPUContext::DrawUserPointer(const void *pVertices, uint32 vertexSize, uint32 nVertices)
+{
+
+}
+
+void NullGPUContext::Dispatch(uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ)
+{
+
+}
@@ -0,0 +1,228 @@
+#include <SDL.h>
+#include "YBaseLib/Log.h"
+#include "YRenderLib/Null/NullGPUBuffer.h"
+#include "YRenderLib/Null/NullGPUContext.h"
+#include "YRenderLib/Null/NullGPUDevice.h"
+#include "YRenderLib/Null/NullGPUTexture.h"
+Log_SetChannel(NullGPUDevice);
+
+NullGPUDevice::NullGPUDevice(uint32 gpuFrameLatency)
+    : m_deferredReleaseQueue(gpuFrameLatency)
+{
+
+}
+
+NullGPUDevice::~NullGPUDevice()
+{
+    m_deferredReleaseQueue.ReleaseAll();
+}
+
+RENDERER_PLATFORM NullGPUDevice::GetPlatform() const
+{
+    return RENDERER_PLATFORM_NULL;
+}
+
+RENDERER_FEATURE_LEVEL NullGPUDevice::GetFeatureLevel() const
+{
+    return RENDERER_FEATURE_LEVEL_SM5;
+}
+
+TEXTURE_PLATFORM NullGPUDevice::GetTexturePlatform() const
+{
+    return TEXTURE_PLATFORM_DXTC;
+}
+
+SHADER_PROGRAM_BYTECODE_TYPE NullGPUDevice::GetShaderProgramType() const
+{
+    // nothing is ever compiled for it, see CreateGraphicsProgram
+    return SHADER_PROGRAM_BYTECODE_TYPE_D3D_SM50;
+}
+
+void NullGPUDevice::GetCounters(RendererCounters* pCounters) const
+{
+    memcpy(pCounters, &m_counters, sizeof(m_counters));
+}
+
+void NullGPUDevice::GetCapabilities(RendererCapabilities *pCapabilities) const
+{
+    pCapabilities->MaxTextureAnisotropy = 16;
+    pCapabilities->MaximumVertexBuffers = NULL_MAX_VERTEX_BUFFERS;
+    pCapabilities->MaximumConstantBuffers = 14;
+    pCapabilities->MaximumTextureUnits = 128;
+    pCapabilities->MaximumSamplers = 16;
+    pCapabilities->MaximumRenderTargets = NULL_MAX_RENDER_TARGETS;
+    pCapabilities->SupportsCommandLists = false;
+    pCapabilities->SupportsMultithreadedResourceCreation = true;
+    pCapabilities->SupportsDrawBaseVertex = true;
+    pCapabilities->SupportsDepthTextures = true;
+    pCapabilities->SupportsTextureArrays = true;
+    pCapabilities->SupportsCubeMapTextureArrays = true;
+    pCapabilities->SupportsGeometryShaders = true;
+    pCapabilities->SupportsSinglePassCubeMaps = true;
+    pCapabilities->SupportsInstancing = true;
+}
+
+bool NullGPUDevice::CheckTexturePixelFormatCompatibility(PIXEL_FORMAT PixelFormat, PIXEL_FORMAT *CompatibleFormat /*= NULL*/) const
+{
+    // every format in the table can be stored, since nothing is
+    if (PixelFormat >= PIXEL_FORMAT_COUNT)
+    {
+        if (CompatibleFormat != NULL)
+            *CompatibleFormat = PIXEL_FORMAT_R8G8B8A8_UNORM;
+
+        return false;
+    }
+
+    if (CompatibleFormat != NULL)
+        *CompatibleFormat = PixelFormat;
+
+    return true;
+}
+
+void NullGPUDevice::CorrectProjectionMatrix(float *projectionMatrix) const
+{
+
+}
+
+float NullGPUDevice::GetTexelOffset() const
+{
+    return 0.0f;
+}
+
+GPUOutputBuffer *NullGPUDevice::CreateOutputBuffer(RenderSystemWindowHandle hWnd, RENDERER_VSYNC_TYPE vsyncType)
+{
+#if defined(Y_PLATFORM_WINDOWS)
+    RECT clientRect;
+    if (!GetClientRect(hWnd, &clientRect))
+    {
+        Log_ErrorPrintf("NullGPUDevice::CreateOutputBuffer: GetClientRect failed");
+        return nullptr;
+    }
+
+    return new NullGPUOutputBuffer(clientRect.right - clientRect.left, clientRect.bottom - clientRect.top, vsyncType);
+#else
+    Log_ErrorPrintf("NullGPUDevice::CreateOutputBuffer: Native window handles are not supported on this platform");
+    return nullptr;
+#endif
+}
+
+GPUOutputBuffer *NullGPUDevice::CreateOutputBuffer(SDL_Window *pSDLWindow, RENDERER_VSYNC_TYPE vsyncType)
+{
+    int width, height;
+    SDL_GetWindowSize(pSDLWindow, &width, &height);
+    return new NullGPUOutputBuffer((uint32)width, (uint32)height, vsyncType);
+}
+
+void NullGPUDevice::BeginResourceBatchUpload()
+{
+
+}
+
+void NullGPUDevice::EndResourceBatchUpload()
+{
+
+}
+
+void NullGPUDevice::ReleaseResourceDeferred(GPUResource *pResource)
+{
+    m_deferredReleaseQueue.Release(pResource);
+}
+
+// gpu sizes are what the d3d11 backend reports, so memory budgets behave the same on both
+void NullGPUSamplerState::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = 128;
+}
+
+GPUSamplerState *NullGPUDevice::CreateSamplerState(const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc)
+{
+    return new NullGPUSamplerState(pSamplerStateDesc);
+}
+
+void NullGPURasterizerState::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = 128;
+}
+
+GPURasterizerState *NullGPUDevice::CreateRasterizerState(const RENDERER_RASTERIZER_STATE_DESC *pRasterizerStateDesc)
+{
+    return new NullGPURasterizerState(pRasterizerStateDesc);
+}
+
+void NullGPUDepthStencilState::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = 128;
+}
+
+GPUDepthStencilState *NullGPUDevice::CreateDepthStencilState(const RENDERER_DEPTHSTENCIL_STATE_DESC *pDepthStencilStateDesc)
+{
+    return new NullGPUDepthStencilState(pDepthStencilStateDesc);
+}
+
+void NullGPUBlendState::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = 128;
+}
+
+GPUBlendState *NullGPUDevice::CreateBlendState(const RENDERER_BLEND_STATE_DESC *pBlendStateDesc)
+{
+    return new NullGPUBlendState(pBlendStateDesc);
+}
+
+void NullGPUQuery::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = 128;
+}
+
+GPUQuery *NullGPUDevice::CreateQuery(GPU_QUERY_TYPE type)
+{
+    return new NullGPUQuery(type);
+}
+
+void NullGPUInputLayout::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this) + sizeof(GPU_VERTEX_ELEMENT_DESC) * m_nElements;
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = 16 * m_nElements;
+}
+
+GPUInputLayout *NullGPUDevice::CreateInputLayout(const GPU_VERTEX_ELEMENT_DESC *pElements, uint32 nElements)
+{
+    GPU_VERTEX_ELEMENT_DESC *pElementsCopy = new GPU_VERTEX_ELEMENT_DESC[nElements];
+    Y_memcpy(pElementsCopy, pElements, sizeof(GPU_VERTEX_ELEMENT_DESC) * nElements);
+    return new NullGPUInputLayout(pElementsCopy, nElements);
+}
+
+GPUShaderProgram *NullGPUDevice::CreateGraphicsProgram(ByteStream *pByteCodeStream)
+{
+    Log_ErrorPrintf("NullGPUDevice::CreateGraphicsProgram: Shader programs are not supported by the null backend");
+    return nullptr;
+}
+
+GPUShaderProgram *NullGPUDevice::CreateComputeProgram(ByteStream *pByteCodeStream)
+{
+    Log_ErrorPrintf("NullGPUDevice::CreateComputeProgram: Shader programs are not supported by the null backend");
+    return nullptr;
+}
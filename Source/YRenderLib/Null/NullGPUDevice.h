@@ -0,0 +1,148 @@
+#pragma once
+#include "YRenderLib/Renderer.h"
+#include "YRenderLib/DeferredReleaseQueue.h"
+
+// Backend without a GPU behind it. Resources are created and tracked like on any other backend, but their
+// contents are discarded: writes are validated and dropped, and reads and queries return zeros. Used for
+// measuring the cost of the frontend and for running tools and tests on machines without a graphics driver.
+
+// limits reported through GetCapabilities, also the size of the context's binding arrays
+static const uint32 NULL_MAX_VERTEX_BUFFERS = 16;
+static const uint32 NULL_MAX_RENDER_TARGETS = 8;
+
+class NullGPUSamplerState : public GPUSamplerState
+{
+public:
+    NullGPUSamplerState(const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc) : GPUSamplerState(pSamplerStateDesc) {}
+    virtual ~NullGPUSamplerState() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPURasterizerState : public GPURasterizerState
+{
+public:
+    NullGPURasterizerState(const RENDERER_RASTERIZER_STATE_DESC *pRasterizerStateDesc) : GPURasterizerState(pRasterizerStateDesc) {}
+    virtual ~NullGPURasterizerState() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUDepthStencilState : public GPUDepthStencilState
+{
+public:
+    NullGPUDepthStencilState(const RENDERER_DEPTHSTENCIL_STATE_DESC *pDepthStencilStateDesc) : GPUDepthStencilState(pDepthStencilStateDesc) {}
+    virtual ~NullGPUDepthStencilState() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUBlendState : public GPUBlendState
+{
+public:
+    NullGPUBlendState(const RENDERER_BLEND_STATE_DESC *pBlendStateDesc) : GPUBlendState(pBlendStateDesc) {}
+    virtual ~NullGPUBlendState() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUQuery : public GPUQuery
+{
+public:
+    NullGPUQuery(GPU_QUERY_TYPE type) : m_type(type) {}
+    virtual ~NullGPUQuery() {}
+
+    virtual GPU_QUERY_TYPE GetQueryType() const override { return m_type; }
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+
+private:
+    GPU_QUERY_TYPE m_type;
+};
+
+class NullGPUInputLayout : public GPUInputLayout
+{
+public:
+    NullGPUInputLayout(GPU_VERTEX_ELEMENT_DESC *pElements, uint32 nElements) : GPUInputLayout(pElements, nElements) {}
+    virtual ~NullGPUInputLayout() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUOutputBuffer : public GPUOutputBuffer
+{
+public:
+    NullGPUOutputBuffer(uint32 width, uint32 height, RENDERER_VSYNC_TYPE vsyncType) : GPUOutputBuffer(vsyncType), m_width(width), m_height(height) {}
+    virtual ~NullGPUOutputBuffer() {}
+
+    virtual uint32 GetWidth() const override { return m_width; }
+    virtual uint32 GetHeight() const override { return m_height; }
+    virtual void SetVSyncType(RENDERER_VSYNC_TYPE vsyncType) override { m_vsyncType = vsyncType; }
+
+    void Resize(uint32 width, uint32 height) { m_width = width; m_height = height; }
+
+private:
+    uint32 m_width;
+    uint32 m_height;
+};
+
+class NullGPUDevice : public GPUDevice
+{
+public:
+    NullGPUDevice(uint32 gpuFrameLatency);
+    virtual ~NullGPUDevice();
+
+    // private methods
+    RendererCounters *GetCounters() { return &m_counters; }
+    DeferredReleaseQueue *GetDeferredReleaseQueue() { return &m_deferredReleaseQueue; }
+
+    // Device queries.
+    virtual RENDERER_PLATFORM GetPlatform() const override final;
+    virtual RENDERER_FEATURE_LEVEL GetFeatureLevel() const override final;
+    virtual TEXTURE_PLATFORM GetTexturePlatform() const override final;
+    virtual SHADER_PROGRAM_BYTECODE_TYPE GetShaderProgramType() const override final;
+    virtual void GetCounters(RendererCounters *pCounters) const override final;
+    virtual void GetCapabilities(RendererCapabilities *pCapabilities) const override final;
+    virtual bool CheckTexturePixelFormatCompatibility(PIXEL_FORMAT PixelFormat, PIXEL_FORMAT *CompatibleFormat = nullptr) const override final;
+    virtual void CorrectProjectionMatrix(float *projectionMatrix) const override final;
+    virtual float GetTexelOffset() const override final;
+
+    // Creates a swap chain on an existing window.
+    virtual GPUOutputBuffer *CreateOutputBuffer(RenderSystemWindowHandle hWnd, RENDERER_VSYNC_TYPE vsyncType) override final;
+    virtual GPUOutputBuffer *CreateOutputBuffer(SDL_Window *pSDLWindow, RENDERER_VSYNC_TYPE vsyncType) override final;
+
+    // Resource creation
+    virtual GPUQuery *CreateQuery(GPU_QUERY_TYPE type) override final;
+    virtual GPUBuffer *CreateBuffer(const GPU_BUFFER_DESC *pDesc, const void *pInitialData = nullptr) override final;
+    virtual GPUTexture1D *CreateTexture1D(const GPU_TEXTURE1D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData = nullptr, const uint32 *pInitialDataPitch = nullptr) override final;
+    virtual GPUTexture1DArray *CreateTexture1DArray(const GPU_TEXTURE1DARRAY_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData = nullptr, const uint32 *pInitialDataPitch = nullptr) override final;
+    virtual GPUTexture2D *CreateTexture2D(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData = nullptr, const uint32 *pInitialDataPitch = nullptr) override final;
+    virtual GPUTexture2DArray *CreateTexture2DArray(const GPU_TEXTURE2DARRAY_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData = nullptr, const uint32 *pInitialDataPitch = nullptr) override final;
+    virtual GPUTexture3D *CreateTexture3D(const GPU_TEXTURE3D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData = nullptr, const uint32 *pInitialDataPitch = nullptr, const uint32 *pInitialDataSlicePitch = nullptr) override final;
+    virtual GPUTextureCube *CreateTextureCube(const GPU_TEXTURECUBE_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData = nullptr, const uint32 *pInitialDataPitch = nullptr) override final;
+    virtual GPUTextureCubeArray *CreateTextureCubeArray(const GPU_TEXTURECUBEARRAY_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData = nullptr, const uint32 *pInitialDataPitch = nullptr) override final;
+    virtual GPUDepthTexture *CreateDepthTexture(const GPU_DEPTH_TEXTURE_DESC *pTextureDesc) override final;
+    virtual GPUSamplerState *CreateSamplerState(const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc) override final;
+    virtual GPURenderTargetView *CreateRenderTargetView(GPUTexture *pTexture, const GPU_RENDER_TARGET_VIEW_DESC *pDesc) override final;
+    virtual GPUDepthStencilBufferView *CreateDepthStencilBufferView(GPUTexture *pTexture, const GPU_DEPTH_STENCIL_BUFFER_VIEW_DESC *pDesc) override final;
+    virtual GPUDepthStencilState *CreateDepthStencilState(const RENDERER_DEPTHSTENCIL_STATE_DESC *pDepthStencilStateDesc) override final;
+    virtual GPURasterizerState *CreateRasterizerState(const RENDERER_RASTERIZER_STATE_DESC *pRasterizerStateDesc) override final;
+    virtual GPUBlendState *CreateBlendState(const RENDERER_BLEND_STATE_DESC *pBlendStateDesc) override final;
+    virtual GPUInputLayout* CreateInputLayout(const GPU_VERTEX_ELEMENT_DESC* pElements, uint32 nElements) override final;
+    virtual GPUShaderProgram *CreateGraphicsProgram(ByteStream *pByteCodeStream) override final;
+    virtual GPUShaderProgram *CreateComputeProgram(ByteStream *pByteCodeStream) override final;
+
+    // off-thread resource creation, nothing is ever staged
+    virtual void BeginResourceBatchUpload() override final;
+    virtual void EndResourceBatchUpload() override final;
+    virtual void ReleaseResourceDeferred(GPUResource *pResource) override final;
+
+private:
+    RendererCounters m_counters;
+    DeferredReleaseQueue m_deferredReleaseQueue;
+};
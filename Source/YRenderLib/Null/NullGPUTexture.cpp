@@ -0,0 +1,370 @@
+#include "YBaseLib/Log.h"
+#include "YRenderLib/Null/NullGPUContext.h"
+#include "YRenderLib/Null/NullGPUDevice.h"
+#include "YRenderLib/Null/NullGPUTexture.h"
+Log_SetChannel(NullGPUContext);
+
+// size of a mip chain as the d3d11 backend reports it, for one array layer or face
+static uint32 CalculateMipChainSize(PIXEL_FORMAT format, uint32 width, uint32 height, uint32 depth, uint32 mipLevels)
+{
+    uint32 memoryUsage = 0;
+    for (uint32 j = 0; j < mipLevels; j++)
+        memoryUsage += PixelFormat_CalculateImageSize(format, Max(width >> j, (uint32)1), Max(height >> j, (uint32)1), Max(depth >> j, (uint32)1));
+
+    return memoryUsage;
+}
+
+// the other backends fail these in the driver, so reject them here for the same code to fail the same way
+static bool ValidateTextureDesc(const char *functionName, PIXEL_FORMAT format, uint32 width, uint32 height, uint32 depth, uint32 mipLevels)
+{
+    if (format >= PIXEL_FORMAT_COUNT)
+    {
+        Log_ErrorPrintf("NullGPUDevice::%s: Invalid pixel format %u", functionName, (uint32)format);
+        return false;
+    }
+
+    if (width == 0 || height == 0 || depth == 0 || mipLevels == 0 || mipLevels > TEXTURE_MAX_MIPMAP_COUNT)
+    {
+        Log_ErrorPrintf("NullGPUDevice::%s: Invalid dimensions %ux%ux%u with %u mip levels", functionName, width, height, depth, mipLevels);
+        return false;
+    }
+
+    return true;
+}
+
+// returns false for regions outside the mip level, like the d3d11 backend
+static bool CheckTextureRegion(uint32 width, uint32 height, uint32 depth, uint32 mipLevels, uint32 mipIndex, uint32 startX, uint32 startY, uint32 startZ, uint32 countX, uint32 countY, uint32 countZ)
+{
+    DebugAssert(countX > 0 && countY > 0 && countZ > 0);
+    if (mipIndex >= mipLevels)
+        return false;
+
+    uint32 mipWidth = Max(width >> mipIndex, (uint32)1);
+    uint32 mipHeight = Max(height >> mipIndex, (uint32)1);
+    uint32 mipDepth = Max(depth >> mipIndex, (uint32)1);
+    return ((startX + countX) <= mipWidth && (startY + countY) <= mipHeight && (startZ + countZ) <= mipDepth);
+}
+
+void NullGPUTexture1D::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = CalculateMipChainSize(m_desc.Format, m_desc.Width, 1, 1, m_desc.MipLevels);
+}
+
+GPUTexture1D *NullGPUDevice::CreateTexture1D(const GPU_TEXTURE1D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData /* = NULL */, const uint32 *pInitialDataPitch /* = NULL */)
+{
+    if (!ValidateTextureDesc("CreateTexture1D", pTextureDesc->Format, pTextureDesc->Width, 1, 1, pTextureDesc->MipLevels))
+        return nullptr;
+
+    return new NullGPUTexture1D(pTextureDesc);
+}
+
+bool NullGPUContext::ReadTexture(GPUTexture1D *pTexture, void *pDestination, uint32 cbDestination, uint32 mipIndex, uint32 start, uint32 count)
+{
+    const GPU_TEXTURE1D_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_READABLE);
+    if (!CheckTextureRegion(pDesc->Width, 1, 1, pDesc->MipLevels, mipIndex, start, 0, 0, count, 1, 1))
+        return false;
+
+    Y_memzero(pDestination, cbDestination);
+    return true;
+}
+
+bool NullGPUContext::WriteTexture(GPUTexture1D *pTexture, const void *pSource, uint32 cbSource, uint32 mipIndex, uint32 start, uint32 count)
+{
+    const GPU_TEXTURE1D_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_WRITABLE);
+    return CheckTextureRegion(pDesc->Width, 1, 1, pDesc->MipLevels, mipIndex, start, 0, 0, count, 1, 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NullGPUTexture1DArray::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = CalculateMipChainSize(m_desc.Format, m_desc.Width, 1, 1, m_desc.MipLevels) * m_desc.ArraySize;
+}
+
+GPUTexture1DArray *NullGPUDevice::CreateTexture1DArray(const GPU_TEXTURE1DARRAY_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData /* = NULL */, const uint32 *pInitialDataPitch /* = NULL */)
+{
+    if (!ValidateTextureDesc("CreateTexture1DArray", pTextureDesc->Format, pTextureDesc->Width, pTextureDesc->ArraySize, 1, pTextureDesc->MipLevels))
+        return nullptr;
+
+    return new NullGPUTexture1DArray(pTextureDesc);
+}
+
+bool NullGPUContext::ReadTexture(GPUTexture1DArray *pTexture, void *pDestination, uint32 cbDestination, uint32 arrayIndex, uint32 mipIndex, uint32 start, uint32 count)
+{
+    const GPU_TEXTURE1DARRAY_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_READABLE);
+    if (arrayIndex >= pDesc->ArraySize || !CheckTextureRegion(pDesc->Width, 1, 1, pDesc->MipLevels, mipIndex, start, 0, 0, count, 1, 1))
+        return false;
+
+    Y_memzero(pDestination, cbDestination);
+    return true;
+}
+
+bool NullGPUContext::WriteTexture(GPUTexture1DArray *pTexture, const void *pSource, uint32 cbSource, uint32 arrayIndex, uint32 mipIndex, uint32 start, uint32 count)
+{
+    const GPU_TEXTURE1DARRAY_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_WRITABLE);
+    return (arrayIndex < pDesc->ArraySize && CheckTextureRegion(pDesc->Width, 1, 1, pDesc->MipLevels, mipIndex, start, 0, 0, count, 1, 1));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NullGPUTexture2D::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = CalculateMipChainSize(m_desc.Format, m_desc.Width, m_desc.Height, 1, m_desc.MipLevels);
+}
+
+GPUTexture2D *NullGPUDevice::CreateTexture2D(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData /* = NULL */, const uint32 *pInitialDataPitch /* = NULL */)
+{
+    if (!ValidateTextureDesc("CreateTexture2D", pTextureDesc->Format, pTextureDesc->Width, pTextureDesc->Height, 1, pTextureDesc->MipLevels))
+        return nullptr;
+
+    return new NullGPUTexture2D(pTextureDesc);
+}
+
+bool NullGPUContext::ReadTexture(GPUTexture2D *pTexture, void *pDestination, uint32 destinationRowPitch, uint32 cbDestination, uint32 mipIndex, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_TEXTURE2D_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_READABLE);
+    if (!CheckTextureRegion(pDesc->Width, pDesc->Height, 1, pDesc->MipLevels, mipIndex, startX, startY, 0, countX, countY, 1))
+        return false;
+
+    Y_memzero(pDestination, cbDestination);
+    return true;
+}
+
+bool NullGPUContext::WriteTexture(GPUTexture2D *pTexture, const void *pSource, uint32 sourceRowPitch, uint32 cbSource, uint32 mipIndex, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_TEXTURE2D_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_WRITABLE);
+    return CheckTextureRegion(pDesc->Width, pDesc->Height, 1, pDesc->MipLevels, mipIndex, startX, startY, 0, countX, countY, 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NullGPUTexture2DArray::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = CalculateMipChainSize(m_desc.Format, m_desc.Width, m_desc.Height, 1, m_desc.MipLevels) * m_desc.ArraySize;
+}
+
+GPUTexture2DArray *NullGPUDevice::CreateTexture2DArray(const GPU_TEXTURE2DARRAY_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData /* = NULL */, const uint32 *pInitialDataPitch /* = NULL */)
+{
+    if (!ValidateTextureDesc("CreateTexture2DArray", pTextureDesc->Format, pTextureDesc->Width, pTextureDesc->Height, pTextureDesc->ArraySize, pTextureDesc->MipLevels))
+        return nullptr;
+
+    return new NullGPUTexture2DArray(pTextureDesc);
+}
+
+bool NullGPUContext::ReadTexture(GPUTexture2DArray *pTexture, void *pDestination, uint32 destinationRowPitch, uint32 cbDestination, uint32 arrayIndex, uint32 mipIndex, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_TEXTURE2DARRAY_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_READABLE);
+    if (arrayIndex >= pDesc->ArraySize || !CheckTextureRegion(pDesc->Width, pDesc->Height, 1, pDesc->MipLevels, mipIndex, startX, startY, 0, countX, countY, 1))
+        return false;
+
+    Y_memzero(pDestination, cbDestination);
+    return true;
+}
+
+bool NullGPUContext::WriteTexture(GPUTexture2DArray *pTexture, const void *pSource, uint32 sourceRowPitch, uint32 cbSource, uint32 arrayIndex, uint32 mipIndex, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_TEXTURE2DARRAY_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_WRITABLE);
+    return (arrayIndex < pDesc->ArraySize && CheckTextureRegion(pDesc->Width, pDesc->Height, 1, pDesc->MipLevels, mipIndex, startX, startY, 0, countX, countY, 1));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NullGPUTexture3D::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = CalculateMipChainSize(m_desc.Format, m_desc.Width, m_desc.Height, m_desc.Depth, m_desc.MipLevels);
+}
+
+GPUTexture3D *NullGPUDevice::CreateTexture3D(const GPU_TEXTURE3D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData /* = NULL */, const uint32 *pInitialDataPitch /* = NULL */, const uint32 *pInitialDataSlicePitch /* = NULL */)
+{
+    if (!ValidateTextureDesc("CreateTexture3D", pTextureDesc->Format, pTextureDesc->Width, pTextureDesc->Height, pTextureDesc->Depth, pTextureDesc->MipLevels))
+        return nullptr;
+
+    return new NullGPUTexture3D(pTextureDesc);
+}
+
+bool NullGPUContext::ReadTexture(GPUTexture3D *pTexture, void *pDestination, uint32 destinationRowPitch, uint32 destinationSlicePitch, uint32 cbDestination, uint32 mipIndex, uint32 startX, uint32 startY, uint32 startZ, uint32 countX, uint32 countY, uint32 countZ)
+{
+    const GPU_TEXTURE3D_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_READABLE);
+    if (!CheckTextureRegion(pDesc->Width, pDesc->Height, pDesc->Depth, pDesc->MipLevels, mipIndex, startX, startY, startZ, countX, countY, countZ))
+        return false;
+
+    Y_memzero(pDestination, cbDestination);
+    return true;
+}
+
+bool NullGPUContext::WriteTexture(GPUTexture3D *pTexture, const void *pSource, uint32 sourceRowPitch, uint32 sourceSlicePitch, uint32 cbSource, uint32 mipIndex, uint32 startX, uint32 startY, uint32 startZ, uint32 countX, uint32 countY, uint32 countZ)
+{
+    const GPU_TEXTURE3D_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_WRITABLE);
+    return CheckTextureRegion(pDesc->Width, pDesc->Height, pDesc->Depth, pDesc->MipLevels, mipIndex, startX, startY, startZ, countX, countY, countZ);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NullGPUTextureCube::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = CalculateMipChainSize(m_desc.Format, m_desc.Width, m_desc.Height, 1, m_desc.MipLevels) * CUBEMAP_FACE_COUNT;
+}
+
+GPUTextureCube *NullGPUDevice::CreateTextureCube(const GPU_TEXTURECUBE_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData /* = NULL */, const uint32 *pInitialDataPitch /* = NULL */)
+{
+    if (!ValidateTextureDesc("CreateTextureCube", pTextureDesc->Format, pTextureDesc->Width, pTextureDesc->Height, 1, pTextureDesc->MipLevels))
+        return nullptr;
+
+    return new NullGPUTextureCube(pTextureDesc);
+}
+
+bool NullGPUContext::ReadTexture(GPUTextureCube *pTexture, void *pDestination, uint32 destinationRowPitch, uint32 cbDestination, CUBEMAP_FACE face, uint32 mipIndex, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_TEXTURECUBE_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_READABLE);
+    if (face >= CUBEMAP_FACE_COUNT || !CheckTextureRegion(pDesc->Width, pDesc->Height, 1, pDesc->MipLevels, mipIndex, startX, startY, 0, countX, countY, 1))
+        return false;
+
+    Y_memzero(pDestination, cbDestination);
+    return true;
+}
+
+bool NullGPUContext::WriteTexture(GPUTextureCube *pTexture, const void *pSource, uint32 sourceRowPitch, uint32 cbSource, CUBEMAP_FACE face, uint32 mipIndex, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_TEXTURECUBE_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_WRITABLE);
+    return (face < CUBEMAP_FACE_COUNT && CheckTextureRegion(pDesc->Width, pDesc->Height, 1, pDesc->MipLevels, mipIndex, startX, startY, 0, countX, countY, 1));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NullGPUTextureCubeArray::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = CalculateMipChainSize(m_desc.Format, m_desc.Width, m_desc.Height, 1, m_desc.MipLevels) * (m_desc.ArraySize * CUBEMAP_FACE_COUNT);
+}
+
+GPUTextureCubeArray *NullGPUDevice::CreateTextureCubeArray(const GPU_TEXTURECUBEARRAY_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, const void **ppInitialData /* = NULL */, const uint32 *pInitialDataPitch /* = NULL */)
+{
+    if (!ValidateTextureDesc("CreateTextureCubeArray", pTextureDesc->Format, pTextureDesc->Width, pTextureDesc->Height, pTextureDesc->ArraySize, pTextureDesc->MipLevels))
+        return nullptr;
+
+    return new NullGPUTextureCubeArray(pTextureDesc);
+}
+
+bool NullGPUContext::ReadTexture(GPUTextureCubeArray *pTexture, void *pDestination, uint32 destinationRowPitch, uint32 cbDestination, uint32 arrayIndex, CUBEMAP_FACE face, uint32 mipIndex, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_TEXTURECUBEARRAY_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_READABLE);
+    if (arrayIndex >= pDesc->ArraySize || face >= CUBEMAP_FACE_COUNT || !CheckTextureRegion(pDesc->Width, pDesc->Height, 1, pDesc->MipLevels, mipIndex, startX, startY, 0, countX, countY, 1))
+        return false;
+
+    Y_memzero(pDestination, cbDestination);
+    return true;
+}
+
+bool NullGPUContext::WriteTexture(GPUTextureCubeArray *pTexture, const void *pSource, uint32 sourceRowPitch, uint32 cbSource, uint32 arrayIndex, CUBEMAP_FACE face, uint32 mipIndex, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_TEXTURECUBEARRAY_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_WRITABLE);
+    return (arrayIndex < pDesc->ArraySize && face < CUBEMAP_FACE_COUNT && CheckTextureRegion(pDesc->Width, pDesc->Height, 1, pDesc->MipLevels, mipIndex, startX, startY, 0, countX, countY, 1));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NullGPUDepthTexture::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = PixelFormat_CalculateImageSize(m_desc.Format, m_desc.Width, m_desc.Height, 1);
+}
+
+GPUDepthTexture *NullGPUDevice::CreateDepthTexture(const GPU_DEPTH_TEXTURE_DESC *pTextureDesc)
+{
+    if (!ValidateTextureDesc("CreateDepthTexture", pTextureDesc->Format, pTextureDesc->Width, pTextureDesc->Height, 1, 1))
+        return nullptr;
+
+    return new NullGPUDepthTexture(pTextureDesc);
+}
+
+bool NullGPUContext::ReadTexture(GPUDepthTexture *pTexture, void *pDestination, uint32 destinationRowPitch, uint32 cbDestination, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_DEPTH_TEXTURE_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_READABLE);
+    if (!CheckTextureRegion(pDesc->Width, pDesc->Height, 1, 1, 0, startX, startY, 0, countX, countY, 1))
+        return false;
+
+    Y_memzero(pDestination, cbDestination);
+    return true;
+}
+
+bool NullGPUContext::WriteTexture(GPUDepthTexture *pTexture, const void *pSource, uint32 sourceRowPitch, uint32 cbSource, uint32 startX, uint32 startY, uint32 countX, uint32 countY)
+{
+    const GPU_DEPTH_TEXTURE_DESC *pDesc = pTexture->GetDesc();
+    DebugAssert(pDesc->Flags & GPU_TEXTURE_FLAG_WRITABLE);
+    return CheckTextureRegion(pDesc->Width, pDesc->Height, 1, 1, 0, startX, startY, 0, countX, countY, 1);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NullGPURenderTargetView::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = 0;
+}
+
+GPURenderTargetView *NullGPUDevice::CreateRenderTargetView(GPUTexture *pTexture, const GPU_RENDER_TARGET_VIEW_DESC *pDesc)
+{
+    DebugAssert(pTexture != nullptr);
+    return new NullGPURenderTargetView(pTexture, pDesc);
+}
+
+void NullGPUDepthStencilBufferView::GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const
+{
+    if (cpuMemoryUsage != nullptr)
+        *cpuMemoryUsage = sizeof(*this);
+    if (gpuMemoryUsage != nullptr)
+        *gpuMemoryUsage = 0;
+}
+
+GPUDepthStencilBufferView *NullGPUDevice::CreateDepthStencilBufferView(GPUTexture *pTexture, const GPU_DEPTH_STENCIL_BUFFER_VIEW_DESC *pDesc)
+{
+    DebugAssert(pTexture != nullptr);
+    return new NullGPUDepthStencilBufferView(pTexture, pDesc);
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "YRenderLib/Renderer.h"
+
+class NullGPUTexture1D : public GPUTexture1D
+{
+public:
+    NullGPUTexture1D(const GPU_TEXTURE1D_DESC *pDesc) : GPUTexture1D(pDesc) {}
+    virtual ~NullGPUTexture1D() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUTexture1DArray : public GPUTexture1DArray
+{
+public:
+    NullGPUTexture1DArray(const GPU_TEXTURE1DARRAY_DESC *pDesc) : GPUTexture1DArray(pDesc) {}
+    virtual ~NullGPUTexture1DArray() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUTexture2D : public GPUTexture2D
+{
+public:
+    NullGPUTexture2D(const GPU_TEXTURE2D_DESC *pDesc) : GPUTexture2D(pDesc) {}
+    virtual ~NullGPUTexture2D() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUTexture2DArray : public GPUTexture2DArray
+{
+public:
+    NullGPUTexture2DArray(const GPU_TEXTURE2DARRAY_DESC *pDesc) : GPUTexture2DArray(pDesc) {}
+    virtual ~NullGPUTexture2DArray() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUTexture3D : public GPUTexture3D
+{
+public:
+    NullGPUTexture3D(const GPU_TEXTURE3D_DESC *pDesc) : GPUTexture3D(pDesc) {}
+    virtual ~NullGPUTexture3D() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUTextureCube : public GPUTextureCube
+{
+public:
+    NullGPUTextureCube(const GPU_TEXTURECUBE_DESC *pDesc) : GPUTextureCube(pDesc) {}
+    virtual ~NullGPUTextureCube() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUTextureCubeArray : public GPUTextureCubeArray
+{
+public:
+    NullGPUTextureCubeArray(const GPU_TEXTURECUBEARRAY_DESC *pDesc) : GPUTextureCubeArray(pDesc) {}
+    virtual ~NullGPUTextureCubeArray() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUDepthTexture : public GPUDepthTexture
+{
+public:
+    NullGPUDepthTexture(const GPU_DEPTH_TEXTURE_DESC *pDesc) : GPUDepthTexture(pDesc) {}
+    virtual ~NullGPUDepthTexture() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPURenderTargetView : public GPURenderTargetView
+{
+public:
+    NullGPURenderTargetView(GPUTexture *pTexture, const GPU_RENDER_TARGET_VIEW_DESC *pDesc) : GPURenderTargetView(pTexture, pDesc) {}
+    virtual ~NullGPURenderTargetView() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
+
+class NullGPUDepthStencilBufferView : public GPUDepthStencilBufferView
+{
+public:
+    NullGPUDepthStencilBufferView(GPUTexture *pTexture, const GPU_DEPTH_STENCIL_BUFFER_VIEW_DESC *pDesc) : GPUDepthStencilBufferView(pTexture, pDesc) {}
+    virtual ~NullGPUDepthStencilBufferView() {}
+
+    virtual void GetMemoryUsage(uint32 *cpuMemoryUsage, uint32 *gpuMemoryUsage) const override;
+    virtual void SetDebugName(const char *name) override {}
+};
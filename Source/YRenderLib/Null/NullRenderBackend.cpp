@@ -0,0 +1,39 @@
+#include "YBaseLib/Log.h"
+#include "YRenderLib/Null/NullGPUContext.h"
+#include "YRenderLib/Null/NullGPUDevice.h"
+Log_SetChannel(NullGPUContext);
+
+bool NullRenderBackend_Create(const RendererInitializationParameters *pCreateParameters, SDL_Window *pSDLWindow, GPUDevice **ppDevice, GPUContext **ppContext, GPUOutputBuffer **ppOutputBuffer)
+{
+    // same clamp as the d3d11 backend, so deferred releases are held for the same number of frames
+    uint32 gpuFrameLatency = Max(pCreateParameters->GPUFrameLatency, (uint32)1);
+
+    // create device and context wrapper classes
+    NullGPUDevice *pGPUDevice = new NullGPUDevice(gpuFrameLatency);
+    NullGPUContext *pGPUContext = new NullGPUContext(pGPUDevice);
+
+    // create implicit swap chain
+    GPUOutputBuffer *pOutputBuffer = nullptr;
+    if (pSDLWindow != nullptr)
+    {
+        // pass through to normal method
+        pOutputBuffer = pGPUDevice->CreateOutputBuffer(pSDLWindow, pCreateParameters->ImplicitSwapChainVSyncType);
+        if (pOutputBuffer == nullptr)
+        {
+            pGPUContext->Release();
+            pGPUDevice->Release();
+            return false;
+        }
+
+        // bind to context
+        pGPUContext->SetOutputBuffer(pOutputBuffer);
+    }
+
+    // set pointers
+    *ppDevice = pGPUDevice;
+    *ppContext = pGPUContext;
+    *ppOutputBuffer = pOutputBuffer;
+
+    Log_InfoPrint("Null render backend creation successful, resource contents will be discarded.");
+    return true;
+}
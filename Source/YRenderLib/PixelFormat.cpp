@@ -1,81 +1,15 @@
 #include "YBaseLib/Assert.h"
 #include "YBaseLib/Memory.h"
 #include "YRenderLib/PixelFormat.h"
+#include "YRenderLib/ImageTransform.h"
+#include <cfloat>
+#include <cmath>
 
-static const PIXEL_FORMAT_INFO g_PixelFormatInfo[PIXEL_FORMAT_COUNT] =
-{
-    // Name                                     BitsPerPixel    IsImageFormat   HasAlpha    IsBlockCompressed   BytesPerBlock   BlockSize   UncompressedFormat                  LinearFormat                        ColorMaskRed    ColorMaskGreen  ColorMaskBlue   ColorMaskAlpha  ColorBits   DepthBits   StencilBits
-    { "PIXEL_FORMAT_R8_UINT",                   8,              true,           false,      false,              0,              0,          PIXEL_FORMAT_R8_UINT,               PIXEL_FORMAT_R8_UINT,               0x000000FF,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_R8_SINT",                   8,              true,           false,      false,              0,              0,          PIXEL_FORMAT_R8_SINT,               PIXEL_FORMAT_R8_SINT,               0x000000FF,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_R8_UNORM",                  8,              true,           false,      false,              0,              0,          PIXEL_FORMAT_R8_UNORM,              PIXEL_FORMAT_R8_UNORM,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_R8_SNORM",                  8,              true,           false,      false,              0,              0,          PIXEL_FORMAT_R8_SNORM,              PIXEL_FORMAT_R8_SNORM,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_R8G8_UINT",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8_UINT,             PIXEL_FORMAT_R8G8_UINT,             0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_R8G8_SINT",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8_SINT,             PIXEL_FORMAT_R8G8_SINT,             0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_R8G8_UNORM",                16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8_UNORM,            PIXEL_FORMAT_R8G8_UNORM,            0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_R8G8_SNORM",                16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8_SNORM,            PIXEL_FORMAT_R8G8_SNORM,            0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_R8G8B8A8_UINT",             32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_UINT,         PIXEL_FORMAT_R8G8B8A8_UINT,         0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R8G8B8A8_SINT",             32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_SINT,         PIXEL_FORMAT_R8G8B8A8_SINT,         0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R8G8B8A8_UNORM",            32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_R8G8B8A8_UNORM,        0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB",       32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_R8G8B8A8_UNORM,        0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R8G8B8A8_SNORM",            32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R8G8B8A8_SNORM,        PIXEL_FORMAT_R8G8B8A8_SNORM,        0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R9G9B9E5_SHAREDEXP",        32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R9G9B9E5_SHAREDEXP,    PIXEL_FORMAT_R9G9B9E5_SHAREDEXP,    0x000001FF,     0x0003FE00,     0x07FC0000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R10G10B10A2_UINT",          32,             false,          true,       false,              0,              0,          PIXEL_FORMAT_R10G10B10A2_UINT,      PIXEL_FORMAT_R10G10B10A2_UINT,      0x000003FF,     0x000FFC00,     0x3FF00000,     0xC0000000,     30,         0,          0           },
-    { "PIXEL_FORMAT_R10G10B10A2_UNORM",         32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R10G10B10A2_UNORM,     PIXEL_FORMAT_R10G10B10A2_UNORM,     0x000003FF,     0x000FFC00,     0x3FF00000,     0xC0000000,     30,         0,          0           },
-    { "PIXEL_FORMAT_R11G11B10_FLOAT",           32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R11G11B10_FLOAT,       PIXEL_FORMAT_R11G11B10_FLOAT,       0x000007FF,     0x003FF800,     0xFFC00000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R16_UINT",                  16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_UINT,              PIXEL_FORMAT_R16_UINT,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_R16_SINT",                  16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_SINT,              PIXEL_FORMAT_R16_SINT,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_R16_UNORM",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_UNORM,             PIXEL_FORMAT_R16_UNORM,             0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_R16_SNORM",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_SNORM,             PIXEL_FORMAT_R16_SNORM,             0x000000FF,     0x00000000,     0x00000000,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_R16_FLOAT",                 16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16_FLOAT,             PIXEL_FORMAT_R16_FLOAT,             0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_R16G16_UINT",               32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_UINT,           PIXEL_FORMAT_R16G16_UINT,           0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R16G16_SINT",               32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_SINT,           PIXEL_FORMAT_R16G16_SINT,           0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R16G16_UNORM",              32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_UNORM,          PIXEL_FORMAT_R16G16_UNORM,          0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R16G16_SNORM",              32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_SNORM,          PIXEL_FORMAT_R16G16_SNORM,          0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R16G16_FLOAT",              32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R16G16_FLOAT,          PIXEL_FORMAT_R16G16_FLOAT,          0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R16G16B16A16_UINT",         64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_UINT,     PIXEL_FORMAT_R16G16B16A16_UINT,     0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
-    { "PIXEL_FORMAT_R16G16B16A16_SINT",         64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_SINT,     PIXEL_FORMAT_R16G16B16A16_SINT,     0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
-    { "PIXEL_FORMAT_R16G16B16A16_UNORM",        64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_UNORM,    PIXEL_FORMAT_R16G16B16A16_UNORM,    0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
-    { "PIXEL_FORMAT_R16G16B16A16_SNORM",        64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_SNORM,    PIXEL_FORMAT_R16G16B16A16_SNORM,    0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
-    { "PIXEL_FORMAT_R16G16B16A16_FLOAT",        64,             true,           true,       false,              0,              0,          PIXEL_FORMAT_R16G16B16A16_FLOAT,    PIXEL_FORMAT_R16G16B16A16_FLOAT,    0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     64,         0,          0           },
-    { "PIXEL_FORMAT_R32_UINT",                  32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32_UINT,              PIXEL_FORMAT_R32_UINT,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R32_SINT",                  32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32_SINT,              PIXEL_FORMAT_R32_SINT,              0x000000FF,     0x00000000,     0x00000000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R32_FLOAT",                 32,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32_FLOAT,             PIXEL_FORMAT_R32_FLOAT,             0x000000FF,     0x00000000,     0x00000000,     0x00000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_R32G32_UINT",               64,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32_UINT,           PIXEL_FORMAT_R32G32_UINT,           0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     64,         0,          0           },
-    { "PIXEL_FORMAT_R32G32_SINT",               64,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32_SINT,           PIXEL_FORMAT_R32G32_SINT,           0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     64,         0,          0           },
-    { "PIXEL_FORMAT_R32G32_FLOAT",              64,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32_FLOAT,          PIXEL_FORMAT_R32G32_FLOAT,          0x000000FF,     0x0000FF00,     0x00000000,     0x00000000,     64,         0,          0           },
-    { "PIXEL_FORMAT_R32G32B32_UINT",            96,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32B32_UINT,        PIXEL_FORMAT_R32G32B32_UINT,        0x000000FF,     0x0000FF00,     0x00FF0000,     0x00000000,     96,         0,          0           },
-    { "PIXEL_FORMAT_R32G32B32_SINT",            96,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32B32_SINT,        PIXEL_FORMAT_R32G32B32_SINT,        0x000000FF,     0x0000FF00,     0x00FF0000,     0x00000000,     96,         0,          0           },
-    { "PIXEL_FORMAT_R32G32B32_FLOAT",           96,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R32G32B32_FLOAT,       PIXEL_FORMAT_R32G32B32_FLOAT,       0x000000FF,     0x0000FF00,     0x00FF0000,     0x00000000,     96,         0,          0           },
-    { "PIXEL_FORMAT_R32G32B32A32_UINT",         128,            true,           true,       false,              0,              0,          PIXEL_FORMAT_R32G32B32A32_UINT,     PIXEL_FORMAT_R32G32B32A32_UINT,     0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     128,        0,          0           },
-    { "PIXEL_FORMAT_R32G32B32A32_SINT",         128,            true,           true,       false,              0,              0,          PIXEL_FORMAT_R32G32B32A32_SINT,     PIXEL_FORMAT_R32G32B32A32_SINT,     0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     128,        0,          0           },
-    { "PIXEL_FORMAT_R32G32B32A32_FLOAT",        128,            true,           true,       false,              0,              0,          PIXEL_FORMAT_R32G32B32A32_FLOAT,    PIXEL_FORMAT_R32G32B32A32_FLOAT,    0x000000FF,     0x0000FF00,     0x00FF0000,     0xFF000000,     128,        0,          0           },
-    { "PIXEL_FORMAT_B8G8R8A8_UNORM",            32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B8G8R8A8_UNORM,        PIXEL_FORMAT_B8G8R8A8_UNORM,        0x00FF0000,     0x0000FF00,     0x000000FF,     0xFF000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_B8G8R8A8_UNORM_SRGB",       32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B8G8R8A8_UNORM_SRGB,   PIXEL_FORMAT_B8G8R8A8_UNORM_SRGB,   0x00FF0000,     0x0000FF00,     0x000000FF,     0xFF000000,     32,         0,          0           },
-    { "PIXEL_FORMAT_B8G8R8X8_UNORM",            32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B8G8R8X8_UNORM,        PIXEL_FORMAT_B8G8R8X8_UNORM,        0x00FF0000,     0x0000FF00,     0x000000FF,     0x00000000,     24,         0,          0           },
-    { "PIXEL_FORMAT_B8G8R8X8_UNORM_SRGB",       32,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B8G8R8X8_UNORM_SRGB,   PIXEL_FORMAT_B8G8R8X8_UNORM_SRGB,   0x00FF0000,     0x0000FF00,     0x000000FF,     0x00000000,     24,         0,          0           },
-    { "PIXEL_FORMAT_B5G6R5_UNORM",              16,             true,           false,      false,              0,              0,          PIXEL_FORMAT_B5G6R5_UNORM,          PIXEL_FORMAT_B5G6R5_UNORM,          0x0000F800,     0x000007E0,     0x0000001F,     0x00000000,     16,         0,          0           },
-    { "PIXEL_FORMAT_B5G5R5A1_UNORM",            16,             true,           true,       false,              0,              0,          PIXEL_FORMAT_B5G5R5A1_UNORM,        PIXEL_FORMAT_B5G5R5A1_UNORM,        0x0000F800,     0x000007C0,     0x0000003E,     0x00000001,     15,         0,          0           },
-    { "PIXEL_FORMAT_BC1_UNORM",                 4,              true,           true,       true,               8,              4,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_BC1_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     4,          0,          0           },
-    { "PIXEL_FORMAT_BC1_UNORM_SRGB",            4,              true,           true,       true,               8,              4,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_BC1_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     4,          0,          0           },
-    { "PIXEL_FORMAT_BC2_UNORM",                 4,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_BC2_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     4,          0,          0           },
-    { "PIXEL_FORMAT_BC2_UNORM_SRGB",            4,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_BC2_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     4,          0,          0           },
-    { "PIXEL_FORMAT_BC3_UNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_BC3_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_BC3_UNORM_SRGB",            8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_BC3_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_BC4_UNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R16_UNORM,             PIXEL_FORMAT_BC4_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_BC4_SNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R16_SNORM,             PIXEL_FORMAT_BC4_SNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_BC5_UNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R16G16_UNORM,          PIXEL_FORMAT_BC5_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_BC5_SNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R16G16_SNORM,          PIXEL_FORMAT_BC5_SNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_BC6H_UF16",                 8,              false,          true,       true,               16,             4,          PIXEL_FORMAT_R16G16_UNORM,          PIXEL_FORMAT_BC6H_UF16,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_BC6H_SF16",                 8,              false,          true,       true,               16,             4,          PIXEL_FORMAT_R16G16_SNORM,          PIXEL_FORMAT_BC6H_SF16,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_BC7_UNORM",                 8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM,        PIXEL_FORMAT_BC7_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_BC7_UNORM_SRGB",            8,              true,           true,       true,               16,             4,          PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,   PIXEL_FORMAT_BC7_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     8,          0,          0           },
-    { "PIXEL_FORMAT_D16_UNORM",                 16,             false,          false,      false,              0,              0,          PIXEL_FORMAT_D16_UNORM,             PIXEL_FORMAT_D16_UNORM,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     0,          16,         0           },
-    { "PIXEL_FORMAT_D24_UNORM_S8_UINT",         32,             false,          false,      false,              0,              0,          PIXEL_FORMAT_D24_UNORM_S8_UINT,     PIXEL_FORMAT_D24_UNORM_S8_UINT,     0x00000000,     0x00000000,     0x00000000,     0x00000000,     0,          24,         8           },
-    { "PIXEL_FORMAT_D32_FLOAT",                 32,             false,          false,      false,              0,              0,          PIXEL_FORMAT_D32_FLOAT,             PIXEL_FORMAT_D32_FLOAT,             0x00000000,     0x00000000,     0x00000000,     0x00000000,     0,          32,         0           },
-    { "PIXEL_FORMAT_D32_FLOAT_S8X24_UINT",      64,             false,          false,      false,              0,              0,          PIXEL_FORMAT_D32_FLOAT_S8X24_UINT,  PIXEL_FORMAT_D32_FLOAT_S8X24_UINT,  0x00000000,     0x00000000,     0x00000000,     0x00000000,     0,          32,         8           },
-    { "PIXEL_FORMAT_R8G8B8_UNORM",              24,             true,           false,      false,              0,              0,          PIXEL_FORMAT_R8G8B8_UNORM,          PIXEL_FORMAT_R8G8B8_UNORM,          0x000000FF,     0x0000FF00,     0x00FF0000,     0x00000000,     24,         0,          0           },
-    { "PIXEL_FORMAT_B8G8R8_UNORM",              24,             true,           false,      false,              0,              0,          PIXEL_FORMAT_B8G8R8_UNORM,          PIXEL_FORMAT_B8G8R8_UNORM,          0x00FF0000,     0x0000FF00,     0x000000FF,     0x00000000,     24,         0,          0           },
-};
+#if Y_CPU_SSE_LEVEL > 0
+    #include <intrin.h>
+#endif
+
+constexpr PIXEL_FORMAT_INFO PixelFormatInfoTable::Entries[PIXEL_FORMAT_COUNT];
 
 Y_Define_NameTable(NameTables::PixelFormat)
     Y_NameTable_VEntry(PIXEL_FORMAT_R8_SINT,                       "R8_SINT")
@@ -156,49 +90,15 @@ const char *PixelFormat_GetPixelFormatName(PIXEL_FORMAT Format)
         return "PIXEL_FORMAT_UNKNOWN";
 
     DebugAssert(Format < PIXEL_FORMAT_COUNT);
-    return g_PixelFormatInfo[Format].Name;
+    return PixelFormatInfoTable::Entries[Format].Name;
 }
 
-const PIXEL_FORMAT_INFO *PixelFormat_GetPixelFormatInfo(PIXEL_FORMAT Format)
+const PIXEL_FORMAT_INFO *PixelFormat_GetInvalidPixelFormatInfo(PIXEL_FORMAT Format)
 {
+    // an empty entry in release builds, so callers see a format with no pixels rather than reading past the table
+    static const PIXEL_FORMAT_INFO invalidFormatInfo = { "PIXEL_FORMAT_UNKNOWN", 0, false, false, false, 0, 0, PIXEL_FORMAT_UNKNOWN, PIXEL_FORMAT_UNKNOWN, 0, 0, 0, 0, 0, 0, 0 };
     DebugAssert(Format < PIXEL_FORMAT_COUNT);
-    return &g_PixelFormatInfo[Format];
-}
-
-uint32 PixelFormat_CalculateRowPitch(PIXEL_FORMAT Format, uint32 uWidth)
-{
-    const PIXEL_FORMAT_INFO *pInfo = PixelFormat_GetPixelFormatInfo(Format);
-    if (pInfo->IsBlockCompressed)
-    {
-        uint32 NumBlocksWide = Max((uint32)1, uWidth / pInfo->BlockSize);
-        return NumBlocksWide * pInfo->BytesPerBlock;
-    }
-    else
-    {
-        // ensure 32bit alignment
-        return ((uWidth * pInfo->BitsPerPixel + 31) / 32) * 4;
-    }
-}
-
-uint32 PixelFormat_CalculateSlicePitch(PIXEL_FORMAT Format, uint32 uWidth, uint32 uHeight)
-{
-    const PIXEL_FORMAT_INFO *pInfo = PixelFormat_GetPixelFormatInfo(Format);
-    if (pInfo->IsBlockCompressed)
-    {
-        uint32 NumBlocksWide = Max((uint32)1, uWidth / pInfo->BlockSize);
-        uint32 NumBlocksHigh = Max((uint32)1, uHeight / pInfo->BlockSize);
-        return NumBlocksWide * pInfo->BytesPerBlock * NumBlocksHigh;
-    }
-    else
-    {
-        // ensure 32bit alignment
-        return ((uWidth * pInfo->BitsPerPixel + 31) / 32) * 4 * uHeight;
-    }
-}
-
-uint32 PixelFormat_CalculateImageSize(PIXEL_FORMAT Format, uint32 uWidth, uint32 uHeight, uint32 uDepth)
-{
-    return PixelFormat_CalculateSlicePitch(Format, uWidth, uHeight) * uDepth;
+    return &invalidFormatInfo;
 }
 
 #if 0
@@ -232,60 +132,13 @@ uint32 PixelFormatHelpers::ConvertFloat4ToRGBA(const Vector4f &rgba)
 void PixelFormat_FlipImageInPlace(void *pPixels, uint32 rowPitch, uint32 rowCount)
 {
     DebugAssert(rowPitch > 0 && rowCount > 0);
-    byte *pRows = (byte *)pPixels;
-
-    // if greater than 64KB, use a malloced buffer
-    byte *pRowBuffer;
-    byte *pHeapBuffer = NULL;
-    if (rowPitch > 65536)
-        pRowBuffer = pHeapBuffer = (byte *)Y_malloc(rowPitch);
-    else
-        pRowBuffer = (byte *)alloca(rowPitch);
-
-    // divide the rows by 2, we only need to do this many swaps
-    uint32 flipCount = rowCount / 2;
-    uint32 rowCountMinusOne = rowCount - 1;
-    for (uint32 i = 0; i < flipCount; i++)
-    {
-        byte *pRow1 = pRows + (i * rowPitch);
-        byte *pRow2 = pRows + ((rowCountMinusOne - i) * rowPitch);
-        Y_memcpy(pRowBuffer, pRow1, rowPitch);
-        Y_memcpy(pRow1, pRow2, rowPitch);
-        Y_memcpy(pRow2, pRowBuffer, rowPitch);
-    }
-
-    // free temp buffer
-    Y_free(pHeapBuffer);
+    ImageTransform::TransformElementsInPlace(pPixels, rowPitch, rowPitch, rowCount, 1, IMAGE_TRANSFORM_FLIP_VERTICAL);
 }
 
 void PixelFormat_FlipImage(void *pDestinationPixels, const void *pPixels, uint32 rowPitch, uint32 rowCount)
 {
     DebugAssert(rowPitch > 0 && rowCount > 0);
-
-    const byte *pSourceRows = (const byte *)pPixels;
-    byte *pDestinationRows = (byte *)pDestinationPixels;
-
-    // divide the rows by 2, we only need to do this many swaps
-    uint32 flipCount = rowCount / 2;
-    uint32 rowCountMinusOne = rowCount - 1;
-    for (uint32 i = 0; i < flipCount; i++)
-    {
-        const byte *pSourceRow1 = pSourceRows + (i * rowPitch);
-        const byte *pSourceRow2 = pSourceRows + ((rowCountMinusOne - i) * rowPitch);
-        byte *pDestinationRow1 = pDestinationRows + (i * rowPitch);
-        byte *pDestinationRow2 = pDestinationRows + ((rowCountMinusOne - i) * rowPitch);
-        Y_memcpy(pDestinationRow1, pSourceRow2, rowPitch);
-        Y_memcpy(pDestinationRow2, pSourceRow1, rowPitch);
-    }
-
-    // handle the middle line in odd sized images
-    if (flipCount & 1)
-    {
-        uint32 oddIndex = flipCount + 1;
-        const byte *pSourceRow = pSourceRows + (oddIndex * rowPitch);
-        byte *pDestinationRow = pDestinationRows + (oddIndex * rowPitch);
-        Y_memcpy(pDestinationRow, pSourceRow, rowPitch);
-    }
+    ImageTransform::TransformElements(pDestinationPixels, rowPitch, pPixels, rowPitch, rowPitch, rowCount, 1, IMAGE_TRANSFORM_FLIP_VERTICAL);
 }
 
 PIXEL_FORMAT PixelFormatHelpers::GetSRGBFormat(PIXEL_FORMAT format)
@@ -413,106 +266,251 @@ Vector4f PixelFormatHelpers::ConvertSRGBToLinear(const Vector4f &color)
 
 #endif
 
-/* Generator code:
-
-import math
-
-def toLinear(cs):
-  if (cs <= 0.04045):
-    return cs / 12.92
-  else:
-    return math.pow((cs + 0.055) / 1.055, 2.4)
-
-def toSRGB(cl):
-  if (cl <= 0.0):
-    return 0.0
-  elif (cl < 0.0031308):
-    return 12.92 * cl
-  elif (cl < 1.0):
-    return 1.055 * pow(cl, 0.41666) - 0.055
-  else:
-    return 1.0
-
-def printLUT(func):
-  line = ""
-  for i in range(0, 256):
-    if (i > 0 and (i % 32) == 0):
-      print(line)
-      line = ""
-    line += str(int(math.floor(func(i / 255.0) * 255.0)))
-    line += ", "
-  print(line)
-
-printLUT(toSRGB)
-printLUT(toLinear)
-
-*/
+//------------------------------------------------------------------ sRGB ----------------------------------------------------------------------------------------------------------------
 
-uint32 PixelFormatHelpers::ConvertLinearToSRGB(const uint32 rgba)
+// The 8-bit conversions are table driven and exact, matching the curve evaluated in double precision. Linear values are
+// encoded by looking up their nearest 16-bit step, which is at most one code away from the answer, then comparing against
+// the exact threshold between codes to correct it.
+// The float conversions use no tables so they vectorize without gathers. The powers are built from square roots and a
+// Newton-refined cube or fifth root: x^(1/2.4) = x^(1/4) * x^(1/6), and y^2.4 = y^2 * (y^2)^(1/5).
+
+static inline double SRGBToLinearDouble(double value)
 {
-    //return ConvertFloat4ToRGBA(ConvertLinearToSRGB(ConvertRGBAToFloat4(rgba)));
-
-//     static const uint8 linearToSRGBLUT[256] = {
-//         0, 20, 28, 33, 38, 42, 46, 49, 52, 55, 58, 61, 63, 65, 68, 70, 72, 74, 76, 78, 80, 81, 83, 85, 87, 88, 90, 91, 93, 94, 96, 97,
-//         99, 100, 102, 103, 104, 106, 107, 108, 109, 111, 112, 113, 114, 115, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 128, 129, 130, 131, 132, 133, 134, 135,
-//         136, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 147, 148, 149, 150, 151, 152, 153, 153, 154, 155, 156, 157, 158, 158, 159, 160, 161, 162, 162,
-//         163, 164, 165, 165, 166, 167, 168, 168, 169, 170, 171, 171, 172, 173, 174, 174, 175, 176, 176, 177, 178, 178, 179, 180, 181, 181, 182, 183, 183, 184, 185, 185,
-//         186, 187, 187, 188, 189, 189, 190, 190, 191, 192, 192, 193, 194, 194, 195, 196, 196, 197, 197, 198, 199, 199, 200, 200, 201, 202, 202, 203, 203, 204, 205, 205,
-//         206, 206, 207, 208, 208, 209, 209, 210, 210, 211, 212, 212, 213, 213, 214, 214, 215, 216, 216, 217, 217, 218, 218, 219, 219, 220, 220, 221, 222, 222, 223, 223,
-//         224, 224, 225, 225, 226, 226, 227, 227, 228, 228, 229, 229, 230, 230, 231, 231, 232, 232, 233, 233, 234, 234, 235, 235, 236, 236, 237, 237, 238, 238, 239, 239,
-//         240, 240, 241, 241, 242, 242, 243, 243, 244, 244, 245, 245, 246, 246, 247, 247, 248, 248, 249, 249, 249, 250, 250, 251, 251, 252, 252, 253, 253, 254, 254, 255
-//     };
-
-    static const uint8 linearToSRGBLUT[256] = {
-        0, 12, 21, 28, 33, 38, 42, 46, 49, 52, 55, 58, 61, 63, 66, 68, 70, 73, 75, 77, 79, 81, 82, 84, 86, 88, 89, 91, 93, 94, 96, 97,
-        99, 100, 102, 103, 104, 106, 107, 109, 110, 111, 112, 114, 115, 116, 117, 118, 120, 121, 122, 123, 124, 125, 126, 127, 129, 130, 131, 132, 133, 134, 135, 136,
-        137, 138, 139, 140, 141, 142, 142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 151, 152, 153, 154, 155, 156, 157, 157, 158, 159, 160, 161, 161, 162, 163, 164,
-        165, 165, 166, 167, 168, 168, 169, 170, 171, 171, 172, 173, 174, 174, 175, 176, 176, 177, 178, 179, 179, 180, 181, 181, 182, 183, 183, 184, 185, 185, 186, 187,
-        187, 188, 189, 189, 190, 191, 191, 192, 193, 193, 194, 194, 195, 196, 196, 197, 197, 198, 199, 199, 200, 201, 201, 202, 202, 203, 204, 204, 205, 205, 206, 206,
-        207, 208, 208, 209, 209, 210, 210, 211, 212, 212, 213, 213, 214, 214, 215, 215, 216, 217, 217, 218, 218, 219, 219, 220, 220, 221, 221, 222, 222, 223, 223, 224,
-        225, 225, 226, 226, 227, 227, 228, 228, 229, 229, 230, 230, 231, 231, 232, 232, 233, 233, 234, 234, 235, 235, 236, 236, 237, 237, 237, 238, 238, 239, 239, 240,
-        240, 241, 241, 242, 242, 243, 243, 244, 244, 245, 245, 245, 246, 246, 247, 247, 248, 248, 249, 249, 250, 250, 251, 251, 251, 252, 252, 253, 253, 254, 254, 255
-    };
+    return (value <= 0.04045) ? (value / 12.92) : pow((value + 0.055) / 1.055, 2.4);
+}
+
+static inline double LinearToSRGBDouble(double value)
+{
+    return (value <= 0.0031308) ? (value * 12.92) : (1.055 * pow(value, 1.0 / 2.4) - 0.055);
+}
+
+struct SRGBTables
+{
+    SRGBTables()
+    {
+        for (uint32 i = 0; i < 256; i++)
+        {
+            double value = SRGBToLinearDouble((double)i / 255.0);
+            SRGB8ToFloat[i] = (float)value;
+            SRGB8ToLinear16[i] = (uint16)(value * 65535.0 + 0.5);
+            SRGB8ToLinear8[i] = (uint8)(value * 255.0 + 0.5);
+        }
+
+        // the real threshold is rounded up to a float, so value >= threshold holds exactly when the curve rounds up
+        double thresholds[255];
+        for (uint32 i = 0; i < 255; i++)
+        {
+            thresholds[i] = SRGBToLinearDouble(((double)i + 0.5) / 255.0);
+            float threshold = (float)thresholds[i];
+            Thresholds[i] = ((double)threshold < thresholds[i]) ? nextafterf(threshold, 2.0f) : threshold;
+        }
+
+        uint32 code = 0;
+        for (uint32 i = 0; i < 65536; i++)
+        {
+            double value = (double)i / 65535.0;
+            while (code < 255 && value >= thresholds[code])
+                code++;
+
+            Linear16ToSRGB8[i] = (uint8)code;
+        }
+    }
+
+    float SRGB8ToFloat[256];
+    uint16 SRGB8ToLinear16[256];
+    uint8 SRGB8ToLinear8[256];
+    float Thresholds[255];              // smallest linear value encoding to code i + 1
+    uint8 Linear16ToSRGB8[65536];
+};
+
+static const SRGBTables s_SRGBTables;
+
+static inline uint8 LinearToSRGB8(float value)
+{
+    // NaN fails the first test and becomes zero, like the UNORM encode
+    if (!(value > 0.0f))
+        return 0;
+    if (value >= 1.0f)
+        return 255;
+
+    // the 16-bit step is within 2^-17 of the value, far closer than two thresholds ever are
+    uint32 code = s_SRGBTables.Linear16ToSRGB8[(uint32)(value * 65535.0f + 0.5f)];
+    if (code < 255 && value >= s_SRGBTables.Thresholds[code])
+        code++;
+    else if (code > 0 && value < s_SRGBTables.Thresholds[code - 1])
+        code--;
+
+    return (uint8)code;
+}
+
+static inline uint8 FloatToUNorm8(float value)
+{
+    value = (value == value) ? Min(Max(value, 0.0f), 1.0f) : 0.0f;
+    return (uint8)std::nearbyint(value * 255.0f);
+}
+
+#if Y_CPU_SSE_LEVEL > 0
+
+// x^(1/3), for positive normal x
+static inline __m128 CubeRoot4(__m128 x)
+{
+    // dividing the bit pattern by three roughly divides the exponent, for a guess within a few percent
+    __m128 guessBits = _mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(x)), _mm_set_ps1(1.0f / 3.0f));
+    __m128 y = _mm_castsi128_ps(_mm_add_epi32(_mm_cvttps_epi32(guessBits), _mm_set1_epi32(709921077)));
+
+    const __m128 third = _mm_set_ps1(1.0f / 3.0f);
+    for (uint32 i = 0; i < 3; i++)
+        y = _mm_mul_ps(_mm_add_ps(_mm_add_ps(y, y), _mm_div_ps(x, _mm_mul_ps(y, y))), third);
+
+    return y;
+}
+
+// x^(1/5), for positive normal x
+static inline __m128 FifthRoot4(__m128 x)
+{
+    __m128 guessBits = _mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(x)), _mm_set_ps1(1.0f / 5.0f));
+    __m128 y = _mm_castsi128_ps(_mm_add_epi32(_mm_cvttps_epi32(guessBits), _mm_set1_epi32(852282573)));
+
+    const __m128 fifth = _mm_set_ps1(1.0f / 5.0f);
+    const __m128 four = _mm_set_ps1(4.0f);
+    for (uint32 i = 0; i < 4; i++)
+    {
+        __m128 y2 = _mm_mul_ps(y, y);
+        y = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(y, four), _mm_div_ps(x, _mm_mul_ps(y2, y2))), fifth);
+    }
+
+    return y;
+}
+
+static inline __m128 LinearToSRGB4(__m128 values)
+{
+    // the power side is computed on clamped values so no lane sees zero, negatives or infinity, and is then masked out
+    __m128 clamped = _mm_min_ps(_mm_max_ps(values, _mm_set_ps1(0.0031308f)), _mm_set_ps1(FLT_MAX));
+    __m128 squareRoot = _mm_sqrt_ps(clamped);
+    __m128 power = _mm_mul_ps(_mm_sqrt_ps(squareRoot), CubeRoot4(squareRoot));
+    __m128 curve = _mm_sub_ps(_mm_mul_ps(power, _mm_set_ps1(1.055f)), _mm_set_ps1(0.055f));
+    __m128 linear = _mm_mul_ps(values, _mm_set_ps1(12.92f));
+
+    __m128 useCurve = _mm_cmpgt_ps(values, _mm_set_ps1(0.0031308f));
+    return _mm_or_ps(_mm_and_ps(useCurve, curve), _mm_andnot_ps(useCurve, linear));
+}
+
+static inline __m128 SRGBToLinear4(__m128 values)
+{
+    // the upper clamp keeps the square finite
+    __m128 clamped = _mm_min_ps(_mm_max_ps(values, _mm_set_ps1(0.04045f)), _mm_set_ps1(1.0e15f));
+    __m128 base = _mm_div_ps(_mm_add_ps(clamped, _mm_set_ps1(0.055f)), _mm_set_ps1(1.055f));
+    __m128 square = _mm_mul_ps(base, base);
+    __m128 curve = _mm_mul_ps(square, FifthRoot4(square));
+    __m128 linear = _mm_div_ps(values, _mm_set_ps1(12.92f));
+
+    __m128 useCurve = _mm_cmpgt_ps(values, _mm_set_ps1(0.04045f));
+    return _mm_or_ps(_mm_and_ps(useCurve, curve), _mm_andnot_ps(useCurve, linear));
+}
+
+template<__m128(*CONVERT)(__m128)>
+static void ConvertFloats(float *pDestination, const float *pSource, uint32 count)
+{
+    uint32 i = 0;
+    for (; (i + 4) <= count; i += 4)
+        _mm_storeu_ps(pDestination + i, CONVERT(_mm_loadu_ps(pSource + i)));
+
+    // the tail goes through the same path, so every element of an array gets identical results
+    if (i < count)
+    {
+        float temp[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        Y_memcpy(temp, pSource + i, sizeof(float) * (count - i));
+        _mm_storeu_ps(temp, CONVERT(_mm_loadu_ps(temp)));
+        Y_memcpy(pDestination + i, temp, sizeof(float) * (count - i));
+    }
+}
+
+#endif
+
+void PixelFormatHelpers::ConvertLinearToSRGB(float *pDestination, const float *pSource, uint32 count)
+{
+#if Y_CPU_SSE_LEVEL > 0
+    ConvertFloats<LinearToSRGB4>(pDestination, pSource, count);
+#else
+    for (uint32 i = 0; i < count; i++)
+        pDestination[i] = (float)LinearToSRGBDouble(pSource[i]);
+#endif
+}
+
+void PixelFormatHelpers::ConvertSRGBToLinear(float *pDestination, const float *pSource, uint32 count)
+{
+#if Y_CPU_SSE_LEVEL > 0
+    ConvertFloats<SRGBToLinear4>(pDestination, pSource, count);
+#else
+    for (uint32 i = 0; i < count; i++)
+        pDestination[i] = (float)SRGBToLinearDouble(pSource[i]);
+#endif
+}
+
+void PixelFormatHelpers::ConvertLinearToSRGB8(uint8 *pDestination, const float *pSource, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++)
+        pDestination[i] = LinearToSRGB8(pSource[i]);
+}
+
+void PixelFormatHelpers::ConvertLinearToSRGB8(uint8 *pDestination, const uint16 *pSource, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++)
+        pDestination[i] = s_SRGBTables.Linear16ToSRGB8[pSource[i]];
+}
+
+void PixelFormatHelpers::ConvertSRGB8ToLinear(float *pDestination, const uint8 *pSource, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++)
+        pDestination[i] = s_SRGBTables.SRGB8ToFloat[pSource[i]];
+}
+
+void PixelFormatHelpers::ConvertSRGB8ToLinear(uint16 *pDestination, const uint8 *pSource, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++)
+        pDestination[i] = s_SRGBTables.SRGB8ToLinear16[pSource[i]];
+}
 
+void PixelFormatHelpers::ConvertLinearToSRGBA8(uint8 *pDestination, const float *pSource, uint32 pixelCount)
+{
+    for (uint32 i = 0; i < pixelCount; i++, pDestination += 4, pSource += 4)
+    {
+        pDestination[0] = LinearToSRGB8(pSource[0]);
+        pDestination[1] = LinearToSRGB8(pSource[1]);
+        pDestination[2] = LinearToSRGB8(pSource[2]);
+        pDestination[3] = FloatToUNorm8(pSource[3]);
+    }
+}
+
+void PixelFormatHelpers::ConvertSRGBA8ToLinear(float *pDestination, const uint8 *pSource, uint32 pixelCount)
+{
+    for (uint32 i = 0; i < pixelCount; i++, pDestination += 4, pSource += 4)
+    {
+        pDestination[0] = s_SRGBTables.SRGB8ToFloat[pSource[0]];
+        pDestination[1] = s_SRGBTables.SRGB8ToFloat[pSource[1]];
+        pDestination[2] = s_SRGBTables.SRGB8ToFloat[pSource[2]];
+        pDestination[3] = (float)pSource[3] / 255.0f;
+    }
+}
+
+uint32 PixelFormatHelpers::ConvertLinearToSRGB(const uint32 rgba)
+{
     union
     {
         uint32 alignedRGB;
         uint8 pRGBBytes[4];
     };
 
+    // c / 255 is exactly c * 257 / 65535, so the 16-bit table gives the rounded result directly
     alignedRGB = rgba;
-    pRGBBytes[0] = linearToSRGBLUT[pRGBBytes[0]];
-    pRGBBytes[1] = linearToSRGBLUT[pRGBBytes[1]];
-    pRGBBytes[2] = linearToSRGBLUT[pRGBBytes[2]];
+    pRGBBytes[0] = s_SRGBTables.Linear16ToSRGB8[pRGBBytes[0] * 257];
+    pRGBBytes[1] = s_SRGBTables.Linear16ToSRGB8[pRGBBytes[1] * 257];
+    pRGBBytes[2] = s_SRGBTables.Linear16ToSRGB8[pRGBBytes[2] * 257];
     return alignedRGB;
 }
 
 uint32 PixelFormatHelpers::ConvertSRGBToLinear(const uint32 rgba)
 {
-    //return ConvertFloat4ToRGBA(ConvertSRGBToLinear(rgba));
-
-//     static const uint8 sRGBToLinearLUT[256] = { 
-//         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2,
-//         2, 2, 3, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 10, 11, 11,
-//         12, 12, 13, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19, 20, 21, 21, 22, 22, 23, 23, 24, 25, 25, 26, 27, 27, 28, 29,
-//         29, 30, 31, 31, 32, 33, 33, 34, 35, 36, 36, 37, 38, 39, 40, 40, 41, 42, 43, 44, 45, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55,
-//         55, 56, 57, 58, 59, 60, 61, 62, 63, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 77, 78, 79, 80, 81, 82, 84, 85, 86, 87, 88, 90,
-//         91, 92, 93, 95, 96, 97, 99, 100, 101, 103, 104, 105, 107, 108, 109, 111, 112, 114, 115, 117, 118, 119, 121, 122, 124, 125, 127, 128, 130, 131, 133, 135,
-//         136, 138, 139, 141, 142, 144, 146, 147, 149, 151, 152, 154, 156, 157, 159, 161, 162, 164, 166, 168, 169, 171, 173, 175, 176, 178, 180, 182, 184, 186, 187, 189,
-//         191, 193, 195, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221, 223, 225, 227, 229, 231, 233, 235, 237, 239, 241, 244, 246, 248, 250, 252, 255
-//     };
-
-    static const uint8 sRGBToLinearLUT[256] = { 
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3,
-        3, 3, 4, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 10, 11, 11, 11, 12, 12,
-        13, 13, 13, 14, 14, 15, 15, 16, 16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 22, 22, 23, 23, 24, 24, 25, 26, 26, 27, 27, 28, 29,
-        29, 30, 31, 31, 32, 33, 33, 34, 35, 36, 36, 37, 38, 38, 39, 40, 41, 42, 42, 43, 44, 45, 46, 47, 47, 48, 49, 50, 51, 52, 53, 54,
-        55, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 70, 71, 72, 73, 74, 75, 76, 77, 78, 80, 81, 82, 83, 84, 85, 87, 88,
-        89, 90, 92, 93, 94, 95, 97, 98, 99, 101, 102, 103, 105, 106, 107, 109, 110, 112, 113, 114, 116, 117, 119, 120, 122, 123, 125, 126, 128, 129, 131, 132,
-        134, 135, 137, 139, 140, 142, 144, 145, 147, 148, 150, 152, 153, 155, 157, 159, 160, 162, 164, 166, 167, 169, 171, 173, 175, 176, 178, 180, 182, 184, 186, 188,
-        190, 192, 193, 195, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 218, 220, 222, 224, 226, 228, 230, 232, 235, 237, 239, 241, 243, 245, 248, 250, 252, 255
-    };
-
     union
     {
         uint32 alignedRGB;
@@ -520,8 +518,8 @@ uint32 PixelFormatHelpers::ConvertSRGBToLinear(const uint32 rgba)
     };
 
     alignedRGB = rgba;
-    pRGBBytes[0] = sRGBToLinearLUT[pRGBBytes[0]];
-    pRGBBytes[1] = sRGBToLinearLUT[pRGBBytes[1]];
-    pRGBBytes[2] = sRGBToLinearLUT[pRGBBytes[2]];
+    pRGBBytes[0] = s_SRGBTables.SRGB8ToLinear8[pRGBBytes[0]];
+    pRGBBytes[1] = s_SRGBTables.SRGB8ToLinear8[pRGBBytes[1]];
+    pRGBBytes[2] = s_SRGBTables.SRGB8ToLinear8[pRGBBytes[2]];
     return alignedRGB;
 }
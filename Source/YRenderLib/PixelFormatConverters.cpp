@@ -3,471 +3,684 @@
 #include "YBaseLib/Memory.h"
 #include "YBaseLib/Log.h"
 #include "YRenderLib/PixelFormat.h"
+#include "YRenderLib/VertexCompression.h"
+#include <cfloat>
+#include <cmath>
 Log_SetChannel(PixelFormatConverters);
 
-// kinda a crappy converter, but basically we just convert each pixel to a R32G32B32A32 pixel, then back to the destination format
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static void DecodeR8G8B8A8(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
+#if Y_CPU_SSE_LEVEL > 0
+    #include <intrin.h>
+#endif
+
+// Every conversion goes through an R32G32B32A32_FLOAT image, the source is decoded to it and then encoded to the
+// destination format. Both directions follow the D3D data conversion rules, so results match what the GPU reads/writes:
+//   UNORM/SNORM -> float       c / (2^n - 1), SNORM clamped to -1
+//   float -> UNORM/SNORM/INT   clamp to the representable range, round to nearest even, NaN becomes 0
+//   float -> half/11/10-bit    round to nearest even, the unsigned 11/10-bit floats clamp negatives to 0
+//   RGB9E5                     shared exponent encoding from EXT_texture_shared_exponent
+// Channels not present in the source decode as 0 for green/blue and 1 for alpha. 32-bit integer
+// components go through float, so they are only exact up to 2^24.
+
+static inline uint32 FloatAsUInt32(float value)
 {
-    const byte *pInBytes = (const byte *)pInPixels;
-    float *pOutRow = pOutPixels;
-    uint32 i, j;
+    uint32 bits;
+    Y_memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
 
-    for (i = 0; i < Height; i++)
-    {
-        for (j = 0; j < Width; j++)
-        {
-            pOutRow[j * 4 + 0] = float(pInBytes[j * 4 + 0]) / 255.0f;
-            pOutRow[j * 4 + 1] = float(pInBytes[j * 4 + 1]) / 255.0f;
-            pOutRow[j * 4 + 2] = float(pInBytes[j * 4 + 2]) / 255.0f;
-            pOutRow[j * 4 + 3] = float(pInBytes[j * 4 + 3]) / 255.0f;
-        }
-        pInBytes += SourcePitch;
-        pOutRow += Width * 4;
-    }
+// uses the current rounding mode, which is round to nearest even unless the application changed it, same as _mm_cvtps_epi32
+static inline int32 RoundToNearestEven(float value)
+{
+    return (int32)std::nearbyint(value);
 }
 
-static void DecodeR8G8B8(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
+//------------------------------------------------------------------ Components ------------------------------------------------------------------------------------------------------------
+
+#if Y_CPU_SSE_LEVEL > 0
+
+static inline __m128i LoadComponents4(const uint8 *pSource)
 {
-    const byte *pInBytes = (const byte *)pInPixels;
-    float *pOutRow = pOutPixels;
-    uint32 i, j;
+    __m128i values = _mm_cvtsi32_si128(*reinterpret_cast<const int32 *>(pSource));
+    values = _mm_unpacklo_epi8(values, _mm_setzero_si128());
+    return _mm_unpacklo_epi16(values, _mm_setzero_si128());
+}
 
-    for (i = 0; i < Height; i++)
-    {
-        for (j = 0; j < Width; j++)
-        {
-            pOutRow[j * 4 + 0] = float(pInBytes[j * 3 + 0]) / 255.0f;
-            pOutRow[j * 4 + 1] = float(pInBytes[j * 3 + 1]) / 255.0f;
-            pOutRow[j * 4 + 2] = float(pInBytes[j * 3 + 2]) / 255.0f;
-            pOutRow[j * 4 + 3] = 1.0f;
-        }
-        pInBytes += SourcePitch;
-        pOutRow += Width * 4;
-    }
+static inline __m128i LoadComponents4(const int8 *pSource)
+{
+    __m128i values = _mm_cvtsi32_si128(*reinterpret_cast<const int32 *>(pSource));
+    values = _mm_unpacklo_epi8(values, values);
+    return _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 24);
 }
 
-static void DecodeB8G8R8A8(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
+static inline __m128i LoadComponents4(const uint16 *pSource)
 {
-    const byte *pInBytes = (const byte *)pInPixels;
-    float *pOutRow = pOutPixels;
-    uint32 i, j;
+    return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pSource)), _mm_setzero_si128());
+}
 
-    for (i = 0; i < Height; i++)
-    {
-        for (j = 0; j < Width; j++)
-        {
-            pOutRow[j * 4 + 0] = float(pInBytes[j * 4 + 3]) / 255.0f;
-            pOutRow[j * 4 + 1] = float(pInBytes[j * 4 + 2]) / 255.0f;
-            pOutRow[j * 4 + 2] = float(pInBytes[j * 4 + 1]) / 255.0f;
-            pOutRow[j * 4 + 3] = float(pInBytes[j * 4 + 0]) / 255.0f;
-        }
-        pInBytes += SourcePitch;
-        pOutRow += Width * 4;
-    }
+static inline __m128i LoadComponents4(const int16 *pSource)
+{
+    __m128i values = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pSource));
+    return _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16);
 }
 
-static void DecodeB8G8R8(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
+// values are already clamped to the component range, so the saturating packs don't change them
+static inline void StoreComponents4(uint8 *pDestination, __m128i values)
 {
-    const byte *pInBytes = (const byte *)pInPixels;
-    float *pOutRow = pOutPixels;
-    uint32 i, j;
+    __m128i packed = _mm_packs_epi32(values, values);
+    *reinterpret_cast<int32 *>(pDestination) = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+}
 
-    for (i = 0; i < Height; i++)
+static inline void StoreComponents4(int8 *pDestination, __m128i values)
+{
+    __m128i packed = _mm_packs_epi32(values, values);
+    *reinterpret_cast<int32 *>(pDestination) = _mm_cvtsi128_si32(_mm_packs_epi16(packed, packed));
+}
+
+static inline void StoreComponents4(uint16 *pDestination, __m128i values)
+{
+    // SSE2 has no unsigned 32->16 pack, so bias into the signed range and flip the top bit back afterwards
+    __m128i biased = _mm_sub_epi32(values, _mm_set1_epi32(0x8000));
+    __m128i packed = _mm_packs_epi32(biased, biased);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(pDestination), _mm_xor_si128(packed, _mm_set1_epi16((int16)0x8000)));
+}
+
+static inline void StoreComponents4(int16 *pDestination, __m128i values)
+{
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(pDestination), _mm_packs_epi32(values, values));
+}
+
+#endif
+
+// value / scale, clamped to minValue, scale is 1 for integer components
+template<typename T>
+static void ComponentsToFloat(float *pDestination, const T *pSource, uint32 count, float scale, float minValue)
+{
+    uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+    const __m128 scaleVector = _mm_set_ps1(scale);
+    const __m128 minVector = _mm_set_ps1(minValue);
+    for (; (i + 4) <= count; i += 4)
+        _mm_storeu_ps(pDestination + i, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(LoadComponents4(pSource + i)), scaleVector), minVector));
+#endif
+
+    for (; i < count; i++)
+        pDestination[i] = Max((float)pSource[i] / scale, minValue);
+}
+
+// value * scale, clamped to [minValue, maxValue] and rounded
+template<typename T>
+static void FloatToComponents(T *pDestination, const float *pSource, uint32 count, float scale, float minValue, float maxValue)
+{
+    uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+    const __m128 scaleVector = _mm_set_ps1(scale);
+    const __m128 minVector = _mm_set_ps1(minValue);
+    const __m128 maxVector = _mm_set_ps1(maxValue);
+    for (; (i + 4) <= count; i += 4)
     {
-        for (j = 0; j < Width; j++)
-        {
-            pOutRow[j * 4 + 0] = float(pInBytes[j * 3 + 3]) / 255.0f;
-            pOutRow[j * 4 + 1] = float(pInBytes[j * 3 + 2]) / 255.0f;
-            pOutRow[j * 4 + 2] = float(pInBytes[j * 3 + 1]) / 255.0f;
-            pOutRow[j * 4 + 3] = 1.0f;
-        }
-        pInBytes += SourcePitch;
-        pOutRow += Width * 4;
+        __m128 values = _mm_mul_ps(_mm_loadu_ps(pSource + i), scaleVector);
+        values = _mm_and_ps(values, _mm_cmpord_ps(values, values));
+        values = _mm_min_ps(_mm_max_ps(values, minVector), maxVector);
+        StoreComponents4(pDestination + i, _mm_cvtps_epi32(values));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        float value = pSource[i] * scale;
+        value = (value == value) ? Min(Max(value, minValue), maxValue) : 0.0f;
+        pDestination[i] = (T)RoundToNearestEven(value);
     }
 }
 
-static void DecodeB8G8R8X8(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
+static void FloatToUInt32Components(uint32 *pDestination, const float *pSource, uint32 count)
 {
-    const byte *pInBytes = (const byte *)pInPixels;
-    float *pOutRow = pOutPixels;
-    uint32 i, j;
+    for (uint32 i = 0; i < count; i++)
+    {
+        float value = pSource[i];
+        if (!(value > 0.0f))
+            pDestination[i] = 0;
+        else if (value >= 4294967296.0f)
+            pDestination[i] = 0xFFFFFFFF;
+        else
+            pDestination[i] = (uint32)std::nearbyint(value);
+    }
+}
 
-    for (i = 0; i < Height; i++)
+static void FloatToInt32Components(int32 *pDestination, const float *pSource, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++)
     {
-        for (j = 0; j < Width; j++)
-        {
-            pOutRow[j * 4 + 0] = float(pInBytes[j * 4 + 3]) / 255.0f;
-            pOutRow[j * 4 + 1] = float(pInBytes[j * 4 + 2]) / 255.0f;
-            pOutRow[j * 4 + 2] = float(pInBytes[j * 4 + 1]) / 255.0f;
-            pOutRow[j * 4 + 3] = 1.0f;
-        }
-        pInBytes += SourcePitch;
-        pOutRow += Width * 4;
+        float value = pSource[i];
+        if (value != value)
+            pDestination[i] = 0;
+        else if (value >= 2147483648.0f)
+            pDestination[i] = 0x7FFFFFFF;
+        else if (value <= -2147483648.0f)
+            pDestination[i] = (int32)0x80000000;
+        else
+            pDestination[i] = RoundToNearestEven(value);
     }
 }
 
-static void DecodeR8(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
+enum COMPONENT_TYPE
 {
-    const byte *pInBytes = (const byte *)pInPixels;
-    float *pOutRow = pOutPixels;
-    uint32 i, j;
+    COMPONENT_TYPE_UNORM8,
+    COMPONENT_TYPE_SNORM8,
+    COMPONENT_TYPE_UINT8,
+    COMPONENT_TYPE_SINT8,
+    COMPONENT_TYPE_UNORM16,
+    COMPONENT_TYPE_SNORM16,
+    COMPONENT_TYPE_UINT16,
+    COMPONENT_TYPE_SINT16,
+    COMPONENT_TYPE_FLOAT16,
+    COMPONENT_TYPE_UINT32,
+    COMPONENT_TYPE_SINT32,
+    COMPONENT_TYPE_FLOAT32,
+};
 
-    for (i = 0; i < Height; i++)
+static void DecodeComponentRow(float *pDestination, const void *pSource, uint32 count, COMPONENT_TYPE type)
+{
+    switch (type)
     {
-        for (j = 0; j < Width; j++)
-        {
-            pOutRow[j * 4 + 0] = float(pInBytes[j]) / 255.0f;
-            pOutRow[j * 4 + 1] = 1.0f;
-            pOutRow[j * 4 + 2] = 1.0f;
-            pOutRow[j * 4 + 3] = 1.0f;
-        }
-        pInBytes += SourcePitch;
-        pOutRow += Width * 4;
+    case COMPONENT_TYPE_UNORM8:     ComponentsToFloat(pDestination, (const uint8 *)pSource, count, 255.0f, 0.0f);           break;
+    case COMPONENT_TYPE_SNORM8:     ComponentsToFloat(pDestination, (const int8 *)pSource, count, 127.0f, -1.0f);           break;
+    case COMPONENT_TYPE_UINT8:      ComponentsToFloat(pDestination, (const uint8 *)pSource, count, 1.0f, 0.0f);             break;
+    case COMPONENT_TYPE_SINT8:      ComponentsToFloat(pDestination, (const int8 *)pSource, count, 1.0f, -FLT_MAX);          break;
+    case COMPONENT_TYPE_UNORM16:    ComponentsToFloat(pDestination, (const uint16 *)pSource, count, 65535.0f, 0.0f);        break;
+    case COMPONENT_TYPE_SNORM16:    ComponentsToFloat(pDestination, (const int16 *)pSource, count, 32767.0f, -1.0f);        break;
+    case COMPONENT_TYPE_UINT16:     ComponentsToFloat(pDestination, (const uint16 *)pSource, count, 1.0f, 0.0f);            break;
+    case COMPONENT_TYPE_SINT16:     ComponentsToFloat(pDestination, (const int16 *)pSource, count, 1.0f, -FLT_MAX);         break;
+    case COMPONENT_TYPE_FLOAT16:    VertexCompression::HalfToFloat(pDestination, (const uint16 *)pSource, count);           break;
+    case COMPONENT_TYPE_FLOAT32:    Y_memcpy(pDestination, pSource, sizeof(float) * count);                                 break;
+
+    case COMPONENT_TYPE_UINT32:
+        for (uint32 i = 0; i < count; i++)
+            pDestination[i] = (float)((const uint32 *)pSource)[i];
+        break;
+
+    case COMPONENT_TYPE_SINT32:
+        for (uint32 i = 0; i < count; i++)
+            pDestination[i] = (float)((const int32 *)pSource)[i];
+        break;
     }
 }
 
-static void DecodeR32G32B32A32F(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
+static void EncodeComponentRow(void *pDestination, const float *pSource, uint32 count, COMPONENT_TYPE type)
 {
-    const byte *pInBytes = (const byte *)pInPixels;
-    float *pOutRow = pOutPixels;
-    uint32 i, j;
+    switch (type)
+    {
+    case COMPONENT_TYPE_UNORM8:     FloatToComponents((uint8 *)pDestination, pSource, count, 255.0f, 0.0f, 255.0f);         break;
+    case COMPONENT_TYPE_SNORM8:     FloatToComponents((int8 *)pDestination, pSource, count, 127.0f, -127.0f, 127.0f);       break;
+    case COMPONENT_TYPE_UINT8:      FloatToComponents((uint8 *)pDestination, pSource, count, 1.0f, 0.0f, 255.0f);           break;
+    case COMPONENT_TYPE_SINT8:      FloatToComponents((int8 *)pDestination, pSource, count, 1.0f, -128.0f, 127.0f);         break;
+    case COMPONENT_TYPE_UNORM16:    FloatToComponents((uint16 *)pDestination, pSource, count, 65535.0f, 0.0f, 65535.0f);    break;
+    case COMPONENT_TYPE_SNORM16:    FloatToComponents((int16 *)pDestination, pSource, count, 32767.0f, -32767.0f, 32767.0f); break;
+    case COMPONENT_TYPE_UINT16:     FloatToComponents((uint16 *)pDestination, pSource, count, 1.0f, 0.0f, 65535.0f);        break;
+    case COMPONENT_TYPE_SINT16:     FloatToComponents((int16 *)pDestination, pSource, count, 1.0f, -32768.0f, 32767.0f);    break;
+    case COMPONENT_TYPE_FLOAT16:    VertexCompression::FloatToHalf((uint16 *)pDestination, pSource, count);                break;
+    case COMPONENT_TYPE_UINT32:     FloatToUInt32Components((uint32 *)pDestination, pSource, count);                        break;
+    case COMPONENT_TYPE_SINT32:     FloatToInt32Components((int32 *)pDestination, pSource, count);                          break;
+    case COMPONENT_TYPE_FLOAT32:    Y_memcpy(pDestination, pSource, sizeof(float) * count);                                 break;
+    }
+}
 
-    for (i = 0; i < Height; i++)
+static uint32 GetComponentSize(COMPONENT_TYPE type)
+{
+    switch (type)
     {
-        for (j = 0; j < Width; j++)
-        {
-            pOutRow[j * 4 + 0] = *(const float *)(&pInBytes[j * 16 + 0]);
-            pOutRow[j * 4 + 1] = *(const float *)(&pInBytes[j * 16 + 4]);
-            pOutRow[j * 4 + 2] = *(const float *)(&pInBytes[j * 16 + 8]);
-            pOutRow[j * 4 + 3] = *(const float *)(&pInBytes[j * 16 + 12]);
-        }
-        pInBytes += SourcePitch;
-        pOutRow += Width * 4;
+    case COMPONENT_TYPE_UNORM8:
+    case COMPONENT_TYPE_SNORM8:
+    case COMPONENT_TYPE_UINT8:
+    case COMPONENT_TYPE_SINT8:
+        return 1;
+
+    case COMPONENT_TYPE_UNORM16:
+    case COMPONENT_TYPE_SNORM16:
+    case COMPONENT_TYPE_UINT16:
+    case COMPONENT_TYPE_SINT16:
+    case COMPONENT_TYPE_FLOAT16:
+        return 2;
+
+    default:
+        return 4;
     }
 }
 
-static void DecodeR16G16B16A16F(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
+//------------------------------------------------------------------ Per-component formats ---------------------------------------------------------------------------------------------------
+
+// swizzle value for a component that is ignored when decoding and written as zero
+static const uint8 COMPONENT_UNUSED = 4;
+
+struct ComponentFormat
 {
-    const byte *pInBytes = (const byte *)pInPixels;
-    float *pOutRow = pOutPixels;
-    uint32 i, j;
+    PIXEL_FORMAT Format;
+    COMPONENT_TYPE Type;
+    uint32 ComponentCount;
+    uint8 Swizzle[4];               // channel held by each component, in memory order
+    bool SRGB;
+};
+
+static const ComponentFormat g_ComponentFormats[] =
+{
+    { PIXEL_FORMAT_R8_UINT,                 COMPONENT_TYPE_UINT8,       1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R8_SINT,                 COMPONENT_TYPE_SINT8,       1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R8_UNORM,                COMPONENT_TYPE_UNORM8,      1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R8_SNORM,                COMPONENT_TYPE_SNORM8,      1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R8G8_UINT,               COMPONENT_TYPE_UINT8,       2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R8G8_SINT,               COMPONENT_TYPE_SINT8,       2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R8G8_UNORM,              COMPONENT_TYPE_UNORM8,      2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R8G8_SNORM,              COMPONENT_TYPE_SNORM8,      2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R8G8B8A8_UINT,           COMPONENT_TYPE_UINT8,       4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R8G8B8A8_SINT,           COMPONENT_TYPE_SINT8,       4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R8G8B8A8_UNORM,          COMPONENT_TYPE_UNORM8,      4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,     COMPONENT_TYPE_UNORM8,      4,  { 0, 1, 2, 3 },                         true    },
+    { PIXEL_FORMAT_R8G8B8A8_SNORM,          COMPONENT_TYPE_SNORM8,      4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R16_UINT,                COMPONENT_TYPE_UINT16,      1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16_SINT,                COMPONENT_TYPE_SINT16,      1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16_UNORM,               COMPONENT_TYPE_UNORM16,     1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16_SNORM,               COMPONENT_TYPE_SNORM16,     1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16_FLOAT,               COMPONENT_TYPE_FLOAT16,     1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16G16_UINT,             COMPONENT_TYPE_UINT16,      2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16G16_SINT,             COMPONENT_TYPE_SINT16,      2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16G16_UNORM,            COMPONENT_TYPE_UNORM16,     2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16G16_SNORM,            COMPONENT_TYPE_SNORM16,     2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16G16_FLOAT,            COMPONENT_TYPE_FLOAT16,     2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R16G16B16A16_UINT,       COMPONENT_TYPE_UINT16,      4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R16G16B16A16_SINT,       COMPONENT_TYPE_SINT16,      4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R16G16B16A16_UNORM,      COMPONENT_TYPE_UNORM16,     4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R16G16B16A16_SNORM,      COMPONENT_TYPE_SNORM16,     4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R16G16B16A16_FLOAT,      COMPONENT_TYPE_FLOAT16,     4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R32_UINT,                COMPONENT_TYPE_UINT32,      1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R32_SINT,                COMPONENT_TYPE_SINT32,      1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R32_FLOAT,               COMPONENT_TYPE_FLOAT32,     1,  { 0, 0, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R32G32_UINT,             COMPONENT_TYPE_UINT32,      2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R32G32_SINT,             COMPONENT_TYPE_SINT32,      2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R32G32_FLOAT,            COMPONENT_TYPE_FLOAT32,     2,  { 0, 1, 0, 0 },                         false   },
+    { PIXEL_FORMAT_R32G32B32_UINT,          COMPONENT_TYPE_UINT32,      3,  { 0, 1, 2, 0 },                         false   },
+    { PIXEL_FORMAT_R32G32B32_SINT,          COMPONENT_TYPE_SINT32,      3,  { 0, 1, 2, 0 },                         false   },
+    { PIXEL_FORMAT_R32G32B32_FLOAT,         COMPONENT_TYPE_FLOAT32,     3,  { 0, 1, 2, 0 },                         false   },
+    { PIXEL_FORMAT_R32G32B32A32_UINT,       COMPONENT_TYPE_UINT32,      4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R32G32B32A32_SINT,       COMPONENT_TYPE_SINT32,      4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_R32G32B32A32_FLOAT,      COMPONENT_TYPE_FLOAT32,     4,  { 0, 1, 2, 3 },                         false   },
+    { PIXEL_FORMAT_B8G8R8A8_UNORM,          COMPONENT_TYPE_UNORM8,      4,  { 2, 1, 0, 3 },                         false   },
+    { PIXEL_FORMAT_B8G8R8A8_UNORM_SRGB,     COMPONENT_TYPE_UNORM8,      4,  { 2, 1, 0, 3 },                         true    },
+    { PIXEL_FORMAT_B8G8R8X8_UNORM,          COMPONENT_TYPE_UNORM8,      4,  { 2, 1, 0, COMPONENT_UNUSED },          false   },
+    { PIXEL_FORMAT_B8G8R8X8_UNORM_SRGB,     COMPONENT_TYPE_UNORM8,      4,  { 2, 1, 0, COMPONENT_UNUSED },          true    },
+    { PIXEL_FORMAT_R8G8B8_UNORM,            COMPONENT_TYPE_UNORM8,      3,  { 0, 1, 2, 0 },                         false   },
+    { PIXEL_FORMAT_B8G8R8_UNORM,            COMPONENT_TYPE_UNORM8,      3,  { 2, 1, 0, 0 },                         false   },
+};
 
-    for (i = 0; i < Height; i++)
+static const ComponentFormat *GetComponentFormat(PIXEL_FORMAT format)
+{
+    for (uint32 i = 0; i < countof(g_ComponentFormats); i++)
     {
-        for (j = 0; j < Width; j++)
-        {
-            pOutRow[j * 4 + 0] = Math::HalfToFloat(*(const uint16 *)(&pInBytes[j * 8 + 0]));
-            pOutRow[j * 4 + 1] = Math::HalfToFloat(*(const uint16 *)(&pInBytes[j * 8 + 2]));
-            pOutRow[j * 4 + 2] = Math::HalfToFloat(*(const uint16 *)(&pInBytes[j * 8 + 4]));
-            pOutRow[j * 4 + 3] = Math::HalfToFloat(*(const uint16 *)(&pInBytes[j * 8 + 6]));
-        }
-        pInBytes += SourcePitch;
-        pOutRow += Width * 4;
+        if (g_ComponentFormats[i].Format == format)
+            return &g_ComponentFormats[i];
     }
+
+    return nullptr;
+}
+
+static bool IsDirectComponentFormat(const ComponentFormat *pComponentFormat)
+{
+    return (pComponentFormat->ComponentCount == 4 && !pComponentFormat->SRGB &&
+            pComponentFormat->Swizzle[0] == 0 && pComponentFormat->Swizzle[1] == 1 && pComponentFormat->Swizzle[2] == 2 && pComponentFormat->Swizzle[3] == 3);
 }
 
-static void DecodeR32F(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
+static void DecodeComponents(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
 {
+    const ComponentFormat *pComponentFormat = GetComponentFormat(SourceFormat);
+    DebugAssert(pComponentFormat != nullptr);
+
     const byte *pInBytes = (const byte *)pInPixels;
     float *pOutRow = pOutPixels;
-    uint32 i, j;
+    uint32 componentCount = pComponentFormat->ComponentCount;
+    uint32 rowComponentCount = Width * componentCount;
 
-    for (i = 0; i < Height; i++)
+    // RGBA layouts convert straight into the output rows
+    if (IsDirectComponentFormat(pComponentFormat))
     {
-        for (j = 0; j < Width; j++)
+        for (uint32 i = 0; i < Height; i++)
         {
-            pOutRow[j * 4 + 0] = *(const float *)(&pInBytes[j * 4]);
-            pOutRow[j * 4 + 1] = 1.0f;
-            pOutRow[j * 4 + 2] = 1.0f;
-            pOutRow[j * 4 + 3] = 1.0f;
+            DecodeComponentRow(pOutRow, pInBytes, rowComponentCount, pComponentFormat->Type);
+            pInBytes += SourcePitch;
+            pOutRow += Width * 4;
         }
-        pInBytes += SourcePitch;
-        pOutRow += Width * 4;
-    }
-}
 
-static void DecodeR16F(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
-{
-    const byte *pInBytes = (const byte *)pInPixels;
-    float *pOutRow = pOutPixels;
-    uint32 i, j;
+        return;
+    }
 
-    for (i = 0; i < Height; i++)
+    float *pTempRow = Y_mallocT<float>(rowComponentCount);
+    for (uint32 i = 0; i < Height; i++)
     {
-        for (j = 0; j < Width; j++)
+        // srgb formats are all four 8-bit components with the color channels first
+        if (pComponentFormat->SRGB)
+            PixelFormatHelpers::ConvertSRGBA8ToLinear(pTempRow, pInBytes, Width);
+        else
+            DecodeComponentRow(pTempRow, pInBytes, rowComponentCount, pComponentFormat->Type);
+
+        const float *pInComponent = pTempRow;
+        for (uint32 j = 0; j < Width; j++)
         {
-            pOutRow[j * 4 + 0] = Math::HalfToFloat(*(const uint16 *)(&pInBytes[j * 2]));
-            pOutRow[j * 4 + 1] = 1.0f;
-            pOutRow[j * 4 + 2] = 1.0f;
-            pOutRow[j * 4 + 3] = 1.0f;
+            float *pOutPixel = &pOutRow[j * 4];
+            pOutPixel[0] = 0.0f;
+            pOutPixel[1] = 0.0f;
+            pOutPixel[2] = 0.0f;
+            pOutPixel[3] = 1.0f;
+
+            for (uint32 k = 0; k < componentCount; k++, pInComponent++)
+            {
+                if (pComponentFormat->Swizzle[k] != COMPONENT_UNUSED)
+                    pOutPixel[pComponentFormat->Swizzle[k]] = *pInComponent;
+            }
         }
+
         pInBytes += SourcePitch;
         pOutRow += Width * 4;
     }
-}
 
-// 
-// static void Decode8BitChannel(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
-// {
-//     PIXEL_FORMAT_INFO *pFormatInfo = PixelFormat_GetPixelFormatInfo(SourceFormat);
-//     DebugAssert(pFormatInfo->BitsPerPixel <= 32);
-// 
-//     const byte *pInBytes = (const byte *)pInPixels;
-//     float *pOutRow = pOutPixels;
-//     uint32 i, j;
-// 
-//     uint32 ShiftRed 
-// 
-//     for (i = 0; i < Height; i++)
-//     {
-//         const byte *pInThisRow = pInBytes;
-//         float *pOutThisRow = pOutRow;
-//         for (j = 0; j < Width; j++)
-//         {
-//             uint32 InInt = 0;
-//             if (pFormatInfo->BitsPerPixel >= 8)
-//             {
-//                 InInt |= (((uint32)*pInThisRow++) << 24);
-//                 if (pFormatInfo->BitsPerPixel >= 16)
-//                 {
-//                     InInt |= (((uint32)*pInThisRow++) << 16);
-//                     if (pFormatInfo->BitsPerPixel >= 24)
-//                     {
-//                         InInt |= (((uint32)*pInThisRow++) << 8);
-//                         if (pFormatInfo->BitsPerPixel >= 32)
-//                             InInt |= (((uint32)*pInThisRow++));
-//                     }
-//                 }
-//             }
-// 
-//             // splat the value across all 4 components, then mask it out
-//             if (pFormatInfo->ColorMaskRed != 0)
-//                 *pOutThisRow++ = (InInt & pFormatInfo->ColorMaskRed) 
-// 
-// 
-//                 
-//             pOutRow[j * 4 + 0] = float(pInBytes[j * 3 + 0]) * 255.0f;
-//             pOutRow[j * 4 + 1] = float(pInBytes[j * 3 + 1]) * 255.0f;
-//             pOutRow[j * 4 + 2] = float(pInBytes[j * 3 + 2]) * 255.0f;
-//             pOutRow[j * 4 + 3] = 1.0f;
-//         }
-//         pInBytes += SourcePitch;
-//         pOutRow += Width * 4;
-//     }
-// }
+    Y_free(pTempRow);
+}
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static void EncodeR8G8B8A8(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+static void EncodeComponents(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
 {
+    const ComponentFormat *pComponentFormat = GetComponentFormat(DestinationFormat);
+    DebugAssert(pComponentFormat != nullptr);
+
     byte *pOutBytes = (byte *)pOutPixels;
     const float *pInRow = pInPixels;
-    uint32 i, j;
+    uint32 componentCount = pComponentFormat->ComponentCount;
+    uint32 rowComponentCount = Width * componentCount;
 
-    for (i = 0; i < Height; i++)
+    if (IsDirectComponentFormat(pComponentFormat))
     {
-        for (j = 0; j < Width; j++)
+        for (uint32 i = 0; i < Height; i++)
         {
-            pOutBytes[j * 4 + 0] = (byte)(pInRow[j * 4 + 0] * 255.0f);
-            pOutBytes[j * 4 + 1] = (byte)(pInRow[j * 4 + 1] * 255.0f);
-            pOutBytes[j * 4 + 2] = (byte)(pInRow[j * 4 + 2] * 255.0f);
-            pOutBytes[j * 4 + 3] = (byte)(pInRow[j * 4 + 3] * 255.0f);
+            EncodeComponentRow(pOutBytes, pInRow, rowComponentCount, pComponentFormat->Type);
+            pOutBytes += DestinationPitch;
+            pInRow += Width * 4;
         }
-        pOutBytes += DestinationPitch;
-        pInRow += Width * 4;
-    }
-}
 
-static void EncodeR8G8B8(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
-{
-    byte *pOutBytes = (byte *)pOutPixels;
-    const float *pInRow = pInPixels;
-    uint32 i, j;
+        return;
+    }
 
-    for (i = 0; i < Height; i++)
+    float *pTempRow = Y_mallocT<float>(rowComponentCount);
+    for (uint32 i = 0; i < Height; i++)
     {
-        for (j = 0; j < Width; j++)
+        float *pOutComponent = pTempRow;
+        for (uint32 j = 0; j < Width; j++)
         {
-            pOutBytes[j * 3 + 0] = (byte)(pInRow[j * 4 + 0] * 255.0f);
-            pOutBytes[j * 3 + 1] = (byte)(pInRow[j * 4 + 1] * 255.0f);
-            pOutBytes[j * 3 + 2] = (byte)(pInRow[j * 4 + 2] * 255.0f);
-            // drop alpha
+            const float *pInPixel = &pInRow[j * 4];
+            for (uint32 k = 0; k < componentCount; k++, pOutComponent++)
+            {
+                uint32 channel = pComponentFormat->Swizzle[k];
+                *pOutComponent = (channel == COMPONENT_UNUSED) ? 0.0f : pInPixel[channel];
+            }
         }
+
+        if (pComponentFormat->SRGB)
+            PixelFormatHelpers::ConvertLinearToSRGBA8(pOutBytes, pTempRow, Width);
+        else
+            EncodeComponentRow(pOutBytes, pTempRow, rowComponentCount, pComponentFormat->Type);
         pOutBytes += DestinationPitch;
         pInRow += Width * 4;
     }
+
+    Y_free(pTempRow);
 }
 
-static void EncodeB8G8R8A8(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+//------------------------------------------------------------------ Packed formats ------------------------------------------------------------------------------------------------------
+
+struct PackedFormat
 {
-    byte *pOutBytes = (byte *)pOutPixels;
-    const float *pInRow = pInPixels;
-    uint32 i, j;
+    PIXEL_FORMAT Format;
+    uint32 BytesPerPixel;
+    uint32 Bits[4];                 // per RGBA channel, zero if the channel isn't stored
+    uint32 Shift[4];
+    bool Integer;                   // UINT rather than UNORM
+};
+
+static const PackedFormat g_PackedFormats[] =
+{
+    { PIXEL_FORMAT_R10G10B10A2_UINT,        4,  { 10, 10, 10, 2 },  { 0, 10, 20, 30 },  true    },
+    { PIXEL_FORMAT_R10G10B10A2_UNORM,       4,  { 10, 10, 10, 2 },  { 0, 10, 20, 30 },  false   },
+    { PIXEL_FORMAT_B5G6R5_UNORM,            2,  { 5, 6, 5, 0 },     { 11, 5, 0, 0 },    false   },
+    { PIXEL_FORMAT_B5G5R5A1_UNORM,          2,  { 5, 5, 5, 1 },     { 10, 5, 0, 15 },   false   },
+};
 
-    for (i = 0; i < Height; i++)
+static const PackedFormat *GetPackedFormat(PIXEL_FORMAT format)
+{
+    for (uint32 i = 0; i < countof(g_PackedFormats); i++)
     {
-        for (j = 0; j < Width; j++)
-        {
-            pOutBytes[j * 4 + 2] = (byte)(pInRow[j * 4 + 0] * 255.0f);
-            pOutBytes[j * 4 + 1] = (byte)(pInRow[j * 4 + 1] * 255.0f);
-            pOutBytes[j * 4 + 0] = (byte)(pInRow[j * 4 + 2] * 255.0f);
-            pOutBytes[j * 4 + 3] = (byte)(pInRow[j * 4 + 3] * 255.0f);
-        }
-        pOutBytes += DestinationPitch;
-        pInRow += Width * 4;
+        if (g_PackedFormats[i].Format == format)
+            return &g_PackedFormats[i];
     }
+
+    return nullptr;
 }
 
-static void EncodeB8G8R8(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+static void DecodePacked(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
 {
-    byte *pOutBytes = (byte *)pOutPixels;
-    const float *pInRow = pInPixels;
-    uint32 i, j;
+    const PackedFormat *pPackedFormat = GetPackedFormat(SourceFormat);
+    DebugAssert(pPackedFormat != nullptr);
+
+    static const float defaultValues[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    const byte *pInBytes = (const byte *)pInPixels;
+    float *pOutRow = pOutPixels;
 
-    for (i = 0; i < Height; i++)
+    for (uint32 i = 0; i < Height; i++)
     {
-        for (j = 0; j < Width; j++)
+        for (uint32 j = 0; j < Width; j++)
         {
-            pOutBytes[j * 3 + 2] = (byte)(pInRow[j * 4 + 0] * 255.0f);
-            pOutBytes[j * 3 + 1] = (byte)(pInRow[j * 4 + 1] * 255.0f);
-            pOutBytes[j * 3 + 0] = (byte)(pInRow[j * 4 + 2] * 255.0f);
+            uint32 pixel = 0;
+            Y_memcpy(&pixel, &pInBytes[j * pPackedFormat->BytesPerPixel], pPackedFormat->BytesPerPixel);
+
+            for (uint32 channel = 0; channel < 4; channel++)
+            {
+                if (pPackedFormat->Bits[channel] == 0)
+                {
+                    pOutRow[j * 4 + channel] = defaultValues[channel];
+                    continue;
+                }
+
+                uint32 mask = (1u << pPackedFormat->Bits[channel]) - 1;
+                float value = (float)((pixel >> pPackedFormat->Shift[channel]) & mask);
+                pOutRow[j * 4 + channel] = (pPackedFormat->Integer) ? value : (value / (float)mask);
+            }
         }
-        pOutBytes += DestinationPitch;
-        pInRow += Width * 4;
+        pInBytes += SourcePitch;
+        pOutRow += Width * 4;
     }
 }
 
-static void EncodeB8G8R8X8(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+static void EncodePacked(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
 {
+    const PackedFormat *pPackedFormat = GetPackedFormat(DestinationFormat);
+    DebugAssert(pPackedFormat != nullptr);
+
     byte *pOutBytes = (byte *)pOutPixels;
     const float *pInRow = pInPixels;
-    uint32 i, j;
 
-    for (i = 0; i < Height; i++)
+    for (uint32 i = 0; i < Height; i++)
     {
-        for (j = 0; j < Width; j++)
+        for (uint32 j = 0; j < Width; j++)
         {
-            pOutBytes[j * 4 + 2] = (byte)(pInRow[j * 4 + 0] * 255.0f);
-            pOutBytes[j * 4 + 1] = (byte)(pInRow[j * 4 + 1] * 255.0f);
-            pOutBytes[j * 4 + 0] = (byte)(pInRow[j * 4 + 2] * 255.0f);
-            pOutBytes[j * 4 + 3] = 0;
+            uint32 pixel = 0;
+            for (uint32 channel = 0; channel < 4; channel++)
+            {
+                if (pPackedFormat->Bits[channel] == 0)
+                    continue;
+
+                uint32 mask = (1u << pPackedFormat->Bits[channel]) - 1;
+                float value = pInRow[j * 4 + channel];
+                if (!pPackedFormat->Integer)
+                    value *= (float)mask;
+
+                value = (value == value) ? Min(Max(value, 0.0f), (float)mask) : 0.0f;
+                pixel |= (uint32)RoundToNearestEven(value) << pPackedFormat->Shift[channel];
+            }
+
+            Y_memcpy(&pOutBytes[j * pPackedFormat->BytesPerPixel], &pixel, pPackedFormat->BytesPerPixel);
         }
         pOutBytes += DestinationPitch;
         pInRow += Width * 4;
     }
 }
 
-static void EncodeR8(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+//------------------------------------------------------------------ Packed floats -------------------------------------------------------------------------------------------------------
+
+// unsigned float with a 5-bit exponent and no sign bit, as used by R11G11B10_FLOAT
+static uint32 FloatToUnsignedSmallFloat(float value, uint32 mantissaBits)
 {
-    byte *pOutBytes = (byte *)pOutPixels;
-    const float *pInRow = pInPixels;
-    uint32 i, j;
+    const uint32 mantissaMask = (1u << mantissaBits) - 1;
+    const uint32 infinity = 0x1Fu << mantissaBits;
+    const uint32 maxFinite = (0x1Eu << mantissaBits) | mantissaMask;
+    const uint32 shift = 23 - mantissaBits;
+
+    uint32 bits = FloatAsUInt32(value);
+    if ((bits & 0x7FFFFFFF) > 0x7F800000)
+        return infinity | (1u << (mantissaBits - 1));
+    if (bits & 0x80000000)
+        return 0;
+    if (bits == 0x7F800000)
+        return infinity;
+
+    // values too large for the format clamp to the largest finite value rather than becoming infinity
+    if (bits >= ((uint32)(15 + 127) << 23) + (mantissaMask << shift))
+        return maxFinite;
+
+    // below the smallest normal 2^-14, the adder does the rounding
+    if (bits < ((uint32)(127 - 14) << 23))
+        return (uint32)RoundToNearestEven(value * ldexpf(1.0f, 14 + mantissaBits));
+
+    // rebias the exponent and round the mantissa to nearest even
+    uint32 rebiased = bits - ((uint32)(127 - 15) << 23);
+    return (rebiased + ((1u << (shift - 1)) - 1) + ((rebiased >> shift) & 1)) >> shift;
+}
 
-    for (i = 0; i < Height; i++)
-    {
-        for (j = 0; j < Width; j++)
-        {
-            pOutBytes[j] = (byte)(pInRow[j * 4 + 0] * 255.0f);
-        }
-        pOutBytes += DestinationPitch;
-        pInRow += Width * 4;
-    }
+static float UnsignedSmallFloatToFloat(uint32 value, uint32 mantissaBits)
+{
+    uint32 exponent = value >> mantissaBits;
+    uint32 mantissa = value & ((1u << mantissaBits) - 1);
+    if (exponent == 0x1F)
+        return (mantissa != 0) ? NAN : INFINITY;
+    if (exponent == 0)
+        return ldexpf((float)mantissa, -14 - (int32)mantissaBits);
+
+    return ldexpf((float)(mantissa | (1u << mantissaBits)), (int32)exponent - 15 - (int32)mantissaBits);
 }
 
-static void EncodeR32G32B32A32F(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+static void DecodeR11G11B10F(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
 {
-    byte *pOutBytes = (byte *)pOutPixels;
-    const float *pInRow = pInPixels;
-    uint32 i, j;
+    const byte *pInBytes = (const byte *)pInPixels;
+    float *pOutRow = pOutPixels;
 
-    for (i = 0; i < Height; i++)
+    for (uint32 i = 0; i < Height; i++)
     {
-        for (j = 0; j < Width; j++)
+        for (uint32 j = 0; j < Width; j++)
         {
-            *(float *)(&pOutBytes[j * 16 + 0]) = pInRow[j * 4 + 0];
-            *(float *)(&pOutBytes[j * 16 + 4]) = pInRow[j * 4 + 1];
-            *(float *)(&pOutBytes[j * 16 + 8]) = pInRow[j * 4 + 2];
-            *(float *)(&pOutBytes[j * 16 + 12]) = pInRow[j * 4 + 3];
+            uint32 pixel;
+            Y_memcpy(&pixel, &pInBytes[j * 4], sizeof(pixel));
+            pOutRow[j * 4 + 0] = UnsignedSmallFloatToFloat(pixel & 0x7FF, 6);
+            pOutRow[j * 4 + 1] = UnsignedSmallFloatToFloat((pixel >> 11) & 0x7FF, 6);
+            pOutRow[j * 4 + 2] = UnsignedSmallFloatToFloat(pixel >> 22, 5);
+            pOutRow[j * 4 + 3] = 1.0f;
         }
-        pOutBytes += DestinationPitch;
-        pInRow += Width * 4;
+        pInBytes += SourcePitch;
+        pOutRow += Width * 4;
     }
 }
 
-static void EncodeR16G16B16A16F(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+static void EncodeR11G11B10F(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
 {
     byte *pOutBytes = (byte *)pOutPixels;
     const float *pInRow = pInPixels;
-    uint32 i, j;
 
-    for (i = 0; i < Height; i++)
+    for (uint32 i = 0; i < Height; i++)
     {
-        for (j = 0; j < Width; j++)
+        for (uint32 j = 0; j < Width; j++)
         {
-            *(uint16 *)(&pOutBytes[j * 8 + 0]) = Math::FloatToHalf(pInRow[j * 4 + 0]);
-            *(uint16 *)(&pOutBytes[j * 8 + 2]) = Math::FloatToHalf(pInRow[j * 4 + 1]);
-            *(uint16 *)(&pOutBytes[j * 8 + 4]) = Math::FloatToHalf(pInRow[j * 4 + 2]);
-            *(uint16 *)(&pOutBytes[j * 8 + 6]) = Math::FloatToHalf(pInRow[j * 4 + 3]);
+            uint32 pixel = FloatToUnsignedSmallFloat(pInRow[j * 4 + 0], 6) |
+                           (FloatToUnsignedSmallFloat(pInRow[j * 4 + 1], 6) << 11) |
+                           (FloatToUnsignedSmallFloat(pInRow[j * 4 + 2], 5) << 22);
+
+            Y_memcpy(&pOutBytes[j * 4], &pixel, sizeof(pixel));
         }
         pOutBytes += DestinationPitch;
         pInRow += Width * 4;
     }
 }
 
-static void EncodeR32F(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+static void DecodeR9G9B9E5(const void *pInPixels, float *pOutPixels, uint32 Width, uint32 Height, uint32 SourcePitch, PIXEL_FORMAT SourceFormat)
 {
-    byte *pOutBytes = (byte *)pOutPixels;
-    const float *pInRow = pInPixels;
-    uint32 i, j;
+    const byte *pInBytes = (const byte *)pInPixels;
+    float *pOutRow = pOutPixels;
 
-    for (i = 0; i < Height; i++)
+    for (uint32 i = 0; i < Height; i++)
     {
-        for (j = 0; j < Width; j++)
+        for (uint32 j = 0; j < Width; j++)
         {
-            *(float *)(&pOutBytes[j * 4]) = pInRow[j * 4 + 0];
+            uint32 pixel;
+            Y_memcpy(&pixel, &pInBytes[j * 4], sizeof(pixel));
+
+            // mantissas have no implicit leading one, exponent bias is 15
+            float scale = ldexpf(1.0f, (int32)(pixel >> 27) - 15 - 9);
+            pOutRow[j * 4 + 0] = (float)(pixel & 0x1FF) * scale;
+            pOutRow[j * 4 + 1] = (float)((pixel >> 9) & 0x1FF) * scale;
+            pOutRow[j * 4 + 2] = (float)((pixel >> 18) & 0x1FF) * scale;
+            pOutRow[j * 4 + 3] = 1.0f;
         }
-        pOutBytes += DestinationPitch;
-        pInRow += Width * 4;
+        pInBytes += SourcePitch;
+        pOutRow += Width * 4;
     }
 }
 
-static void EncodeR16F(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+static void EncodeR9G9B9E5(const float *pInPixels, void *pOutPixels, uint32 Width, uint32 Height, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
 {
+    // (511 / 512) * 2^16, the largest representable value
+    const float maxValue = 65408.0f;
+
     byte *pOutBytes = (byte *)pOutPixels;
     const float *pInRow = pInPixels;
-    uint32 i, j;
 
-    for (i = 0; i < Height; i++)
+    for (uint32 i = 0; i < Height; i++)
     {
-        for (j = 0; j < Width; j++)
+        for (uint32 j = 0; j < Width; j++)
         {
-            *(uint16 *)(&pOutBytes[j * 2]) = Math::FloatToHalf(pInRow[j * 4 + 0]);
+            float rgb[3];
+            for (uint32 k = 0; k < 3; k++)
+            {
+                float value = pInRow[j * 4 + k];
+                rgb[k] = (value > 0.0f) ? Min(value, maxValue) : 0.0f;
+            }
+
+            // floor(log2(max)) straight from the float exponent, tiny values use the smallest shared exponent
+            float maxChannel = Max(rgb[0], Max(rgb[1], rgb[2]));
+            int32 exponent = Max(-16, (int32)((FloatAsUInt32(maxChannel) >> 23) & 0xFF) - 127) + 1 + 15;
+            float scale = ldexpf(1.0f, exponent - 15 - 9);
+
+            // rounding the largest channel up can overflow the mantissa, in which case use the next exponent
+            if ((uint32)floorf(maxChannel / scale + 0.5f) == 512)
+            {
+                exponent++;
+                scale *= 2.0f;
+            }
+
+            uint32 pixel = (uint32)floorf(rgb[0] / scale + 0.5f) |
+                           ((uint32)floorf(rgb[1] / scale + 0.5f) << 9) |
+                           ((uint32)floorf(rgb[2] / scale + 0.5f) << 18) |
+                           ((uint32)exponent << 27);
+
+            Y_memcpy(&pOutBytes[j * 4], &pixel, sizeof(pixel));
         }
         pOutBytes += DestinationPitch;
         pInRow += Width * 4;
     }
 }
 
-// static void EncodeGetPixelRGBA8(const float *pInPixels, uint32 Width, uint32 Height, uint32 x, uint32 y, uint32 *Out)
-// {
-//     byte *pByteOut = (byte *)Out;
-//     if (x >= Width || y >= Height)
-//     {
-//         pByteOut[0] = 0;
-//         pByteOut[1] = 0;
-//         pByteOut[2] = 0;
-//         pByteOut[3] = 255;
-//     }
-//     else
-//     {
-//         const float *pPixel = &pInPixels[y * Width + x];
-//         pByteOut[0] = (byte)(pPixel[0] * 255.0f);
-//         pByteOut[1] = (byte)(pPixel[1] * 255.0f);
-//         pByteOut[2] = (byte)(pPixel[2] * 255.0f);
-//         pByteOut[3] = (byte)(pPixel[3] * 255.0f);
-//     }
-// }
-
 #ifdef HAVE_SQUISH
 
 #include <squish.h>
@@ -479,8 +692,8 @@ static void EncodeBC123(const float *pInPixels, void *pOutPixels, uint32 Width,
     //static const uint32 *ZeroPixel = { 0, 0, 0, 0xFF };
 
     const PIXEL_FORMAT_INFO *pFormatInfo = PixelFormat_GetPixelFormatInfo(DestinationFormat);
-    uint32 BlocksWide = Max((uint32)1, Width / pFormatInfo->BlockSize);
-    uint32 BlocksHigh = Max((uint32)1, Height / pFormatInfo->BlockSize);
+    uint32 BlocksWide = PixelFormat_CalculateBlockCount(Width, pFormatInfo->BlockSize);
+    uint32 BlocksHigh = PixelFormat_CalculateBlockCount(Height, pFormatInfo->BlockSize);
     byte *pOutBytes = (byte *)pOutPixels;
 
     uint32 BlockIn[16];
@@ -536,8 +749,8 @@ static void DecodeBC123(const void *pInPixels, float *pOutPixels, uint32 width,
 {
     const PIXEL_FORMAT_INFO *pFormatInfo = PixelFormat_GetPixelFormatInfo(sourceFormat);
     uint32 blockSize = pFormatInfo->BlockSize;
-    uint32 blocksWide = Max((uint32)1, width / blockSize);
-    uint32 blocksHigh = Max((uint32)1, height / blockSize);
+    uint32 blocksWide = PixelFormat_CalculateBlockCount(width, blockSize);
+    uint32 blocksHigh = PixelFormat_CalculateBlockCount(height, blockSize);
 
     uint32 flags = 0;
     if (sourceFormat == PIXEL_FORMAT_BC1_UNORM)
@@ -605,16 +818,58 @@ struct PixelFormatEncodeDecode
 
 static const PixelFormatEncodeDecode g_PixelFormatEncodeDecode[] =
 {
-    { PIXEL_FORMAT_R8G8B8A8_UNORM,          EncodeR8G8B8A8,         DecodeR8G8B8A8      },
-    { PIXEL_FORMAT_R8G8B8_UNORM,            EncodeR8G8B8,           DecodeR8G8B8        },
-    { PIXEL_FORMAT_B8G8R8A8_UNORM,          EncodeB8G8R8A8,         DecodeB8G8R8A8      },
-    { PIXEL_FORMAT_B8G8R8X8_UNORM,          EncodeB8G8R8X8,         DecodeB8G8R8X8      },
-    { PIXEL_FORMAT_B8G8R8_UNORM,            EncodeB8G8R8,           DecodeB8G8R8        },
-    { PIXEL_FORMAT_R8_UNORM,                EncodeR8,               DecodeR8            },
-    { PIXEL_FORMAT_R32G32B32A32_FLOAT,      EncodeR32G32B32A32F,    DecodeR32G32B32A32F },
-    { PIXEL_FORMAT_R16G16B16A16_FLOAT,      EncodeR16G16B16A16F,    DecodeR16G16B16A16F },
-    { PIXEL_FORMAT_R32_FLOAT,               EncodeR32F,             DecodeR32F          },
-    { PIXEL_FORMAT_R16_FLOAT,               EncodeR16F,             DecodeR16F          },
+    { PIXEL_FORMAT_R8_UINT,                 EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8_SINT,                 EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8_UNORM,                EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8_SNORM,                EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8G8_UINT,               EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8G8_SINT,               EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8G8_UNORM,              EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8G8_SNORM,              EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8G8B8A8_UINT,           EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8G8B8A8_SINT,           EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8G8B8A8_UNORM,          EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8G8B8A8_UNORM_SRGB,     EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R8G8B8A8_SNORM,          EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R9G9B9E5_SHAREDEXP,      EncodeR9G9B9E5,         DecodeR9G9B9E5      },
+    { PIXEL_FORMAT_R10G10B10A2_UINT,        EncodePacked,           DecodePacked        },
+    { PIXEL_FORMAT_R10G10B10A2_UNORM,       EncodePacked,           DecodePacked        },
+    { PIXEL_FORMAT_R11G11B10_FLOAT,         EncodeR11G11B10F,       DecodeR11G11B10F    },
+    { PIXEL_FORMAT_R16_UINT,                EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16_SINT,                EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16_UNORM,               EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16_SNORM,               EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16_FLOAT,               EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16_UINT,             EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16_SINT,             EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16_UNORM,            EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16_SNORM,            EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16_FLOAT,            EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16B16A16_UINT,       EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16B16A16_SINT,       EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16B16A16_UNORM,      EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16B16A16_SNORM,      EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R16G16B16A16_FLOAT,      EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32_UINT,                EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32_SINT,                EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32_FLOAT,               EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32G32_UINT,             EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32G32_SINT,             EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32G32_FLOAT,            EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32G32B32_UINT,          EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32G32B32_SINT,          EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32G32B32_FLOAT,         EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32G32B32A32_UINT,       EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32G32B32A32_SINT,       EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_R32G32B32A32_FLOAT,      EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_B8G8R8A8_UNORM,          EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_B8G8R8A8_UNORM_SRGB,     EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_B8G8R8X8_UNORM,          EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_B8G8R8X8_UNORM_SRGB,     EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_B5G6R5_UNORM,            EncodePacked,           DecodePacked        },
+    { PIXEL_FORMAT_B5G5R5A1_UNORM,          EncodePacked,           DecodePacked        },
+    { PIXEL_FORMAT_R8G8B8_UNORM,            EncodeComponents,       DecodeComponents    },
+    { PIXEL_FORMAT_B8G8R8_UNORM,            EncodeComponents,       DecodeComponents    },
 #ifdef HAVE_SQUISH
     { PIXEL_FORMAT_BC1_UNORM,               EncodeBC123,            DecodeBC123         },
     { PIXEL_FORMAT_BC2_UNORM,               EncodeBC123,            DecodeBC123         },
@@ -622,33 +877,65 @@ static const PixelFormatEncodeDecode g_PixelFormatEncodeDecode[] =
 #endif
 };
 
-bool PixelFormat_ConvertPixels(uint32 Width, uint32 Height, const void *SourcePixels, uint32 SourcePitch, PIXEL_FORMAT SourceFormat, void *DestinationPixels, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat, uint32 *DestinationPixelSize)
+static const PixelFormatEncodeDecode *GetPixelFormatEncodeDecode(PIXEL_FORMAT Format)
 {
-    uint32 i;
+    for (uint32 i = 0; i < countof(g_PixelFormatEncodeDecode); i++)
+    {
+        if (g_PixelFormatEncodeDecode[i].Format == Format)
+            return &g_PixelFormatEncodeDecode[i];
+    }
 
-    DebugAssert(SourceFormat < PIXEL_FORMAT_COUNT && DestinationFormat < PIXEL_FORMAT_COUNT);
-    DebugAssert(SourceFormat != DestinationFormat);
+    return NULL;
+}
 
-    //Log_DevPrintf("PixelFormat_ConvertPixels: Converting %ux%u image from %s to %s...", Width, Height, PixelFormat_GetPixelFormatInfo(SourceFormat)->Name, PixelFormat_GetPixelFormatInfo(DestinationFormat)->Name);
+bool PixelFormat_IsConvertible(PIXEL_FORMAT Format)
+{
+    return (GetPixelFormatEncodeDecode(Format) != NULL);
+}
 
-    PixelFormatEncodeDecode::DecodeFunctionType DecodeFunction = NULL;
-    PixelFormatEncodeDecode::EncodeFunctionType EncodeFunction = NULL;
+bool PixelFormat_DecodePixels(uint32 Width, uint32 Height, const void *SourcePixels, uint32 SourcePitch, PIXEL_FORMAT SourceFormat, float *DestinationPixels)
+{
+    const PixelFormatEncodeDecode *pEncodeDecode = GetPixelFormatEncodeDecode(SourceFormat);
+    if (pEncodeDecode == NULL)
+    {
+        Log_ErrorPrintf("PixelFormat_DecodePixels: No Decode function for %s.", PixelFormat_GetPixelFormatInfo(SourceFormat)->Name);
+        return false;
+    }
 
-    for (i = 0; i < countof(g_PixelFormatEncodeDecode); i++)
+    pEncodeDecode->DecodeFunction(SourcePixels, DestinationPixels, Width, Height, SourcePitch, SourceFormat);
+    return true;
+}
+
+bool PixelFormat_EncodePixels(uint32 Width, uint32 Height, const float *SourcePixels, void *DestinationPixels, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat)
+{
+    const PixelFormatEncodeDecode *pEncodeDecode = GetPixelFormatEncodeDecode(DestinationFormat);
+    if (pEncodeDecode == NULL)
     {
-        if (g_PixelFormatEncodeDecode[i].Format == SourceFormat)
-            DecodeFunction = g_PixelFormatEncodeDecode[i].DecodeFunction;
-        if (g_PixelFormatEncodeDecode[i].Format == DestinationFormat)
-            EncodeFunction = g_PixelFormatEncodeDecode[i].EncodeFunction;
+        Log_ErrorPrintf("PixelFormat_EncodePixels: No Encode function for %s.", PixelFormat_GetPixelFormatInfo(DestinationFormat)->Name);
+        return false;
     }
 
-    if (DecodeFunction == NULL)
+    pEncodeDecode->EncodeFunction(SourcePixels, DestinationPixels, Width, Height, DestinationPitch, DestinationFormat);
+    return true;
+}
+
+bool PixelFormat_ConvertPixels(uint32 Width, uint32 Height, const void *SourcePixels, uint32 SourcePitch, PIXEL_FORMAT SourceFormat, void *DestinationPixels, uint32 DestinationPitch, PIXEL_FORMAT DestinationFormat, uint32 *DestinationPixelSize)
+{
+    DebugAssert(SourceFormat < PIXEL_FORMAT_COUNT && DestinationFormat < PIXEL_FORMAT_COUNT);
+    DebugAssert(SourceFormat != DestinationFormat);
+
+    //Log_DevPrintf("PixelFormat_ConvertPixels: Converting %ux%u image from %s to %s...", Width, Height, PixelFormat_GetPixelFormatInfo(SourceFormat)->Name, PixelFormat_GetPixelFormatInfo(DestinationFormat)->Name);
+
+    const PixelFormatEncodeDecode *pDecode = GetPixelFormatEncodeDecode(SourceFormat);
+    const PixelFormatEncodeDecode *pEncode = GetPixelFormatEncodeDecode(DestinationFormat);
+
+    if (pDecode == NULL)
     {
         Log_ErrorPrintf("PixelFormat_ConvertPixels: No Decode function for %s.", PixelFormat_GetPixelFormatInfo(SourceFormat)->Name);
         return false;
     }
 
-    if (EncodeFunction == NULL)
+    if (pEncode == NULL)
     {
         Log_ErrorPrintf("PixelFormat_ConvertPixels: No Encode function for %s.", PixelFormat_GetPixelFormatInfo(DestinationFormat)->Name);
         return false;
@@ -666,10 +953,10 @@ bool PixelFormat_ConvertPixels(uint32 Width, uint32 Height, const void *SourcePi
     float *pTempPixels = Y_mallocT<float>(Width * Height * 4);
 
     // decode pixels to 32f
-    DecodeFunction(SourcePixels, pTempPixels, Width, Height, SourcePitch, SourceFormat);
+    pDecode->DecodeFunction(SourcePixels, pTempPixels, Width, Height, SourcePitch, SourceFormat);
 
     // now encode them to the dest format
-    EncodeFunction(pTempPixels, DestinationPixels, Width, Height, DestinationPitch, DestinationFormat);
+    pEncode->EncodeFunction(pTempPixels, DestinationPixels, Width, Height, DestinationPitch, DestinationFormat);
 
     // log/free/return
     Y_free(pTempPixels);
@@ -0,0 +1,223 @@
+#include "YRenderLib/RenderTargetPool.h"
+#include "YBaseLib/Log.h"
+#include "YBaseLib/NumericLimits.h"
+#include "YBaseLib/StringConverter.h"
+Log_SetChannel(RenderTargetPool);
+
+RenderTargetPool::RenderTargetPool()
+    : m_pGPUDevice(nullptr)
+    , m_frameNumber(0)
+    , m_unusedFrameLimit(30)
+    , m_pooledMemory(0)
+    , m_acquiredMemory(0)
+    , m_peakPooledMemory(0)
+    , m_peakAcquiredMemory(0)
+{
+
+}
+
+RenderTargetPool::~RenderTargetPool()
+{
+    Shutdown();
+}
+
+void RenderTargetPool::Initialize(GPUDevice *pGPUDevice)
+{
+    DebugAssert(m_pGPUDevice == nullptr);
+    m_pGPUDevice = pGPUDevice;
+    m_pGPUDevice->AddRef();
+}
+
+void RenderTargetPool::Shutdown()
+{
+    if (m_pGPUDevice == nullptr)
+        return;
+
+    for (uint32 i = 0; i < m_targets.GetSize(); i++)
+    {
+        if (m_targets[i]->Acquired)
+            Log_WarningPrintf("RenderTargetPool::Shutdown: %ux%u target is still acquired", m_targets[i]->TextureDesc.Width, m_targets[i]->TextureDesc.Height);
+
+        DestroyTarget(m_targets[i]);
+    }
+    m_targets.Obliterate();
+
+    m_pGPUDevice->Release();
+    m_pGPUDevice = nullptr;
+}
+
+const TransientRenderTarget *RenderTargetPool::AcquireRenderTarget(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_RENDER_TARGET_VIEW_DESC *pViewDesc /* = nullptr */, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc /* = nullptr */)
+{
+    DebugAssert(pTextureDesc->Flags & GPU_TEXTURE_FLAG_BIND_RENDER_TARGET);
+
+    GPU_RENDER_TARGET_VIEW_DESC viewDesc(0, 0, 1, pTextureDesc->Format);
+    if (pViewDesc != nullptr)
+        viewDesc = *pViewDesc;
+
+    return FindOrCreateTarget(pTextureDesc, pSamplerStateDesc, false, &viewDesc, sizeof(viewDesc));
+}
+
+const TransientRenderTarget *RenderTargetPool::AcquireDepthStencilBuffer(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_DEPTH_STENCIL_BUFFER_VIEW_DESC *pViewDesc /* = nullptr */, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc /* = nullptr */)
+{
+    DebugAssert(pTextureDesc->Flags & GPU_TEXTURE_FLAG_BIND_DEPTH_STENCIL_BUFFER);
+
+    GPU_DEPTH_STENCIL_BUFFER_VIEW_DESC viewDesc(0, 0, 1, pTextureDesc->Format);
+    if (pViewDesc != nullptr)
+        viewDesc = *pViewDesc;
+
+    return FindOrCreateTarget(pTextureDesc, pSamplerStateDesc, true, &viewDesc, sizeof(viewDesc));
+}
+
+void RenderTargetPool::ReleaseTarget(const TransientRenderTarget *pTarget)
+{
+    PooledTarget *pPooledTarget = const_cast<PooledTarget *>(static_cast<const PooledTarget *>(pTarget));
+    DebugAssert(pPooledTarget->Acquired);
+
+    pPooledTarget->Acquired = false;
+    m_acquiredMemory -= pPooledTarget->MemoryUsage;
+}
+
+void RenderTargetPool::EndFrame()
+{
+    // drop targets that haven't been used recently, e.g. intermediates at an old resolution
+    for (uint32 i = 0; i < m_targets.GetSize(); )
+    {
+        PooledTarget *pTarget = m_targets[i];
+        if (!pTarget->Acquired && (m_frameNumber - pTarget->LastUsedFrame) >= m_unusedFrameLimit)
+        {
+            DestroyTarget(pTarget);
+            m_targets.FastRemove(i);
+            continue;
+        }
+
+        i++;
+    }
+
+    m_frameNumber++;
+}
+
+void RenderTargetPool::Purge()
+{
+    for (uint32 i = 0; i < m_targets.GetSize(); )
+    {
+        if (!m_targets[i]->Acquired)
+        {
+            DestroyTarget(m_targets[i]);
+            m_targets.FastRemove(i);
+            continue;
+        }
+
+        i++;
+    }
+}
+
+void RenderTargetPool::ResetPeaks()
+{
+    m_peakPooledMemory = m_pooledMemory;
+    m_peakAcquiredMemory = m_acquiredMemory;
+}
+
+RenderTargetPool::PooledTarget *RenderTargetPool::FindOrCreateTarget(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, bool isDepthStencil, const void *pViewDesc, uint32 viewDescSize)
+{
+    // the sampler only matters when the texture can be bound to shaders
+    GPU_SAMPLER_STATE_DESC samplerStateDesc;
+    Y_memzero(&samplerStateDesc, sizeof(samplerStateDesc));
+    if (pTextureDesc->Flags & GPU_TEXTURE_FLAG_SHADER_BINDABLE)
+    {
+        if (pSamplerStateDesc != nullptr)
+            samplerStateDesc = *pSamplerStateDesc;
+        else
+            samplerStateDesc.Set(TEXTURE_FILTER_MIN_MAG_MIP_LINEAR, TEXTURE_ADDRESS_MODE_CLAMP, TEXTURE_ADDRESS_MODE_CLAMP, TEXTURE_ADDRESS_MODE_CLAMP, FloatColor::Black, 0.0f, 0, Y_INT32_MAX, 1, GPU_COMPARISON_FUNC_NEVER);
+    }
+
+    // reuse a free target with identical descriptions
+    for (uint32 i = 0; i < m_targets.GetSize(); i++)
+    {
+        PooledTarget *pTarget = m_targets[i];
+        if (pTarget->Acquired || pTarget->IsDepthStencil != isDepthStencil)
+            continue;
+
+        const void *pTargetViewDesc = (isDepthStencil) ? (const void *)&pTarget->DepthStencilBufferViewDesc : (const void *)&pTarget->RenderTargetViewDesc;
+        if (Y_memcmp(&pTarget->TextureDesc, pTextureDesc, sizeof(GPU_TEXTURE2D_DESC)) != 0 ||
+            Y_memcmp(pTargetViewDesc, pViewDesc, viewDescSize) != 0 ||
+            Y_memcmp(&pTarget->SamplerStateDesc, &samplerStateDesc, sizeof(samplerStateDesc)) != 0)
+        {
+            continue;
+        }
+
+        AcquireTarget(pTarget);
+        return pTarget;
+    }
+
+    // create a new one
+    GPUTexture2D *pTexture = m_pGPUDevice->CreateTexture2D(pTextureDesc, (pTextureDesc->Flags & GPU_TEXTURE_FLAG_SHADER_BINDABLE) ? &samplerStateDesc : nullptr);
+    if (pTexture == nullptr)
+    {
+        Log_ErrorPrintf("RenderTargetPool: Failed to create %ux%u %s target", pTextureDesc->Width, pTextureDesc->Height, PixelFormat_GetPixelFormatName(pTextureDesc->Format));
+        return nullptr;
+    }
+
+    GPURenderTargetView *pRenderTargetView = nullptr;
+    GPUDepthStencilBufferView *pDepthStencilBufferView = nullptr;
+    if (isDepthStencil)
+        pDepthStencilBufferView = m_pGPUDevice->CreateDepthStencilBufferView(pTexture, reinterpret_cast<const GPU_DEPTH_STENCIL_BUFFER_VIEW_DESC *>(pViewDesc));
+    else
+        pRenderTargetView = m_pGPUDevice->CreateRenderTargetView(pTexture, reinterpret_cast<const GPU_RENDER_TARGET_VIEW_DESC *>(pViewDesc));
+    if (pRenderTargetView == nullptr && pDepthStencilBufferView == nullptr)
+    {
+        Log_ErrorPrintf("RenderTargetPool: Failed to create view for %ux%u %s target", pTextureDesc->Width, pTextureDesc->Height, PixelFormat_GetPixelFormatName(pTextureDesc->Format));
+        pTexture->Release();
+        return nullptr;
+    }
+
+    PooledTarget *pTarget = new PooledTarget();
+    Y_memzero(pTarget, sizeof(PooledTarget));
+    pTarget->pTexture = pTexture;
+    pTarget->pRenderTargetView = pRenderTargetView;
+    pTarget->pDepthStencilBufferView = pDepthStencilBufferView;
+    pTarget->TextureDesc = *pTextureDesc;
+    pTarget->SamplerStateDesc = samplerStateDesc;
+    if (isDepthStencil)
+        Y_memcpy(&pTarget->DepthStencilBufferViewDesc, pViewDesc, viewDescSize);
+    else
+        Y_memcpy(&pTarget->RenderTargetViewDesc, pViewDesc, viewDescSize);
+    pTarget->IsDepthStencil = isDepthStencil;
+
+    uint32 width = pTextureDesc->Width;
+    uint32 height = pTextureDesc->Height;
+    for (uint32 i = 0; i < pTextureDesc->MipLevels; i++)
+    {
+        pTarget->MemoryUsage += PixelFormat_CalculateImageSize(pTextureDesc->Format, width, height, 1);
+        width = Max(width / 2, (uint32)1);
+        height = Max(height / 2, (uint32)1);
+    }
+
+    m_targets.Add(pTarget);
+    m_pooledMemory += pTarget->MemoryUsage;
+    m_peakPooledMemory = Max(m_peakPooledMemory, m_pooledMemory);
+    Log_PerfPrintf("RenderTargetPool: Created %ux%u %s target (%s), pool is now %s", pTextureDesc->Width, pTextureDesc->Height, PixelFormat_GetPixelFormatName(pTextureDesc->Format),
+                   StringConverter::SizeToHumanReadableString(pTarget->MemoryUsage).GetCharArray(), StringConverter::SizeToHumanReadableString(m_pooledMemory).GetCharArray());
+
+    AcquireTarget(pTarget);
+    return pTarget;
+}
+
+void RenderTargetPool::AcquireTarget(PooledTarget *pTarget)
+{
+    pTarget->Acquired = true;
+    pTarget->LastUsedFrame = m_frameNumber;
+    m_acquiredMemory += pTarget->MemoryUsage;
+    m_peakAcquiredMemory = Max(m_peakAcquiredMemory, m_acquiredMemory);
+}
+
+void RenderTargetPool::DestroyTarget(PooledTarget *pTarget)
+{
+    if (pTarget->Acquired)
+        m_acquiredMemory -= pTarget->MemoryUsage;
+    m_pooledMemory -= pTarget->MemoryUsage;
+
+    SAFE_RELEASE(pTarget->pRenderTargetView);
+    SAFE_RELEASE(pTarget->pDepthStencilBufferView);
+    pTarget->pTexture->Release();
+    delete pTarget;
+}
@@ -15,6 +15,7 @@ Log_SetChannel(Renderer);
 
 #define WITH_RENDERER_D3D11
 #define WITH_RENDERER_VULKAN
+#define WITH_RENDERER_NULL
 
 //----------------------------------------------------- RenderSystem Creation Functions -----------------------------------------------------------------------------------------------
 // renderer creation functions
@@ -34,6 +35,9 @@ typedef bool(*RendererFactoryFunction)(const RendererInitializationParameters *p
 #if defined(WITH_RENDERER_VULKAN)
     extern bool VulkanBackend_Create(const RendererInitializationParameters *pCreateParameters, SDL_Window *pSDLWindow, GPUDevice **ppDevice, GPUContext **ppImmediateContext, GPUOutputBuffer **ppOutputBuffer);
 #endif
+#if defined(WITH_RENDERER_NULL)
+    extern bool NullRenderBackend_Create(const RendererInitializationParameters *pCreateParameters, SDL_Window *pSDLWindow, GPUDevice **ppDevice, GPUContext **ppImmediateContext, GPUOutputBuffer **ppOutputBuffer);
+#endif
 struct RENDERER_PLATFORM_FACTORY_FUNCTION
 {
     RENDERER_PLATFORM Platform;
@@ -58,6 +62,9 @@ static const RENDERER_PLATFORM_FACTORY_FUNCTION s_renderSystemDeclarations[] =
 #if defined(WITH_RENDERER_VULKAN)
     { RENDERER_PLATFORM_VULKAN,     VulkanBackend_Create,           true    },
 #endif
+#if defined(WITH_RENDERER_NULL)
+    { RENDERER_PLATFORM_NULL,       NullRenderBackend_Create,       false   },
+#endif
 };
 
 //----------------------------------------------------- Output Window Class ----------------------------------------------------------------------------------------------------------
@@ -374,9 +381,12 @@ RendererCounters::RendererCounters()
     , m_shaderChangeCounter(0)
     , m_pipelineChangeCounter(0)
     , m_framesDroppedCounter(0)
+    , m_totalGPUMemoryUsage(0)
+    , m_totalGPUMemoryPeak(0)
 {
     Y_memzero((void *)m_resourceCPUMemoryUsage, sizeof(m_resourceCPUMemoryUsage));
     Y_memzero((void *)m_resourceGPUMemoryUsage, sizeof(m_resourceGPUMemoryUsage));
+    Y_memzero(m_resourceGPUMemoryPeak, sizeof(m_resourceGPUMemoryPeak));
 }
 
 RendererCounters::~RendererCounters()
@@ -398,6 +408,15 @@ void RendererCounters::OnResourceCreated(const GPUResource *pResource)
     pResource->GetMemoryUsage(&cpuMemoryUsage, &gpuMemoryUsage);
     Y_AtomicAdd(m_resourceCPUMemoryUsage[type], (ptrdiff_t)cpuMemoryUsage);
     Y_AtomicAdd(m_resourceGPUMemoryUsage[type], (ptrdiff_t)gpuMemoryUsage);
+    Y_AtomicAdd(m_totalGPUMemoryUsage, (ptrdiff_t)gpuMemoryUsage);
+
+    // high-water marks
+    ptrdiff_t typeUsage = m_resourceGPUMemoryUsage[type];
+    if (typeUsage > m_resourceGPUMemoryPeak[type])
+        m_resourceGPUMemoryPeak[type] = typeUsage;
+    ptrdiff_t totalUsage = m_totalGPUMemoryUsage;
+    if (totalUsage > m_totalGPUMemoryPeak)
+        m_totalGPUMemoryPeak = totalUsage;
 }
 
 void RendererCounters::OnResourceDeleted(const GPUResource *pResource)
@@ -407,6 +426,29 @@ void RendererCounters::OnResourceDeleted(const GPUResource *pResource)
     pResource->GetMemoryUsage(&cpuMemoryUsage, &gpuMemoryUsage);
     Y_AtomicAdd(m_resourceCPUMemoryUsage[type], -(ptrdiff_t)cpuMemoryUsage);
     Y_AtomicAdd(m_resourceGPUMemoryUsage[type], -(ptrdiff_t)gpuMemoryUsage);
+    Y_AtomicAdd(m_totalGPUMemoryUsage, -(ptrdiff_t)gpuMemoryUsage);
+}
+
+ptrdiff_t RendererCounters::GetTotalCPUMemoryUsage() const
+{
+    ptrdiff_t total = 0;
+    for (uint32 i = 0; i < GPU_RESOURCE_TYPE_COUNT; i++)
+        total += m_resourceCPUMemoryUsage[i];
+
+    return total;
+}
+
+ptrdiff_t RendererCounters::GetTotalGPUMemoryUsage() const
+{
+    return m_totalGPUMemoryUsage;
+}
+
+void RendererCounters::ResetMemoryPeaks()
+{
+    for (uint32 i = 0; i < GPU_RESOURCE_TYPE_COUNT; i++)
+        m_resourceGPUMemoryPeak[i] = m_resourceGPUMemoryUsage[i];
+
+    m_totalGPUMemoryPeak = m_totalGPUMemoryUsage;
 }
 
 void RENDERER_RASTERIZER_STATE_DESC::SetDefault()
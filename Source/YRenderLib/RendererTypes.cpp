@@ -392,8 +392,83 @@ Y_Define_NameTable(NameTables::GPUVertexElementType)
     Y_NameTable_Entry("uint3",              GPU_VERTEX_ELEMENT_TYPE_UINT3)
     Y_NameTable_Entry("uint4",              GPU_VERTEX_ELEMENT_TYPE_UINT4)
     Y_NameTable_Entry("color",              GPU_VERTEX_ELEMENT_TYPE_UNORM4)
+    Y_NameTable_Entry("snorm16x2",          GPU_VERTEX_ELEMENT_TYPE_SNORM16_2)
+    Y_NameTable_Entry("snorm16x4",          GPU_VERTEX_ELEMENT_TYPE_SNORM16_4)
+    Y_NameTable_Entry("unorm10_10_10_2",    GPU_VERTEX_ELEMENT_TYPE_UNORM10_10_10_2)
 Y_NameTable_End()
 
+uint32 GPUVertexElementTypeSize(GPU_VERTEX_ELEMENT_TYPE Type)
+{
+    static const uint32 Sizes[GPU_VERTEX_ELEMENT_TYPE_COUNT] =
+    {
+        1,      // GPU_VERTEX_ELEMENT_TYPE_BYTE
+        2,      // GPU_VERTEX_ELEMENT_TYPE_BYTE2
+        4,      // GPU_VERTEX_ELEMENT_TYPE_BYTE4
+        1,      // GPU_VERTEX_ELEMENT_TYPE_UBYTE
+        2,      // GPU_VERTEX_ELEMENT_TYPE_UBYTE2
+        4,      // GPU_VERTEX_ELEMENT_TYPE_UBYTE4
+        2,      // GPU_VERTEX_ELEMENT_TYPE_HALF
+        4,      // GPU_VERTEX_ELEMENT_TYPE_HALF2
+        8,      // GPU_VERTEX_ELEMENT_TYPE_HALF4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_FLOAT
+        8,      // GPU_VERTEX_ELEMENT_TYPE_FLOAT2
+        12,     // GPU_VERTEX_ELEMENT_TYPE_FLOAT3
+        16,     // GPU_VERTEX_ELEMENT_TYPE_FLOAT4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_INT
+        8,      // GPU_VERTEX_ELEMENT_TYPE_INT2
+        12,     // GPU_VERTEX_ELEMENT_TYPE_INT3
+        16,     // GPU_VERTEX_ELEMENT_TYPE_INT4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_UINT
+        8,      // GPU_VERTEX_ELEMENT_TYPE_UINT2
+        12,     // GPU_VERTEX_ELEMENT_TYPE_UINT3
+        16,     // GPU_VERTEX_ELEMENT_TYPE_UINT4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_SNORM4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_UNORM4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_SNORM16_2
+        8,      // GPU_VERTEX_ELEMENT_TYPE_SNORM16_4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_UNORM10_10_10_2
+    };
+
+    DebugAssert(Type < GPU_VERTEX_ELEMENT_TYPE_COUNT);
+    return Sizes[Type];
+}
+
+uint32 GPUVertexElementTypeComponentCount(GPU_VERTEX_ELEMENT_TYPE Type)
+{
+    static const uint32 ComponentCounts[GPU_VERTEX_ELEMENT_TYPE_COUNT] =
+    {
+        1,      // GPU_VERTEX_ELEMENT_TYPE_BYTE
+        2,      // GPU_VERTEX_ELEMENT_TYPE_BYTE2
+        4,      // GPU_VERTEX_ELEMENT_TYPE_BYTE4
+        1,      // GPU_VERTEX_ELEMENT_TYPE_UBYTE
+        2,      // GPU_VERTEX_ELEMENT_TYPE_UBYTE2
+        4,      // GPU_VERTEX_ELEMENT_TYPE_UBYTE4
+        1,      // GPU_VERTEX_ELEMENT_TYPE_HALF
+        2,      // GPU_VERTEX_ELEMENT_TYPE_HALF2
+        4,      // GPU_VERTEX_ELEMENT_TYPE_HALF4
+        1,      // GPU_VERTEX_ELEMENT_TYPE_FLOAT
+        2,      // GPU_VERTEX_ELEMENT_TYPE_FLOAT2
+        3,      // GPU_VERTEX_ELEMENT_TYPE_FLOAT3
+        4,      // GPU_VERTEX_ELEMENT_TYPE_FLOAT4
+        1,      // GPU_VERTEX_ELEMENT_TYPE_INT
+        2,      // GPU_VERTEX_ELEMENT_TYPE_INT2
+        3,      // GPU_VERTEX_ELEMENT_TYPE_INT3
+        4,      // GPU_VERTEX_ELEMENT_TYPE_INT4
+        1,      // GPU_VERTEX_ELEMENT_TYPE_UINT
+        2,      // GPU_VERTEX_ELEMENT_TYPE_UINT2
+        3,      // GPU_VERTEX_ELEMENT_TYPE_UINT3
+        4,      // GPU_VERTEX_ELEMENT_TYPE_UINT4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_SNORM4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_UNORM4
+        2,      // GPU_VERTEX_ELEMENT_TYPE_SNORM16_2
+        4,      // GPU_VERTEX_ELEMENT_TYPE_SNORM16_4
+        4,      // GPU_VERTEX_ELEMENT_TYPE_UNORM10_10_10_2
+    };
+
+    DebugAssert(Type < GPU_VERTEX_ELEMENT_TYPE_COUNT);
+    return ComponentCounts[Type];
+}
+
 Y_Define_NameTable(NameTables::GPUVertexElementSemantic)
     Y_NameTable_Entry("POSITION",           GPU_VERTEX_ELEMENT_SEMANTIC_POSITION)
     Y_NameTable_Entry("TEXCOORD",           GPU_VERTEX_ELEMENT_SEMANTIC_TEXCOORD)
@@ -418,6 +493,7 @@ Y_Define_NameTable(NameTables::RendererPlatform)
     Y_NameTable_Entry("D3D12",                  RENDERER_PLATFORM_D3D12)
     Y_NameTable_Entry("OPENGL",                 RENDERER_PLATFORM_OPENGL)
     Y_NameTable_Entry("OPENGLES2",              RENDERER_PLATFORM_OPENGLES2)
+    Y_NameTable_Entry("NULL",                   RENDERER_PLATFORM_NULL)
 Y_NameTable_End()
 
 Y_Define_NameTable(NameTables::RendererPlatformFullName)
@@ -425,6 +501,7 @@ Y_Define_NameTable(NameTables::RendererPlatformFullName)
     Y_NameTable_Entry("Direct3D 12",            RENDERER_PLATFORM_D3D12)
     Y_NameTable_Entry("OpenGL",                 RENDERER_PLATFORM_OPENGL)
     Y_NameTable_Entry("OpenGL ES 2",            RENDERER_PLATFORM_OPENGLES2)
+    Y_NameTable_Entry("Null",                   RENDERER_PLATFORM_NULL)
 Y_NameTable_End()
 
 Y_Define_NameTable(NameTables::RendererFeatureLevel)
@@ -0,0 +1,474 @@
+#include "YRenderLib/TextureAtlas.h"
+#include "YRenderLib/ImageResampler.h"
+#include "YBaseLib/Memory.h"
+#include "YBaseLib/Log.h"
+#include <algorithm>
+Log_SetChannel(TextureAtlas);
+
+static const uint32 INVALID_ENTRY_INDEX = 0xFFFFFFFF;
+
+// largest image grid a mipLevels of 0 picks, 16 pixels is 5 levels
+static const uint32 AUTO_MIP_MAX_ALIGNMENT = 16;
+
+//------------------------------------------------------------------ TextureAtlasPacker ---------------------------------------------------------------------------------------------
+
+TextureAtlasPacker::TextureAtlasPacker()
+    : m_width(0),
+      m_height(0),
+      m_usedArea(0)
+{
+
+}
+
+TextureAtlasPacker::TextureAtlasPacker(uint32 width, uint32 height)
+{
+    Reset(width, height);
+}
+
+TextureAtlasPacker::~TextureAtlasPacker()
+{
+
+}
+
+void TextureAtlasPacker::Reset(uint32 width, uint32 height)
+{
+    m_width = width;
+    m_height = height;
+    m_usedArea = 0;
+
+    Rect pageRect = { 0, 0, width, height };
+    m_freeRects.Clear();
+    m_freeRects.Add(pageRect);
+}
+
+bool TextureAtlasPacker::Insert(uint32 width, uint32 height, uint32 *pX, uint32 *pY)
+{
+    if (width == 0 || height == 0)
+    {
+        *pX = *pY = 0;
+        return true;
+    }
+
+    // best short side fit, ties broken by the long side
+    uint32 bestIndex = m_freeRects.GetSize();
+    uint32 bestShortSide = 0xFFFFFFFF;
+    uint32 bestLongSide = 0xFFFFFFFF;
+    for (uint32 i = 0; i < m_freeRects.GetSize(); i++)
+    {
+        const Rect &freeRect = m_freeRects[i];
+        if (freeRect.Width < width || freeRect.Height < height)
+            continue;
+
+        uint32 leftoverWidth = freeRect.Width - width;
+        uint32 leftoverHeight = freeRect.Height - height;
+        uint32 shortSide = Min(leftoverWidth, leftoverHeight);
+        uint32 longSide = Max(leftoverWidth, leftoverHeight);
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+        {
+            bestIndex = i;
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+        }
+    }
+
+    if (bestIndex == m_freeRects.GetSize())
+        return false;
+
+    Rect usedRect = { m_freeRects[bestIndex].X, m_freeRects[bestIndex].Y, width, height };
+    SplitFreeRects(usedRect);
+    PruneFreeRects();
+
+    m_usedArea += (uint64)width * (uint64)height;
+    *pX = usedRect.X;
+    *pY = usedRect.Y;
+    return true;
+}
+
+void TextureAtlasPacker::SplitFreeRects(const Rect &usedRect)
+{
+    // rectangles overlapping the used area are replaced by the up to four maximal pieces left around it
+    uint32 originalCount = m_freeRects.GetSize();
+    for (uint32 i = 0; i < originalCount; i++)
+    {
+        Rect freeRect = m_freeRects[i];
+        if (usedRect.X >= (freeRect.X + freeRect.Width) || (usedRect.X + usedRect.Width) <= freeRect.X ||
+            usedRect.Y >= (freeRect.Y + freeRect.Height) || (usedRect.Y + usedRect.Height) <= freeRect.Y)
+        {
+            continue;
+        }
+
+        if (usedRect.X > freeRect.X)
+        {
+            Rect piece = { freeRect.X, freeRect.Y, usedRect.X - freeRect.X, freeRect.Height };
+            m_freeRects.Add(piece);
+        }
+        if ((usedRect.X + usedRect.Width) < (freeRect.X + freeRect.Width))
+        {
+            Rect piece = { usedRect.X + usedRect.Width, freeRect.Y, (freeRect.X + freeRect.Width) - (usedRect.X + usedRect.Width), freeRect.Height };
+            m_freeRects.Add(piece);
+        }
+        if (usedRect.Y > freeRect.Y)
+        {
+            Rect piece = { freeRect.X, freeRect.Y, freeRect.Width, usedRect.Y - freeRect.Y };
+            m_freeRects.Add(piece);
+        }
+        if ((usedRect.Y + usedRect.Height) < (freeRect.Y + freeRect.Height))
+        {
+            Rect piece = { freeRect.X, usedRect.Y + usedRect.Height, freeRect.Width, (freeRect.Y + freeRect.Height) - (usedRect.Y + usedRect.Height) };
+            m_freeRects.Add(piece);
+        }
+
+        // marked for removal by PruneFreeRects
+        m_freeRects[i].Width = 0;
+    }
+}
+
+void TextureAtlasPacker::PruneFreeRects()
+{
+    // drop the split rectangles, and any rectangle entirely inside another
+    uint32 count = m_freeRects.GetSize();
+    for (uint32 i = 0; i < count; i++)
+    {
+        const Rect &inner = m_freeRects[i];
+        if (inner.Width == 0)
+            continue;
+
+        for (uint32 j = 0; j < count; j++)
+        {
+            const Rect &outer = m_freeRects[j];
+            if (i == j || outer.Width == 0)
+                continue;
+
+            if (inner.X >= outer.X && inner.Y >= outer.Y && (inner.X + inner.Width) <= (outer.X + outer.Width) && (inner.Y + inner.Height) <= (outer.Y + outer.Height))
+            {
+                m_freeRects[i].Width = 0;
+                break;
+            }
+        }
+    }
+
+    uint32 keptCount = 0;
+    for (uint32 i = 0; i < count; i++)
+    {
+        if (m_freeRects[i].Width != 0)
+            m_freeRects[keptCount++] = m_freeRects[i];
+    }
+    m_freeRects.Resize(keptCount);
+}
+
+//------------------------------------------------------------------ TextureAtlasBuilder --------------------------------------------------------------------------------------------
+
+TextureAtlasBuilder::TextureAtlasBuilder()
+    : m_format(PIXEL_FORMAT_UNKNOWN),
+      m_bytesPerPixel(0),
+      m_pageWidth(0),
+      m_pageHeight(0),
+      m_mipLevels(0),
+      m_padding(0),
+      m_alignment(1),
+      m_maxPages(0),
+      m_pageCount(0),
+      m_pPageMemory(nullptr)
+{
+
+}
+
+TextureAtlasBuilder::~TextureAtlasBuilder()
+{
+    FreePages();
+}
+
+bool TextureAtlasBuilder::Initialize(PIXEL_FORMAT format, uint32 pageWidth, uint32 pageHeight, uint32 mipLevels /* = 1 */, uint32 padding /* = 2 */, uint32 maxPages /* = 1 */)
+{
+    const PIXEL_FORMAT_INFO *pFormatInfo = PixelFormat_GetPixelFormatInfo(format);
+    if (pFormatInfo->IsBlockCompressed || pFormatInfo->BitsPerPixel == 0 || (pFormatInfo->BitsPerPixel % 8) != 0)
+    {
+        Log_ErrorPrintf("TextureAtlasBuilder::Initialize: Unsupported atlas format %s", pFormatInfo->Name);
+        return false;
+    }
+
+    uint32 fullChainLength = 1;
+    while ((Max(pageWidth, pageHeight) >> fullChainLength) > 0 && fullChainLength < TEXTURE_MAX_MIPMAP_COUNT)
+        fullChainLength++;
+
+    // The full chain would align every image to the page size, so the automatic chain stops at a grid of
+    // AUTO_MIP_MAX_ALIGNMENT pixels, or earlier if the page size isn't a multiple of the next step.
+    if (mipLevels == 0)
+    {
+        mipLevels = 1;
+        while (mipLevels < fullChainLength && (1u << mipLevels) <= AUTO_MIP_MAX_ALIGNMENT &&
+               (pageWidth % (1u << mipLevels)) == 0 && (pageHeight % (1u << mipLevels)) == 0)
+        {
+            mipLevels++;
+        }
+    }
+
+    mipLevels = Min(mipLevels, fullChainLength);
+    uint32 alignment = 1 << (mipLevels - 1);
+    if (pageWidth == 0 || pageHeight == 0 || maxPages == 0 || (pageWidth % alignment) != 0 || (pageHeight % alignment) != 0)
+    {
+        Log_ErrorPrintf("TextureAtlasBuilder::Initialize: %ux%u pages with %u mip levels must be a multiple of %u pixels", pageWidth, pageHeight, mipLevels, alignment);
+        return false;
+    }
+
+    FreePages();
+    m_imageData.Clear();
+    m_images.Clear();
+    m_entries.Clear();
+
+    m_format = format;
+    m_bytesPerPixel = pFormatInfo->BitsPerPixel / 8;
+    m_pageWidth = pageWidth;
+    m_pageHeight = pageHeight;
+    m_mipLevels = mipLevels;
+    m_padding = padding;
+    m_alignment = alignment;
+    m_maxPages = maxPages;
+    return true;
+}
+
+uint32 TextureAtlasBuilder::AddImage(const void *pPixels, uint32 width, uint32 height, uint32 pitch, PIXEL_FORMAT format)
+{
+    uint32 cellWidth = ((width + m_padding * 2 + m_alignment - 1) / m_alignment) * m_alignment;
+    uint32 cellHeight = ((height + m_padding * 2 + m_alignment - 1) / m_alignment) * m_alignment;
+    if (width == 0 || height == 0 || cellWidth > m_pageWidth || cellHeight > m_pageHeight)
+    {
+        Log_ErrorPrintf("TextureAtlasBuilder::AddImage: A %ux%u image can't fit in a %ux%u page", width, height, m_pageWidth, m_pageHeight);
+        return INVALID_ENTRY_INDEX;
+    }
+
+    // converted to the atlas format up front, so Build only copies rows
+    QueuedImage image;
+    image.DataOffset = m_imageData.GetSize();
+    image.Width = width;
+    image.Height = height;
+
+    uint32 rowSize = width * m_bytesPerPixel;
+    m_imageData.Resize(m_imageData.GetSize() + rowSize * height);
+    byte *pDestination = m_imageData.GetBasePointer() + image.DataOffset;
+    if (format == m_format)
+    {
+        for (uint32 y = 0; y < height; y++)
+            Y_memcpy(pDestination + y * rowSize, reinterpret_cast<const byte *>(pPixels) + y * pitch, rowSize);
+    }
+    else
+    {
+        uint32 destinationPixelSize = rowSize * height;
+        if (!PixelFormat_ConvertPixels(width, height, pPixels, pitch, format, pDestination, rowSize, m_format, &destinationPixelSize))
+        {
+            Log_ErrorPrintf("TextureAtlasBuilder::AddImage: Can't convert %s to %s", PixelFormat_GetPixelFormatName(format), PixelFormat_GetPixelFormatName(m_format));
+            m_imageData.Resize(static_cast<uint32>(image.DataOffset));
+            return INVALID_ENTRY_INDEX;
+        }
+    }
+
+    // placed by Build
+    TEXTURE_ATLAS_ENTRY entry;
+    entry.Page = 0;
+    entry.X = 0;
+    entry.Y = 0;
+    entry.Width = width;
+    entry.Height = height;
+    entry.UVScale.SetZero();
+    entry.UVOffset.SetZero();
+
+    m_images.Add(image);
+    m_entries.Add(entry);
+    return m_images.GetSize() - 1;
+}
+
+bool TextureAtlasBuilder::Build()
+{
+    FreePages();
+
+    // largest first packs noticeably tighter than insertion order
+    PODArray<uint32> order;
+    order.Resize(m_images.GetSize());
+    for (uint32 i = 0; i < order.GetSize(); i++)
+        order[i] = i;
+
+    const QueuedImage *pImages = m_images.GetBasePointer();
+    std::sort(order.GetBasePointer(), order.GetBasePointer() + order.GetSize(), [pImages](uint32 lhs, uint32 rhs)
+    {
+        uint32 lhsSide = Max(pImages[lhs].Width, pImages[lhs].Height);
+        uint32 rhsSide = Max(pImages[rhs].Width, pImages[rhs].Height);
+        if (lhsSide != rhsSide)
+            return (lhsSide > rhsSide);
+
+        return (pImages[lhs].Width * pImages[lhs].Height) > (pImages[rhs].Width * pImages[rhs].Height);
+    });
+
+    // packing is done in units of the alignment, which keeps every cell on the mip grid
+    struct Placement
+    {
+        uint32 CellX, CellY;
+        uint32 CellWidth, CellHeight;
+    };
+
+    PODArray<Placement> placements;
+    placements.Resize(m_images.GetSize());
+    TextureAtlasPacker *pPackers = new TextureAtlasPacker[m_maxPages];
+    uint32 pageCount = 0;
+    for (uint32 i = 0; i < order.GetSize(); i++)
+    {
+        uint32 imageIndex = order[i];
+        const QueuedImage &image = m_images[imageIndex];
+        uint32 gridWidth = (image.Width + m_padding * 2 + m_alignment - 1) / m_alignment;
+        uint32 gridHeight = (image.Height + m_padding * 2 + m_alignment - 1) / m_alignment;
+
+        // first page with space, opening a new one when they're all full
+        uint32 page, gridX, gridY;
+        for (page = 0; page < pageCount; page++)
+        {
+            if (pPackers[page].Insert(gridWidth, gridHeight, &gridX, &gridY))
+                break;
+        }
+        if (page == pageCount)
+        {
+            if (pageCount == m_maxPages)
+            {
+                Log_ErrorPrintf("TextureAtlasBuilder::Build: %u images don't fit in %u %ux%u pages", m_images.GetSize(), m_maxPages, m_pageWidth, m_pageHeight);
+                delete[] pPackers;
+                return false;
+            }
+
+            pPackers[pageCount++].Reset(m_pageWidth / m_alignment, m_pageHeight / m_alignment);
+            pPackers[page].Insert(gridWidth, gridHeight, &gridX, &gridY);
+        }
+
+        Placement &placement = placements[imageIndex];
+        placement.CellX = gridX * m_alignment;
+        placement.CellY = gridY * m_alignment;
+        placement.CellWidth = gridWidth * m_alignment;
+        placement.CellHeight = gridHeight * m_alignment;
+
+        TEXTURE_ATLAS_ENTRY &entry = m_entries[imageIndex];
+        entry.Page = page;
+        entry.X = placement.CellX + m_padding;
+        entry.Y = placement.CellY + m_padding;
+        entry.UVScale.Set(static_cast<float>(entry.Width) / static_cast<float>(m_pageWidth), static_cast<float>(entry.Height) / static_cast<float>(m_pageHeight));
+        entry.UVOffset.Set(static_cast<float>(entry.X) / static_cast<float>(m_pageWidth), static_cast<float>(entry.Y) / static_cast<float>(m_pageHeight));
+    }
+
+    delete[] pPackers;
+
+    // every page and level in one allocation, unused space is cleared to zero
+    m_pageCount = Max(pageCount, (uint32)1);
+    size_t totalSize = 0;
+    m_subresourceData.Resize(m_pageCount * m_mipLevels);
+    m_subresourcePitches.Resize(m_pageCount * m_mipLevels);
+    for (uint32 page = 0; page < m_pageCount; page++)
+    {
+        for (uint32 mipLevel = 0; mipLevel < m_mipLevels; mipLevel++)
+        {
+            uint32 mipWidth = Max(m_pageWidth >> mipLevel, (uint32)1);
+            uint32 mipHeight = Max(m_pageHeight >> mipLevel, (uint32)1);
+            m_subresourceData[page * m_mipLevels + mipLevel] = reinterpret_cast<const void *>(totalSize);
+            m_subresourcePitches[page * m_mipLevels + mipLevel] = mipWidth * m_bytesPerPixel;
+            totalSize += mipWidth * mipHeight * m_bytesPerPixel;
+        }
+    }
+
+    m_pPageMemory = reinterpret_cast<byte *>(Y_malloc(totalSize));
+    Y_memzero(m_pPageMemory, totalSize);
+    for (uint32 i = 0; i < m_subresourceData.GetSize(); i++)
+        m_subresourceData[i] = m_pPageMemory + reinterpret_cast<size_t>(m_subresourceData[i]);
+
+    for (uint32 i = 0; i < m_images.GetSize(); i++)
+        WriteImage(&m_images[i], &m_entries[i], placements[i].CellX, placements[i].CellY, placements[i].CellWidth, placements[i].CellHeight);
+
+    for (uint32 page = 0; page < m_pageCount; page++)
+    {
+        if (!GenerateMipLevels(page))
+        {
+            FreePages();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TextureAtlasBuilder::WriteImage(const QueuedImage *pImage, const TEXTURE_ATLAS_ENTRY *pEntry, uint32 cellX, uint32 cellY, uint32 cellWidth, uint32 cellHeight)
+{
+    byte *pPage = const_cast<byte *>(reinterpret_cast<const byte *>(GetPageData(pEntry->Page, 0)));
+    uint32 pitch = GetPagePitch(0);
+    uint32 bytesPerPixel = m_bytesPerPixel;
+    uint32 rowSize = pImage->Width * bytesPerPixel;
+    const byte *pSource = m_imageData.GetBasePointer() + pImage->DataOffset;
+
+    // image rows, with the first and last pixel bled across the cell's left and right gutters
+    for (uint32 y = 0; y < pImage->Height; y++)
+    {
+        byte *pCellRow = pPage + (pEntry->Y + y) * pitch + cellX * bytesPerPixel;
+        byte *pImageRow = pPage + (pEntry->Y + y) * pitch + pEntry->X * bytesPerPixel;
+        Y_memcpy(pImageRow, pSource + y * rowSize, rowSize);
+
+        for (byte *pGutter = pCellRow; pGutter < pImageRow; pGutter += bytesPerPixel)
+            Y_memcpy(pGutter, pImageRow, bytesPerPixel);
+
+        const byte *pLastPixel = pImageRow + rowSize - bytesPerPixel;
+        for (byte *pGutter = pImageRow + rowSize; pGutter < (pCellRow + cellWidth * bytesPerPixel); pGutter += bytesPerPixel)
+            Y_memcpy(pGutter, pLastPixel, bytesPerPixel);
+    }
+
+    // then the first and last rows, gutters included, bled up and down
+    uint32 cellRowSize = cellWidth * bytesPerPixel;
+    const byte *pFirstRow = pPage + pEntry->Y * pitch + cellX * bytesPerPixel;
+    const byte *pLastRow = pPage + (pEntry->Y + pImage->Height - 1) * pitch + cellX * bytesPerPixel;
+    for (uint32 y = cellY; y < pEntry->Y; y++)
+        Y_memcpy(pPage + y * pitch + cellX * bytesPerPixel, pFirstRow, cellRowSize);
+    for (uint32 y = pEntry->Y + pImage->Height; y < (cellY + cellHeight); y++)
+        Y_memcpy(pPage + y * pitch + cellX * bytesPerPixel, pLastRow, cellRowSize);
+}
+
+bool TextureAtlasBuilder::GenerateMipLevels(uint32 page)
+{
+    // cells are aligned to every level's texel grid, so a plain 2x2 box of the whole page never mixes images
+    for (uint32 mipLevel = 1; mipLevel < m_mipLevels; mipLevel++)
+    {
+        if (!ImageResampler::Resample(GetPageData(page, mipLevel - 1), Max(m_pageWidth >> (mipLevel - 1), (uint32)1), Max(m_pageHeight >> (mipLevel - 1), (uint32)1), GetPagePitch(mipLevel - 1), m_format,
+                                      const_cast<void *>(GetPageData(page, mipLevel)), Max(m_pageWidth >> mipLevel, (uint32)1), Max(m_pageHeight >> mipLevel, (uint32)1), GetPagePitch(mipLevel), m_format,
+                                      IMAGE_RESAMPLE_FILTER_BOX))
+        {
+            Log_ErrorPrintf("TextureAtlasBuilder::GenerateMipLevels: Can't generate mip levels for %s", PixelFormat_GetPixelFormatName(m_format));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TextureAtlasBuilder::FreePages()
+{
+    Y_free(m_pPageMemory);
+    m_pPageMemory = nullptr;
+    m_subresourceData.Clear();
+    m_subresourcePitches.Clear();
+    m_pageCount = 0;
+}
+
+GPUTexture2D *TextureAtlasBuilder::CreateTexture2D(GPUDevice *pGPUDevice, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, uint32 page, uint32 flags /* = GPU_TEXTURE_FLAG_SHADER_BINDABLE */) const
+{
+    if (page >= m_pageCount)
+    {
+        Log_ErrorPrintf("TextureAtlasBuilder::CreateTexture2D: Page %u has not been built", page);
+        return nullptr;
+    }
+
+    GPU_TEXTURE2D_DESC textureDesc(m_pageWidth, m_pageHeight, m_format, flags, m_mipLevels);
+    return pGPUDevice->CreateTexture2D(&textureDesc, pSamplerStateDesc, const_cast<const void **>(m_subresourceData.GetBasePointer() + page * m_mipLevels),
+                                       m_subresourcePitches.GetBasePointer() + page * m_mipLevels);
+}
+
+GPUTexture2DArray *TextureAtlasBuilder::CreateTexture2DArray(GPUDevice *pGPUDevice, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, uint32 flags /* = GPU_TEXTURE_FLAG_SHADER_BINDABLE */) const
+{
+    if (m_pageCount == 0)
+    {
+        Log_ErrorPrintf("TextureAtlasBuilder::CreateTexture2DArray: Atlas has not been built");
+        return nullptr;
+    }
+
+    GPU_TEXTURE2DARRAY_DESC textureDesc(m_pageWidth, m_pageHeight, m_format, flags, m_mipLevels, m_pageCount);
+    return pGPUDevice->CreateTexture2DArray(&textureDesc, pSamplerStateDesc, const_cast<const void **>(m_subresourceData.GetBasePointer()), m_subresourcePitches.GetBasePointer());
+}
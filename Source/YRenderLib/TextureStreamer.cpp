@@ -0,0 +1,588 @@
+#include "YRenderLib/TextureStreamer.h"
+#include "YBaseLib/Log.h"
+#include <algorithm>
+Log_SetChannel(TextureStreamer);
+
+// reads in flight per I/O thread, keeps the queue short enough that priorities stay current
+static const uint32 MAX_REQUESTS_PER_IO_THREAD = 4;
+static const uint32 DEFAULT_UPLOAD_BUDGET_PER_FRAME = 8 * 1024 * 1024;
+static const uint32 DEFAULT_TAIL_SIZE = 64;
+static const uint32 DEFAULT_EVICTION_DELAY = 60;
+
+// A contiguous mip range [FirstMipLevel, MipLevels) being read on an I/O thread, then uploaded to a new texture.
+struct TextureStreamingRequest
+{
+    StreamedTexture *pTexture;
+    TextureStreamingSource *pSource;
+    GPU_TEXTURE2D_DESC Desc;
+    uint32 FirstMipLevel;
+    float Priority;
+    bool Started;
+    bool Succeeded;
+
+    // filled by the I/O thread
+    byte *pData;
+    uint32 LevelOffsets[TEXTURE_MAX_MIPMAP_COUNT];
+    uint32 LevelRowPitches[TEXTURE_MAX_MIPMAP_COUNT];
+    uint32 LevelSizes[TEXTURE_MAX_MIPMAP_COUNT];
+
+    // upload progress on the render thread
+    GPUTexture2D *pNewTexture;
+    uint32 UploadedLevelCount;
+};
+
+static uint32 GetMipDimension(uint32 dimension, uint32 mipLevel)
+{
+    return Max(dimension >> mipLevel, (uint32)1);
+}
+
+static void DeleteRequest(TextureStreamingRequest *pRequest)
+{
+    SAFE_RELEASE(pRequest->pNewTexture);
+    Y_free(pRequest->pData);
+    delete pRequest;
+}
+
+// reads levels [firstMipLevel, desc.MipLevels) into one allocation, returns false on a short read
+static bool ReadMipLevels(TextureStreamingSource *pSource, const GPU_TEXTURE2D_DESC *pDesc, uint32 firstMipLevel, byte **ppData, uint32 *pLevelOffsets, uint32 *pLevelRowPitches, uint32 *pLevelSizes)
+{
+    uint32 totalSize = 0;
+    for (uint32 mipLevel = firstMipLevel; mipLevel < pDesc->MipLevels; mipLevel++)
+    {
+        uint32 width = GetMipDimension(pDesc->Width, mipLevel);
+        uint32 height = GetMipDimension(pDesc->Height, mipLevel);
+        uint32 index = mipLevel - firstMipLevel;
+        pLevelOffsets[index] = totalSize;
+        pLevelRowPitches[index] = PixelFormat_CalculateRowPitch(pDesc->Format, width);
+        pLevelSizes[index] = PixelFormat_CalculateImageSize(pDesc->Format, width, height, 1);
+        totalSize += pLevelSizes[index];
+    }
+
+    byte *pData = (byte *)Y_malloc(totalSize);
+    for (uint32 mipLevel = firstMipLevel; mipLevel < pDesc->MipLevels; mipLevel++)
+    {
+        uint32 index = mipLevel - firstMipLevel;
+        if (!pSource->ReadMipLevel(mipLevel, pData + pLevelOffsets[index], pLevelRowPitches[index], pLevelSizes[index]))
+        {
+            Y_free(pData);
+            return false;
+        }
+    }
+
+    *ppData = pData;
+    return true;
+}
+
+TextureStreamer::TextureStreamer()
+    : m_pGPUDevice(nullptr),
+      m_pGPUContext(nullptr),
+      m_memoryBudget(0),
+      m_residentMemory(0),
+      m_uploadBudgetPerFrame(DEFAULT_UPLOAD_BUDGET_PER_FRAME),
+      m_tailSize(DEFAULT_TAIL_SIZE),
+      m_evictionDelay(DEFAULT_EVICTION_DELAY),
+      m_frameNumber(0),
+      m_inFlightRequestCount(0),
+      m_shutdownThreads(false)
+{
+
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    Shutdown();
+}
+
+bool TextureStreamer::Initialize(GPUDevice *pGPUDevice, GPUContext *pGPUContext, uint64 memoryBudget, uint32 ioThreadCount /* = 2 */)
+{
+    DebugAssert(m_pGPUDevice == nullptr && ioThreadCount > 0);
+    m_pGPUDevice = AddRefAndReturn(pGPUDevice);
+    m_pGPUContext = AddRefAndReturn(pGPUContext);
+    m_memoryBudget = memoryBudget;
+    m_shutdownThreads = false;
+
+    for (uint32 i = 0; i < ioThreadCount; i++)
+        m_ioThreads.Add(new std::thread(&TextureStreamer::IOThreadMain, this));
+
+    return true;
+}
+
+void TextureStreamer::Shutdown()
+{
+    if (m_pGPUDevice == nullptr)
+        return;
+
+    // stop the I/O threads, anything they were reading ends up in the completed list
+    {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        m_shutdownThreads = true;
+    }
+    m_queueCondition.notify_all();
+    for (uint32 i = 0; i < m_ioThreads.GetSize(); i++)
+    {
+        m_ioThreads[i]->join();
+        delete m_ioThreads[i];
+    }
+    m_ioThreads.Obliterate();
+
+    for (uint32 i = 0; i < m_queuedRequests.GetSize(); i++)
+        DeleteRequest(m_queuedRequests[i]);
+    for (uint32 i = 0; i < m_completedRequests.GetSize(); i++)
+        DeleteRequest(m_completedRequests[i]);
+    for (uint32 i = 0; i < m_uploadingRequests.GetSize(); i++)
+    {
+        if (m_uploadingRequests[i]->pNewTexture != nullptr)
+            m_residentMemory -= m_uploadingRequests[i]->pTexture->GetMipChainSize(m_uploadingRequests[i]->FirstMipLevel);
+        DeleteRequest(m_uploadingRequests[i]);
+    }
+    m_queuedRequests.Obliterate();
+    m_completedRequests.Obliterate();
+    m_uploadingRequests.Obliterate();
+    m_inFlightRequestCount = 0;
+
+    for (uint32 i = 0; i < m_textures.GetSize(); i++)
+        m_textures[i]->m_pRequest = nullptr;
+    for (uint32 i = 0; i < m_destroyedTextures.GetSize(); i++)
+    {
+        m_destroyedTextures[i]->m_pRequest = nullptr;
+        FreeTexture(m_destroyedTextures[i]);
+    }
+    for (uint32 i = 0; i < m_textures.GetSize(); i++)
+        FreeTexture(m_textures[i]);
+    m_destroyedTextures.Obliterate();
+    m_textures.Obliterate();
+    m_sortedTextures.Obliterate();
+    DebugAssert(m_residentMemory == 0);
+
+    SAFE_RELEASE(m_pGPUContext);
+    SAFE_RELEASE(m_pGPUDevice);
+}
+
+StreamedTexture *TextureStreamer::CreateTexture(const GPU_TEXTURE2D_DESC *pTextureDesc, const GPU_SAMPLER_STATE_DESC *pSamplerStateDesc, TextureStreamingSource *pSource)
+{
+    if (pTextureDesc->MipLevels == 0 || pTextureDesc->MipLevels > TEXTURE_MAX_MIPMAP_COUNT)
+    {
+        Log_ErrorPrintf("TextureStreamer::CreateTexture: Invalid mip level count %u", pTextureDesc->MipLevels);
+        delete pSource;
+        return nullptr;
+    }
+
+    StreamedTexture *pTexture = new StreamedTexture();
+    Y_memcpy(&pTexture->m_desc, pTextureDesc, sizeof(pTexture->m_desc));
+    Y_memcpy(&pTexture->m_samplerStateDesc, pSamplerStateDesc, sizeof(pTexture->m_samplerStateDesc));
+    pTexture->m_desc.Flags |= GPU_TEXTURE_FLAG_SHADER_BINDABLE;
+    pTexture->m_pSource = pSource;
+    pTexture->m_pGPUTexture = nullptr;
+    pTexture->m_requestedScreenSize = 0.0f;
+    pTexture->m_priority = 0.0f;
+    pTexture->m_lastRequestedFrame = m_frameNumber;
+    pTexture->m_pRequest = nullptr;
+    pTexture->m_streamingFailed = false;
+    pTexture->m_destroyed = false;
+
+    // chain sizes from the smallest level up, and the first level that fits in the tail size
+    uint64 chainSize = 0;
+    pTexture->m_tailMipLevel = pTextureDesc->MipLevels - 1;
+    for (uint32 mipLevel = pTextureDesc->MipLevels; mipLevel-- > 0; )
+    {
+        uint32 width = GetMipDimension(pTextureDesc->Width, mipLevel);
+        uint32 height = GetMipDimension(pTextureDesc->Height, mipLevel);
+        chainSize += PixelFormat_CalculateImageSize(pTextureDesc->Format, width, height, 1);
+        pTexture->m_mipChainSizes[mipLevel] = chainSize;
+        if (width <= m_tailSize && height <= m_tailSize)
+            pTexture->m_tailMipLevel = mipLevel;
+    }
+
+    // the tail is read here so there is always something to sample
+    byte *pTailData;
+    uint32 levelOffsets[TEXTURE_MAX_MIPMAP_COUNT], levelRowPitches[TEXTURE_MAX_MIPMAP_COUNT], levelSizes[TEXTURE_MAX_MIPMAP_COUNT];
+    if (!ReadMipLevels(pSource, &pTexture->m_desc, pTexture->m_tailMipLevel, &pTailData, levelOffsets, levelRowPitches, levelSizes))
+    {
+        Log_ErrorPrintf("TextureStreamer::CreateTexture: Failed to read mip tail");
+        delete pSource;
+        delete pTexture;
+        return nullptr;
+    }
+
+    uint32 tailLevelCount = pTextureDesc->MipLevels - pTexture->m_tailMipLevel;
+    const void *ppInitialData[TEXTURE_MAX_MIPMAP_COUNT];
+    for (uint32 i = 0; i < tailLevelCount; i++)
+        ppInitialData[i] = pTailData + levelOffsets[i];
+
+    GPU_TEXTURE2D_DESC tailDesc(GetMipDimension(pTextureDesc->Width, pTexture->m_tailMipLevel), GetMipDimension(pTextureDesc->Height, pTexture->m_tailMipLevel),
+                                pTextureDesc->Format, pTexture->m_desc.Flags, tailLevelCount);
+
+    m_pGPUDevice->BeginResourceBatchUpload();
+    pTexture->m_pGPUTexture = m_pGPUDevice->CreateTexture2D(&tailDesc, &pTexture->m_samplerStateDesc, ppInitialData, levelRowPitches);
+    m_pGPUDevice->EndResourceBatchUpload();
+    Y_free(pTailData);
+    if (pTexture->m_pGPUTexture == nullptr)
+    {
+        Log_ErrorPrintf("TextureStreamer::CreateTexture: Failed to create tail texture");
+        delete pSource;
+        delete pTexture;
+        return nullptr;
+    }
+
+    pTexture->m_residentMipLevel = pTexture->m_tailMipLevel;
+    pTexture->m_targetMipLevel = pTexture->m_tailMipLevel;
+    m_residentMemory += pTexture->GetMipChainSize(pTexture->m_tailMipLevel);
+    m_textures.Add(pTexture);
+    return pTexture;
+}
+
+void TextureStreamer::DestroyTexture(StreamedTexture *pTexture)
+{
+    for (uint32 i = 0; i < m_textures.GetSize(); i++)
+    {
+        if (m_textures[i] == pTexture)
+        {
+            m_textures.FastRemove(i);
+            break;
+        }
+    }
+
+    TextureStreamingRequest *pRequest = pTexture->m_pRequest;
+    if (pRequest != nullptr)
+    {
+        // still waiting for a thread, or part way through uploading, can be dropped now
+        bool dropped = false;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            for (uint32 i = 0; i < m_queuedRequests.GetSize(); i++)
+            {
+                if (m_queuedRequests[i] == pRequest)
+                {
+                    m_queuedRequests.FastRemove(i);
+                    dropped = true;
+                    break;
+                }
+            }
+        }
+        for (uint32 i = 0; i < m_uploadingRequests.GetSize() && !dropped; i++)
+        {
+            if (m_uploadingRequests[i] == pRequest)
+            {
+                if (pRequest->pNewTexture != nullptr)
+                    m_residentMemory -= pTexture->GetMipChainSize(pRequest->FirstMipLevel);
+                m_uploadingRequests.OrderedRemove(i);
+                dropped = true;
+            }
+        }
+
+        if (!dropped)
+        {
+            // being read, freed once it comes back
+            pTexture->m_destroyed = true;
+            m_destroyedTextures.Add(pTexture);
+            return;
+        }
+
+        DeleteRequest(pRequest);
+        m_inFlightRequestCount--;
+        pTexture->m_pRequest = nullptr;
+    }
+
+    FreeTexture(pTexture);
+}
+
+void TextureStreamer::FreeTexture(StreamedTexture *pTexture)
+{
+    DebugAssert(pTexture->m_pRequest == nullptr);
+    m_residentMemory -= pTexture->GetMipChainSize(pTexture->m_residentMipLevel);
+    SAFE_RELEASE(pTexture->m_pGPUTexture);
+    delete pTexture->m_pSource;
+    delete pTexture;
+}
+
+void TextureStreamer::Update()
+{
+    m_frameNumber++;
+
+    uint32 uploadBytesRemaining = m_uploadBudgetPerFrame;
+    m_pGPUDevice->BeginResourceBatchUpload();
+    ProcessCompletedRequests(&uploadBytesRemaining);
+    m_pGPUDevice->EndResourceBatchUpload();
+
+    UpdateTargets();
+    IssueRequests();
+}
+
+uint32 TextureStreamer::CalculateWantedMipLevel(const StreamedTexture *pTexture) const
+{
+    if (pTexture->m_priority <= 0.0f)
+        return pTexture->m_tailMipLevel;
+
+    // most detailed level that is still at least as large as the texture appears on screen
+    uint32 maxDimension = Max(pTexture->m_desc.Width, pTexture->m_desc.Height);
+    uint32 mipLevel = 0;
+    while (mipLevel < pTexture->m_tailMipLevel && (float)(maxDimension >> (mipLevel + 1)) >= pTexture->m_priority)
+        mipLevel++;
+
+    return mipLevel;
+}
+
+void TextureStreamer::UpdateTargets()
+{
+    // gather this frame's feedback, textures that haven't been seen for a while fall back to their tails
+    uint64 wantedMemory = 0;
+    for (uint32 i = 0; i < m_textures.GetSize(); i++)
+    {
+        StreamedTexture *pTexture = m_textures[i];
+        if (pTexture->m_requestedScreenSize > 0.0f)
+        {
+            pTexture->m_priority = pTexture->m_requestedScreenSize;
+            pTexture->m_lastRequestedFrame = m_frameNumber;
+            pTexture->m_requestedScreenSize = 0.0f;
+        }
+        else if ((m_frameNumber - pTexture->m_lastRequestedFrame) > m_evictionDelay)
+        {
+            pTexture->m_priority = 0.0f;
+        }
+
+        pTexture->m_targetMipLevel = (pTexture->m_streamingFailed) ? pTexture->m_residentMipLevel : CalculateWantedMipLevel(pTexture);
+        wantedMemory += pTexture->GetMipChainSize(pTexture->m_targetMipLevel) - pTexture->GetMipChainSize(pTexture->m_tailMipLevel);
+    }
+
+    m_sortedTextures.Resize(m_textures.GetSize());
+    if (m_textures.GetSize() > 0)
+    {
+        Y_memcpy(m_sortedTextures.GetBasePointer(), m_textures.GetBasePointer(), sizeof(StreamedTexture *) * m_textures.GetSize());
+        std::sort(m_sortedTextures.GetBasePointer(), m_sortedTextures.GetBasePointer() + m_sortedTextures.GetSize(),
+                  [](const StreamedTexture *pLeft, const StreamedTexture *pRight) { return pLeft->m_priority < pRight->m_priority; });
+    }
+
+    // over budget, drop levels from the least important textures until everything fits
+    for (uint32 i = 0; i < m_sortedTextures.GetSize() && wantedMemory > m_memoryBudget; i++)
+    {
+        StreamedTexture *pTexture = m_sortedTextures[i];
+        while (wantedMemory > m_memoryBudget && pTexture->m_targetMipLevel < pTexture->m_tailMipLevel && !pTexture->m_streamingFailed)
+        {
+            wantedMemory -= pTexture->GetMipChainSize(pTexture->m_targetMipLevel) - pTexture->GetMipChainSize(pTexture->m_targetMipLevel + 1);
+            pTexture->m_targetMipLevel++;
+        }
+    }
+}
+
+void TextureStreamer::IssueRequests()
+{
+    uint32 maxInFlightRequests = m_ioThreads.GetSize() * MAX_REQUESTS_PER_IO_THREAD;
+    bool queuedRequests = false;
+    {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+
+        // most important first, so they get the free request slots
+        for (uint32 i = m_sortedTextures.GetSize(); i-- > 0; )
+        {
+            StreamedTexture *pTexture = m_sortedTextures[i];
+            TextureStreamingRequest *pRequest = pTexture->m_pRequest;
+            if (pTexture->m_targetMipLevel == pTexture->m_residentMipLevel)
+            {
+                // the target moved back to what is resident, drop the request if no thread has picked it up yet
+                if (pRequest != nullptr && !pRequest->Started)
+                {
+                    for (uint32 j = 0; j < m_queuedRequests.GetSize(); j++)
+                    {
+                        if (m_queuedRequests[j] == pRequest)
+                        {
+                            m_queuedRequests.FastRemove(j);
+                            break;
+                        }
+                    }
+
+                    pTexture->m_pRequest = nullptr;
+                    DeleteRequest(pRequest);
+                    m_inFlightRequestCount--;
+                }
+
+                continue;
+            }
+
+            // evictions only re-read the small levels and free memory, so they jump the queue
+            float priority = (pTexture->m_targetMipLevel > pTexture->m_residentMipLevel) ? Y_FLT_MAX : pTexture->m_priority;
+            if (pRequest != nullptr)
+            {
+                // retarget requests that no thread has picked up yet
+                if (!pRequest->Started)
+                {
+                    pRequest->FirstMipLevel = pTexture->m_targetMipLevel;
+                    pRequest->Priority = priority;
+                }
+
+                continue;
+            }
+
+            if (m_inFlightRequestCount >= maxInFlightRequests)
+                continue;
+
+            pRequest = new TextureStreamingRequest;
+            Y_memzero(pRequest, sizeof(TextureStreamingRequest));
+            pRequest->pTexture = pTexture;
+            pRequest->pSource = pTexture->m_pSource;
+            Y_memcpy(&pRequest->Desc, &pTexture->m_desc, sizeof(pRequest->Desc));
+            pRequest->FirstMipLevel = pTexture->m_targetMipLevel;
+            pRequest->Priority = priority;
+            pTexture->m_pRequest = pRequest;
+            m_queuedRequests.Add(pRequest);
+            m_inFlightRequestCount++;
+            queuedRequests = true;
+        }
+    }
+
+    if (queuedRequests)
+        m_queueCondition.notify_all();
+}
+
+void TextureStreamer::ProcessCompletedRequests(uint32 *pUploadBytesRemaining)
+{
+    // finish partial uploads from previous frames first, in order
+    while (m_uploadingRequests.GetSize() > 0)
+    {
+        if (!UploadRequest(m_uploadingRequests[0], pUploadBytesRemaining))
+            return;
+
+        m_uploadingRequests.OrderedRemove(0);
+    }
+
+    PODArray<TextureStreamingRequest *> completedRequests;
+    {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        for (uint32 i = 0; i < m_completedRequests.GetSize(); i++)
+            completedRequests.Add(m_completedRequests[i]);
+        m_completedRequests.Clear();
+    }
+
+    for (uint32 i = 0; i < completedRequests.GetSize(); i++)
+    {
+        TextureStreamingRequest *pRequest = completedRequests[i];
+        StreamedTexture *pTexture = pRequest->pTexture;
+        if (pTexture->m_destroyed)
+        {
+            for (uint32 j = 0; j < m_destroyedTextures.GetSize(); j++)
+            {
+                if (m_destroyedTextures[j] == pTexture)
+                {
+                    m_destroyedTextures.FastRemove(j);
+                    break;
+                }
+            }
+
+            pTexture->m_pRequest = nullptr;
+            DeleteRequest(pRequest);
+            m_inFlightRequestCount--;
+            FreeTexture(pTexture);
+            continue;
+        }
+
+        if (!pRequest->Succeeded)
+        {
+            // keep whatever is resident rather than retrying every frame
+            Log_WarningPrintf("TextureStreamer: Failed to read mip levels %u-%u, streaming disabled for texture", pRequest->FirstMipLevel, pRequest->Desc.MipLevels - 1);
+            pTexture->m_streamingFailed = true;
+            pTexture->m_pRequest = nullptr;
+            DeleteRequest(pRequest);
+            m_inFlightRequestCount--;
+            continue;
+        }
+
+        // once the upload budget is spent, the rest wait for the next frame
+        if (m_uploadingRequests.GetSize() > 0 || !UploadRequest(pRequest, pUploadBytesRemaining))
+            m_uploadingRequests.Add(pRequest);
+    }
+}
+
+bool TextureStreamer::UploadRequest(TextureStreamingRequest *pRequest, uint32 *pUploadBytesRemaining)
+{
+    StreamedTexture *pTexture = pRequest->pTexture;
+    uint32 levelCount = pRequest->Desc.MipLevels - pRequest->FirstMipLevel;
+    if (pRequest->pNewTexture == nullptr)
+    {
+        GPU_TEXTURE2D_DESC textureDesc(GetMipDimension(pRequest->Desc.Width, pRequest->FirstMipLevel), GetMipDimension(pRequest->Desc.Height, pRequest->FirstMipLevel),
+                                       pRequest->Desc.Format, pRequest->Desc.Flags | GPU_TEXTURE_FLAG_WRITABLE, levelCount);
+
+        pRequest->pNewTexture = m_pGPUDevice->CreateTexture2D(&textureDesc, &pTexture->m_samplerStateDesc);
+        if (pRequest->pNewTexture == nullptr)
+        {
+            // drop the request, it'll be reissued next frame
+            Log_WarningPrintf("TextureStreamer: Failed to create %ux%u texture", textureDesc.Width, textureDesc.Height);
+            pTexture->m_pRequest = nullptr;
+            DeleteRequest(pRequest);
+            m_inFlightRequestCount--;
+            return true;
+        }
+
+        m_residentMemory += pTexture->GetMipChainSize(pRequest->FirstMipLevel);
+    }
+
+    // at least one level goes up per frame, so levels larger than the budget still make progress
+    while (pRequest->UploadedLevelCount < levelCount)
+    {
+        uint32 index = pRequest->UploadedLevelCount;
+        uint32 levelSize = pRequest->LevelSizes[index];
+        if (levelSize > *pUploadBytesRemaining && *pUploadBytesRemaining != m_uploadBudgetPerFrame)
+            return false;
+
+        uint32 mipLevel = pRequest->FirstMipLevel + index;
+        if (!m_pGPUContext->WriteTexture(pRequest->pNewTexture, pRequest->pData + pRequest->LevelOffsets[index], pRequest->LevelRowPitches[index], levelSize, index, 0, 0,
+                                         GetMipDimension(pRequest->Desc.Width, mipLevel), GetMipDimension(pRequest->Desc.Height, mipLevel)))
+        {
+            Log_WarningPrintf("TextureStreamer: Failed to upload mip level %u, streaming disabled for texture", mipLevel);
+            m_residentMemory -= pTexture->GetMipChainSize(pRequest->FirstMipLevel);
+            pTexture->m_streamingFailed = true;
+            pTexture->m_pRequest = nullptr;
+            DeleteRequest(pRequest);
+            m_inFlightRequestCount--;
+            return true;
+        }
+
+        *pUploadBytesRemaining -= Min(levelSize, *pUploadBytesRemaining);
+        pRequest->UploadedLevelCount++;
+    }
+
+    FinishRequest(pRequest);
+    return true;
+}
+
+void TextureStreamer::FinishRequest(TextureStreamingRequest *pRequest)
+{
+    // swap in the new range
+    StreamedTexture *pTexture = pRequest->pTexture;
+    m_residentMemory -= pTexture->GetMipChainSize(pTexture->m_residentMipLevel);
+    pTexture->m_pGPUTexture->Release();
+    pTexture->m_pGPUTexture = pRequest->pNewTexture;
+    pTexture->m_residentMipLevel = pRequest->FirstMipLevel;
+    pTexture->m_pRequest = nullptr;
+
+    pRequest->pNewTexture = nullptr;
+    DeleteRequest(pRequest);
+    m_inFlightRequestCount--;
+}
+
+void TextureStreamer::IOThreadMain()
+{
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    for (;;)
+    {
+        m_queueCondition.wait(lock, [this]() { return m_shutdownThreads || m_queuedRequests.GetSize() > 0; });
+        if (m_shutdownThreads)
+            return;
+
+        uint32 bestIndex = 0;
+        for (uint32 i = 1; i < m_queuedRequests.GetSize(); i++)
+        {
+            if (m_queuedRequests[i]->Priority > m_queuedRequests[bestIndex]->Priority)
+                bestIndex = i;
+        }
+
+        // the request can't be retargeted once started, so the range is fixed from here
+        TextureStreamingRequest *pRequest = m_queuedRequests[bestIndex];
+        m_queuedRequests.FastRemove(bestIndex);
+        pRequest->Started = true;
+        lock.unlock();
+
+        pRequest->Succeeded = ReadMipLevels(pRequest->pSource, &pRequest->Desc, pRequest->FirstMipLevel, &pRequest->pData, pRequest->LevelOffsets, pRequest->LevelRowPitches, pRequest->LevelSizes);
+
+        lock.lock();
+        m_completedRequests.Add(pRequest);
+    }
+}
@@ -0,0 +1,631 @@
+#include "YBaseLib/Assert.h"
+#include "YBaseLib/Math.h"
+#include "YBaseLib/Log.h"
+#include "YRenderLib/VertexCompression.h"
+#include <cmath>
+Log_SetChannel(VertexCompression);
+
+#if Y_CPU_SSE_LEVEL > 0
+    #include <emmintrin.h>
+
+    // F16C is not reported separately by the compiler, but every AVX2 part has it
+    #if defined(__F16C__) || defined(__AVX2__)
+        #include <immintrin.h>
+        #define VERTEX_COMPRESSION_USE_F16C 1
+    #endif
+#endif
+
+// vertices are converted in blocks of this many, so the temporaries stay in L1
+static const uint32 BLOCK_SIZE = 256;
+
+//------------------------------------------------------------------ Half ------------------------------------------------------------------------------------------------------------------
+
+#if Y_CPU_SSE_LEVEL > 0 && !defined(VERTEX_COMPRESSION_USE_F16C)
+
+// round to nearest even float->half for four values, results are sign-extended into each 32-bit lane so they survive _mm_packs_epi32
+// based on Fabian Giesen's float_to_half_fast3
+static inline __m128i FloatToHalfSSE2(__m128 f)
+{
+    const __m128i signMask = _mm_set1_epi32(0x80000000);
+    const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i nanBit = _mm_set1_epi32(0x200);
+    const __m128i infinityAsHalf = _mm_set1_epi32(0x7C00);
+    const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+    __m128 justSign = _mm_and_ps(_mm_castsi128_ps(signMask), f);
+    __m128 absF = _mm_xor_ps(f, justSign);
+    __m128i absFInt = _mm_castps_si128(absF);
+
+    __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absF, absF));
+    __m128i isRegular = _mm_cmpgt_epi32(f16Max, absFInt);
+    __m128i infOrNaN = _mm_or_si128(_mm_and_si128(isNaN, nanBit), infinityAsHalf);
+    __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absFInt);
+
+    // subnormal results, let the fp adder do the rounding
+    __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absF, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+    // normal results, rebias the exponent and round the mantissa to even
+    __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absFInt, 31 - 13), 31);
+    __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absFInt, normalBias), mantissaOdd), 13);
+
+    __m128i nonSpecial = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+    __m128i joined = _mm_or_si128(_mm_and_si128(isRegular, nonSpecial), _mm_andnot_si128(isRegular, infOrNaN));
+    return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(justSign), 16));
+}
+
+// half->float for four values held in the low 16 bits of each lane
+static inline __m128 HalfToFloatSSE2(__m128i h)
+{
+    const __m128i noSignMask = _mm_set1_epi32(0x7FFF);
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128i wasInfNaN = _mm_set1_epi32(0x7BFF);
+    const __m128i infNaNExponent = _mm_set1_epi32(255 << 23);
+
+    __m128i exponentMantissa = _mm_and_si128(noSignMask, h);
+    __m128i justSign = _mm_xor_si128(h, exponentMantissa);
+    __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), magic);
+    __m128i infNaN = _mm_and_si128(_mm_cmpgt_epi32(exponentMantissa, wasInfNaN), infNaNExponent);
+    __m128i signInfNaN = _mm_or_si128(_mm_slli_epi32(justSign, 16), infNaN);
+    return _mm_or_ps(scaled, _mm_castsi128_ps(signInfNaN));
+}
+
+#endif
+
+#if Y_CPU_SSE_LEVEL > 0
+
+static inline void FloatToHalf8(uint16 *pDestination, const float *pSource)
+{
+#ifdef VERTEX_COMPRESSION_USE_F16C
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(pDestination), _mm256_cvtps_ph(_mm256_loadu_ps(pSource), _MM_FROUND_TO_NEAREST_INT));
+#else
+    __m128i lo = FloatToHalfSSE2(_mm_loadu_ps(pSource));
+    __m128i hi = FloatToHalfSSE2(_mm_loadu_ps(pSource + 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(pDestination), _mm_packs_epi32(lo, hi));
+#endif
+}
+
+static inline void HalfToFloat8(float *pDestination, const uint16 *pSource)
+{
+#ifdef VERTEX_COMPRESSION_USE_F16C
+    _mm256_storeu_ps(pDestination, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource))));
+#else
+    __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource));
+    _mm_storeu_ps(pDestination, HalfToFloatSSE2(_mm_unpacklo_epi16(halves, _mm_setzero_si128())));
+    _mm_storeu_ps(pDestination + 4, HalfToFloatSSE2(_mm_unpackhi_epi16(halves, _mm_setzero_si128())));
+#endif
+}
+
+#endif
+
+void VertexCompression::FloatToHalf(uint16 *pDestination, const float *pSource, uint32 count)
+{
+#if Y_CPU_SSE_LEVEL > 0
+    uint32 i = 0;
+    for (; (i + 8) <= count; i += 8)
+        FloatToHalf8(pDestination + i, pSource + i);
+
+    // tail goes through the same path so rounding is identical for every element
+    if (i < count)
+    {
+        float tempSource[8] = { 0.0f };
+        uint16 tempDestination[8];
+        Y_memcpy(tempSource, pSource + i, sizeof(float) * (count - i));
+        FloatToHalf8(tempDestination, tempSource);
+        Y_memcpy(pDestination + i, tempDestination, sizeof(uint16) * (count - i));
+    }
+#else
+    for (uint32 i = 0; i < count; i++)
+        pDestination[i] = Math::FloatToHalf(pSource[i]);
+#endif
+}
+
+void VertexCompression::HalfToFloat(float *pDestination, const uint16 *pSource, uint32 count)
+{
+#if Y_CPU_SSE_LEVEL > 0
+    uint32 i = 0;
+    for (; (i + 8) <= count; i += 8)
+        HalfToFloat8(pDestination + i, pSource + i);
+
+    if (i < count)
+    {
+        uint16 tempSource[8] = { 0 };
+        float tempDestination[8];
+        Y_memcpy(tempSource, pSource + i, sizeof(uint16) * (count - i));
+        HalfToFloat8(tempDestination, tempSource);
+        Y_memcpy(pDestination + i, tempDestination, sizeof(float) * (count - i));
+    }
+#else
+    for (uint32 i = 0; i < count; i++)
+        pDestination[i] = Math::HalfToFloat(pSource[i]);
+#endif
+}
+
+//------------------------------------------------------------------ Normalized integers ---------------------------------------------------------------------------------------------------
+
+void VertexCompression::FloatToSNorm16(int16 *pDestination, const float *pSource, uint32 count)
+{
+    uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+    const __m128 minValue = _mm_set_ps1(-1.0f);
+    const __m128 maxValue = _mm_set_ps1(1.0f);
+    const __m128 scale = _mm_set_ps1(32767.0f);
+    for (; (i + 8) <= count; i += 8)
+    {
+        __m128 lo = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSource + i), minValue), maxValue), scale);
+        __m128 hi = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSource + i + 4), minValue), maxValue), scale);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDestination + i), _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi)));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        // round to nearest even, to match _mm_cvtps_epi32
+        pDestination[i] = (int16)std::nearbyint(Max(-1.0f, Min(1.0f, pSource[i])) * 32767.0f);
+    }
+}
+
+void VertexCompression::SNorm16ToFloat(float *pDestination, const int16 *pSource, uint32 count)
+{
+    uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+    // -32768 and -32767 both map to -1
+    const __m128 minValue = _mm_set_ps1(-1.0f);
+    const __m128 scale = _mm_set_ps1(1.0f / 32767.0f);
+    for (; (i + 8) <= count; i += 8)
+    {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16);
+        _mm_storeu_ps(pDestination + i, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(lo), scale), minValue));
+        _mm_storeu_ps(pDestination + i + 4, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(hi), scale), minValue));
+    }
+#endif
+
+    for (; i < count; i++)
+        pDestination[i] = Max(-1.0f, (float)pSource[i] * (1.0f / 32767.0f));
+}
+
+void VertexCompression::FloatToUNorm8(uint8 *pDestination, const float *pSource, uint32 count)
+{
+    uint32 i = 0;
+
+#if Y_CPU_SSE_LEVEL > 0
+    const __m128 minValue = _mm_setzero_ps();
+    const __m128 maxValue = _mm_set_ps1(1.0f);
+    const __m128 scale = _mm_set_ps1(255.0f);
+    for (; (i + 16) <= count; i += 16)
+    {
+        __m128i v0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSource + i), minValue), maxValue), scale));
+        __m128i v1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSource + i + 4), minValue), maxValue), scale));
+        __m128i v2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSource + i + 8), minValue), maxValue), scale));
+        __m128i v3 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSource + i + 12), minValue), maxValue), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDestination + i), _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3)));
+    }
+#endif
+
+    for (; i < count; i++)
+        pDestination[i] = (uint8)std::nearbyint(Max(0.0f, Min(1.0f, pSource[i])) * 255.0f);
+}
+
+//------------------------------------------------------------------ Unit vectors ----------------------------------------------------------------------------------------------------------
+
+// deinterleaved temporaries for a block, padded to a multiple of four
+struct UnitVectorBlock
+{
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float X[BLOCK_SIZE];
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float Y[BLOCK_SIZE];
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float Z[BLOCK_SIZE];
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float W[BLOCK_SIZE];
+};
+
+// missing components default to zero, except w which defaults to one
+static void GatherUnitVectors(UnitVectorBlock *pBlock, const byte *pSource, uint32 sourceStride, uint32 sourceComponents, uint32 count)
+{
+    DebugAssert(count <= BLOCK_SIZE);
+    for (uint32 i = 0; i < count; i++)
+    {
+        const float *pValues = reinterpret_cast<const float *>(pSource + i * sourceStride);
+        pBlock->X[i] = pValues[0];
+        pBlock->Y[i] = (sourceComponents > 1) ? pValues[1] : 0.0f;
+        pBlock->Z[i] = (sourceComponents > 2) ? pValues[2] : 0.0f;
+        pBlock->W[i] = (sourceComponents > 3) ? pValues[3] : 1.0f;
+    }
+
+    for (uint32 i = count; i < ((count + 3) & ~3u); i++)
+    {
+        pBlock->X[i] = 0.0f;
+        pBlock->Y[i] = 0.0f;
+        pBlock->Z[i] = 1.0f;
+        pBlock->W[i] = 1.0f;
+    }
+}
+
+// projects onto the octahedron |x| + |y| + |z| = 1 and folds the lower half over, writing interleaved xy pairs
+static void EncodeOctahedralBlock(float *pDestination, const UnitVectorBlock *pBlock, uint32 count)
+{
+#if Y_CPU_SSE_LEVEL > 0
+    const __m128 signMask = _mm_set_ps1(-0.0f);
+    const __m128 one = _mm_set_ps1(1.0f);
+    const __m128 tiny = _mm_set_ps1(Y_FLT_EPSILON);
+    for (uint32 i = 0; i < count; i += 4)
+    {
+        __m128 x = _mm_load_ps(pBlock->X + i);
+        __m128 y = _mm_load_ps(pBlock->Y + i);
+        __m128 z = _mm_load_ps(pBlock->Z + i);
+
+        __m128 absSum = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)), _mm_andnot_ps(signMask, z));
+        __m128 invSum = _mm_div_ps(one, _mm_max_ps(absSum, tiny));
+        x = _mm_mul_ps(x, invSum);
+        y = _mm_mul_ps(y, invSum);
+
+        __m128 foldedX = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, y)), _mm_and_ps(signMask, x));
+        __m128 foldedY = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, x)), _mm_and_ps(signMask, y));
+        __m128 lowerHalf = _mm_cmplt_ps(z, _mm_setzero_ps());
+        x = _mm_or_ps(_mm_and_ps(lowerHalf, foldedX), _mm_andnot_ps(lowerHalf, x));
+        y = _mm_or_ps(_mm_and_ps(lowerHalf, foldedY), _mm_andnot_ps(lowerHalf, y));
+
+        _mm_storeu_ps(pDestination + i * 2, _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(pDestination + i * 2 + 4, _mm_unpackhi_ps(x, y));
+    }
+#else
+    for (uint32 i = 0; i < count; i++)
+    {
+        float x = pBlock->X[i];
+        float y = pBlock->Y[i];
+        float z = pBlock->Z[i];
+        float invSum = 1.0f / Max(Y_fabsf(x) + Y_fabsf(y) + Y_fabsf(z), Y_FLT_EPSILON);
+        x *= invSum;
+        y *= invSum;
+        if (z < 0.0f)
+        {
+            float foldedX = (1.0f - Y_fabsf(y)) * ((x >= 0.0f) ? 1.0f : -1.0f);
+            float foldedY = (1.0f - Y_fabsf(x)) * ((y >= 0.0f) ? 1.0f : -1.0f);
+            x = foldedX;
+            y = foldedY;
+        }
+
+        pDestination[i * 2 + 0] = x;
+        pDestination[i * 2 + 1] = y;
+    }
+#endif
+}
+
+// xyz mapped from [-1, 1] to 10-bit unorm, handedness in the top two bits
+static void EncodeTangentBlock(uint32 *pDestination, const UnitVectorBlock *pBlock, uint32 count)
+{
+#if Y_CPU_SSE_LEVEL > 0
+    const __m128 oneHalf = _mm_set_ps1(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set_ps1(1.0f);
+    const __m128 scale = _mm_set_ps1(1023.0f);
+    const __m128i alphaBits = _mm_set1_epi32(0xC0000000);
+    for (uint32 i = 0; i < count; i += 4)
+    {
+        __m128i x = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(pBlock->X + i), oneHalf), oneHalf), zero), one), scale));
+        __m128i y = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(pBlock->Y + i), oneHalf), oneHalf), zero), one), scale));
+        __m128i z = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(pBlock->Z + i), oneHalf), oneHalf), zero), one), scale));
+        __m128i a = _mm_and_si128(_mm_castps_si128(_mm_cmpge_ps(_mm_load_ps(pBlock->W + i), zero)), alphaBits);
+        __m128i packed = _mm_or_si128(_mm_or_si128(x, _mm_slli_epi32(y, 10)), _mm_or_si128(_mm_slli_epi32(z, 20), a));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDestination + i), packed);
+    }
+#else
+    for (uint32 i = 0; i < count; i++)
+    {
+        uint32 x = (uint32)std::nearbyint(Max(0.0f, Min(1.0f, pBlock->X[i] * 0.5f + 0.5f)) * 1023.0f);
+        uint32 y = (uint32)std::nearbyint(Max(0.0f, Min(1.0f, pBlock->Y[i] * 0.5f + 0.5f)) * 1023.0f);
+        uint32 z = (uint32)std::nearbyint(Max(0.0f, Min(1.0f, pBlock->Z[i] * 0.5f + 0.5f)) * 1023.0f);
+        uint32 a = (pBlock->W[i] >= 0.0f) ? 3 : 0;
+        pDestination[i] = x | (y << 10) | (z << 20) | (a << 30);
+    }
+#endif
+}
+
+static void EncodeOctahedralNormalsStrided(int16 *pDestination, const byte *pSource, uint32 sourceStride, uint32 sourceComponents, uint32 count)
+{
+    UnitVectorBlock block;
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float encoded[BLOCK_SIZE * 2];
+    for (uint32 start = 0; start < count; start += BLOCK_SIZE)
+    {
+        uint32 blockCount = Min(count - start, BLOCK_SIZE);
+        GatherUnitVectors(&block, pSource + start * sourceStride, sourceStride, sourceComponents, blockCount);
+        EncodeOctahedralBlock(encoded, &block, blockCount);
+        VertexCompression::FloatToSNorm16(pDestination + start * 2, encoded, blockCount * 2);
+    }
+}
+
+static void EncodeTangentsStrided(uint32 *pDestination, const byte *pSource, uint32 sourceStride, uint32 sourceComponents, uint32 count)
+{
+    UnitVectorBlock block;
+    ALIGN_DECL(Y_SSE_ALIGNMENT) uint32 encoded[BLOCK_SIZE];
+    for (uint32 start = 0; start < count; start += BLOCK_SIZE)
+    {
+        uint32 blockCount = Min(count - start, BLOCK_SIZE);
+        GatherUnitVectors(&block, pSource + start * sourceStride, sourceStride, sourceComponents, blockCount);
+        EncodeTangentBlock(encoded, &block, blockCount);
+        Y_memcpy(pDestination + start, encoded, sizeof(uint32) * blockCount);
+    }
+}
+
+void VertexCompression::EncodeOctahedralNormals(int16 *pDestination, const Vector3f *pNormals, uint32 count)
+{
+    EncodeOctahedralNormalsStrided(pDestination, reinterpret_cast<const byte *>(pNormals), sizeof(Vector3f), 3, count);
+}
+
+void VertexCompression::DecodeOctahedralNormals(Vector3f *pDestination, const int16 *pSource, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++)
+    {
+        float x = Max(-1.0f, (float)pSource[i * 2 + 0] * (1.0f / 32767.0f));
+        float y = Max(-1.0f, (float)pSource[i * 2 + 1] * (1.0f / 32767.0f));
+        float z = 1.0f - Y_fabsf(x) - Y_fabsf(y);
+
+        // unfold the lower hemisphere
+        float t = Max(-z, 0.0f);
+        x += (x >= 0.0f) ? -t : t;
+        y += (y >= 0.0f) ? -t : t;
+
+        pDestination[i] = Vector3f(x, y, z).Normalize();
+    }
+}
+
+void VertexCompression::EncodeTangents(uint32 *pDestination, const Vector4f *pTangents, uint32 count)
+{
+    EncodeTangentsStrided(pDestination, reinterpret_cast<const byte *>(pTangents), sizeof(Vector4f), 4, count);
+}
+
+void VertexCompression::DecodeTangents(Vector4f *pDestination, const uint32 *pSource, uint32 count)
+{
+    for (uint32 i = 0; i < count; i++)
+    {
+        uint32 packed = pSource[i];
+        pDestination[i].x = (float)(packed & 0x3FF) * (2.0f / 1023.0f) - 1.0f;
+        pDestination[i].y = (float)((packed >> 10) & 0x3FF) * (2.0f / 1023.0f) - 1.0f;
+        pDestination[i].z = (float)((packed >> 20) & 0x3FF) * (2.0f / 1023.0f) - 1.0f;
+        pDestination[i].w = ((packed >> 30) != 0) ? 1.0f : -1.0f;
+    }
+}
+
+//------------------------------------------------------------------ Layouts ---------------------------------------------------------------------------------------------------------------
+
+enum VERTEX_CONVERSION
+{
+    VERTEX_CONVERSION_NONE,
+    VERTEX_CONVERSION_COPY,
+    VERTEX_CONVERSION_FLOAT,
+    VERTEX_CONVERSION_HALF,
+    VERTEX_CONVERSION_SNORM16,
+    VERTEX_CONVERSION_UNORM8,
+    VERTEX_CONVERSION_OCTAHEDRAL,
+    VERTEX_CONVERSION_TANGENT,
+};
+
+static bool IsFloatElementType(GPU_VERTEX_ELEMENT_TYPE type)
+{
+    return (type >= GPU_VERTEX_ELEMENT_TYPE_FLOAT && type <= GPU_VERTEX_ELEMENT_TYPE_FLOAT4);
+}
+
+static bool IsDirectionSemantic(GPU_VERTEX_ELEMENT_SEMANTIC semantic)
+{
+    return (semantic == GPU_VERTEX_ELEMENT_SEMANTIC_NORMAL || semantic == GPU_VERTEX_ELEMENT_SEMANTIC_TANGENT || semantic == GPU_VERTEX_ELEMENT_SEMANTIC_BINORMAL);
+}
+
+static VERTEX_CONVERSION GetVertexConversion(const GPU_VERTEX_ELEMENT_DESC *pSourceElement, const GPU_VERTEX_ELEMENT_DESC *pDestinationElement)
+{
+    if (pSourceElement->Type == pDestinationElement->Type)
+        return VERTEX_CONVERSION_COPY;
+    if (!IsFloatElementType(pSourceElement->Type))
+        return VERTEX_CONVERSION_NONE;
+
+    uint32 sourceComponents = GPUVertexElementTypeComponentCount(pSourceElement->Type);
+    switch (pDestinationElement->Type)
+    {
+    case GPU_VERTEX_ELEMENT_TYPE_FLOAT:
+    case GPU_VERTEX_ELEMENT_TYPE_FLOAT2:
+    case GPU_VERTEX_ELEMENT_TYPE_FLOAT3:
+    case GPU_VERTEX_ELEMENT_TYPE_FLOAT4:
+        return VERTEX_CONVERSION_FLOAT;
+
+    case GPU_VERTEX_ELEMENT_TYPE_HALF:
+    case GPU_VERTEX_ELEMENT_TYPE_HALF2:
+    case GPU_VERTEX_ELEMENT_TYPE_HALF4:
+        return VERTEX_CONVERSION_HALF;
+
+    case GPU_VERTEX_ELEMENT_TYPE_SNORM16_2:
+        return (IsDirectionSemantic(pDestinationElement->Semantic) && sourceComponents >= 3) ? VERTEX_CONVERSION_OCTAHEDRAL : VERTEX_CONVERSION_SNORM16;
+
+    case GPU_VERTEX_ELEMENT_TYPE_SNORM16_4:
+        return VERTEX_CONVERSION_SNORM16;
+
+    case GPU_VERTEX_ELEMENT_TYPE_UNORM10_10_10_2:
+        return (sourceComponents >= 3) ? VERTEX_CONVERSION_TANGENT : VERTEX_CONVERSION_NONE;
+
+    case GPU_VERTEX_ELEMENT_TYPE_UNORM4:
+        return VERTEX_CONVERSION_UNORM8;
+
+    default:
+        return VERTEX_CONVERSION_NONE;
+    }
+}
+
+static const GPU_VERTEX_ELEMENT_DESC *FindMatchingElement(const GPU_VERTEX_ELEMENT_DESC *pElements, uint32 nElements, const GPU_VERTEX_ELEMENT_DESC *pElement)
+{
+    for (uint32 i = 0; i < nElements; i++)
+    {
+        if (pElements[i].Semantic == pElement->Semantic && pElements[i].SemanticIndex == pElement->SemanticIndex)
+            return &pElements[i];
+    }
+
+    return nullptr;
+}
+
+// copies float components into a tightly packed array, missing components default to zero and w to one
+static void GatherFloats(float *pDestination, uint32 destinationComponents, const byte *pSource, uint32 sourceStride, uint32 sourceComponents, uint32 count)
+{
+    static const float defaultValues[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    uint32 copyComponents = Min(sourceComponents, destinationComponents);
+    for (uint32 i = 0; i < count; i++)
+    {
+        const float *pValues = reinterpret_cast<const float *>(pSource + i * sourceStride);
+        uint32 j = 0;
+        for (; j < copyComponents; j++)
+            pDestination[j] = pValues[j];
+        for (; j < destinationComponents; j++)
+            pDestination[j] = defaultValues[j];
+
+        pDestination += destinationComponents;
+    }
+}
+
+static void ScatterElements(byte *pDestination, uint32 destinationStride, const void *pPacked, uint32 elementSize, uint32 count)
+{
+    const byte *pPackedBytes = reinterpret_cast<const byte *>(pPacked);
+    for (uint32 i = 0; i < count; i++)
+        Y_memcpy(pDestination + i * destinationStride, pPackedBytes + i * elementSize, elementSize);
+}
+
+uint32 VertexCompression::BuildCompressedLayout(const GPU_VERTEX_ELEMENT_DESC *pSourceElements, uint32 nElements, uint32 flags, GPU_VERTEX_ELEMENT_DESC *pDestinationElements)
+{
+    uint32 offset = 0;
+    for (uint32 i = 0; i < nElements; i++)
+    {
+        const GPU_VERTEX_ELEMENT_DESC &sourceElement = pSourceElements[i];
+        GPU_VERTEX_ELEMENT_TYPE type = sourceElement.Type;
+        if (IsFloatElementType(type))
+        {
+            uint32 components = GPUVertexElementTypeComponentCount(type);
+            switch (sourceElement.Semantic)
+            {
+            case GPU_VERTEX_ELEMENT_SEMANTIC_POSITION:
+                if (flags & VERTEX_COMPRESSION_FLAG_HALF_POSITIONS)
+                    type = GPU_VERTEX_ELEMENT_TYPE_HALF4;
+                break;
+
+            case GPU_VERTEX_ELEMENT_SEMANTIC_TEXCOORD:
+                type = (components == 1) ? GPU_VERTEX_ELEMENT_TYPE_HALF : ((components == 2) ? GPU_VERTEX_ELEMENT_TYPE_HALF2 : GPU_VERTEX_ELEMENT_TYPE_HALF4);
+                break;
+
+            case GPU_VERTEX_ELEMENT_SEMANTIC_NORMAL:
+            case GPU_VERTEX_ELEMENT_SEMANTIC_BINORMAL:
+                if (components >= 3)
+                    type = GPU_VERTEX_ELEMENT_TYPE_SNORM16_2;
+                break;
+
+            case GPU_VERTEX_ELEMENT_SEMANTIC_TANGENT:
+                if (components >= 3)
+                    type = GPU_VERTEX_ELEMENT_TYPE_UNORM10_10_10_2;
+                break;
+
+            case GPU_VERTEX_ELEMENT_SEMANTIC_COLOR:
+            case GPU_VERTEX_ELEMENT_SEMANTIC_BLENDWEIGHTS:
+                if (components >= 3)
+                    type = GPU_VERTEX_ELEMENT_TYPE_UNORM4;
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        pDestinationElements[i].Set(sourceElement.Semantic, sourceElement.SemanticIndex, type, sourceElement.StreamIndex, offset, sourceElement.InstanceStepRate);
+        offset += (GPUVertexElementTypeSize(type) + 3) & ~3u;
+    }
+
+    return offset;
+}
+
+bool VertexCompression::CompressVertices(const GPU_VERTEX_ELEMENT_DESC *pSourceElements, uint32 nSourceElements, const void *pSourceVertices, uint32 sourceStride,
+                                         const GPU_VERTEX_ELEMENT_DESC *pDestinationElements, uint32 nDestinationElements, void *pDestinationVertices, uint32 destinationStride,
+                                         uint32 vertexCount)
+{
+    // validate everything up front so we don't leave a half-written buffer
+    for (uint32 i = 0; i < nDestinationElements; i++)
+    {
+        const GPU_VERTEX_ELEMENT_DESC *pDestinationElement = &pDestinationElements[i];
+        const GPU_VERTEX_ELEMENT_DESC *pSourceElement = FindMatchingElement(pSourceElements, nSourceElements, pDestinationElement);
+        if (pSourceElement == nullptr)
+        {
+            Log_ErrorPrintf("VertexCompression::CompressVertices: No source element for %s%u",
+                            NameTable_GetNameString(NameTables::GPUVertexElementSemantic, pDestinationElement->Semantic), pDestinationElement->SemanticIndex);
+            return false;
+        }
+
+        if (GetVertexConversion(pSourceElement, pDestinationElement) == VERTEX_CONVERSION_NONE)
+        {
+            Log_ErrorPrintf("VertexCompression::CompressVertices: Can't convert %s%u from %s to %s",
+                            NameTable_GetNameString(NameTables::GPUVertexElementSemantic, pDestinationElement->Semantic), pDestinationElement->SemanticIndex,
+                            NameTable_GetNameString(NameTables::GPUVertexElementType, pSourceElement->Type),
+                            NameTable_GetNameString(NameTables::GPUVertexElementType, pDestinationElement->Type));
+            return false;
+        }
+    }
+
+    ALIGN_DECL(Y_SSE_ALIGNMENT) float gathered[BLOCK_SIZE * 4];
+    ALIGN_DECL(Y_SSE_ALIGNMENT) byte packed[BLOCK_SIZE * 16];
+
+    // one column at a time, so each pass only touches one element of each vertex
+    for (uint32 i = 0; i < nDestinationElements; i++)
+    {
+        const GPU_VERTEX_ELEMENT_DESC *pDestinationElement = &pDestinationElements[i];
+        const GPU_VERTEX_ELEMENT_DESC *pSourceElement = FindMatchingElement(pSourceElements, nSourceElements, pDestinationElement);
+        const byte *pSource = reinterpret_cast<const byte *>(pSourceVertices) + pSourceElement->StreamOffset;
+        byte *pDestination = reinterpret_cast<byte *>(pDestinationVertices) + pDestinationElement->StreamOffset;
+        uint32 sourceComponents = GPUVertexElementTypeComponentCount(pSourceElement->Type);
+        uint32 destinationComponents = GPUVertexElementTypeComponentCount(pDestinationElement->Type);
+        uint32 destinationSize = GPUVertexElementTypeSize(pDestinationElement->Type);
+
+        VERTEX_CONVERSION conversion = GetVertexConversion(pSourceElement, pDestinationElement);
+        for (uint32 start = 0; start < vertexCount; start += BLOCK_SIZE)
+        {
+            uint32 blockCount = Min(vertexCount - start, BLOCK_SIZE);
+            const byte *pBlockSource = pSource + start * sourceStride;
+            byte *pBlockDestination = pDestination + start * destinationStride;
+
+            switch (conversion)
+            {
+            case VERTEX_CONVERSION_COPY:
+                for (uint32 j = 0; j < blockCount; j++)
+                    Y_memcpy(pBlockDestination + j * destinationStride, pBlockSource + j * sourceStride, destinationSize);
+                continue;
+
+            case VERTEX_CONVERSION_FLOAT:
+                GatherFloats(reinterpret_cast<float *>(packed), destinationComponents, pBlockSource, sourceStride, sourceComponents, blockCount);
+                break;
+
+            case VERTEX_CONVERSION_HALF:
+                GatherFloats(gathered, destinationComponents, pBlockSource, sourceStride, sourceComponents, blockCount);
+                FloatToHalf(reinterpret_cast<uint16 *>(packed), gathered, blockCount * destinationComponents);
+                break;
+
+            case VERTEX_CONVERSION_SNORM16:
+                GatherFloats(gathered, destinationComponents, pBlockSource, sourceStride, sourceComponents, blockCount);
+                FloatToSNorm16(reinterpret_cast<int16 *>(packed), gathered, blockCount * destinationComponents);
+                break;
+
+            case VERTEX_CONVERSION_UNORM8:
+                GatherFloats(gathered, destinationComponents, pBlockSource, sourceStride, sourceComponents, blockCount);
+                FloatToUNorm8(reinterpret_cast<uint8 *>(packed), gathered, blockCount * destinationComponents);
+                break;
+
+            case VERTEX_CONVERSION_OCTAHEDRAL:
+                EncodeOctahedralNormalsStrided(reinterpret_cast<int16 *>(packed), pBlockSource, sourceStride, sourceComponents, blockCount);
+                break;
+
+            case VERTEX_CONVERSION_TANGENT:
+                EncodeTangentsStrided(reinterpret_cast<uint32 *>(packed), pBlockSource, sourceStride, sourceComponents, blockCount);
+                break;
+
+            default:
+                UnreachableCode();
+                break;
+            }
+
+            ScatterElements(pBlockDestination, destinationStride, packed, destinationSize, blockCount);
+        }
+    }
+
+    return true;
+}
@@ -327,6 +327,16 @@ void VulkanGPUContext::DiscardTargets(bool discardColor /*= true*/, bool discard
     Panic("The method or operation is not implemented.");
 }
 
+void VulkanGPUContext::DiscardRenderTargetView(GPURenderTargetView *pRenderTargetView)
+{
+    Panic("The method or operation is not implemented.");
+}
+
+void VulkanGPUContext::DiscardDepthStencilBufferView(GPUDepthStencilBufferView *pDepthStencilBufferView)
+{
+    Panic("The method or operation is not implemented.");
+}
+
 GPUOutputBuffer* VulkanGPUContext::GetOutputBuffer()
 {
     Panic("The method or operation is not implemented.");
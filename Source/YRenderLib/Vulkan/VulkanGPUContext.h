@@ -81,6 +81,8 @@ public:
 
     virtual void ClearTargets(bool clearColor = true, bool clearDepth = true, bool clearStencil = true, const FloatColor &clearColorValue = FloatColor::Black, float clearDepthValue = 1.0f, uint8 clearStencilValue = 0) override;
     virtual void DiscardTargets(bool discardColor = true, bool discardDepth = true, bool discardStencil = true) override;
+    virtual void DiscardRenderTargetView(GPURenderTargetView *pRenderTargetView) override;
+    virtual void DiscardDepthStencilBufferView(GPUDepthStencilBufferView *pDepthStencilBufferView) override;
 
     virtual GPUOutputBuffer* GetOutputBuffer() override;
     virtual void SetOutputBuffer(GPUOutputBuffer* pOutputBuffer) override;
@@ -201,3 +201,8 @@ void VulkanGPUDevice::EndResourceBatchUpload()
     Panic("The method or operation is not implemented.");
 }
 
+void VulkanGPUDevice::ReleaseResourceDeferred(GPUResource *pResource)
+{
+    Panic("The method or operation is not implemented.");
+}
+
@@ -47,6 +47,7 @@ public:
 
     virtual void BeginResourceBatchUpload() override;
     virtual void EndResourceBatchUpload() override;
+    virtual void ReleaseResourceDeferred(GPUResource *pResource) override;
 
 private:
     VkInstance m_vkInstance;
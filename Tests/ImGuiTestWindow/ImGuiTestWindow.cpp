@@ -16,7 +16,7 @@ int main(int argc, char* argv[])
     if (!RenderLib::CreateRenderDeviceAndWindow(&params, &pDevice, &pContext, &pWindow))
         Panic("Failed create window");
 
-    if (!ImGuiBridge::Initialize(pDevice, pContext))
+    if (!ImGuiBridge::Initialize(pDevice, pContext, params.GPUFrameLatency))
         Panic("Failed to initialize imgui bridge");
     
     while (!pWindow->IsClosed())
@@ -0,0 +1,385 @@
+#include <SDL.h>
+#include "YBaseLib/Log.h"
+#include "YBaseLib/PODArray.h"
+#include "YBaseLib/String.h"
+#include "YBaseLib/Timer.h"
+#include "YRenderLib/Renderer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+Log_SetChannel(ResourceBenchmark);
+
+// Measures resource creation/destruction, upload bandwidth and state object creation, and writes the results
+// as JSON to the output file, the console only gets the log. Runs without a window. The null backend discards
+// resource contents and needs no GPU, so it measures the frontend overhead alone; use -warp for the d3d11
+// software rasterizer when the driver should be included but no GPU is available.
+//
+// usage: ResourceBenchmark -output file.json [-platform null|d3d11] [-warp] [-iterations n]
+
+static GPUDevice *s_pDevice = nullptr;
+static GPUContext *s_pContext = nullptr;
+static uint32 s_iterations = 200;
+static FILE *s_pOutputFile = nullptr;
+static bool s_firstResult = true;
+
+// Time of each iteration in microseconds, reported as ops/sec over the total and percentiles.
+static void WriteResult(const char *name, PODArray<double> &samples, uint32 bytesPerOp = 0)
+{
+    if (samples.IsEmpty())
+    {
+        Log_WarningPrintf("%s: no samples", name);
+        return;
+    }
+
+    uint32 sampleCount = samples.GetSize();
+    double total = 0.0;
+    for (uint32 i = 0; i < sampleCount; i++)
+        total += samples[i];
+
+    std::sort(samples.GetBasePointer(), samples.GetBasePointer() + sampleCount);
+    auto percentile = [&samples, sampleCount](double p) { return samples[Min((uint32)(p * (double)sampleCount), sampleCount - 1)]; };
+
+    double opsPerSecond = (double)sampleCount / (total / 1000000.0);
+    double megabytesPerSecond = (bytesPerOp > 0) ? (opsPerSecond * (double)bytesPerOp / (1024.0 * 1024.0)) : 0.0;
+
+    fprintf(s_pOutputFile, "%s    { \"name\": \"%s\", \"iterations\": %u, \"ops_per_sec\": %.1f, \"mb_per_sec\": %.1f, "
+            "\"min_us\": %.2f, \"p50_us\": %.2f, \"p90_us\": %.2f, \"p99_us\": %.2f, \"max_us\": %.2f }",
+            s_firstResult ? "" : ",\n", name, sampleCount, opsPerSecond, megabytesPerSecond,
+            samples[0], percentile(0.5), percentile(0.9), percentile(0.99), samples[sampleCount - 1]);
+    s_firstResult = false;
+
+    Log_InfoPrintf("%-40s %10.1f ops/sec  p50 %8.2f us  p99 %8.2f us", name, opsPerSecond, percentile(0.5), percentile(0.99));
+}
+
+// Creates s_iterations objects timing each creation, then releases them timing each release.
+template<typename CreateFunction>
+static void BenchmarkCreateDestroy(const char *name, CreateFunction createFunction)
+{
+    PODArray<GPUResource *> resources;
+    PODArray<double> createSamples, destroySamples;
+    resources.Reserve(s_iterations);
+    createSamples.Reserve(s_iterations);
+    destroySamples.Reserve(s_iterations);
+
+    for (uint32 i = 0; i < s_iterations; i++)
+    {
+        Timer::Value start = Timer::GetValue();
+        GPUResource *pResource = createFunction(i);
+        createSamples.Add(Timer::ConvertValueToMilliseconds(Timer::GetValue() - start) * 1000.0);
+        if (pResource == nullptr)
+        {
+            Log_ErrorPrintf("%s: creation failed", name);
+            break;
+        }
+
+        resources.Add(pResource);
+    }
+
+    for (uint32 i = 0; i < resources.GetSize(); i++)
+    {
+        Timer::Value start = Timer::GetValue();
+        resources[i]->Release();
+        destroySamples.Add(Timer::ConvertValueToMilliseconds(Timer::GetValue() - start) * 1000.0);
+    }
+
+    // let the backend actually free everything before the next test
+    s_pContext->Flush();
+
+    SmallString resultName;
+    resultName.Format("create_%s", name);
+    WriteResult(resultName, createSamples);
+    resultName.Format("destroy_%s", name);
+    WriteResult(resultName, destroySamples);
+}
+
+// Times s_iterations calls of a function that uploads bytesPerOp bytes.
+template<typename UploadFunction>
+static void BenchmarkUpload(const char *name, uint32 bytesPerOp, UploadFunction uploadFunction)
+{
+    PODArray<double> samples;
+    samples.Reserve(s_iterations);
+    for (uint32 i = 0; i < s_iterations; i++)
+    {
+        Timer::Value start = Timer::GetValue();
+        if (!uploadFunction(i))
+        {
+            Log_ErrorPrintf("%s: upload failed", name);
+            break;
+        }
+        samples.Add(Timer::ConvertValueToMilliseconds(Timer::GetValue() - start) * 1000.0);
+    }
+
+    s_pContext->Flush();
+    WriteResult(name, samples, bytesPerOp);
+}
+
+static void RunBufferBenchmarks(const byte *pData)
+{
+    static const uint32 sizes[] = { 256, 64 * 1024, 4 * 1024 * 1024 };
+    SmallString name;
+
+    for (uint32 size : sizes)
+    {
+        name.Format("buffer_immutable_%u", size);
+        BenchmarkCreateDestroy(name, [size, pData](uint32) -> GPUResource * {
+            GPU_BUFFER_DESC desc(GPU_BUFFER_FLAG_BIND_VERTEX_BUFFER, size);
+            return s_pDevice->CreateBuffer(&desc, pData);
+        });
+
+        name.Format("buffer_writable_%u", size);
+        BenchmarkCreateDestroy(name, [size](uint32) -> GPUResource * {
+            GPU_BUFFER_DESC desc(GPU_BUFFER_FLAG_BIND_VERTEX_BUFFER | GPU_BUFFER_FLAG_WRITABLE, size);
+            return s_pDevice->CreateBuffer(&desc, nullptr);
+        });
+    }
+
+    // upload bandwidth
+    for (uint32 size : sizes)
+    {
+        GPU_BUFFER_DESC writableDesc(GPU_BUFFER_FLAG_BIND_VERTEX_BUFFER | GPU_BUFFER_FLAG_WRITABLE, size);
+        GPUBuffer *pWritableBuffer = s_pDevice->CreateBuffer(&writableDesc, nullptr);
+        GPU_BUFFER_DESC mappableDesc(GPU_BUFFER_FLAG_BIND_VERTEX_BUFFER | GPU_BUFFER_FLAG_MAPPABLE, size);
+        GPUBuffer *pMappableBuffer = s_pDevice->CreateBuffer(&mappableDesc, nullptr);
+        if (pWritableBuffer == nullptr || pMappableBuffer == nullptr)
+        {
+            Log_ErrorPrintf("Failed to create %u byte upload buffers", size);
+            SAFE_RELEASE(pWritableBuffer);
+            SAFE_RELEASE(pMappableBuffer);
+            continue;
+        }
+
+        name.Format("write_buffer_%u", size);
+        BenchmarkUpload(name, size, [pWritableBuffer, pData, size](uint32) {
+            return s_pContext->WriteBuffer(pWritableBuffer, pData, 0, size);
+        });
+
+        name.Format("map_buffer_discard_%u", size);
+        BenchmarkUpload(name, size, [pMappableBuffer, pData, size](uint32) {
+            void *pPointer;
+            if (!s_pContext->MapBuffer(pMappableBuffer, GPU_MAP_TYPE_WRITE_DISCARD, &pPointer))
+                return false;
+
+            Y_memcpy(pPointer, pData, size);
+            s_pContext->Unmapbuffer(pMappableBuffer, pPointer);
+            return true;
+        });
+
+        pWritableBuffer->Release();
+        pMappableBuffer->Release();
+    }
+}
+
+static void RunTextureBenchmarks(const byte *pData)
+{
+    static const uint32 sizes[] = { 64, 256, 1024 };
+    const PIXEL_FORMAT format = PIXEL_FORMAT_R8G8B8A8_UNORM;
+    const uint32 flags = GPU_TEXTURE_FLAG_SHADER_BINDABLE | GPU_TEXTURE_FLAG_WRITABLE;
+    GPU_SAMPLER_STATE_DESC samplerStateDesc;
+    samplerStateDesc.SetDefault();
+    SmallString name;
+
+    for (uint32 size : sizes)
+    {
+        name.Format("texture1d_%u", size);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_TEXTURE1D_DESC desc(size, format, flags, 1);
+            return s_pDevice->CreateTexture1D(&desc, &samplerStateDesc);
+        });
+
+        name.Format("texture1darray_%ux4", size);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_TEXTURE1DARRAY_DESC desc(size, format, flags, 1, 4);
+            return s_pDevice->CreateTexture1DArray(&desc, &samplerStateDesc);
+        });
+
+        name.Format("texture2d_%u", size);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_TEXTURE2D_DESC desc(size, size, format, flags, 1);
+            return s_pDevice->CreateTexture2D(&desc, &samplerStateDesc);
+        });
+
+        name.Format("texture2d_initial_data_%u", size);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_TEXTURE2D_DESC desc(size, size, format, GPU_TEXTURE_FLAG_SHADER_BINDABLE, 1);
+            const void *pInitialData = pData;
+            uint32 initialDataPitch = size * 4;
+            return s_pDevice->CreateTexture2D(&desc, &samplerStateDesc, &pInitialData, &initialDataPitch);
+        });
+
+        name.Format("texture2darray_%ux4", size);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_TEXTURE2DARRAY_DESC desc(size, size, format, flags, 1, 4);
+            return s_pDevice->CreateTexture2DArray(&desc, &samplerStateDesc);
+        });
+
+        name.Format("texture3d_%u", size / 4);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_TEXTURE3D_DESC desc(size / 4, size / 4, size / 4, format, flags, 1);
+            return s_pDevice->CreateTexture3D(&desc, &samplerStateDesc);
+        });
+
+        name.Format("texturecube_%u", size);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_TEXTURECUBE_DESC desc(size, size, format, flags, 1);
+            return s_pDevice->CreateTextureCube(&desc, &samplerStateDesc);
+        });
+
+        name.Format("texturecubearray_%ux2", size);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_TEXTURECUBEARRAY_DESC desc(size, size, format, flags, 1, 2);
+            return s_pDevice->CreateTextureCubeArray(&desc, &samplerStateDesc);
+        });
+
+        name.Format("depthtexture_%u", size);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_DEPTH_TEXTURE_DESC desc(size, size, PIXEL_FORMAT_D32_FLOAT, GPU_TEXTURE_FLAG_BIND_DEPTH_STENCIL_BUFFER);
+            return s_pDevice->CreateDepthTexture(&desc);
+        });
+
+        name.Format("render_target_%u", size);
+        BenchmarkCreateDestroy(name, [&](uint32) -> GPUResource * {
+            GPU_TEXTURE2D_DESC desc(size, size, format, GPU_TEXTURE_FLAG_SHADER_BINDABLE | GPU_TEXTURE_FLAG_BIND_RENDER_TARGET, 1);
+            return s_pDevice->CreateTexture2D(&desc, &samplerStateDesc);
+        });
+    }
+
+    // upload bandwidth, full and partial updates
+    for (uint32 size : sizes)
+    {
+        GPU_TEXTURE2D_DESC desc(size, size, format, flags, 1);
+        GPUTexture2D *pTexture = s_pDevice->CreateTexture2D(&desc, &samplerStateDesc);
+        if (pTexture == nullptr)
+        {
+            Log_ErrorPrintf("Failed to create %ux%u upload texture", size, size);
+            continue;
+        }
+
+        uint32 rowPitch = size * 4;
+        name.Format("write_texture2d_%u", size);
+        BenchmarkUpload(name, rowPitch * size, [pTexture, pData, rowPitch, size](uint32) {
+            return s_pContext->WriteTexture(pTexture, pData, rowPitch, rowPitch * size, 0, 0, 0, size, size);
+        });
+
+        uint32 tileSize = size / 4;
+        name.Format("write_texture2d_%u_region_%u", size, tileSize);
+        BenchmarkUpload(name, tileSize * tileSize * 4, [pTexture, pData, tileSize](uint32 i) {
+            uint32 x = (i % 4) * tileSize, y = ((i / 4) % 4) * tileSize;
+            return s_pContext->WriteTexture(pTexture, pData, tileSize * 4, tileSize * tileSize * 4, 0, x, y, tileSize, tileSize);
+        });
+
+        pTexture->Release();
+    }
+}
+
+static void RunStateBenchmarks()
+{
+    // vary a field per iteration so backends can't return a cached object
+    BenchmarkCreateDestroy("rasterizer_state", [](uint32 i) -> GPUResource * {
+        RENDERER_RASTERIZER_STATE_DESC desc;
+        desc.SetDefault();
+        desc.DepthBias = (int32)i;
+        return s_pDevice->CreateRasterizerState(&desc);
+    });
+
+    BenchmarkCreateDestroy("depth_stencil_state", [](uint32 i) -> GPUResource * {
+        RENDERER_DEPTHSTENCIL_STATE_DESC desc;
+        desc.SetDefault();
+        desc.StencilReadMask = (uint8)i;
+        desc.StencilWriteMask = (uint8)(i >> 8);
+        return s_pDevice->CreateDepthStencilState(&desc);
+    });
+
+    BenchmarkCreateDestroy("blend_state", [](uint32 i) -> GPUResource * {
+        RENDERER_BLEND_STATE_DESC desc;
+        desc.SetDefault();
+        desc.BlendEnable = true;
+        desc.SrcBlend = (RENDERER_BLEND_OPTION)(i % RENDERER_BLEND_OPTION_COUNT);
+        desc.DestBlend = (RENDERER_BLEND_OPTION)((i / RENDERER_BLEND_OPTION_COUNT) % RENDERER_BLEND_OPTION_COUNT);
+        return s_pDevice->CreateBlendState(&desc);
+    });
+
+    BenchmarkCreateDestroy("sampler_state", [](uint32 i) -> GPUResource * {
+        GPU_SAMPLER_STATE_DESC desc;
+        desc.SetDefault();
+        desc.LODBias = (float)i * 0.01f;
+        return s_pDevice->CreateSamplerState(&desc);
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    Log::GetInstance().SetConsoleOutputParams(true);
+
+    RendererInitializationParameters params;
+    params.HideImplicitSwapChain = true;
+    const char *outputFileName = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (Y_strcmp(argv[i], "-platform") == 0 && (i + 1) < argc)
+        {
+            i++;
+            if (Y_strcmp(argv[i], "null") == 0)
+            {
+                params.Platform = RENDERER_PLATFORM_NULL;
+            }
+            else if (Y_strcmp(argv[i], "d3d11") == 0)
+            {
+                params.Platform = RENDERER_PLATFORM_D3D11;
+            }
+            else
+            {
+                Log_ErrorPrintf("Unknown platform '%s', expected null or d3d11", argv[i]);
+                return 1;
+            }
+        }
+        else if (Y_strcmp(argv[i], "-warp") == 0)
+        {
+            params.D3DForceWarpDevice = true;
+        }
+        else if (Y_strcmp(argv[i], "-iterations") == 0 && (i + 1) < argc)
+        {
+            s_iterations = Max((uint32)atoi(argv[++i]), (uint32)1);
+        }
+        else if (Y_strcmp(argv[i], "-output") == 0 && (i + 1) < argc)
+        {
+            outputFileName = argv[++i];
+        }
+    }
+
+    // the log goes to the console, so the results can't share it
+    if (outputFileName == nullptr)
+    {
+        Log_ErrorPrintf("No output file, usage: ResourceBenchmark -output file.json [-platform null|d3d11] [-warp] [-iterations n]");
+        return 1;
+    }
+
+    // no window, the benchmarks don't present
+    GPUOutputBuffer *pOutputBuffer;
+    if (!RenderLib::CreateRenderDevice(&params, nullptr, &s_pDevice, &s_pContext, &pOutputBuffer))
+        Panic("Failed to create device");
+
+    s_pOutputFile = fopen(outputFileName, "w");
+    if (s_pOutputFile == nullptr)
+        Panic("Failed to open output file");
+
+    // source data for uploads, large enough for the biggest buffer and texture
+    PODArray<byte> data;
+    data.Resize(4 * 1024 * 1024);
+    for (uint32 i = 0; i < data.GetSize(); i++)
+        data[i] = (byte)(i * 31);
+
+    fprintf(s_pOutputFile, "{\n  \"platform\": \"%s\",\n  \"warp\": %s,\n  \"iterations\": %u,\n  \"results\": [\n",
+            NameTable_GetNameString(NameTables::RendererPlatform, s_pDevice->GetPlatform()), params.D3DForceWarpDevice ? "true" : "false", s_iterations);
+
+    RunBufferBenchmarks(data.GetBasePointer());
+    RunTextureBenchmarks(data.GetBasePointer());
+    RunStateBenchmarks();
+
+    fprintf(s_pOutputFile, "\n  ]\n}\n");
+    fclose(s_pOutputFile);
+
+    SAFE_RELEASE(pOutputBuffer);
+    s_pContext->Release();
+    s_pDevice->Release();
+    return 0;
+}